@@ -0,0 +1,204 @@
+#include "bench_common.h"
+#include <string.h>
+#include "tree/art.h"
+#include "tree/rb_tree.h"
+
+// URL路由表：n条形如"/api/v2/service17/123456/update"的路由，公共前缀长
+// 对比以strcmp为比较函数的红黑树与自适应基数树：随机插入、精确查找、
+// 最长前缀匹配（请求路径在路由后带有额外路径段；红黑树按'/'逐段截短后重试查找）、前缀扫描
+// 用法：bench_art [n1 n2 ...]，默认 100K 与 1M
+
+#define KEY_SIZE 64
+#define SCAN_COUNT 1000
+
+static volatile uintptr_t sink;
+
+static const char *const actions[] = {"create", "read", "update", "delete", "list", "search", "export", "audit"};
+
+static int str_cmp(void *a, void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+static bool count_visit(const unsigned char *key, size_t len, void *value, void *arg)
+{
+    (void)key;
+    (void)len;
+    (void)value;
+    (*(size_t *)arg)++;
+    return true;
+}
+
+static bool rb_count_visit(void *key, void *value, void *arg)
+{
+    (void)key;
+    (void)value;
+    (*(size_t *)arg)++;
+    return true;
+}
+
+// 生成路由（各不相同）与对应的请求路径
+static void make_routes(size_t n, char *routes, char *requests, size_t *lens, uint64_t *seed)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t r = bench_rand(seed);
+        int len = snprintf(routes + i * KEY_SIZE, KEY_SIZE, "/api/v%u/service%u/%zu/%s", (unsigned)(r % 3) + 1,
+                           (unsigned)(r >> 8) % 64, i, actions[(r >> 20) % 8]);
+        lens[i] = (size_t)len;
+        snprintf(requests + i * KEY_SIZE, KEY_SIZE, "%s/item/%u", routes + i * KEY_SIZE, (unsigned)(r >> 32) % 1000);
+    }
+}
+
+static void shuffle(size_t *order, size_t n, uint64_t *seed)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        order[i] = i;
+    }
+    for (size_t i = n - 1; i > 0; i--)
+    {
+        size_t j = (size_t)(bench_rand(seed) % (i + 1));
+        size_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+}
+
+static void run_rb(size_t n, char *routes, char *requests, const size_t *order)
+{
+    rb_tree_t *rb = rb_create_pooled(str_cmp, 0);
+    char buf[KEY_SIZE];
+    uintptr_t check = 0;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        rb_put(rb, routes + order[i] * KEY_SIZE, (void *)(order[i] + 1));
+    }
+    bench_report("rb_tree strcmp insert", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        check += (uintptr_t)rb_get(rb, routes + order[i] * KEY_SIZE);
+    }
+    bench_report("rb_tree strcmp lookup", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        // 从完整路径开始，每次在最后一个'/'处截短，直到命中路由
+        strcpy(buf, requests + order[i] * KEY_SIZE);
+        size_t len = strlen(buf);
+        for (;;)
+        {
+            void *value = rb_get(rb, buf);
+            if (value != NULL)
+            {
+                check += (uintptr_t)value;
+                break;
+            }
+            while (len > 0 && buf[len - 1] != '/')
+            {
+                len--;
+            }
+            if (len == 0)
+            {
+                break;
+            }
+            buf[--len] = '\0';
+        }
+    }
+    bench_report("rb_tree longest prefix", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    size_t seen = 0;
+    for (size_t i = 0; i < SCAN_COUNT; i++)
+    {
+        // 前缀扫描：区间["/api/v2/service17/", "/api/v2/service170")，'0'紧跟在'/'之后
+        const char *route = routes + order[i % n] * KEY_SIZE;
+        const char *end = strchr(route + 8, '/') + 1;
+        size_t plen = (size_t)(end - route);
+        char low[KEY_SIZE];
+        char high[KEY_SIZE];
+        memcpy(low, route, plen);
+        low[plen] = '\0';
+        memcpy(high, low, plen + 1);
+        high[plen - 1] = '0';
+        rb_range(rb, low, high, rb_count_visit, &seen);
+    }
+    bench_report("rb_tree prefix scan", SCAN_COUNT, SCAN_COUNT, bench_now_ns() - start);
+    sink = check + seen;
+    rb_destroy(rb);
+}
+
+static void run_art(size_t n, char *routes, char *requests, const size_t *lens, const size_t *order)
+{
+    art_tree_t *art = art_create();
+    uintptr_t check = 0;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        art_put(art, routes + order[i] * KEY_SIZE, lens[order[i]], (void *)(order[i] + 1));
+    }
+    bench_report("art insert", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        check += (uintptr_t)art_get(art, routes + order[i] * KEY_SIZE, lens[order[i]]);
+    }
+    bench_report("art lookup", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        const char *request = requests + order[i] * KEY_SIZE;
+        void *value = NULL;
+        art_longest_prefix(art, request, strlen(request), NULL, &value);
+        check += (uintptr_t)value;
+    }
+    bench_report("art longest prefix", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    size_t seen = 0;
+    for (size_t i = 0; i < SCAN_COUNT; i++)
+    {
+        const char *route = routes + order[i % n] * KEY_SIZE;
+        const char *end = strchr(route + 8, '/') + 1;
+        art_scan_prefix(art, route, (size_t)(end - route), count_visit, &seen);
+    }
+    bench_report("art prefix scan", SCAN_COUNT, SCAN_COUNT, bench_now_ns() - start);
+    sink = check + seen;
+    art_destroy(art);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {100000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t n = sizes[i];
+        char *routes = (char *)malloc(n * KEY_SIZE);
+        char *requests = (char *)malloc(n * KEY_SIZE);
+        size_t *lens = (size_t *)malloc(n * sizeof(size_t));
+        size_t *order = (size_t *)malloc(n * sizeof(size_t));
+        uint64_t seed = 42;
+
+        make_routes(n, routes, requests, lens, &seed);
+        shuffle(order, n, &seed);
+        run_rb(n, routes, requests, order);
+        run_art(n, routes, requests, lens, order);
+        printf("\n");
+        free(routes);
+        free(requests);
+        free(lens);
+        free(order);
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "bench_common.h"
+#include "tree/bplus_tree.h"
+#include "tree/rb_tree.h"
+
+// 有序索引：红黑树 与 B+树（比较函数键 / uint64_t键节点内SIMD查找）对比
+// 随机插入、随机查找、整体范围扫描（B+树按叶节点整段复制到缓冲区）
+// uint64_t键的B+树在CPU支持的每个节点内SIMD级别（线性扫描/SSE4.2/AVX2）下各跑一次
+// 用法：bench_bplus_tree [n1 n2 ...]，默认 1M 与 4M
+
+#define SCAN_BATCH 4096
+
+static volatile uintptr_t sink;
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static void report_scan(const char *name, size_t n, uint64_t ns)
+{
+    bench_report(name, n, n, ns);
+    printf("  %.2f GB/s (16 bytes per entry)\n", ns > 0 ? (double)n * 16 / (double)ns : 0.0);
+}
+
+static void run_rb(size_t n, const uint64_t *keys)
+{
+    rb_tree_t *rb = rb_create_pooled(key_cmp, 0);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        rb_put(rb, (void *)(uintptr_t)keys[i], NULL);
+    }
+    bench_report("rb_tree insert", n, n, bench_now_ns() - start);
+
+    uintptr_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += rb_contains(rb, (void *)(uintptr_t)keys[i]);
+    }
+    bench_report("rb_tree find", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (rb_node_t *node = rb_first(rb); node != NULL; node = rb_next(node))
+    {
+        found += (uintptr_t)node->key + (uintptr_t)node->value;
+    }
+    report_scan("rb_tree scan", n, bench_now_ns() - start);
+    sink = found;
+    rb_destroy(rb);
+}
+
+static void run_bpt(size_t n, const uint64_t *keys, bool generic)
+{
+    static const char *const level_names[] = {"scan", "sse4.2", "avx2"};
+    bplus_tree_t *bpt = generic ? bpt_create(key_cmp) : bpt_create_u64();
+    char label[48];
+    char name[64];
+    if (generic)
+    {
+        snprintf(label, sizeof(label), "bplus_tree cmp");
+    }
+    else
+    {
+        snprintf(label, sizeof(label), "bplus_tree u64 %s", level_names[bpt_simd_level()]);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        if (generic)
+        {
+            bpt_put(bpt, (void *)(uintptr_t)keys[i], NULL);
+        }
+        else
+        {
+            bpt_put_u64(bpt, keys[i], NULL);
+        }
+    }
+    snprintf(name, sizeof(name), "%s insert", label);
+    bench_report(name, n, n, bench_now_ns() - start);
+
+    uintptr_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += generic ? bpt_find(bpt, (void *)(uintptr_t)keys[i], NULL) : bpt_find_u64(bpt, keys[i], NULL);
+    }
+    snprintf(name, sizeof(name), "%s find", label);
+    bench_report(name, n, n, bench_now_ns() - start);
+
+    if (!generic)
+    {
+        uint64_t *batch_keys = (uint64_t *)malloc(SCAN_BATCH * sizeof(uint64_t));
+        void **batch_values = (void **)malloc(SCAN_BATCH * sizeof(void *));
+        uint64_t low = 0;
+        size_t got;
+        size_t total = 0;
+        start = bench_now_ns();
+        while ((got = bpt_range_u64(bpt, low, UINT64_MAX, batch_keys, batch_values, SCAN_BATCH)) > 0)
+        {
+            found += batch_keys[got - 1] + (uintptr_t)batch_values[got - 1];
+            total += got;
+            low = batch_keys[got - 1] + 1;
+        }
+        snprintf(name, sizeof(name), "%s range scan", label);
+        report_scan(name, total, bench_now_ns() - start);
+        free(batch_keys);
+        free(batch_values);
+    }
+    snprintf(name, sizeof(name), "%s iterator scan", label);
+    start = bench_now_ns();
+    size_t total = 0;
+    for (bpt_iter_t it = bpt_first(bpt); bpt_iter_valid(it); bpt_iter_next(&it))
+    {
+        found += bpt_iter_key_u64(it) + (uintptr_t)bpt_iter_value(it);
+        total++;
+    }
+    report_scan(name, total, bench_now_ns() - start);
+    printf("  height=%zu\n", bpt_height(bpt));
+    sink = found;
+    bpt_destroy(bpt);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000000, 4000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t n = sizes[i];
+        uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+        uint64_t seed = 42;
+        for (size_t j = 0; j < n; j++)
+        {
+            keys[j] = bench_rand(&seed);
+        }
+        run_rb(n, keys);
+        run_bpt(n, keys, true);
+        bpt_simd_t supported = bpt_simd_level();
+        for (int level = BPT_SIMD_NONE; level <= (int)supported; level++)
+        {
+            bpt_set_simd_level((bpt_simd_t)level);
+            run_bpt(n, keys, false);
+        }
+        free(keys);
+        printf("\n");
+    }
+    return 0;
+}
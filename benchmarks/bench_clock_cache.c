@@ -0,0 +1,199 @@
+#include "bench_common.h"
+#include <pthread.h>
+#include "cache/lru_cache.h"
+#include "cache/clock_cache.h"
+
+// 读多写少的缓存扩展性：分片CLOCK缓存对比单互斥锁保护的LRU缓存
+// 键空间为缓存容量的2倍，80%的访问落在20%的热键上；未命中时回填。
+// 线程数从1倍增到64，同时给出命中率与clock_cache抽样的平均查找耗时
+// 用法：bench_clock_cache [容量]，默认 100K
+
+#define TOTAL_OPS 4000000
+#define MAX_THREADS 64
+
+static size_t key_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+static int key_cmp(void *a, void *b)
+{
+    return a != b;
+}
+
+// 统一两种缓存的操作接口
+typedef struct
+{
+    const char *name;
+    void *(*create)(size_t capacity);
+    void (*destroy)(void *cache);
+    bool (*put)(void *cache, void *key, void *value);
+    bool (*find)(void *cache, void *key, void **value);
+} cache_ops_t;
+
+// 单互斥锁保护的LRU缓存：每次命中都要加锁移动链表节点
+typedef struct
+{
+    pthread_mutex_t lock;
+    lru_cache_t *lru;
+} locked_lru_t;
+
+static void *locked_create(size_t capacity)
+{
+    locked_lru_t *c = (locked_lru_t *)malloc(sizeof(locked_lru_t));
+    pthread_mutex_init(&c->lock, NULL);
+    c->lru = lru_create(capacity, key_hash, key_cmp, NULL, NULL);
+    return c;
+}
+
+static void locked_destroy(void *cache)
+{
+    locked_lru_t *c = (locked_lru_t *)cache;
+    lru_destroy(c->lru);
+    pthread_mutex_destroy(&c->lock);
+    free(c);
+}
+
+static bool locked_put(void *cache, void *key, void *value)
+{
+    locked_lru_t *c = (locked_lru_t *)cache;
+    pthread_mutex_lock(&c->lock);
+    bool ok = lru_put(c->lru, key, value);
+    pthread_mutex_unlock(&c->lock);
+    return ok;
+}
+
+static bool locked_find(void *cache, void *key, void **value)
+{
+    locked_lru_t *c = (locked_lru_t *)cache;
+    pthread_mutex_lock(&c->lock);
+    bool found = lru_find(c->lru, key, value);
+    pthread_mutex_unlock(&c->lock);
+    return found;
+}
+
+static void *cc_create_op(size_t capacity)
+{
+    clock_cache_t *cache = cc_create(capacity, 0, key_hash, key_cmp, NULL, NULL);
+    // 只开启耗时抽样（每64次计时一次），命中计数由工作线程自己统计
+    cc_set_sampling(cache, 64);
+    return cache;
+}
+
+static void cc_destroy_op(void *cache)
+{
+    cc_destroy((clock_cache_t *)cache);
+}
+
+static bool cc_put_op(void *cache, void *key, void *value)
+{
+    return cc_put((clock_cache_t *)cache, key, value);
+}
+
+static bool cc_find_op(void *cache, void *key, void **value)
+{
+    return cc_find((clock_cache_t *)cache, key, value);
+}
+
+static const cache_ops_t caches[] = {
+    {"mutex+lru", locked_create, locked_destroy, locked_put, locked_find},
+    {"clock_cache", cc_create_op, cc_destroy_op, cc_put_op, cc_find_op},
+};
+
+typedef struct
+{
+    const cache_ops_t *ops;
+    void *cache;
+    size_t keys;
+    size_t count;
+    uint64_t seed;
+    size_t hits;
+} worker_t;
+
+static void *worker_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    size_t hot = w->keys / 5;
+    for (size_t i = 0; i < w->count; i++)
+    {
+        uint64_t r = bench_rand(&w->seed);
+        uintptr_t key = (r >> 32) % 100 < 80 ? (uintptr_t)(r % hot) : (uintptr_t)(hot + r % (w->keys - hot));
+        key++;
+        void *value;
+        if (w->ops->find(w->cache, (void *)key, &value))
+        {
+            w->hits++;
+        }
+        else
+        {
+            w->ops->put(w->cache, (void *)key, (void *)key);
+        }
+    }
+    return NULL;
+}
+
+static void run(const cache_ops_t *ops, size_t capacity, size_t threads)
+{
+    void *cache = ops->create(capacity);
+    pthread_t tids[MAX_THREADS];
+    worker_t workers[MAX_THREADS];
+    size_t keys = capacity * 2;
+
+    for (uintptr_t key = 1; key <= capacity; key++)
+    {
+        ops->put(cache, (void *)key, (void *)key);
+    }
+
+    size_t per_thread = TOTAL_OPS / threads;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers[i].ops = ops;
+        workers[i].cache = cache;
+        workers[i].keys = keys;
+        workers[i].count = per_thread;
+        workers[i].seed = i * 7919 + 1;
+        workers[i].hits = 0;
+        pthread_create(&tids[i], NULL, worker_run, &workers[i]);
+    }
+    size_t hits = 0;
+    for (size_t i = 0; i < threads; i++)
+    {
+        pthread_join(tids[i], NULL);
+        hits += workers[i].hits;
+    }
+    uint64_t ns = bench_now_ns() - start;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s t=%zu", ops->name, threads);
+    bench_report(name, capacity, per_thread * threads, ns);
+    printf("    hit rate %.1f%%", 100.0 * (double)hits / (double)(per_thread * threads));
+    if (ops->create == cc_create_op)
+    {
+        cc_stats_t stats;
+        cc_stats((clock_cache_t *)cache, &stats);
+        printf(", shards %zu, sampled lookup avg %.1f ns max %llu ns",
+               cc_shard_count((clock_cache_t *)cache),
+               stats.lookup_samples ? (double)stats.lookup_ns / (double)stats.lookup_samples : 0.0,
+               (unsigned long long)stats.lookup_max_ns);
+    }
+    printf("\n");
+
+    ops->destroy(cache);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {100000};
+    size_t sizes[1];
+    bench_parse_sizes(argc, argv, sizes, 1, defaults, 1);
+
+    for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        for (size_t c = 0; c < sizeof(caches) / sizeof(caches[0]); c++)
+        {
+            run(&caches[c], sizes[0], threads);
+        }
+    }
+    return 0;
+}
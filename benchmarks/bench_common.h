@@ -0,0 +1,68 @@
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+// 基准测试公共工具：计时、随机数、规模参数解析
+// 须在其他系统头文件之前包含
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// 单调时钟（纳秒）
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift64* 伪随机数
+static inline uint64_t bench_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+// 解析命令行中的规模参数，未指定时使用默认值
+// 返回规模个数，结果写入sizes（最多max个）
+static inline size_t bench_parse_sizes(int argc, char **argv, size_t *sizes, size_t max,
+                                       const size_t *defaults, size_t ndefaults)
+{
+    size_t count = 0;
+    for (int i = 1; i < argc && count < max; i++)
+    {
+        char *end = NULL;
+        unsigned long long value = strtoull(argv[i], &end, 10);
+        if (end != argv[i] && value > 0)
+        {
+            sizes[count++] = (size_t)value;
+        }
+    }
+    if (count == 0)
+    {
+        for (size_t i = 0; i < ndefaults && i < max; i++)
+        {
+            sizes[count++] = defaults[i];
+        }
+    }
+    return count;
+}
+
+// 以 Mops/s 打印一次测量结果
+static inline void bench_report(const char *name, size_t n, uint64_t ops, uint64_t ns)
+{
+    double sec = (double)ns / 1e9;
+    printf("%-36s n=%-10zu %10.2f ms %10.2f Mops/s\n", name, n, (double)ns / 1e6,
+           sec > 0 ? (double)ops / sec / 1e6 : 0.0);
+}
+
+#endif // __BENCH_COMMON_H__
@@ -0,0 +1,212 @@
+#include "bench_common.h"
+#include <pthread.h>
+#include "hash_table/hash_table.h"
+#include "hash_table/concurrent_map.h"
+
+// 并发哈希表读写扩展性：读无锁的concurrent_map对比单互斥锁保护的hash_table
+// 每个线程在预填充的键空间上随机读写，写操作为插入或删除各半；
+// 读比例分别为90%与99%，线程数从1倍增到64
+// 用法：bench_concurrent_map [键数]，默认 100K
+
+#define TOTAL_OPS 4000000
+#define MAX_THREADS 64
+
+static size_t key_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+static int key_cmp(void *a, void *b)
+{
+    return a != b;
+}
+
+// 统一两种表的操作接口
+typedef struct
+{
+    const char *name;
+    void *(*create)(void);
+    void (*destroy)(void *map);
+    bool (*put)(void *map, void *key, void *value);
+    bool (*find)(void *map, void *key, void **value);
+    bool (*remove)(void *map, void *key);
+} map_ops_t;
+
+// 单互斥锁保护的Robin Hood表
+typedef struct
+{
+    pthread_mutex_t lock;
+    hash_table_t *ht;
+} locked_table_t;
+
+static void *locked_create(void)
+{
+    locked_table_t *t = (locked_table_t *)malloc(sizeof(locked_table_t));
+    pthread_mutex_init(&t->lock, NULL);
+    t->ht = ht_create(key_hash, key_cmp);
+    return t;
+}
+
+static void locked_destroy(void *map)
+{
+    locked_table_t *t = (locked_table_t *)map;
+    ht_destroy(t->ht);
+    pthread_mutex_destroy(&t->lock);
+    free(t);
+}
+
+static bool locked_put(void *map, void *key, void *value)
+{
+    locked_table_t *t = (locked_table_t *)map;
+    pthread_mutex_lock(&t->lock);
+    bool ok = ht_put(t->ht, key, value);
+    pthread_mutex_unlock(&t->lock);
+    return ok;
+}
+
+static bool locked_find(void *map, void *key, void **value)
+{
+    locked_table_t *t = (locked_table_t *)map;
+    pthread_mutex_lock(&t->lock);
+    bool found = ht_find(t->ht, key, value);
+    pthread_mutex_unlock(&t->lock);
+    return found;
+}
+
+static bool locked_remove(void *map, void *key)
+{
+    locked_table_t *t = (locked_table_t *)map;
+    pthread_mutex_lock(&t->lock);
+    bool found = ht_remove(t->ht, key, NULL);
+    pthread_mutex_unlock(&t->lock);
+    return found;
+}
+
+static void *cm_create_op(void)
+{
+    return cm_create(key_hash, key_cmp);
+}
+
+static void cm_destroy_op(void *map)
+{
+    cm_destroy((concurrent_map_t *)map);
+}
+
+static bool cm_put_op(void *map, void *key, void *value)
+{
+    return cm_put((concurrent_map_t *)map, key, value);
+}
+
+static bool cm_find_op(void *map, void *key, void **value)
+{
+    return cm_find((concurrent_map_t *)map, key, value);
+}
+
+static bool cm_remove_op(void *map, void *key)
+{
+    return cm_remove((concurrent_map_t *)map, key, NULL);
+}
+
+static const map_ops_t maps[] = {
+    {"mutex+robin_hood", locked_create, locked_destroy, locked_put, locked_find, locked_remove},
+    {"concurrent_map", cm_create_op, cm_destroy_op, cm_put_op, cm_find_op, cm_remove_op},
+};
+
+typedef struct
+{
+    const map_ops_t *ops;
+    void *map;
+    size_t keys;
+    size_t count;
+    unsigned read_percent;
+    uint64_t seed;
+    size_t found;
+} worker_t;
+
+static void *worker_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    for (size_t i = 0; i < w->count; i++)
+    {
+        uint64_t r = bench_rand(&w->seed);
+        uintptr_t key = (uintptr_t)(r % w->keys) + 1;
+        if ((r >> 32) % 100 < w->read_percent)
+        {
+            void *value;
+            w->found += w->ops->find(w->map, (void *)key, &value);
+        }
+        else if ((r >> 40) & 1)
+        {
+            w->ops->put(w->map, (void *)key, (void *)key);
+        }
+        else
+        {
+            w->ops->remove(w->map, (void *)key);
+        }
+    }
+    return NULL;
+}
+
+static volatile size_t sink;
+
+static void run(const map_ops_t *ops, size_t keys, size_t threads, unsigned read_percent)
+{
+    void *map = ops->create();
+    pthread_t tids[MAX_THREADS];
+    worker_t workers[MAX_THREADS];
+
+    // 预填充一半的键，写操作使存在的键数保持在一半左右
+    for (uintptr_t key = 1; key <= keys; key += 2)
+    {
+        ops->put(map, (void *)key, (void *)key);
+    }
+
+    size_t per_thread = TOTAL_OPS / threads;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers[i].ops = ops;
+        workers[i].map = map;
+        workers[i].keys = keys;
+        workers[i].count = per_thread;
+        workers[i].read_percent = read_percent;
+        workers[i].seed = i * 7919 + 1;
+        workers[i].found = 0;
+        pthread_create(&tids[i], NULL, worker_run, &workers[i]);
+    }
+    size_t found = 0;
+    for (size_t i = 0; i < threads; i++)
+    {
+        pthread_join(tids[i], NULL);
+        found += workers[i].found;
+    }
+    uint64_t ns = bench_now_ns() - start;
+    sink = found;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s r%u%% t=%zu", ops->name, read_percent, threads);
+    bench_report(name, keys, per_thread * threads, ns);
+
+    ops->destroy(map);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {100000};
+    size_t sizes[1];
+    bench_parse_sizes(argc, argv, sizes, 1, defaults, 1);
+
+    static const unsigned read_percents[] = {90, 99};
+    for (size_t r = 0; r < 2; r++)
+    {
+        for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2)
+        {
+            for (size_t m = 0; m < sizeof(maps) / sizeof(maps[0]); m++)
+            {
+                run(&maps[m], sizes[0], threads, read_percents[r]);
+            }
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_common.h"
+#include <string.h>
+#include <unistd.h>
+#include "tree/disk_btree.h"
+#include "tree/bplus_tree.h"
+
+// 持久化有序索引：随机插入（每BATCH次提交一次，默认缓存与能容纳整棵树的缓存）、从有序输入批量构建、
+// 以及重启后的"就绪 + LOOKUPS次随机查找"：
+// 把键值对顺序保存为普通文件、启动时读回并插入内存B+树，对比直接打开磁盘B+树（页缓存或mmap）
+// 另测缓存预热后的随机查找与整体范围扫描。文件建在/tmp下，结束时删除
+// 用法：bench_disk_btree [n1 n2 ...]，默认 100K 与 1M
+
+#define BATCH 10000
+#define LOOKUPS 10000
+#define SCAN_BATCH 1024
+
+static volatile uint64_t sink;
+
+static void make_path(char *path)
+{
+    strcpy(path, "/tmp/bench_disk_btree_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+static void remove_files(const char *path)
+{
+    char wal[64];
+    snprintf(wal, sizeof(wal), "%s-wal", path);
+    unlink(path);
+    unlink(wal);
+}
+
+// 修改过的页装不下缓存时会自动提交，每次提交两次fsync
+static void run_insert(size_t n, const uint64_t *keys, const char *path, size_t cache, const char *name)
+{
+    unlink(path);
+    disk_btree_t *dbt = dbt_open(path, 0, cache);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        dbt_put(dbt, keys[i], i);
+        if ((i + 1) % BATCH == 0)
+        {
+            dbt_commit(dbt);
+        }
+    }
+    dbt_close(dbt);
+    bench_report(name, n, n, bench_now_ns() - start);
+}
+
+static void run_bulk(size_t n, const uint64_t *sorted, const uint64_t *values, const char *path)
+{
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+    uint64_t start = bench_now_ns();
+    dbt_bulk_load(dbt, sorted, values, n);
+    dbt_close(dbt);
+    bench_report("disk_btree bulk load", n, n, bench_now_ns() - start);
+}
+
+// 基准做法：键值对按序写成普通文件，重启时整个读回并逐个插入内存B+树
+static void run_reload(size_t n, const uint64_t *sorted, const uint64_t *values, const uint64_t *probes,
+                       const char *path)
+{
+    FILE *fp = fopen(path, "wb");
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t pair[2] = {sorted[i], values[i]};
+        fwrite(pair, sizeof(pair), 1, fp);
+    }
+    fclose(fp);
+
+    uint64_t start = bench_now_ns();
+    bplus_tree_t *bpt = bpt_create_u64();
+    uint64_t *buf = (uint64_t *)malloc(2 * SCAN_BATCH * sizeof(uint64_t));
+    fp = fopen(path, "rb");
+    size_t got;
+    while ((got = fread(buf, 2 * sizeof(uint64_t), SCAN_BATCH, fp)) > 0)
+    {
+        for (size_t i = 0; i < got; i++)
+        {
+            bpt_put_u64(bpt, buf[2 * i], (void *)(uintptr_t)buf[2 * i + 1]);
+        }
+    }
+    fclose(fp);
+    uint64_t check = 0;
+    for (size_t i = 0; i < LOOKUPS; i++)
+    {
+        void *value = NULL;
+        bpt_find_u64(bpt, probes[i], &value);
+        check += (uintptr_t)value;
+    }
+    bench_report("restart: reload into bplus_tree", n, LOOKUPS, bench_now_ns() - start);
+    sink = check;
+    bpt_destroy(bpt);
+    free(buf);
+}
+
+static void run_restart(size_t n, const uint64_t *probes, const char *path, unsigned flags, const char *name)
+{
+    uint64_t start = bench_now_ns();
+    disk_btree_t *dbt = dbt_open(path, flags, 0);
+    uint64_t check = 0;
+    for (size_t i = 0; i < LOOKUPS; i++)
+    {
+        uint64_t value = 0;
+        dbt_get(dbt, probes[i], &value);
+        check += value;
+    }
+    bench_report(name, n, LOOKUPS, bench_now_ns() - start);
+    sink = check;
+    dbt_close(dbt);
+}
+
+static void run_warm(size_t n, const uint64_t *keys, const char *path, unsigned flags, size_t cache,
+                     const char *name)
+{
+    disk_btree_t *dbt = dbt_open(path, flags, cache);
+    uint64_t check = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        dbt_get(dbt, keys[i], NULL);
+    }
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t value = 0;
+        dbt_get(dbt, keys[i], &value);
+        check += value;
+    }
+    bench_report(name, n, n, bench_now_ns() - start);
+
+    uint64_t *keys_out = (uint64_t *)malloc(SCAN_BATCH * sizeof(uint64_t));
+    uint64_t *values_out = (uint64_t *)malloc(SCAN_BATCH * sizeof(uint64_t));
+    start = bench_now_ns();
+    uint64_t low = 0;
+    size_t got;
+    size_t total = 0;
+    while ((got = dbt_range(dbt, low, UINT64_MAX, keys_out, values_out, SCAN_BATCH)) > 0)
+    {
+        total += got;
+        check += values_out[got - 1];
+        low = keys_out[got - 1] + 1;
+    }
+    bench_report(flags & DBT_MMAP ? "disk_btree range scan (mmap)" : "disk_btree range scan (cache)", n, total,
+                 bench_now_ns() - start);
+    sink = check;
+    free(keys_out);
+    free(values_out);
+    dbt_close(dbt);
+}
+
+static int u64_cmp(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {100000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t c = 0; c < count; c++)
+    {
+        size_t n = sizes[c];
+        uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+        uint64_t *sorted = (uint64_t *)malloc(n * sizeof(uint64_t));
+        uint64_t *values = (uint64_t *)malloc(n * sizeof(uint64_t));
+        uint64_t *probes = (uint64_t *)malloc(LOOKUPS * sizeof(uint64_t));
+        uint64_t seed = 42;
+        char tree_path[64];
+        char bulk_path[64];
+        char flat_path[64];
+
+        for (size_t i = 0; i < n; i++)
+        {
+            keys[i] = bench_rand(&seed);
+            values[i] = i;
+        }
+        memcpy(sorted, keys, n * sizeof(uint64_t));
+        qsort(sorted, n, sizeof(uint64_t), u64_cmp);
+        for (size_t i = 0; i < LOOKUPS; i++)
+        {
+            probes[i] = keys[bench_rand(&seed) % n];
+        }
+        make_path(tree_path);
+        make_path(bulk_path);
+        make_path(flat_path);
+
+        run_insert(n, keys, tree_path, 0, "disk_btree insert (default cache)");
+        run_insert(n, keys, tree_path, 2 * (n / DBT_LEAF_KEYS) + 64, "disk_btree insert (cache fits tree)");
+        run_bulk(n, sorted, values, bulk_path);
+        run_reload(n, sorted, values, probes, flat_path);
+        run_restart(n, probes, bulk_path, 0, "restart: dbt_open + page cache");
+        run_restart(n, probes, bulk_path, DBT_MMAP, "restart: dbt_open + mmap");
+        run_warm(n, keys, bulk_path, 0, n / DBT_LEAF_KEYS + 64, "disk_btree warm lookup (cache)");
+        run_warm(n, keys, bulk_path, DBT_MMAP, 0, "disk_btree warm lookup (mmap)");
+        printf("\n");
+
+        remove_files(tree_path);
+        remove_files(bulk_path);
+        remove_files(flat_path);
+        free(keys);
+        free(sorted);
+        free(values);
+        free(probes);
+    }
+    return 0;
+}
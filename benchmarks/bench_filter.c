@@ -0,0 +1,176 @@
+#include "bench_common.h"
+#include <stdbool.h>
+#include "hash/hash.h"
+#include "hash_table/bloom_filter.h"
+#include "hash_table/cuckoo_filter.h"
+#include "linked_list/single_list.h"
+
+// 成员过滤器：分块布隆过滤器与布谷鸟过滤器的插入、查询吞吐量（逐个与批量）、
+// 实测误判率与每键位数；最后演示在sl_search前先查过滤器跳过大部分不存在键的扫描
+// 用法：bench_filter [n1 n2 ...]，默认 1M 10M
+
+#define TARGET_FPR 0.01
+#define LIST_SIZE 1000
+#define LIST_QUERIES 200000
+
+static volatile size_t sink;
+
+static void bench_bloom(size_t n, const uint64_t *present, const uint64_t *absent, bool *out)
+{
+    bloom_filter_t *bf = bf_create(n, TARGET_FPR);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        bf_add_hash(bf, present[i]);
+    }
+    bench_report("bloom add", n, n, bench_now_ns() - start);
+
+    bf_clear(bf);
+    start = bench_now_ns();
+    bf_add_bulk(bf, present, n);
+    bench_report("bloom add_bulk", n, n, bench_now_ns() - start);
+
+    size_t positives = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        positives += bf_contains_hash(bf, absent[i]);
+    }
+    bench_report("bloom contains (absent)", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    sink = bf_contains_bulk(bf, absent, n, out);
+    bench_report("bloom contains_bulk (absent)", n, n, bench_now_ns() - start);
+
+    printf("  bloom fpr %.4f%%, %.2f bits/key, k=%u\n", 100.0 * (double)positives / (double)n,
+           (double)bf_bits(bf) / (double)n, bf_hash_count(bf));
+    bf_destroy(bf);
+}
+
+static void bench_cuckoo(size_t n, const uint64_t *present, const uint64_t *absent, bool *out)
+{
+    cuckoo_filter_t *cf = cf_create(n, TARGET_FPR);
+
+    uint64_t start = bench_now_ns();
+    size_t added = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        added += cf_add_hash(cf, present[i]);
+    }
+    bench_report("cuckoo add", n, n, bench_now_ns() - start);
+
+    cf_clear(cf);
+    start = bench_now_ns();
+    added = cf_add_bulk(cf, present, n);
+    bench_report("cuckoo add_bulk", n, n, bench_now_ns() - start);
+
+    size_t positives = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        positives += cf_contains_hash(cf, absent[i]);
+    }
+    bench_report("cuckoo contains (absent)", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    sink = cf_contains_bulk(cf, absent, n, out);
+    bench_report("cuckoo contains_bulk (absent)", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        cf_remove_hash(cf, present[i]);
+    }
+    bench_report("cuckoo remove", n, n, bench_now_ns() - start);
+
+    printf("  cuckoo fpr %.4f%%, %.2f bits/key, %u-bit fingerprints, added %zu/%zu\n",
+           100.0 * (double)positives / (double)n, (double)cf_capacity(cf) * cf_fingerprint_bits(cf) / (double)n,
+           cf_fingerprint_bits(cf), added, n);
+    cf_destroy(cf);
+}
+
+static int key_cmp(void *a, void *b)
+{
+    return a != b;
+}
+
+// 90%的查询键不在链表中：直接sl_search与先查布隆过滤器的对比
+static void bench_list_guard(void)
+{
+    sl_list_t *list = sl_create();
+    bloom_filter_t *bf = bf_create(LIST_SIZE, TARGET_FPR);
+    for (uintptr_t i = 1; i <= LIST_SIZE; i++)
+    {
+        sl_add_last(list, sl_node_create((void *)i));
+        bf_add_hash(bf, hash_u64(i));
+    }
+
+    uint64_t seed = 42;
+    size_t found = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t q = 0; q < LIST_QUERIES; q++)
+    {
+        uint64_t r = bench_rand(&seed);
+        uintptr_t key = (r % 10 == 0) ? (uintptr_t)(r >> 32) % LIST_SIZE + 1 : (uintptr_t)(r >> 16) + LIST_SIZE + 1;
+        found += sl_search(list, (void *)key, key_cmp) != NULL;
+    }
+    bench_report("sl_search", LIST_SIZE, LIST_QUERIES, bench_now_ns() - start);
+
+    seed = 42;
+    size_t guarded = 0;
+    start = bench_now_ns();
+    for (size_t q = 0; q < LIST_QUERIES; q++)
+    {
+        uint64_t r = bench_rand(&seed);
+        uintptr_t key = (r % 10 == 0) ? (uintptr_t)(r >> 32) % LIST_SIZE + 1 : (uintptr_t)(r >> 16) + LIST_SIZE + 1;
+        if (bf_contains_hash(bf, hash_u64(key)))
+        {
+            guarded += sl_search(list, (void *)key, key_cmp) != NULL;
+        }
+    }
+    bench_report("bloom + sl_search", LIST_SIZE, LIST_QUERIES, bench_now_ns() - start);
+    sink = found + guarded;
+
+    bf_destroy(bf);
+    sl_destroy(list);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000000, 10000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t s = 0; s < count; s++)
+    {
+        size_t n = sizes[s];
+        uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+        uint64_t *present = (uint64_t *)malloc(n * sizeof(uint64_t));
+        uint64_t *absent = (uint64_t *)malloc(n * sizeof(uint64_t));
+        bool *out = (bool *)malloc(n * sizeof(bool));
+
+        for (size_t i = 0; i < n; i++)
+        {
+            keys[i] = i;
+        }
+        hash_u64_bulk(keys, n, present);
+        for (size_t i = 0; i < n; i++)
+        {
+            keys[i] = i + n;
+        }
+        hash_u64_bulk(keys, n, absent);
+
+        bench_bloom(n, present, absent, out);
+        bench_cuckoo(n, present, absent, out);
+        printf("\n");
+
+        free(out);
+        free(absent);
+        free(present);
+        free(keys);
+    }
+
+    bench_list_guard();
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "bench_common.h"
+#include <string.h>
+#include "hash/hash.h"
+
+// 哈希函数吞吐量
+// 字节串：8B~4KB各长度下hash_bytes与FNV-1a的吞吐（Mops/s与GB/s）
+// 整数：逐个调用与批量接口（CPU支持的每个指令集级别）对比
+// 用法：bench_hash [len1 len2 ...]，默认 8 16 32 64 128 256 512 1024 2048 4096
+
+#define BYTES_PER_RUN (256u << 20)
+#define BUFFER_SIZE (1u << 20)
+#define INT_KEYS (1u << 20)
+#define INT_ROUNDS 32
+
+static volatile uint64_t sink;
+
+// 对照组：逐字节FNV-1a
+static uint64_t fnv1a(const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < len; i++)
+    {
+        h = (h ^ p[i]) * 0x100000001B3ull;
+    }
+    return h;
+}
+
+static void report_bytes(const char *label, size_t len, uint64_t count, uint64_t ns)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%s %zuB", label, len);
+    bench_report(name, len, count, ns);
+    printf("    %.2f GB/s\n", ns > 0 ? (double)(count * len) / (double)ns : 0.0);
+}
+
+static void run_bytes(const uint8_t *buffer, size_t len)
+{
+    uint64_t count = BYTES_PER_RUN / len;
+    size_t span = BUFFER_SIZE - len;
+    uint64_t acc = 0;
+
+    // 依次取缓冲区中不同偏移的数据，避免编译器把结果当作常量
+    uint64_t start = bench_now_ns();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        acc += hash_bytes(buffer + (i * 64) % span, len);
+    }
+    report_bytes("hash_bytes", len, count, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        acc += fnv1a(buffer + (i * 64) % span, len);
+    }
+    report_bytes("fnv1a", len, count, bench_now_ns() - start);
+    sink = acc;
+}
+
+static void run_integers(void)
+{
+    uint64_t *keys64 = (uint64_t *)malloc(INT_KEYS * sizeof(uint64_t));
+    uint64_t *out64 = (uint64_t *)malloc(INT_KEYS * sizeof(uint64_t));
+    uint32_t *keys32 = (uint32_t *)malloc(INT_KEYS * sizeof(uint32_t));
+    uint32_t *out32 = (uint32_t *)malloc(INT_KEYS * sizeof(uint32_t));
+    uint64_t seed = 3;
+    for (size_t i = 0; i < INT_KEYS; i++)
+    {
+        keys64[i] = bench_rand(&seed);
+        keys32[i] = (uint32_t)keys64[i];
+    }
+
+    uint64_t ops = (uint64_t)INT_KEYS * INT_ROUNDS;
+    uint64_t start = bench_now_ns();
+    for (int r = 0; r < INT_ROUNDS; r++)
+    {
+        for (size_t i = 0; i < INT_KEYS; i++)
+        {
+            out64[i] = hash_u64(keys64[i]);
+        }
+    }
+    bench_report("hash_u64 loop", INT_KEYS, ops, bench_now_ns() - start);
+
+    // 批量接口：CPU支持的每个指令集级别各跑一次
+    static const char *const level_names[] = {"scalar", "sse2", "sse4.1", "avx2", "avx512"};
+    hash_simd_t supported = hash_simd_level();
+    char name[64];
+    for (int level = HASH_SIMD_NONE; level <= (int)supported; level++)
+    {
+        hash_set_simd_level((hash_simd_t)level);
+        start = bench_now_ns();
+        for (int r = 0; r < INT_ROUNDS; r++)
+        {
+            hash_u64_bulk(keys64, INT_KEYS, out64);
+        }
+        snprintf(name, sizeof(name), "hash_u64_bulk %s", level_names[level]);
+        bench_report(name, INT_KEYS, ops, bench_now_ns() - start);
+    }
+
+    start = bench_now_ns();
+    for (int r = 0; r < INT_ROUNDS; r++)
+    {
+        for (size_t i = 0; i < INT_KEYS; i++)
+        {
+            out32[i] = hash_u32(keys32[i]);
+        }
+    }
+    bench_report("hash_u32 loop", INT_KEYS, ops, bench_now_ns() - start);
+
+    for (int level = HASH_SIMD_NONE; level <= (int)supported; level++)
+    {
+        hash_set_simd_level((hash_simd_t)level);
+        start = bench_now_ns();
+        for (int r = 0; r < INT_ROUNDS; r++)
+        {
+            hash_u32_bulk(keys32, INT_KEYS, out32);
+        }
+        snprintf(name, sizeof(name), "hash_u32_bulk %s", level_names[level]);
+        bench_report(name, INT_KEYS, ops, bench_now_ns() - start);
+    }
+    hash_set_simd_level(supported);
+
+    sink = out64[INT_KEYS / 2] + out32[INT_KEYS / 3];
+    free(keys64);
+    free(out64);
+    free(keys32);
+    free(out32);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 10);
+
+    uint8_t *buffer = (uint8_t *)malloc(BUFFER_SIZE);
+    uint64_t seed = 1;
+    for (size_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        buffer[i] = (uint8_t)bench_rand(&seed);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (sizes[i] < BUFFER_SIZE)
+        {
+            run_bytes(buffer, sizes[i]);
+        }
+    }
+    printf("\n");
+    run_integers();
+
+    free(buffer);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "bench_common.h"
+#include "hash_table/hash_table.h"
+
+// 扩容延迟：一次性rehash与渐进式rehash的单次插入延迟分布
+// 逐次计时n次插入，报告总吞吐、p99、p99.9与最大延迟
+// 用法：bench_hash_rehash [n1 n2 ...]，默认 1M 与 10M
+
+static size_t key_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+static int key_cmp(void *a, void *b)
+{
+    return a != b;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void run(const char *label, size_t step, size_t n, uint64_t *lat)
+{
+    hash_table_t *ht = ht_create(key_hash, key_cmp);
+    ht_set_rehash_step(ht, step);
+
+    uint64_t total = bench_now_ns();
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        uint64_t start = bench_now_ns();
+        ht_put(ht, (void *)i, (void *)i);
+        lat[i - 1] = bench_now_ns() - start;
+    }
+    total = bench_now_ns() - total;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s insert", label);
+    bench_report(name, n, n, total);
+
+    qsort(lat, n, sizeof(uint64_t), cmp_u64);
+    printf("    p99 %8llu ns  p99.9 %8llu ns  max %12llu ns\n",
+           (unsigned long long)lat[n * 99 / 100], (unsigned long long)lat[n * 999 / 1000],
+           (unsigned long long)lat[n - 1]);
+    ht_destroy(ht);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000000, 10000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t *lat = (uint64_t *)malloc(sizes[i] * sizeof(uint64_t));
+        if (lat == NULL)
+        {
+            return 1;
+        }
+        run("stop-the-world", 0, sizes[i], lat);
+        run("incremental", HT_DEFAULT_REHASH_STEP, sizes[i], lat);
+        free(lat);
+        printf("\n");
+    }
+    return 0;
+}
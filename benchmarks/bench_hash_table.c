@@ -0,0 +1,168 @@
+#include "bench_common.h"
+#include "hash_table/hash_table.h"
+#include "hash_table/swiss_table.h"
+
+// 开放寻址表（Robin Hood）与分组探测表（Swiss table）对比
+// 场景：插入、命中查找、未命中查找；以及装满到扩容阈值时的高负载查找
+// 用法：bench_hash_table [n1 n2 ...]，默认 1K 与 1M，100M 需显式指定
+
+static size_t key_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+static int key_cmp(void *a, void *b)
+{
+    return a != b;
+}
+
+// 统一两种表的操作接口
+typedef struct
+{
+    const char *name;
+    void *(*create)(double max_load);
+    void (*destroy)(void *table);
+    bool (*reserve)(void *table, size_t count);
+    size_t (*limit)(void *table);
+    bool (*put)(void *table, void *key, void *value);
+    bool (*find)(void *table, void *key, void **value);
+} table_ops_t;
+
+static void *ht_create_op(double max_load)
+{
+    return ht_create_with_load(key_hash, key_cmp, max_load);
+}
+
+static void ht_destroy_op(void *table)
+{
+    ht_destroy((hash_table_t *)table);
+}
+
+static bool ht_reserve_op(void *table, size_t count)
+{
+    return ht_reserve((hash_table_t *)table, count);
+}
+
+static size_t ht_limit_op(void *table)
+{
+    return ((hash_table_t *)table)->threshold;
+}
+
+static bool ht_put_op(void *table, void *key, void *value)
+{
+    return ht_put((hash_table_t *)table, key, value);
+}
+
+static bool ht_find_op(void *table, void *key, void **value)
+{
+    return ht_find((hash_table_t *)table, key, value);
+}
+
+static void *st_create_op(double max_load)
+{
+    (void)max_load;
+    return st_create(key_hash, key_cmp);
+}
+
+static void st_destroy_op(void *table)
+{
+    st_destroy((swiss_table_t *)table);
+}
+
+static bool st_reserve_op(void *table, size_t count)
+{
+    return st_reserve((swiss_table_t *)table, count);
+}
+
+static size_t st_limit_op(void *table)
+{
+    swiss_table_t *st = (swiss_table_t *)table;
+    return st->capacity / ST_MAX_LOAD_DEN * ST_MAX_LOAD_NUM;
+}
+
+static bool st_put_op(void *table, void *key, void *value)
+{
+    return st_put((swiss_table_t *)table, key, value);
+}
+
+static bool st_find_op(void *table, void *key, void **value)
+{
+    return st_find((swiss_table_t *)table, key, value);
+}
+
+static const table_ops_t tables[] = {
+    {"robin_hood", ht_create_op, ht_destroy_op, ht_reserve_op, ht_limit_op, ht_put_op, ht_find_op},
+    {"swiss", st_create_op, st_destroy_op, st_reserve_op, st_limit_op, st_put_op, st_find_op},
+};
+
+static volatile size_t sink;
+
+// 在count个键上做查找，键取自[base, base+range)
+static uint64_t run_lookups(const table_ops_t *ops, void *table, size_t count, uintptr_t base, size_t range)
+{
+    uint64_t seed = 7;
+    size_t found = 0;
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < count; i++)
+    {
+        uintptr_t key = base + (uintptr_t)(bench_rand(&seed) % range);
+        void *value;
+        found += ops->find(table, (void *)key, &value);
+    }
+    uint64_t ns = bench_now_ns() - start;
+    sink = found;
+    return ns;
+}
+
+static void run(const table_ops_t *ops, size_t n)
+{
+    char name[64];
+
+    // 常规负载：自然扩容
+    void *table = ops->create(HT_DEFAULT_MAX_LOAD);
+    uint64_t start = bench_now_ns();
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        ops->put(table, (void *)i, (void *)i);
+    }
+    uint64_t ns = bench_now_ns() - start;
+    snprintf(name, sizeof(name), "%s insert", ops->name);
+    bench_report(name, n, n, ns);
+
+    snprintf(name, sizeof(name), "%s hit", ops->name);
+    bench_report(name, n, n, run_lookups(ops, table, n, 1, n));
+    snprintf(name, sizeof(name), "%s miss", ops->name);
+    bench_report(name, n, n, run_lookups(ops, table, n, n + 1, n));
+    ops->destroy(table);
+
+    // 高负载：预留后装满到扩容阈值
+    table = ops->create(0.95);
+    ops->reserve(table, n);
+    size_t full = ops->limit(table);
+    for (uintptr_t i = 1; i <= full; i++)
+    {
+        ops->put(table, (void *)i, (void *)i);
+    }
+    snprintf(name, sizeof(name), "%s high-load hit", ops->name);
+    bench_report(name, full, full, run_lookups(ops, table, full, 1, full));
+    snprintf(name, sizeof(name), "%s high-load miss", ops->name);
+    bench_report(name, full, full, run_lookups(ops, table, full, full + 1, full));
+    ops->destroy(table);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t t = 0; t < sizeof(tables) / sizeof(tables[0]); t++)
+        {
+            run(&tables[t], sizes[i]);
+        }
+        printf("\n");
+    }
+    return 0;
+}
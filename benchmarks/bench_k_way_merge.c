@@ -0,0 +1,176 @@
+#include "bench_common.h"
+#include <string.h>
+#include "heap/k_way_merge.h"
+#include "queue/priority_queue.h"
+
+// 合并64个有序分片：败者树K路归并 与 拼接后整体排序、二叉堆维护各路首元素的归并对比
+// 数组：qsort vs 二叉堆归并 vs km_merge_arrays；链表：sl_sort（仅n不超过SL_SORT_LIMIT）vs km_merge_sl
+// 用法：bench_k_way_merge [n1 n2 ...]，默认 10K 与 1M（总元素数）
+
+#define SHARDS 64
+#define SL_SORT_LIMIT 20000
+
+static volatile uintptr_t sink;
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static int qsort_cmp(const void *a, const void *b)
+{
+    return key_cmp(*(void *const *)a, *(void *const *)b);
+}
+
+// 二叉堆归并中每路的读取位置
+typedef struct cursor
+{
+    void **pos;
+    void **end;
+} cursor_t;
+
+static int cursor_cmp(void *a, void *b)
+{
+    return key_cmp(*((cursor_t *)a)->pos, *((cursor_t *)b)->pos);
+}
+
+static void run_arrays(size_t n, void ***arrays, const size_t *lens, void **out)
+{
+    uint64_t start = bench_now_ns();
+    size_t total = 0;
+    for (size_t s = 0; s < SHARDS; s++)
+    {
+        memcpy(out + total, arrays[s], lens[s] * sizeof(void *));
+        total += lens[s];
+    }
+    qsort(out, total, sizeof(void *), qsort_cmp);
+    bench_report("arrays concat + qsort", n, total, bench_now_ns() - start);
+    uintptr_t expected = (uintptr_t)out[total - 1];
+
+    cursor_t cursors[SHARDS];
+    priority_queue_t *pq = pq_create_with_arity(cursor_cmp, 2);
+    start = bench_now_ns();
+    for (size_t s = 0; s < SHARDS; s++)
+    {
+        cursors[s].pos = arrays[s];
+        cursors[s].end = arrays[s] + lens[s];
+        if (lens[s] > 0)
+        {
+            pq_push(pq, &cursors[s]);
+        }
+    }
+    size_t count = 0;
+    while (!pq_is_empty(pq))
+    {
+        cursor_t *c = (cursor_t *)pq_pop(pq);
+        out[count++] = *c->pos++;
+        if (c->pos != c->end)
+        {
+            pq_push(pq, c);
+        }
+    }
+    bench_report("arrays binary heap merge", n, count, bench_now_ns() - start);
+    pq_destroy(pq);
+
+    start = bench_now_ns();
+    count = km_merge_arrays(out, arrays, lens, SHARDS, key_cmp);
+    bench_report("arrays km_merge_arrays", n, count, bench_now_ns() - start);
+    if ((uintptr_t)out[count - 1] != expected)
+    {
+        printf("  MISMATCH\n");
+    }
+}
+
+static void build_lists(sl_list_t **lists, void ***arrays, const size_t *lens)
+{
+    for (size_t s = 0; s < SHARDS; s++)
+    {
+        lists[s] = sl_create();
+        for (size_t i = 0; i < lens[s]; i++)
+        {
+            sl_add_last(lists[s], sl_node_create(arrays[s][i]));
+        }
+    }
+}
+
+static void run_lists(size_t n, void ***arrays, const size_t *lens)
+{
+    sl_list_t *lists[SHARDS];
+
+    if (n <= SL_SORT_LIMIT)
+    {
+        build_lists(lists, arrays, lens);
+        uint64_t start = bench_now_ns();
+        sl_list_t *all = lists[0];
+        for (size_t s = 1; s < SHARDS; s++)
+        {
+            // 拼接：直接把分片接到末尾
+            if (lists[s]->head != NULL)
+            {
+                all->tail->next = lists[s]->head;
+                all->tail = lists[s]->tail;
+                all->size += lists[s]->size;
+                lists[s]->head = lists[s]->tail = NULL;
+                lists[s]->size = 0;
+            }
+        }
+        sl_sort(all, key_cmp);
+        bench_report("lists concat + sl_sort", n, n, bench_now_ns() - start);
+        for (size_t s = 0; s < SHARDS; s++)
+        {
+            sl_destroy(lists[s]);
+        }
+    }
+
+    build_lists(lists, arrays, lens);
+    sl_list_t *dst = sl_create();
+    uint64_t start = bench_now_ns();
+    km_merge_sl(dst, lists, SHARDS, key_cmp);
+    bench_report("lists km_merge_sl", n, n, bench_now_ns() - start);
+    sink = (uintptr_t)dst->tail->data;
+    for (size_t s = 0; s < SHARDS; s++)
+    {
+        sl_destroy(lists[s]);
+    }
+    sl_destroy(dst);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {10000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t n = sizes[i] / SHARDS * SHARDS;
+        void **data = (void **)malloc(n * sizeof(void *));
+        void **out = (void **)malloc(n * sizeof(void *));
+        void **arrays[SHARDS];
+        size_t lens[SHARDS];
+        uint64_t seed = 31;
+
+        // 每个分片为递增序列，各分片的取值范围相互交错
+        for (size_t s = 0; s < SHARDS; s++)
+        {
+            lens[s] = n / SHARDS;
+            arrays[s] = data + s * lens[s];
+            uintptr_t key = 0;
+            for (size_t j = 0; j < lens[s]; j++)
+            {
+                key += (uintptr_t)(bench_rand(&seed) % 1000);
+                arrays[s][j] = (void *)key;
+            }
+        }
+
+        run_arrays(n, arrays, lens, out);
+        run_lists(n, arrays, lens);
+        printf("\n");
+
+        free(out);
+        free(data);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "bench_common.h"
+#include "cache/lru_cache.h"
+
+// LRU缓存：手写的dl_list_t + dl_search（O(n)查找）对比lru_cache（哈希索引O(1)）
+// 访问的键在[0, 2*容量)内随机，命中率约50%，未命中时插入并淘汰最久未使用的条目
+// 用法：bench_lru_cache [容量1 容量2 ...]，默认 100 1000 10000
+
+#define OPS 1000000
+// 线性查找的总比较次数上限，避免大容量时耗时过长
+#define NAIVE_BUDGET 200000000ull
+
+static size_t key_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+static int key_cmp(void *a, void *b)
+{
+    return a != b;
+}
+
+static volatile size_t sink;
+
+static void run_naive(size_t capacity)
+{
+    dl_list_t *list = dl_create();
+    uint64_t seed = 5;
+    size_t hits = 0;
+    size_t ops = NAIVE_BUDGET / capacity < OPS ? (size_t)(NAIVE_BUDGET / capacity) : OPS;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ops; i++)
+    {
+        uintptr_t key = (uintptr_t)(bench_rand(&seed) % (capacity * 2));
+        dl_node_t *node = dl_search(list, (void *)key, key_cmp);
+        if (node != NULL)
+        {
+            dl_remove(list, node);
+            dl_add_first(list, node);
+            hits++;
+            continue;
+        }
+        if (dl_size(list) == capacity)
+        {
+            dl_node_destroy(dl_remove_last(list));
+        }
+        dl_add_first(list, dl_node_create((void *)key));
+    }
+    uint64_t ns = bench_now_ns() - start;
+    sink = hits;
+    bench_report("dl_list+dl_search", capacity, ops, ns);
+
+    dl_destroy(list);
+}
+
+static void run_lru(size_t capacity)
+{
+    lru_cache_t *cache = lru_create(capacity, key_hash, key_cmp, NULL, NULL);
+    uint64_t seed = 5;
+    size_t hits = 0;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < OPS; i++)
+    {
+        uintptr_t key = (uintptr_t)(bench_rand(&seed) % (capacity * 2));
+        if (lru_find(cache, (void *)key, NULL))
+        {
+            hits++;
+            continue;
+        }
+        lru_put(cache, (void *)key, (void *)key);
+    }
+    uint64_t ns = bench_now_ns() - start;
+    sink = hits;
+    bench_report("lru_cache", capacity, OPS, ns);
+
+    lru_destroy(cache);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {100, 1000, 10000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 3);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        run_naive(sizes[i]);
+        run_lru(sizes[i]);
+        printf("\n");
+    }
+    return 0;
+}
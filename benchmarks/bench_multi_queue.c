@@ -0,0 +1,86 @@
+#include "bench_common.h"
+#include <pthread.h>
+#include <unistd.h>
+#include "queue/multi_queue.h"
+
+// MultiQueue 多线程吞吐量：每个线程交替插入和弹出
+// 对比单分片（等价于一个全局加锁的堆）与每线程两个分片
+// 用法：bench_multi_queue [每线程操作数]，线程数从1倍增到CPU数
+
+#define PREFILL 100000
+
+typedef struct
+{
+    multi_queue_t *mq;
+    size_t ops;
+    uint64_t seed;
+} worker_t;
+
+static void *worker_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    for (size_t i = 0; i < w->ops; i++)
+    {
+        uint64_t priority = 0;
+        if (mq_pop(w->mq, &priority, NULL))
+        {
+            priority += bench_rand(&w->seed) >> 44;
+        }
+        mq_push(w->mq, priority, NULL);
+    }
+    return NULL;
+}
+
+static void run(size_t threads, size_t shards, size_t ops)
+{
+    multi_queue_t *mq = mq_create(shards);
+    pthread_t tids[256];
+    worker_t workers[256];
+    uint64_t seed = 42;
+
+    for (size_t i = 0; i < PREFILL; i++)
+    {
+        mq_push(mq, bench_rand(&seed) >> 20, NULL);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers[i].mq = mq;
+        workers[i].ops = ops;
+        workers[i].seed = i * 7919 + 1;
+        pthread_create(&tids[i], NULL, worker_run, &workers[i]);
+    }
+    for (size_t i = 0; i < threads; i++)
+    {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t ns = bench_now_ns() - start;
+
+    char name[64];
+    snprintf(name, sizeof(name), "threads=%zu shards=%zu", threads, shards);
+    bench_report(name, threads * ops, threads * ops * 2, ns);
+
+    mq_destroy(mq);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000000};
+    size_t sizes[1];
+    bench_parse_sizes(argc, argv, sizes, 1, defaults, 1);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = cpus > 0 ? (size_t)cpus : 1;
+    if (max_threads > 256)
+    {
+        max_threads = 256;
+    }
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        run(threads, 1, sizes[0]);
+        run(threads, threads * MQ_SHARDS_PER_CPU, sizes[0]);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "bench_common.h"
+#include <string.h>
+#include "tree/order_stat_tree.h"
+#include "linked_list/single_list.h"
+
+// 滑动窗口分位数：每步加入一个延迟样本、移除最旧的样本，再查询p50与p99
+// 对比每次查询都重新排序（sl_sort + sl_get、复制后qsort）与顺序统计树增量维护
+// 重新排序的方法只运行BASELINE_STEPS步，sl_sort（插入排序）仅在窗口不超过SL_SORT_LIMIT时运行
+// 用法：bench_order_stat_tree [n1 n2 ...]，默认窗口 1K 与 100K
+
+#define OST_STEPS 100000
+#define BASELINE_STEPS 200
+#define SL_SORT_LIMIT 2000
+
+static volatile uintptr_t sink;
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static int qsort_cmp(const void *a, const void *b)
+{
+    return key_cmp(*(void *const *)a, *(void *const *)b);
+}
+
+// 对数正态风格的延迟样本（微秒）：大部分在几百微秒，少量长尾
+static uintptr_t next_latency(uint64_t *seed)
+{
+    uint64_t r = bench_rand(seed);
+    uintptr_t base = 100 + (uintptr_t)(r % 400);
+    return (r >> 32) % 100 == 0 ? base * 50 : base;
+}
+
+static void fill_window(void **window, size_t n, uint64_t *seed)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        window[i] = (void *)next_latency(seed);
+    }
+}
+
+static void run_sl_sort(size_t n, size_t steps)
+{
+    void **window = (void **)malloc(n * sizeof(void *));
+    uint64_t seed = 42;
+    uintptr_t check = 0;
+
+    fill_window(window, n, &seed);
+    uint64_t start = bench_now_ns();
+    for (size_t step = 0; step < steps; step++)
+    {
+        window[step % n] = (void *)next_latency(&seed);
+        sl_list_t *list = sl_from_array(window, n);
+        sl_sort(list, key_cmp);
+        check += (uintptr_t)sl_get(list, (n + 1) / 2 - 1)->data;
+        check += (uintptr_t)sl_get(list, (n * 99 + 99) / 100 - 1)->data;
+        sl_destroy(list);
+    }
+    bench_report("sl_sort + sl_get per query", n, steps, bench_now_ns() - start);
+    sink = check;
+    free(window);
+}
+
+static void run_qsort(size_t n, size_t steps)
+{
+    void **window = (void **)malloc(n * sizeof(void *));
+    void **sorted = (void **)malloc(n * sizeof(void *));
+    uint64_t seed = 42;
+    uintptr_t check = 0;
+
+    fill_window(window, n, &seed);
+    uint64_t start = bench_now_ns();
+    for (size_t step = 0; step < steps; step++)
+    {
+        window[step % n] = (void *)next_latency(&seed);
+        memcpy(sorted, window, n * sizeof(void *));
+        qsort(sorted, n, sizeof(void *), qsort_cmp);
+        check += (uintptr_t)sorted[(n + 1) / 2 - 1];
+        check += (uintptr_t)sorted[(n * 99 + 99) / 100 - 1];
+    }
+    bench_report("copy + qsort per query", n, steps, bench_now_ns() - start);
+    sink = check;
+    free(window);
+    free(sorted);
+}
+
+static void run_ost(size_t n, size_t steps)
+{
+    void **window = (void **)malloc(n * sizeof(void *));
+    order_stat_tree_t *ost = ost_create(key_cmp);
+    uint64_t seed = 42;
+    uintptr_t check = 0;
+
+    fill_window(window, n, &seed);
+    for (size_t i = 0; i < n; i++)
+    {
+        ost_insert(ost, window[i]);
+    }
+    uint64_t start = bench_now_ns();
+    for (size_t step = 0; step < steps; step++)
+    {
+        ost_remove(ost, window[step % n]);
+        window[step % n] = (void *)next_latency(&seed);
+        ost_insert(ost, window[step % n]);
+        check += (uintptr_t)ost_quantile(ost, 0.5);
+        check += (uintptr_t)ost_quantile(ost, 0.99);
+    }
+    bench_report("order_stat_tree incremental", n, steps, bench_now_ns() - start);
+    sink = check;
+    ost_destroy(ost);
+    free(window);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000, 100000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (sizes[i] <= SL_SORT_LIMIT)
+        {
+            run_sl_sort(sizes[i], BASELINE_STEPS);
+        }
+        run_qsort(sizes[i], BASELINE_STEPS);
+        run_ost(sizes[i], OST_STEPS);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,257 @@
+#include "bench_common.h"
+#include <string.h>
+#include "heap/pairing_heap.h"
+#include "queue/priority_queue.h"
+
+// 配对堆与数组堆在Dijkstra上的对比：随机稀疏图（每点8条出边，加一条环边保证连通）
+// 配对堆用decrease-key调整已入堆的顶点；数组堆（二叉与4叉）不支持调整，
+// 改为重复插入，弹出时跳过过期项。另测合并64个堆：ph_meld与把元素逐个推入数组堆
+// 用法：bench_pairing_heap [n1 n2 ...]，默认 100K 与 1M（顶点数）
+
+#define DEGREE 8
+#define MAX_WEIGHT 1000
+#define MELD_HEAPS 64
+
+typedef struct graph
+{
+    size_t n;
+    size_t *offsets;
+    uint32_t *targets;
+    uint32_t *weights;
+} graph_t;
+
+// 堆元素：顶点当前的距离
+typedef struct entry
+{
+    uint64_t dist;
+    uint32_t vertex;
+} entry_t;
+
+static int entry_cmp(void *a, void *b)
+{
+    uint64_t x = ((entry_t *)a)->dist;
+    uint64_t y = ((entry_t *)b)->dist;
+    return (x > y) - (x < y);
+}
+
+static graph_t make_graph(size_t n)
+{
+    graph_t g;
+    uint64_t seed = 12345;
+
+    g.n = n;
+    g.offsets = (size_t *)malloc((n + 1) * sizeof(size_t));
+    g.targets = (uint32_t *)malloc(n * (DEGREE + 1) * sizeof(uint32_t));
+    g.weights = (uint32_t *)malloc(n * (DEGREE + 1) * sizeof(uint32_t));
+    for (size_t v = 0; v < n; v++)
+    {
+        size_t base = v * (DEGREE + 1);
+        g.offsets[v] = base;
+        g.targets[base] = (uint32_t)((v + 1) % n);
+        g.weights[base] = MAX_WEIGHT;
+        for (size_t e = 1; e <= DEGREE; e++)
+        {
+            uint64_t r = bench_rand(&seed);
+            g.targets[base + e] = (uint32_t)(r % n);
+            g.weights[base + e] = (uint32_t)((r >> 32) % MAX_WEIGHT) + 1;
+        }
+    }
+    g.offsets[n] = n * (DEGREE + 1);
+    return g;
+}
+
+static void free_graph(graph_t *g)
+{
+    free(g->weights);
+    free(g->targets);
+    free(g->offsets);
+}
+
+// 数组堆：每次松弛都插入新条目，弹出的条目若已过期则跳过
+static uint64_t dijkstra_array(const graph_t *g, size_t arity, size_t *pushes)
+{
+    size_t m = g->offsets[g->n];
+    entry_t *pool = (entry_t *)malloc((m + 1) * sizeof(entry_t));
+    uint64_t *dist = (uint64_t *)malloc(g->n * sizeof(uint64_t));
+    priority_queue_t *pq = pq_create_with_arity(entry_cmp, arity);
+    size_t used = 0;
+
+    memset(dist, 0xFF, g->n * sizeof(uint64_t));
+    dist[0] = 0;
+    pool[used] = (entry_t){0, 0};
+    pq_push(pq, &pool[used++]);
+
+    while (!pq_is_empty(pq))
+    {
+        entry_t *top = (entry_t *)pq_pop(pq);
+        if (top->dist > dist[top->vertex])
+        {
+            continue;
+        }
+        for (size_t e = g->offsets[top->vertex]; e < g->offsets[top->vertex + 1]; e++)
+        {
+            uint32_t to = g->targets[e];
+            uint64_t nd = top->dist + g->weights[e];
+            if (nd < dist[to])
+            {
+                dist[to] = nd;
+                pool[used] = (entry_t){nd, to};
+                pq_push(pq, &pool[used++]);
+            }
+        }
+    }
+
+    uint64_t sum = 0;
+    for (size_t v = 0; v < g->n; v++)
+    {
+        sum += dist[v];
+    }
+    *pushes = used;
+    pq_destroy(pq);
+    free(dist);
+    free(pool);
+    return sum;
+}
+
+// 配对堆：每个顶点至多一个节点，距离缩短时decrease-key
+static uint64_t dijkstra_pairing(const graph_t *g, size_t *decreases)
+{
+    entry_t *entries = (entry_t *)malloc(g->n * sizeof(entry_t));
+    ph_node_t **nodes = (ph_node_t **)calloc(g->n, sizeof(ph_node_t *));
+    uint8_t *settled = (uint8_t *)calloc(g->n, 1);
+    pairing_heap_t *ph = ph_create(entry_cmp);
+    size_t count = 0;
+
+    for (size_t v = 0; v < g->n; v++)
+    {
+        entries[v].dist = UINT64_MAX;
+        entries[v].vertex = (uint32_t)v;
+    }
+    entries[0].dist = 0;
+    nodes[0] = ph_push(ph, &entries[0]);
+
+    while (!ph_is_empty(ph))
+    {
+        entry_t *top = (entry_t *)ph_pop(ph);
+        settled[top->vertex] = 1;
+        for (size_t e = g->offsets[top->vertex]; e < g->offsets[top->vertex + 1]; e++)
+        {
+            uint32_t to = g->targets[e];
+            uint64_t nd = top->dist + g->weights[e];
+            if (settled[to] || nd >= entries[to].dist)
+            {
+                continue;
+            }
+            entries[to].dist = nd;
+            if (nodes[to] == NULL)
+            {
+                nodes[to] = ph_push(ph, &entries[to]);
+            }
+            else
+            {
+                ph_decrease_key(ph, nodes[to]);
+                count++;
+            }
+        }
+    }
+
+    uint64_t sum = 0;
+    for (size_t v = 0; v < g->n; v++)
+    {
+        sum += entries[v].dist;
+    }
+    *decreases = count;
+    ph_destroy(ph);
+    free(settled);
+    free(nodes);
+    free(entries);
+    return sum;
+}
+
+static void bench_dijkstra(size_t n)
+{
+    graph_t g = make_graph(n);
+    size_t m = g.offsets[n];
+    size_t extra = 0;
+    char name[64];
+
+    uint64_t start = bench_now_ns();
+    uint64_t expected = dijkstra_pairing(&g, &extra);
+    bench_report("dijkstra pairing_heap", n, m, bench_now_ns() - start);
+    printf("  %zu decrease-key calls\n", extra);
+
+    static const size_t arities[] = {2, 4};
+    for (size_t a = 0; a < 2; a++)
+    {
+        start = bench_now_ns();
+        uint64_t sum = dijkstra_array(&g, arities[a], &extra);
+        snprintf(name, sizeof(name), "dijkstra arity=%zu (lazy)", arities[a]);
+        bench_report(name, n, m, bench_now_ns() - start);
+        printf("  %zu pushes for %zu vertices%s\n", extra, n, sum == expected ? "" : " (MISMATCH)");
+    }
+
+    free_graph(&g);
+}
+
+// 合并MELD_HEAPS个各含n/MELD_HEAPS个元素的堆
+static void bench_meld(size_t n)
+{
+    size_t per = n / MELD_HEAPS;
+    entry_t *entries = (entry_t *)malloc(per * MELD_HEAPS * sizeof(entry_t));
+    pairing_heap_t *heaps[MELD_HEAPS];
+    priority_queue_t *arrays[MELD_HEAPS];
+    uint64_t seed = 777;
+
+    for (size_t h = 0; h < MELD_HEAPS; h++)
+    {
+        heaps[h] = ph_create(entry_cmp);
+        arrays[h] = pq_create_with_arity(entry_cmp, 2);
+        for (size_t i = 0; i < per; i++)
+        {
+            entry_t *item = &entries[h * per + i];
+            item->dist = bench_rand(&seed) >> 16;
+            item->vertex = (uint32_t)i;
+            ph_push(heaps[h], item);
+            pq_push(arrays[h], item);
+        }
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t h = 1; h < MELD_HEAPS; h++)
+    {
+        ph_meld(heaps[0], heaps[h]);
+    }
+    bench_report("meld 64 heaps pairing_heap", n, MELD_HEAPS - 1, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t h = 1; h < MELD_HEAPS; h++)
+    {
+        while (!pq_is_empty(arrays[h]))
+        {
+            pq_push(arrays[0], pq_pop(arrays[h]));
+        }
+    }
+    bench_report("meld 64 heaps arity=2 (re-push)", n, MELD_HEAPS - 1, bench_now_ns() - start);
+
+    for (size_t h = 0; h < MELD_HEAPS; h++)
+    {
+        ph_destroy(heaps[h]);
+        pq_destroy(arrays[h]);
+    }
+    free(entries);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {100000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        bench_dijkstra(sizes[i]);
+        bench_meld(sizes[i]);
+        printf("\n");
+    }
+    return 0;
+}
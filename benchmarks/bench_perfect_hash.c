@@ -0,0 +1,129 @@
+#include "bench_common.h"
+#include <string.h>
+#include <unistd.h>
+#include "hash_table/perfect_hash.h"
+#include "hash_table/string_map.h"
+
+// 静态最小完美哈希表：构建耗时与每键位数、命中/未命中查找对比string_map，
+// 以及启动时加载方式的对比：mmap已生成的文件 vs 用string_map重新插入全部键
+// 用法：bench_perfect_hash [n1 n2 ...]，默认 1K 与 1M
+
+#define KEY_SIZE 24
+
+static volatile size_t sink;
+
+// 生成n个形如"user:000123456"的键，prefix区分命中与未命中集合
+static char *make_keys(size_t n, char prefix, size_t *lens)
+{
+    char *keys = (char *)malloc(n * KEY_SIZE);
+    uint64_t seed = 99;
+    for (size_t i = 0; i < n; i++)
+    {
+        lens[i] = (size_t)snprintf(keys + i * KEY_SIZE, KEY_SIZE, "user%c:%09llu", prefix,
+                                   (unsigned long long)(i * 1000 + bench_rand(&seed) % 1000));
+    }
+    return keys;
+}
+
+static void run_string_map(size_t n, const char *keys, const char *misses, const size_t *lens)
+{
+    string_map_t *sm = sm_create();
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        sm_put(sm, keys + i * KEY_SIZE, lens[i], (void *)(uintptr_t)i);
+    }
+    bench_report("string_map load (insert all)", n, n, bench_now_ns() - start);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sm_contains(sm, keys + i * KEY_SIZE, lens[i]);
+    }
+    bench_report("string_map hit", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sm_contains(sm, misses + i * KEY_SIZE, lens[i]);
+    }
+    bench_report("string_map miss", n, n, bench_now_ns() - start);
+    sink = found;
+
+    sm_destroy(sm);
+}
+
+static void run_perfect_hash(size_t n, const char *keys, const char *misses, const size_t *lens)
+{
+    mph_builder_t *builder = mph_builder_create();
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t value = i;
+        mph_builder_add(builder, keys + i * KEY_SIZE, lens[i], &value, sizeof(value));
+    }
+
+    size_t size = 0;
+    uint64_t start = bench_now_ns();
+    void *buf = mph_build(builder, &size);
+    bench_report("perfect_hash build", n, n, bench_now_ns() - start);
+    mph_builder_destroy(builder);
+
+    char path[] = "/tmp/bench_perfect_hash_XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    mph_write_file(buf, size, path);
+
+    start = bench_now_ns();
+    mph_table_t *table = mph_map_file(path);
+    bench_report("perfect_hash load (mmap)", n, n, bench_now_ns() - start);
+    printf("  %.2f bits/key for the hash, %zu levels, %zu bytes total\n",
+           (double)table->bit_words * 64 / (double)n, table->level_count, size);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += mph_contains(table, keys + i * KEY_SIZE, lens[i]);
+    }
+    bench_report("perfect_hash hit", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += mph_contains(table, misses + i * KEY_SIZE, lens[i]);
+    }
+    bench_report("perfect_hash miss", n, n, bench_now_ns() - start);
+    sink = found;
+
+    mph_close(table);
+    unlink(path);
+    free(buf);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t n = sizes[i];
+        size_t *lens = (size_t *)malloc(n * sizeof(size_t));
+        size_t *miss_lens = (size_t *)malloc(n * sizeof(size_t));
+        char *keys = make_keys(n, 'a', lens);
+        char *misses = make_keys(n, 'b', miss_lens);
+
+        run_string_map(n, keys, misses, lens);
+        run_perfect_hash(n, keys, misses, lens);
+        printf("\n");
+
+        free(misses);
+        free(keys);
+        free(miss_lens);
+        free(lens);
+    }
+    return 0;
+}
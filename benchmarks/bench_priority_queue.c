@@ -0,0 +1,76 @@
+#include "bench_common.h"
+#include "queue/priority_queue.h"
+
+// d叉堆与二叉堆对比：随机插入n个元素后全部弹出
+// 用法：bench_priority_queue [n1 n2 ...]，默认 1K 与 1M，100M 需显式指定
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t ka = (uintptr_t)a;
+    uintptr_t kb = (uintptr_t)b;
+    return (ka > kb) - (ka < kb);
+}
+
+// 模拟事件队列：先批量装入，再交替弹出并推入更晚的定时器
+static void run(size_t n, size_t arity)
+{
+    priority_queue_t *pq = pq_create_with_arity(key_cmp, arity);
+    if (pq == NULL || !pq_reserve(pq, n + 1))
+    {
+        fprintf(stderr, "allocation failed for n=%zu\n", n);
+        pq_destroy(pq);
+        return;
+    }
+
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    char name[64];
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        pq_push(pq, (void *)(uintptr_t)(bench_rand(&seed) >> 1));
+    }
+    uint64_t push_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        uintptr_t now = (uintptr_t)pq_pop(pq);
+        pq_push(pq, (void *)(now + (bench_rand(&seed) >> 40)));
+    }
+    uint64_t hold_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    while (!pq_is_empty(pq))
+    {
+        pq_pop(pq);
+    }
+    uint64_t pop_ns = bench_now_ns() - start;
+
+    snprintf(name, sizeof(name), "arity=%zu push", arity);
+    bench_report(name, n, n, push_ns);
+    snprintf(name, sizeof(name), "arity=%zu pop+push (hold)", arity);
+    bench_report(name, n, n, hold_ns);
+    snprintf(name, sizeof(name), "arity=%zu pop", arity);
+    bench_report(name, n, n, pop_ns);
+
+    pq_destroy(pq);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+    static const size_t arities[] = {2, 4, 8};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < sizeof(arities) / sizeof(arities[0]); j++)
+        {
+            run(sizes[i], arities[j]);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "bench_common.h"
+#include "heap/radix_heap.h"
+#include "queue/priority_queue.h"
+
+// 基数堆与d叉堆对比：事件模拟器的定时器轨迹（纳秒时间戳）
+// 先装入n个定时器，再执行4n次“弹出最早的定时器并按它的时间重新调度”，最后全部弹出
+// 延迟分布：90%在1ms内（网络/IO回调），9%在1s内，1%在60s内（超时）
+// 用法：bench_radix_heap [n1 n2 ...]，默认 1K 与 1M（同时挂起的定时器数）
+
+#define HOLD_ROUNDS 4
+
+static volatile uint64_t sink;
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t ka = (uintptr_t)a;
+    uintptr_t kb = (uintptr_t)b;
+    return (ka > kb) - (ka < kb);
+}
+
+static uint64_t next_delay(uint64_t *seed)
+{
+    uint64_t r = bench_rand(seed);
+    uint64_t pick = r % 100;
+    r >>= 8;
+    if (pick < 90)
+    {
+        return r % 1000000ull;
+    }
+    if (pick < 99)
+    {
+        return r % 1000000000ull;
+    }
+    return r % 60000000000ull;
+}
+
+static void run_pq(size_t n, size_t arity)
+{
+    priority_queue_t *pq = pq_create_with_arity(key_cmp, arity);
+    uint64_t seed = 42;
+    uint64_t check = 0;
+    char name[64];
+
+    pq_reserve(pq, n + 1);
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        pq_push(pq, (void *)(uintptr_t)next_delay(&seed));
+    }
+    for (size_t i = 0; i < HOLD_ROUNDS * n; i++)
+    {
+        uint64_t now = (uintptr_t)pq_pop(pq);
+        check += now;
+        pq_push(pq, (void *)(uintptr_t)(now + next_delay(&seed)));
+    }
+    while (!pq_is_empty(pq))
+    {
+        check += (uintptr_t)pq_pop(pq);
+    }
+    snprintf(name, sizeof(name), "timer trace arity=%zu", arity);
+    bench_report(name, n, (HOLD_ROUNDS + 2) * n, bench_now_ns() - start);
+    sink = check;
+    pq_destroy(pq);
+}
+
+static void run_radix(size_t n)
+{
+    radix_heap_t *rh = rh_create();
+    uint64_t seed = 42;
+    uint64_t check = 0;
+    uint64_t now;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        rh_push(rh, next_delay(&seed), NULL);
+    }
+    for (size_t i = 0; i < HOLD_ROUNDS * n; i++)
+    {
+        rh_pop(rh, &now, NULL);
+        check += now;
+        rh_push(rh, now + next_delay(&seed), NULL);
+    }
+    while (rh_pop(rh, &now, NULL))
+    {
+        check += now;
+    }
+    bench_report("timer trace radix_heap", n, (HOLD_ROUNDS + 2) * n, bench_now_ns() - start);
+    if (check != sink)
+    {
+        printf("  MISMATCH\n");
+    }
+    rh_destroy(rh);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        run_pq(sizes[i], 2);
+        run_pq(sizes[i], 4);
+        run_radix(sizes[i]);
+        printf("\n");
+    }
+    return 0;
+}
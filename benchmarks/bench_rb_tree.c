@@ -0,0 +1,133 @@
+#include "bench_common.h"
+#include "tree/rb_tree.h"
+#include "linked_list/double_list.h"
+
+// 有序集合：按序插入的双向链表（线性查找插入位置）与红黑树对比
+// 红黑树分别测试节点逐个malloc与节点池分配：随机插入、随机查找、整体有序遍历、逐个删除
+// 用法：bench_rb_tree [n1 n2 ...]，默认 10K 与 1M；链表仅在n不超过DL_LIMIT时运行
+
+#define DL_LIMIT 20000
+
+static volatile uintptr_t sink;
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static void run_dl(size_t n, const uintptr_t *keys)
+{
+    dl_list_t *list = dl_create();
+    uint64_t start = bench_now_ns();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        dl_node_t *pos = list->head;
+        while (pos != NULL && (uintptr_t)pos->data < keys[i])
+        {
+            pos = pos->next;
+        }
+        dl_node_t *node = dl_node_create((void *)keys[i]);
+        if (pos == NULL)
+        {
+            dl_add_last(list, node);
+        }
+        else
+        {
+            node->prev = pos->prev;
+            node->next = pos;
+            if (pos->prev == NULL)
+            {
+                list->head = node;
+            }
+            else
+            {
+                pos->prev->next = node;
+            }
+            pos->prev = node;
+            list->size++;
+        }
+    }
+    bench_report("sorted dl_list insert", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    uintptr_t found = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        found += dl_search(list, (void *)keys[i], key_cmp) != NULL;
+    }
+    bench_report("sorted dl_list find", n, n, bench_now_ns() - start);
+    sink = found;
+    dl_destroy(list);
+}
+
+static void run_rb(size_t n, const uintptr_t *keys, bool pooled)
+{
+    rb_tree_t *rb = pooled ? rb_create_pooled(key_cmp, 0) : rb_create(key_cmp);
+    const char *label = pooled ? "rb_tree pooled" : "rb_tree malloc";
+    char name[64];
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        rb_put(rb, (void *)keys[i], NULL);
+    }
+    snprintf(name, sizeof(name), "%s insert", label);
+    bench_report(name, n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    uintptr_t found = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        found += rb_contains(rb, (void *)keys[i]);
+    }
+    snprintf(name, sizeof(name), "%s find", label);
+    bench_report(name, n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (rb_node_t *node = rb_first(rb); node != NULL; node = rb_next(node))
+    {
+        found += (uintptr_t)node->key;
+    }
+    snprintf(name, sizeof(name), "%s in-order scan", label);
+    bench_report(name, n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        rb_remove(rb, (void *)keys[i], NULL);
+    }
+    snprintf(name, sizeof(name), "%s remove", label);
+    bench_report(name, n, n, bench_now_ns() - start);
+    sink = found;
+    rb_destroy(rb);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {10000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t n = sizes[i];
+        uintptr_t *keys = (uintptr_t *)malloc(n * sizeof(uintptr_t));
+        uint64_t seed = 42;
+        for (size_t j = 0; j < n; j++)
+        {
+            keys[j] = (uintptr_t)bench_rand(&seed);
+        }
+        if (n <= DL_LIMIT)
+        {
+            run_dl(n, keys);
+        }
+        run_rb(n, keys, false);
+        run_rb(n, keys, true);
+        free(keys);
+        printf("\n");
+    }
+    return 0;
+}
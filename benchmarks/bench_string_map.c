@@ -0,0 +1,134 @@
+#include "bench_common.h"
+#include <string.h>
+#include "hash_table/hash_table.h"
+#include "hash_table/string_map.h"
+
+// 短字符串键：string_map（键复制到内存池，槽中缓存哈希与长度）
+// 对比 hash_table + 每键strdup + 每次探测重新哈希并strcmp
+// 场景：插入、命中查找、未命中查找（未命中键与已有键长度相同、前缀相同）
+// 用法：bench_string_map [n1 n2 ...]，默认 1K 与 1M
+
+#define KEY_SIZE 24
+
+static size_t str_hash(void *key)
+{
+    size_t hash = 5381;
+    for (const char *p = (const char *)key; *p != '\0'; p++)
+    {
+        hash = hash * 33 + (unsigned char)*p;
+    }
+    return hash;
+}
+
+static int str_cmp(void *a, void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+static void free_key(void *key, void *value)
+{
+    (void)value;
+    free(key);
+}
+
+static volatile size_t sink;
+
+// 生成n个形如"user:000123456"的键，prefix区分命中与未命中集合
+static char *make_keys(size_t n, char prefix)
+{
+    char *keys = (char *)malloc(n * KEY_SIZE);
+    uint64_t seed = 99;
+    for (size_t i = 0; i < n; i++)
+    {
+        snprintf(keys + i * KEY_SIZE, KEY_SIZE, "user%c:%09llu", prefix,
+                 (unsigned long long)(i * 1000 + bench_rand(&seed) % 1000));
+    }
+    return keys;
+}
+
+static void run_hash_table(size_t n, const char *keys, const char *misses)
+{
+    hash_table_t *ht = ht_create(str_hash, str_cmp);
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        char *copy = strdup(keys + i * KEY_SIZE);
+        ht_put(ht, copy, (void *)(uintptr_t)i);
+    }
+    bench_report("hash_table+strdup insert", n, n, bench_now_ns() - start);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += ht_contains(ht, (void *)(keys + i * KEY_SIZE));
+    }
+    bench_report("hash_table+strdup hit", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += ht_contains(ht, (void *)(misses + i * KEY_SIZE));
+    }
+    bench_report("hash_table+strdup miss", n, n, bench_now_ns() - start);
+    sink = found;
+
+    ht_foreach(ht, free_key);
+    ht_destroy(ht);
+}
+
+static void run_string_map(size_t n, const char *keys, const char *misses)
+{
+    string_map_t *sm = sm_create();
+    size_t *lens = (size_t *)malloc(n * sizeof(size_t));
+    for (size_t i = 0; i < n; i++)
+    {
+        lens[i] = strlen(keys + i * KEY_SIZE);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        sm_put(sm, keys + i * KEY_SIZE, lens[i], (void *)(uintptr_t)i);
+    }
+    bench_report("string_map insert", n, n, bench_now_ns() - start);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sm_contains(sm, keys + i * KEY_SIZE, lens[i]);
+    }
+    bench_report("string_map hit", n, n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += sm_contains(sm, misses + i * KEY_SIZE, lens[i]);
+    }
+    bench_report("string_map miss", n, n, bench_now_ns() - start);
+    sink = found;
+
+    free(lens);
+    sm_destroy(sm);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {1000, 1000000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        char *keys = make_keys(sizes[i], 'a');
+        char *misses = make_keys(sizes[i], 'b');
+        run_hash_table(sizes[i], keys, misses);
+        run_string_map(sizes[i], keys, misses);
+        free(keys);
+        free(misses);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "bench_common.h"
+#include <string.h>
+#include "heap/top_k.h"
+#include "linked_list/single_list.h"
+
+// 取前K个：整体排序后取前K个 与 流式Top-K（有界堆 + 阈值提前拒绝）对比
+// 数组：qsort vs tk_offer_array；链表：sl_sort（插入排序，仅在n不超过SL_SORT_LIMIT时运行）vs tk_offer_sl
+// 用法：bench_top_k [n1 n2 ...]，默认 10K 与 1M，K取10、100、1000
+
+#define SL_SORT_LIMIT 20000
+
+static volatile uintptr_t sink;
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static int qsort_cmp(const void *a, const void *b)
+{
+    return key_cmp(*(void *const *)a, *(void *const *)b);
+}
+
+static void run(size_t n, size_t k, void **items, sl_list_t *list)
+{
+    void **copy = (void **)malloc(n * sizeof(void *));
+    void **out = (void **)malloc(k * sizeof(void *));
+    char name[64];
+
+    memcpy(copy, items, n * sizeof(void *));
+    uint64_t start = bench_now_ns();
+    qsort(copy, n, sizeof(void *), qsort_cmp);
+    snprintf(name, sizeof(name), "k=%zu qsort array", k);
+    bench_report(name, n, n, bench_now_ns() - start);
+    uintptr_t expected = (uintptr_t)copy[(k < n ? k : n) - 1];
+
+    top_k_t *tk = tk_create(k, key_cmp);
+    start = bench_now_ns();
+    tk_offer_array(tk, items, n);
+    size_t got = tk_result(tk, out);
+    snprintf(name, sizeof(name), "k=%zu tk_offer_array", k);
+    bench_report(name, n, n, bench_now_ns() - start);
+    printf("  rejected by threshold %.1f%%%s\n", 100.0 * (double)tk_rejected(tk) / (double)n,
+           (uintptr_t)out[got - 1] == expected ? "" : " (MISMATCH)");
+
+    tk_clear(tk);
+    start = bench_now_ns();
+    tk_offer_sl(tk, list);
+    tk_result(tk, out);
+    snprintf(name, sizeof(name), "k=%zu tk_offer_sl", k);
+    bench_report(name, n, n, bench_now_ns() - start);
+    sink = (uintptr_t)out[0];
+    tk_destroy(tk);
+
+    if (n <= SL_SORT_LIMIT)
+    {
+        sl_list_t *sorted = sl_create();
+        for (size_t i = 0; i < n; i++)
+        {
+            sl_add_last(sorted, sl_node_create(items[i]));
+        }
+        start = bench_now_ns();
+        sl_sort(sorted, key_cmp);
+        size_t taken = 0;
+        for (sl_node_t *node = sorted->head; node != NULL && taken < k; node = node->next)
+        {
+            out[taken++] = node->data;
+        }
+        snprintf(name, sizeof(name), "k=%zu sl_sort + first k", k);
+        bench_report(name, n, n, bench_now_ns() - start);
+        sink = (uintptr_t)out[0];
+        sl_destroy(sorted);
+    }
+
+    free(out);
+    free(copy);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t defaults[] = {10000, 1000000};
+    static const size_t ks[] = {10, 100, 1000};
+    size_t sizes[16];
+    size_t count = bench_parse_sizes(argc, argv, sizes, 16, defaults, 2);
+
+    for (size_t s = 0; s < count; s++)
+    {
+        size_t n = sizes[s];
+        void **items = (void **)malloc(n * sizeof(void *));
+        sl_list_t *list = sl_create();
+        uint64_t seed = 2024;
+        for (size_t i = 0; i < n; i++)
+        {
+            items[i] = (void *)(uintptr_t)(bench_rand(&seed) >> 1);
+            sl_add_last(list, sl_node_create(items[i]));
+        }
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            run(n, ks[i], items, list);
+        }
+        printf("\n");
+
+        sl_destroy(list);
+        free(items);
+    }
+    return 0;
+}
@@ -0,0 +1,603 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "clock_cache.h"
+#include "hash/hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 线程的统计计数器组号+1，0表示尚未分配
+static __thread size_t cc_thread_stripe;
+static size_t cc_next_stripe;
+// 线程的操作计数，用于抽样计时
+static __thread uint32_t cc_thread_tick;
+
+static size_t cc_counter_stripe(void)
+{
+    if (cc_thread_stripe == 0)
+    {
+        cc_thread_stripe = __atomic_fetch_add(&cc_next_stripe, 1, __ATOMIC_RELAXED) % CC_COUNTER_STRIPES + 1;
+    }
+    return cc_thread_stripe - 1;
+}
+
+static uint64_t cc_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static size_t cc_round_pow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
+
+// 本次操作是否计时
+static bool cc_should_sample(clock_cache_t *cache)
+{
+    if (!__atomic_load_n(&cache->sampling, __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+    return (++cc_thread_tick & __atomic_load_n(&cache->sample_mask, __ATOMIC_RELAXED)) == 0;
+}
+
+static void cc_update_max(uint64_t *max, uint64_t value)
+{
+    uint64_t current = __atomic_load_n(max, __ATOMIC_RELAXED);
+    while (value > current &&
+           !__atomic_compare_exchange_n(max, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+// 持锁更新的计数器：其他线程只做原子读
+static void cc_bump(uint64_t *counter, uint64_t delta)
+{
+    __atomic_store_n(counter, *counter + delta, __ATOMIC_RELAXED);
+}
+
+// 混合调用方哈希值：高半部分选分片，低位选桶
+static size_t cc_mix(clock_cache_t *cache, void *key)
+{
+    return (size_t)hash_u64((uint64_t)cache->hash(key));
+}
+
+static cc_shard_t *cc_shard_of(clock_cache_t *cache, size_t hash)
+{
+    return &cache->shards[(hash >> (sizeof(size_t) * 4)) & (cache->shard_count - 1)];
+}
+
+// 回收回调：调用淘汰回调后释放条目
+static void cc_release(void *ptr, void *arg)
+{
+    clock_cache_t *cache = (clock_cache_t *)arg;
+    cc_entry_t *entry = (cc_entry_t *)ptr;
+    if (cache->on_evict != NULL)
+    {
+        cache->on_evict(entry->key, entry->value, (cc_reason_t)entry->reason, cache->evict_arg);
+    }
+    free(entry);
+}
+
+// 退休已摘除的条目到所在分片的待回收列表（调用方不得处于读临界区中）
+static void cc_retire(clock_cache_t *cache, cc_shard_t *shard, cc_entry_t *entry, cc_reason_t reason)
+{
+    entry->reason = (uint8_t)reason;
+    ebr_retire_to(&cache->ebr, &shard->limbo, entry, cc_release, cache);
+}
+
+// 无锁查找（调用方处于读临界区中）
+static cc_entry_t *cc_lookup(clock_cache_t *cache, cc_shard_t *shard, void *key, size_t hash)
+{
+    cc_entry_t *entry = __atomic_load_n(&shard->buckets[hash & shard->mask], __ATOMIC_ACQUIRE);
+    while (entry != NULL)
+    {
+        if (entry->hash == hash && cache->cmp(entry->key, key) == 0)
+        {
+            return entry;
+        }
+        entry = __atomic_load_n(&entry->next, __ATOMIC_ACQUIRE);
+    }
+    return NULL;
+}
+
+// 从索引链上摘除条目（调用方持有分片锁）
+// 摘除后entry->next保持不变，正在该条目上的读线程仍能继续遍历
+static void cc_unlink(cc_shard_t *shard, cc_entry_t *entry)
+{
+    cc_entry_t **link = &shard->buckets[entry->hash & shard->mask];
+    while (*link != entry)
+    {
+        link = &(*link)->next;
+    }
+    __atomic_store_n(link, entry->next, __ATOMIC_RELEASE);
+}
+
+// 时钟指针扫过环，返回应淘汰条目的位置（调用方持有分片锁，环已满）
+// 读线程可能不断重新置位，最多扫两圈后直接淘汰指针所指条目
+static size_t cc_sweep(cc_shard_t *shard)
+{
+    for (size_t step = 0; step < 2 * shard->capacity; step++)
+    {
+        cc_entry_t *entry = shard->ring[shard->hand];
+        if (__atomic_load_n(&entry->ref, __ATOMIC_RELAXED) == 0)
+        {
+            break;
+        }
+        __atomic_store_n(&entry->ref, 0, __ATOMIC_RELAXED);
+        shard->hand = shard->hand + 1 == shard->capacity ? 0 : shard->hand + 1;
+    }
+    return shard->hand;
+}
+
+static void cc_free_shards(cc_shard_t *shards, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        free(shards[i].buckets);
+        free(shards[i].ring);
+        pthread_mutex_destroy(&shards[i].lock);
+    }
+    free(shards);
+}
+
+static void cc_collect(cc_shard_t *shard, cc_stats_t *stats)
+{
+    for (size_t i = 0; i < CC_COUNTER_STRIPES; i++)
+    {
+        cc_counter_t *counter = &shard->counters[i];
+        stats->hits += __atomic_load_n(&counter->hits, __ATOMIC_RELAXED);
+        stats->misses += __atomic_load_n(&counter->misses, __ATOMIC_RELAXED);
+        stats->lookup_samples += __atomic_load_n(&counter->lookup_samples, __ATOMIC_RELAXED);
+        stats->lookup_ns += __atomic_load_n(&counter->lookup_ns, __ATOMIC_RELAXED);
+        uint64_t max = __atomic_load_n(&counter->lookup_max_ns, __ATOMIC_RELAXED);
+        if (max > stats->lookup_max_ns)
+        {
+            stats->lookup_max_ns = max;
+        }
+    }
+    stats->inserts += __atomic_load_n(&shard->inserts, __ATOMIC_RELAXED);
+    stats->evictions += __atomic_load_n(&shard->evictions, __ATOMIC_RELAXED);
+    stats->size += __atomic_load_n(&shard->count, __ATOMIC_RELAXED);
+    stats->capacity += shard->capacity;
+    stats->insert_samples += __atomic_load_n(&shard->insert_samples, __ATOMIC_RELAXED);
+    stats->insert_ns += __atomic_load_n(&shard->insert_ns, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&shard->insert_max_ns, __ATOMIC_RELAXED);
+    if (max > stats->insert_max_ns)
+    {
+        stats->insert_max_ns = max;
+    }
+}
+
+// 创建缓存，capacity为条目个数上限，均分到各分片
+// shards为分片数（向上取2的幂，0表示缺省值，不超过capacity），on_evict可为NULL
+clock_cache_t *cc_create(size_t capacity, size_t shards, ht_hash_fn hash, ht_cmp_fn cmp,
+                         cc_evict_fn on_evict, void *arg)
+{
+    if (capacity == 0 || hash == NULL || cmp == NULL)
+    {
+        return NULL;
+    }
+
+    shards = cc_round_pow2(shards == 0 ? CC_DEFAULT_SHARDS : shards);
+    while (shards > 1 && shards > capacity)
+    {
+        shards >>= 1;
+    }
+
+    void *mem = NULL;
+    if (posix_memalign(&mem, 64, sizeof(clock_cache_t)) != 0)
+    {
+        return NULL;
+    }
+    clock_cache_t *cache = (clock_cache_t *)mem;
+    memset(cache, 0, sizeof(clock_cache_t));
+
+    if (posix_memalign(&mem, 64, shards * sizeof(cc_shard_t)) != 0)
+    {
+        free(cache);
+        return NULL;
+    }
+    cache->shards = (cc_shard_t *)mem;
+    memset(cache->shards, 0, shards * sizeof(cc_shard_t));
+
+    for (size_t i = 0; i < shards; i++)
+    {
+        cc_shard_t *shard = &cache->shards[i];
+        shard->capacity = capacity / shards + (i < capacity % shards ? 1 : 0);
+        size_t buckets = cc_round_pow2(shard->capacity);
+        shard->mask = buckets - 1;
+        shard->buckets = (cc_entry_t **)calloc(buckets, sizeof(cc_entry_t *));
+        shard->ring = (cc_entry_t **)malloc(shard->capacity * sizeof(cc_entry_t *));
+        pthread_mutex_init(&shard->lock, NULL);
+        ebr_limbo_init(&shard->limbo);
+        if (shard->buckets == NULL || shard->ring == NULL)
+        {
+            for (size_t j = 0; j <= i; j++)
+            {
+                ebr_limbo_destroy(&cache->shards[j].limbo);
+            }
+            cc_free_shards(cache->shards, i + 1);
+            free(cache);
+            return NULL;
+        }
+    }
+
+    cache->shard_count = shards;
+    cache->capacity = capacity;
+    cache->hash = hash;
+    cache->cmp = cmp;
+    cache->on_evict = on_evict;
+    cache->evict_arg = arg;
+    ebr_init(&cache->ebr);
+    return cache;
+}
+
+// 销毁缓存，对每个条目以CC_CLEARED调用回调，调用时不得有其他线程访问
+void cc_destroy(clock_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    // 先执行已退休条目的回调，再处理仍在缓存中的条目
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        ebr_limbo_destroy(&cache->shards[i].limbo);
+    }
+    ebr_destroy(&cache->ebr);
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        cc_shard_t *shard = &cache->shards[i];
+        for (size_t j = 0; j < shard->count; j++)
+        {
+            shard->ring[j]->reason = CC_CLEARED;
+            cc_release(shard->ring[j], cache);
+        }
+    }
+    cc_free_shards(cache->shards, cache->shard_count);
+    free(cache);
+}
+
+// 清空缓存，对每个条目以CC_CLEARED调用回调（延迟到没有读线程访问时）
+void cc_clear(clock_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        cc_shard_t *shard = &cache->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        for (size_t b = 0; b <= shard->mask; b++)
+        {
+            __atomic_store_n(&shard->buckets[b], NULL, __ATOMIC_RELEASE);
+        }
+        for (size_t j = 0; j < shard->count; j++)
+        {
+            cc_retire(cache, shard, shard->ring[j], CC_CLEARED);
+        }
+        __atomic_store_n(&shard->count, 0, __ATOMIC_RELAXED);
+        shard->hand = 0;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+// 获取条目个数（并发修改时为近似值）
+size_t cc_size(clock_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    size_t size = 0;
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        size += __atomic_load_n(&cache->shards[i].count, __ATOMIC_RELAXED);
+    }
+    return size;
+}
+
+// 获取容量
+size_t cc_capacity(clock_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    return cache->capacity;
+}
+
+// 获取分片数
+size_t cc_shard_count(clock_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    return cache->shard_count;
+}
+
+// 设置耗时抽样间隔（向上取2的幂），每个线程每interval次操作计时一次，0表示关闭（缺省）
+void cc_set_sampling(clock_cache_t *cache, uint32_t interval)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    if (interval == 0)
+    {
+        __atomic_store_n(&cache->sampling, false, __ATOMIC_RELAXED);
+        return;
+    }
+    __atomic_store_n(&cache->sample_mask, (uint32_t)cc_round_pow2(interval) - 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&cache->sampling, true, __ATOMIC_RELAXED);
+}
+
+// 开启或关闭命中/未命中计数（缺省关闭），开启后每次cc_get/cc_find写一次共享计数器
+void cc_set_counting(clock_cache_t *cache, bool enable)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    __atomic_store_n(&cache->counting, enable, __ATOMIC_RELAXED);
+}
+
+// 插入或替换，替换时以CC_REPLACED对旧键值调用回调
+// 分片已满时按CLOCK淘汰一个条目，以CC_EVICTED调用回调
+bool cc_put(clock_cache_t *cache, void *key, void *value)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    bool sample = cc_should_sample(cache);
+    uint64_t start = sample ? cc_now_ns() : 0;
+    size_t hash = cc_mix(cache, key);
+    cc_shard_t *shard = cc_shard_of(cache, hash);
+
+    cc_entry_t *entry = (cc_entry_t *)malloc(sizeof(cc_entry_t));
+    if (entry == NULL)
+    {
+        return false;
+    }
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+    entry->ref = 0;
+    entry->reason = CC_EVICTED;
+
+    cc_entry_t *victim = NULL;
+    cc_reason_t reason = CC_EVICTED;
+
+    pthread_mutex_lock(&shard->lock);
+    cc_entry_t **link = &shard->buckets[hash & shard->mask];
+    cc_entry_t *old = *link;
+    while (old != NULL && !(old->hash == hash && cache->cmp(old->key, key) == 0))
+    {
+        link = &old->next;
+        old = *link;
+    }
+
+    if (old != NULL)
+    {
+        // 新条目接替旧条目在索引链和环上的位置，读线程要么看到旧条目要么看到新条目
+        entry->next = old->next;
+        entry->slot = old->slot;
+        entry->ref = 1;
+        shard->ring[old->slot] = entry;
+        __atomic_store_n(link, entry, __ATOMIC_RELEASE);
+        victim = old;
+        reason = CC_REPLACED;
+    }
+    else
+    {
+        if (shard->count == shard->capacity)
+        {
+            // 新条目放在被淘汰者的位置，指针移到下一个，使新条目经过整整一圈才被检查
+            size_t slot = cc_sweep(shard);
+            victim = shard->ring[slot];
+            cc_unlink(shard, victim);
+            entry->slot = slot;
+            shard->ring[slot] = entry;
+            shard->hand = slot + 1 == shard->capacity ? 0 : slot + 1;
+            cc_bump(&shard->evictions, 1);
+        }
+        else
+        {
+            entry->slot = shard->count;
+            shard->ring[shard->count] = entry;
+            __atomic_store_n(&shard->count, shard->count + 1, __ATOMIC_RELAXED);
+        }
+        cc_entry_t **bucket = &shard->buckets[hash & shard->mask];
+        entry->next = *bucket;
+        // 条目内容先于链入对读线程可见
+        __atomic_store_n(bucket, entry, __ATOMIC_RELEASE);
+        cc_bump(&shard->inserts, 1);
+    }
+
+    if (sample)
+    {
+        uint64_t ns = cc_now_ns() - start;
+        cc_bump(&shard->insert_samples, 1);
+        cc_bump(&shard->insert_ns, ns);
+        if (ns > shard->insert_max_ns)
+        {
+            __atomic_store_n(&shard->insert_max_ns, ns, __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    if (victim != NULL)
+    {
+        cc_retire(cache, shard, victim, reason);
+    }
+    return true;
+}
+
+// 获取键对应的值，不存在返回NULL
+void *cc_get(clock_cache_t *cache, void *key)
+{
+    void *value = NULL;
+    cc_find(cache, key, &value);
+    return value;
+}
+
+// 查找键并置引用位，存在时通过value返回对应的值（不加锁）
+bool cc_find(clock_cache_t *cache, void *key, void **value)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    bool sample = cc_should_sample(cache);
+    uint64_t start = sample ? cc_now_ns() : 0;
+    size_t hash = cc_mix(cache, key);
+    cc_shard_t *shard = cc_shard_of(cache, hash);
+
+    ebr_guard_t guard = ebr_enter(&cache->ebr);
+    cc_entry_t *entry = cc_lookup(cache, shard, key, hash);
+    if (entry != NULL)
+    {
+        // 已置位时不写，热点条目的缓存行不会在读线程间来回迁移
+        if (__atomic_load_n(&entry->ref, __ATOMIC_RELAXED) == 0)
+        {
+            __atomic_store_n(&entry->ref, 1, __ATOMIC_RELAXED);
+        }
+        if (value != NULL)
+        {
+            *value = entry->value;
+        }
+    }
+    ebr_exit(&cache->ebr, guard);
+
+    if (__atomic_load_n(&cache->counting, __ATOMIC_RELAXED))
+    {
+        cc_counter_t *counter = &shard->counters[cc_counter_stripe()];
+        __atomic_fetch_add(entry != NULL ? &counter->hits : &counter->misses, 1, __ATOMIC_RELAXED);
+    }
+    if (sample)
+    {
+        cc_counter_t *counter = &shard->counters[cc_counter_stripe()];
+        uint64_t ns = cc_now_ns() - start;
+        __atomic_fetch_add(&counter->lookup_samples, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&counter->lookup_ns, ns, __ATOMIC_RELAXED);
+        cc_update_max(&counter->lookup_max_ns, ns);
+    }
+    return entry != NULL;
+}
+
+// 检查键是否存在（不置引用位，也不计入统计）
+bool cc_contains(clock_cache_t *cache, void *key)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    size_t hash = cc_mix(cache, key);
+    ebr_guard_t guard = ebr_enter(&cache->ebr);
+    bool found = cc_lookup(cache, cc_shard_of(cache, hash), key, hash) != NULL;
+    ebr_exit(&cache->ebr, guard);
+    return found;
+}
+
+// 删除键，以CC_REMOVED调用回调
+bool cc_remove(clock_cache_t *cache, void *key)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    size_t hash = cc_mix(cache, key);
+    cc_shard_t *shard = cc_shard_of(cache, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    cc_entry_t *entry = shard->buckets[hash & shard->mask];
+    while (entry != NULL && !(entry->hash == hash && cache->cmp(entry->key, key) == 0))
+    {
+        entry = entry->next;
+    }
+    if (entry == NULL)
+    {
+        pthread_mutex_unlock(&shard->lock);
+        return false;
+    }
+    cc_unlink(shard, entry);
+
+    // 环上最后一个条目补到空位
+    size_t last = shard->count - 1;
+    shard->ring[entry->slot] = shard->ring[last];
+    shard->ring[entry->slot]->slot = entry->slot;
+    __atomic_store_n(&shard->count, last, __ATOMIC_RELAXED);
+    if (shard->hand >= last)
+    {
+        shard->hand = 0;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    cc_retire(cache, shard, entry, CC_REMOVED);
+    return true;
+}
+
+// 进入读临界区：在cc_unpin之前，期间读到的值不会被淘汰回调释放
+// 读临界区内不得调用cc_put、cc_remove与cc_clear
+cc_guard_t cc_pin(clock_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        cc_guard_t none = {0, 0};
+        return none;
+    }
+    return ebr_enter(&cache->ebr);
+}
+
+// 退出读临界区
+void cc_unpin(clock_cache_t *cache, cc_guard_t guard)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    ebr_exit(&cache->ebr, guard);
+}
+
+// 获取单个分片的统计
+bool cc_shard_stats(clock_cache_t *cache, size_t shard, cc_stats_t *stats)
+{
+    if (cache == NULL || stats == NULL || shard >= cache->shard_count)
+    {
+        return false;
+    }
+    memset(stats, 0, sizeof(cc_stats_t));
+    cc_collect(&cache->shards[shard], stats);
+    return true;
+}
+
+// 获取全部分片合计的统计
+void cc_stats(clock_cache_t *cache, cc_stats_t *stats)
+{
+    if (cache == NULL || stats == NULL)
+    {
+        return;
+    }
+    memset(stats, 0, sizeof(cc_stats_t));
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        cc_collect(&cache->shards[i], stats);
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef __CLOCK_CACHE_H__
+#define __CLOCK_CACHE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "hash_table/hash_table.h"
+#include "sync/ebr.h"
+
+// 分片CLOCK缓存（并发）
+// 键按哈希分到多个分片，每个分片是固定容量的CLOCK环加固定桶数的链式索引。
+// 命中只把条目的引用位原子置1（已为1时不写），不移动任何节点，读操作不加锁，
+// 读临界区只写本线程独占的计数槽；插入、删除与淘汰持有所在分片的锁。
+// 淘汰时时钟指针扫过环，引用位为1的条目清零后跳过（第二次机会），
+// 遇到引用位为0的条目将其淘汰。
+// 被摘除的条目经纪元回收延迟释放，每个分片有自己的待回收列表，不同分片的写线程
+// 不争用同一把锁；淘汰回调也延迟到没有读线程可能再访问该条目时才调用
+// （在该分片的某个写线程中执行，回调中不得再访问该缓存）。
+// cc_get返回的值可能随后被淘汰回调释放：回调会释放值时，应在cc_pin与
+// cc_unpin之间使用读到的值。
+// 每个分片记录插入与淘汰次数；命中/未命中计数（cc_set_counting）与查找、插入
+// 耗时抽样（cc_set_sampling）会在读路径上增加共享计数器的写，默认关闭。
+
+// 分片数缺省值（2的幂）
+#define CC_DEFAULT_SHARDS 64
+// 每个分片的读统计计数器组数，线程分散到各组以避免争用同一缓存行
+#define CC_COUNTER_STRIPES 8
+
+// 条目被放弃的原因
+typedef enum cc_reason
+{
+    CC_EVICTED,     // 分片已满被淘汰
+    CC_REPLACED,    // 同一键被重新put
+    CC_REMOVED,     // cc_remove
+    CC_CLEARED,     // cc_clear或cc_destroy
+} cc_reason_t;
+
+typedef void (*cc_evict_fn)(void *key, void *value, cc_reason_t reason, void *arg);
+
+typedef struct cc_entry
+{
+    struct cc_entry *next;  // 索引链，原子访问
+    void *key;
+    void *value;
+    size_t hash;
+    size_t slot;            // 在CLOCK环中的位置
+    uint8_t ref;            // 引用位，原子访问
+    uint8_t reason;         // 摘除原因，回收时传给回调
+} cc_entry_t;
+
+// 读统计：独占缓存行
+typedef struct cc_counter
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t lookup_samples;
+    uint64_t lookup_ns;
+    uint64_t lookup_max_ns;
+} __attribute__((aligned(64))) cc_counter_t;
+
+typedef struct cc_shard
+{
+    pthread_mutex_t lock;   // 保护ring、hand与索引链的修改
+    cc_entry_t **buckets;   // 原子访问
+    size_t mask;            // 桶数-1
+    cc_entry_t **ring;      // CLOCK环
+    size_t capacity;
+    size_t count;           // 原子读
+    size_t hand;            // 时钟指针
+    uint64_t inserts;       // 以下持锁更新，原子读
+    uint64_t evictions;
+    uint64_t insert_samples;
+    uint64_t insert_ns;
+    uint64_t insert_max_ns;
+    ebr_limbo_t limbo;      // 本分片被摘除条目的待回收列表
+    cc_counter_t counters[CC_COUNTER_STRIPES];
+} __attribute__((aligned(64))) cc_shard_t;
+
+typedef struct clock_cache
+{
+    cc_shard_t *shards;
+    size_t shard_count;
+    size_t capacity;
+    ht_hash_fn hash;
+    ht_cmp_fn cmp;
+    cc_evict_fn on_evict;
+    void *evict_arg;
+    uint32_t sample_mask;   // 抽样间隔-1，原子访问
+    bool sampling;          // 是否抽样计时，原子访问
+    bool counting;          // 是否统计命中/未命中，原子访问
+    ebr_domain_t ebr;       // 被摘除条目的延迟回收
+} clock_cache_t;
+
+// 统计快照（并发修改时各字段可能不完全一致）
+typedef struct cc_stats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;
+    size_t size;
+    size_t capacity;
+    uint64_t lookup_samples;    // 被计时的查找次数
+    uint64_t lookup_ns;         // 被计时查找的总耗时
+    uint64_t lookup_max_ns;
+    uint64_t insert_samples;    // 被计时的插入次数（含等锁时间）
+    uint64_t insert_ns;
+    uint64_t insert_max_ns;
+} cc_stats_t;
+
+typedef ebr_guard_t cc_guard_t;
+
+clock_cache_t *cc_create(size_t capacity, size_t shards, ht_hash_fn hash, ht_cmp_fn cmp,
+                         cc_evict_fn on_evict, void *arg);
+void cc_destroy(clock_cache_t *cache);
+void cc_clear(clock_cache_t *cache);
+size_t cc_size(clock_cache_t *cache);
+size_t cc_capacity(clock_cache_t *cache);
+size_t cc_shard_count(clock_cache_t *cache);
+void cc_set_sampling(clock_cache_t *cache, uint32_t interval);
+void cc_set_counting(clock_cache_t *cache, bool enable);
+
+bool cc_put(clock_cache_t *cache, void *key, void *value);
+void *cc_get(clock_cache_t *cache, void *key);
+bool cc_find(clock_cache_t *cache, void *key, void **value);
+bool cc_contains(clock_cache_t *cache, void *key);
+bool cc_remove(clock_cache_t *cache, void *key);
+
+cc_guard_t cc_pin(clock_cache_t *cache);
+void cc_unpin(clock_cache_t *cache, cc_guard_t guard);
+
+bool cc_shard_stats(clock_cache_t *cache, size_t shard, cc_stats_t *stats);
+void cc_stats(clock_cache_t *cache, cc_stats_t *stats);
+
+#endif // __CLOCK_CACHE_H__
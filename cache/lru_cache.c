@@ -0,0 +1,299 @@
+#include "lru_cache.h"
+#include <stdlib.h>
+
+// 条目所在节点移到表头
+static void lru_touch(lru_cache_t *cache, lru_entry_t *entry)
+{
+    if (cache->list.head != &entry->node)
+    {
+        dl_remove(&cache->list, &entry->node);
+        dl_add_first(&cache->list, &entry->node);
+    }
+}
+
+// 从表尾淘汰，直到总开销不超过容量
+static void lru_evict(lru_cache_t *cache)
+{
+    while (cache->usage > cache->capacity && cache->list.tail != NULL)
+    {
+        lru_entry_t *entry = (lru_entry_t *)dl_remove_last(&cache->list)->data;
+        ht_remove(cache->index, entry->key, NULL);
+        cache->usage -= entry->charge;
+        cache->evictions++;
+        if (cache->on_evict != NULL)
+        {
+            cache->on_evict(entry->key, entry->value, LRU_EVICTED, cache->evict_arg);
+        }
+        free(entry);
+    }
+}
+
+// 创建LRU缓存，capacity为总开销上限，on_evict可为NULL
+lru_cache_t *lru_create(size_t capacity, ht_hash_fn hash, ht_cmp_fn cmp, lru_evict_fn on_evict, void *arg)
+{
+    if (capacity == 0 || hash == NULL || cmp == NULL)
+    {
+        return NULL;
+    }
+
+    lru_cache_t *cache = (lru_cache_t *)malloc(sizeof(lru_cache_t));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+    cache->index = ht_create(hash, cmp);
+    if (cache->index == NULL)
+    {
+        free(cache);
+        return NULL;
+    }
+    cache->list.head = NULL;
+    cache->list.tail = NULL;
+    cache->list.size = 0;
+    cache->capacity = capacity;
+    cache->usage = 0;
+    cache->on_evict = on_evict;
+    cache->evict_arg = arg;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    return cache;
+}
+
+// 销毁缓存，对每个条目以LRU_CLEARED调用回调
+void lru_destroy(lru_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    lru_clear(cache);
+    ht_destroy(cache->index);
+    free(cache);
+}
+
+// 清空缓存，对每个条目以LRU_CLEARED调用回调
+void lru_clear(lru_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    dl_node_t *node = cache->list.head;
+    while (node != NULL)
+    {
+        dl_node_t *next = node->next;
+        lru_entry_t *entry = (lru_entry_t *)node->data;
+        if (cache->on_evict != NULL)
+        {
+            cache->on_evict(entry->key, entry->value, LRU_CLEARED, cache->evict_arg);
+        }
+        free(entry);
+        node = next;
+    }
+    cache->list.head = NULL;
+    cache->list.tail = NULL;
+    cache->list.size = 0;
+    cache->usage = 0;
+    ht_clear(cache->index);
+}
+
+// 获取条目个数
+size_t lru_size(lru_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    return cache->list.size;
+}
+
+// 获取当前总开销
+size_t lru_usage(lru_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    return cache->usage;
+}
+
+// 获取容量
+size_t lru_capacity(lru_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    return cache->capacity;
+}
+
+// 修改容量，缩小时立即淘汰
+void lru_set_capacity(lru_cache_t *cache, size_t capacity)
+{
+    if (cache == NULL || capacity == 0)
+    {
+        return;
+    }
+    cache->capacity = capacity;
+    lru_evict(cache);
+}
+
+// 插入或替换，开销为1
+bool lru_put(lru_cache_t *cache, void *key, void *value)
+{
+    return lru_put_charged(cache, key, value, 1);
+}
+
+// 插入或替换，指定开销；开销超过容量时不插入并返回false（键值仍归调用方）
+// 替换时以LRU_REPLACED对旧键值调用回调
+bool lru_put_charged(lru_cache_t *cache, void *key, void *value, size_t charge)
+{
+    if (cache == NULL || charge > cache->capacity)
+    {
+        return false;
+    }
+
+    lru_entry_t *entry = (lru_entry_t *)ht_get(cache->index, key);
+    if (entry != NULL)
+    {
+        void *old_key = entry->key;
+        void *old_value = entry->value;
+        // 新旧键对象不同时先更新索引，回调可能释放旧键
+        if (old_key != key)
+        {
+            ht_remove(cache->index, old_key, NULL);
+            if (!ht_put(cache->index, key, entry))
+            {
+                ht_put(cache->index, old_key, entry);
+                return false;
+            }
+        }
+        entry->key = key;
+        entry->value = value;
+        cache->usage = cache->usage - entry->charge + charge;
+        entry->charge = charge;
+        lru_touch(cache, entry);
+        lru_evict(cache);
+        if (cache->on_evict != NULL)
+        {
+            cache->on_evict(old_key, old_value, LRU_REPLACED, cache->evict_arg);
+        }
+        return true;
+    }
+
+    entry = (lru_entry_t *)malloc(sizeof(lru_entry_t));
+    if (entry == NULL)
+    {
+        return false;
+    }
+    if (!ht_put(cache->index, key, entry))
+    {
+        free(entry);
+        return false;
+    }
+    entry->node.data = entry;
+    entry->key = key;
+    entry->value = value;
+    entry->charge = charge;
+    dl_add_first(&cache->list, &entry->node);
+    cache->usage += charge;
+    // 新条目在表头且开销不超过容量，不会被自己的插入淘汰
+    lru_evict(cache);
+    return true;
+}
+
+// 获取键对应的值并标记为最近使用，不存在返回NULL
+void *lru_get(lru_cache_t *cache, void *key)
+{
+    void *value = NULL;
+    lru_find(cache, key, &value);
+    return value;
+}
+
+// 查找键并标记为最近使用，存在时通过value返回对应的值
+bool lru_find(lru_cache_t *cache, void *key, void **value)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    lru_entry_t *entry = (lru_entry_t *)ht_get(cache->index, key);
+    if (entry == NULL)
+    {
+        cache->misses++;
+        return false;
+    }
+    cache->hits++;
+    lru_touch(cache, entry);
+    if (value != NULL)
+    {
+        *value = entry->value;
+    }
+    return true;
+}
+
+// 查找键但不改变使用顺序，也不计入命中统计
+bool lru_peek(lru_cache_t *cache, void *key, void **value)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    lru_entry_t *entry = (lru_entry_t *)ht_get(cache->index, key);
+    if (entry == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = entry->value;
+    }
+    return true;
+}
+
+// 检查键是否存在（不改变使用顺序）
+bool lru_contains(lru_cache_t *cache, void *key)
+{
+    return lru_peek(cache, key, NULL);
+}
+
+// 删除键，存在时通过value返回原值（不调用回调）
+bool lru_remove(lru_cache_t *cache, void *key, void **value)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+
+    lru_entry_t *entry = NULL;
+    if (!ht_remove(cache->index, key, (void **)&entry))
+    {
+        return false;
+    }
+    dl_remove(&cache->list, &entry->node);
+    cache->usage -= entry->charge;
+    if (value != NULL)
+    {
+        *value = entry->value;
+    }
+    free(entry);
+    return true;
+}
+
+// 从最近到最久依次遍历
+void lru_foreach(lru_cache_t *cache, void (*func)(void *key, void *value))
+{
+    if (cache == NULL || func == NULL)
+    {
+        return;
+    }
+    for (dl_node_t *node = cache->list.head; node != NULL; node = node->next)
+    {
+        lru_entry_t *entry = (lru_entry_t *)node->data;
+        func(entry->key, entry->value);
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef __LRU_CACHE_H__
+#define __LRU_CACHE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "linked_list/double_list.h"
+#include "hash_table/hash_table.h"
+
+// LRU缓存
+// 条目内嵌dl_node_t挂在最近使用链表上（表头最新、表尾最旧），
+// 另用hash_table按键索引条目，get/put/淘汰均为O(1)。
+// 容量按"开销"计：lru_put每个条目开销为1（即按个数限制），
+// lru_put_charged可指定开销（如字节数）。总开销超过容量时从表尾淘汰。
+// 缓存放弃持有的条目（淘汰、被替换、清空、销毁）时调用回调，
+// 调用方可在回调中释放键值（回调中不得再访问该缓存）；
+// lru_remove直接把值交还调用方，不调用回调。
+
+// 条目被放弃的原因
+typedef enum lru_reason
+{
+    LRU_EVICTED,    // 超出容量被淘汰
+    LRU_REPLACED,   // 同一键被重新put
+    LRU_CLEARED,    // lru_clear或lru_destroy
+} lru_reason_t;
+
+typedef void (*lru_evict_fn)(void *key, void *value, lru_reason_t reason, void *arg);
+
+typedef struct lru_entry
+{
+    dl_node_t node;     // 最近使用链表节点，node.data指向条目自身
+    void *key;
+    void *value;
+    size_t charge;
+} lru_entry_t;
+
+typedef struct lru_cache
+{
+    dl_list_t list;         // 最近使用链表
+    hash_table_t *index;    // 键 -> lru_entry_t *
+    size_t capacity;        // 总开销上限
+    size_t usage;           // 当前总开销
+    lru_evict_fn on_evict;
+    void *evict_arg;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} lru_cache_t;
+
+lru_cache_t *lru_create(size_t capacity, ht_hash_fn hash, ht_cmp_fn cmp, lru_evict_fn on_evict, void *arg);
+void lru_destroy(lru_cache_t *cache);
+void lru_clear(lru_cache_t *cache);
+size_t lru_size(lru_cache_t *cache);
+size_t lru_usage(lru_cache_t *cache);
+size_t lru_capacity(lru_cache_t *cache);
+void lru_set_capacity(lru_cache_t *cache, size_t capacity);
+
+bool lru_put(lru_cache_t *cache, void *key, void *value);
+bool lru_put_charged(lru_cache_t *cache, void *key, void *value, size_t charge);
+void *lru_get(lru_cache_t *cache, void *key);
+bool lru_find(lru_cache_t *cache, void *key, void **value);
+bool lru_peek(lru_cache_t *cache, void *key, void **value);
+bool lru_contains(lru_cache_t *cache, void *key);
+bool lru_remove(lru_cache_t *cache, void *key, void **value);
+void lru_foreach(lru_cache_t *cache, void (*func)(void *key, void *value));
+
+#endif // __LRU_CACHE_H__
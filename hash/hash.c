@@ -0,0 +1,448 @@
+#include "hash.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// x86上用target属性单独编译各指令集版本，运行时按CPU选择，无需-m编译选项
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HASH_X86_DISPATCH 1
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// 混合常数（取自wyhash）
+static const uint64_t hash_secret[4] = {
+    0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull,
+};
+
+// 64x64->128位乘法，低64位写回a，高64位写回b
+static inline void hash_mum(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t hash_mix(uint64_t a, uint64_t b)
+{
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+// 按小端读取（x86与ARM均为小端）
+static inline uint64_t hash_read8(const uint8_t *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hash_read4(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 1~3字节：首、中、尾三个字节
+static inline uint64_t hash_read3(const uint8_t *p, size_t len)
+{
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+}
+
+// 任意字节串的64位哈希
+uint64_t hash_bytes(const void *data, size_t len)
+{
+    return hash_bytes_seeded(data, len, 0);
+}
+
+// 带种子的字节串哈希
+uint64_t hash_bytes_seeded(const void *data, size_t len, uint64_t seed)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t a;
+    uint64_t b;
+
+    seed ^= hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            // 4~16字节：首尾各两次4字节读取，覆盖全部字节
+            size_t mid = (len >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + mid);
+            b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - mid);
+        }
+        else if (len > 0)
+        {
+            a = hash_read3(p, len);
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+        if (i > 48)
+        {
+            // 三路独立的乘法链，充分利用乘法器流水线
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+            do
+            {
+                seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+                see1 = hash_mix(hash_read8(p + 16) ^ hash_secret[2], hash_read8(p + 24) ^ see1);
+                see2 = hash_mix(hash_read8(p + 32) ^ hash_secret[3], hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // 最后16字节可能与已处理部分重叠
+        a = hash_read8(p + i - 16);
+        b = hash_read8(p + i - 8);
+    }
+
+    a ^= hash_secret[1];
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mix(a ^ hash_secret[0] ^ len, b ^ hash_secret[1]);
+}
+
+// 64位整数混合（SplitMix64终结函数）
+uint64_t hash_u64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+// 带种子的64位整数哈希
+uint64_t hash_u64_seeded(uint64_t x, uint64_t seed)
+{
+    return hash_mix(x ^ hash_secret[0], seed ^ hash_secret[1]);
+}
+
+// 32位整数混合（MurmurHash3终结函数）
+uint32_t hash_u32(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+// 组合哈希值
+uint64_t hash_combine(uint64_t seed, uint64_t value)
+{
+    return hash_mix(seed ^ hash_secret[2], value ^ hash_secret[3]);
+}
+
+// 生成随机种子
+uint64_t hash_random_seed(void)
+{
+    static uint64_t counter;
+    uint64_t seed = 0;
+
+    FILE *fp = fopen("/dev/urandom", "rb");
+    if (fp != NULL)
+    {
+        size_t got = fread(&seed, 1, sizeof(seed), fp);
+        fclose(fp);
+        if (got == sizeof(seed))
+        {
+            return seed;
+        }
+    }
+
+    // 没有系统随机源时混合时间、地址与调用次数
+    uint64_t local = 0;
+    seed = hash_combine((uint64_t)time(NULL), (uint64_t)clock());
+    seed = hash_combine(seed, (uint64_t)(uintptr_t)&local);
+    seed = hash_combine(seed, ++counter);
+    return seed;
+}
+
+// 批量接口生效的指令集级别，-1表示尚未检测，原子访问
+static int hash_simd_state = -1;
+
+static hash_simd_t hash_simd_detect(void)
+{
+#if defined(HASH_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+    {
+        return HASH_SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return HASH_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return HASH_SIMD_SSE41;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return HASH_SIMD_SSE2;
+    }
+#endif
+    return HASH_SIMD_NONE;
+}
+
+// 批量接口当前使用的指令集，首次调用时检测CPU
+hash_simd_t hash_simd_level(void)
+{
+    int level = __atomic_load_n(&hash_simd_state, __ATOMIC_RELAXED);
+    if (level < 0)
+    {
+        level = (int)hash_simd_detect();
+        __atomic_store_n(&hash_simd_state, level, __ATOMIC_RELAXED);
+    }
+    return (hash_simd_t)level;
+}
+
+// 限制批量接口使用的指令集，不超过CPU支持的级别，返回实际生效的级别
+hash_simd_t hash_set_simd_level(hash_simd_t level)
+{
+    hash_simd_t supported = hash_simd_detect();
+    if (level > supported)
+    {
+        level = supported;
+    }
+    __atomic_store_n(&hash_simd_state, (int)level, __ATOMIC_RELAXED);
+    return level;
+}
+
+// 无64位向量乘法时四路展开，让多条乘法链并行执行
+static void hash_u64_bulk_scalar(const uint64_t *keys, size_t count, uint64_t *out)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        uint64_t x0 = hash_u64(keys[i]);
+        uint64_t x1 = hash_u64(keys[i + 1]);
+        uint64_t x2 = hash_u64(keys[i + 2]);
+        uint64_t x3 = hash_u64(keys[i + 3]);
+        out[i] = x0;
+        out[i + 1] = x1;
+        out[i + 2] = x2;
+        out[i + 3] = x3;
+    }
+    for (; i < count; i++)
+    {
+        out[i] = hash_u64(keys[i]);
+    }
+}
+
+static void hash_u32_bulk_scalar(const uint32_t *keys, size_t count, uint32_t *out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = hash_u32(keys[i]);
+    }
+}
+
+#if defined(HASH_X86_DISPATCH)
+__attribute__((target("avx512f,avx512dq")))
+static void hash_u64_bulk_avx512(const uint64_t *keys, size_t count, uint64_t *out)
+{
+    const __m512i m1 = _mm512_set1_epi64((long long)0xBF58476D1CE4E5B9ull);
+    const __m512i m2 = _mm512_set1_epi64((long long)0x94D049BB133111EBull);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512i x = _mm512_loadu_si512((const void *)(keys + i));
+        x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 30));
+        x = _mm512_mullo_epi64(x, m1);
+        x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 27));
+        x = _mm512_mullo_epi64(x, m2);
+        x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 31));
+        _mm512_storeu_si512((void *)(out + i), x);
+    }
+    hash_u64_bulk_scalar(keys + i, count - i, out + i);
+}
+
+// AVX2没有64位低位乘法，由三次32x32->64位乘法拼出：
+// x*m mod 2^64 = xl*ml + ((xh*ml + xl*mh) << 32)
+__attribute__((target("avx2")))
+static inline __m256i hash_mullo_epi64_avx2(__m256i x, __m256i m_lo, __m256i m_hi)
+{
+    __m256i low = _mm256_mul_epu32(x, m_lo);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), m_lo), _mm256_mul_epu32(x, m_hi));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+static void hash_u64_bulk_avx2(const uint64_t *keys, size_t count, uint64_t *out)
+{
+    const __m256i m1_lo = _mm256_set1_epi64x(0x1CE4E5B9ll);
+    const __m256i m1_hi = _mm256_set1_epi64x(0xBF58476Dll);
+    const __m256i m2_lo = _mm256_set1_epi64x(0x133111EBll);
+    const __m256i m2_hi = _mm256_set1_epi64x(0x94D049BBll);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(keys + i));
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 30));
+        x = hash_mullo_epi64_avx2(x, m1_lo, m1_hi);
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 27));
+        x = hash_mullo_epi64_avx2(x, m2_lo, m2_hi);
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 31));
+        _mm256_storeu_si256((__m256i *)(out + i), x);
+    }
+    hash_u64_bulk_scalar(keys + i, count - i, out + i);
+}
+
+__attribute__((target("avx2")))
+static void hash_u32_bulk_avx2(const uint32_t *keys, size_t count, uint32_t *out)
+{
+    const __m256i m1 = _mm256_set1_epi32((int)0x85EBCA6Bu);
+    const __m256i m2 = _mm256_set1_epi32((int)0xC2B2AE35u);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(keys + i));
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+        x = _mm256_mullo_epi32(x, m1);
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 13));
+        x = _mm256_mullo_epi32(x, m2);
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+        _mm256_storeu_si256((__m256i *)(out + i), x);
+    }
+    hash_u32_bulk_scalar(keys + i, count - i, out + i);
+}
+
+__attribute__((target("sse4.1")))
+static void hash_u32_bulk_sse41(const uint32_t *keys, size_t count, uint32_t *out)
+{
+    const __m128i m1 = _mm_set1_epi32((int)0x85EBCA6Bu);
+    const __m128i m2 = _mm_set1_epi32((int)0xC2B2AE35u);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(keys + i));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+        x = _mm_mullo_epi32(x, m1);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 13));
+        x = _mm_mullo_epi32(x, m2);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+        _mm_storeu_si128((__m128i *)(out + i), x);
+    }
+    hash_u32_bulk_scalar(keys + i, count - i, out + i);
+}
+
+// SSE2没有32位低位乘法：奇偶两组各用一次_mm_mul_epu32，再取各64位积的低32位拼回
+__attribute__((target("sse2")))
+static inline __m128i hash_mullo_epi32_sse2(__m128i x, __m128i m)
+{
+    __m128i even = _mm_mul_epu32(x, m);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(m, 32));
+    even = _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0));
+    odd = _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0));
+    return _mm_unpacklo_epi32(even, odd);
+}
+
+__attribute__((target("sse2")))
+static void hash_u32_bulk_sse2(const uint32_t *keys, size_t count, uint32_t *out)
+{
+    const __m128i m1 = _mm_set1_epi32((int)0x85EBCA6Bu);
+    const __m128i m2 = _mm_set1_epi32((int)0xC2B2AE35u);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(keys + i));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+        x = hash_mullo_epi32_sse2(x, m1);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 13));
+        x = hash_mullo_epi32_sse2(x, m2);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+        _mm_storeu_si128((__m128i *)(out + i), x);
+    }
+    hash_u32_bulk_scalar(keys + i, count - i, out + i);
+}
+#endif
+
+// 批量64位整数混合
+// 两路的SSE2拼乘法不比标量快，SSE2/SSE4.1级别用展开的标量循环
+void hash_u64_bulk(const uint64_t *keys, size_t count, uint64_t *out)
+{
+#if defined(HASH_X86_DISPATCH)
+    switch (hash_simd_level())
+    {
+    case HASH_SIMD_AVX512:
+        hash_u64_bulk_avx512(keys, count, out);
+        return;
+    case HASH_SIMD_AVX2:
+        hash_u64_bulk_avx2(keys, count, out);
+        return;
+    default:
+        break;
+    }
+#endif
+    hash_u64_bulk_scalar(keys, count, out);
+}
+
+// 批量32位整数混合
+void hash_u32_bulk(const uint32_t *keys, size_t count, uint32_t *out)
+{
+#if defined(HASH_X86_DISPATCH)
+    switch (hash_simd_level())
+    {
+    case HASH_SIMD_AVX512:
+    case HASH_SIMD_AVX2:
+        hash_u32_bulk_avx2(keys, count, out);
+        return;
+    case HASH_SIMD_SSE41:
+        hash_u32_bulk_sse41(keys, count, out);
+        return;
+    case HASH_SIMD_SSE2:
+        hash_u32_bulk_sse2(keys, count, out);
+        return;
+    default:
+        break;
+    }
+#endif
+    hash_u32_bulk_scalar(keys, count, out);
+}
+
+// 批量定长字节串哈希
+void hash_bytes_bulk(const void *keys, size_t key_len, size_t count, uint64_t seed, uint64_t *out)
+{
+    const uint8_t *p = (const uint8_t *)keys;
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = hash_bytes_seeded(p + i * key_len, key_len, seed);
+    }
+}
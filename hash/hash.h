@@ -0,0 +1,52 @@
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 哈希函数
+// hash_bytes：任意字节串的64位哈希，采用wyhash的结构：
+// 每16字节只需一次64x64->128位乘法，短键与长键都很快。
+// hash_u64/hash_u32：整数混合函数，均为双射，适合整数键与哈希值再混合。
+// 带seed的版本在种子未知时无法预先构造大量冲突键，
+// 面向不可信输入的哈希表应使用hash_random_seed()生成的种子。
+// 批量接口对整数键数组使用SIMD，结果与逐个调用相同。x86上不依赖编译选项，
+// 运行时按CPU选择：hash_u64_bulk依次尝试AVX-512DQ与AVX2（其余为展开的标量循环），
+// hash_u32_bulk依次尝试AVX2、SSE4.1与SSE2。
+
+// 批量接口使用的指令集级别
+typedef enum hash_simd
+{
+    HASH_SIMD_NONE,     // 标量
+    HASH_SIMD_SSE2,
+    HASH_SIMD_SSE41,
+    HASH_SIMD_AVX2,
+    HASH_SIMD_AVX512,   // AVX-512F与AVX-512DQ
+} hash_simd_t;
+
+// 任意字节串
+uint64_t hash_bytes(const void *data, size_t len);
+uint64_t hash_bytes_seeded(const void *data, size_t len, uint64_t seed);
+
+// 整数混合函数
+uint64_t hash_u64(uint64_t x);
+uint64_t hash_u64_seeded(uint64_t x, uint64_t seed);
+uint32_t hash_u32(uint32_t x);
+// 将value合入已有哈希值seed，用于组合多个字段
+uint64_t hash_combine(uint64_t seed, uint64_t value);
+
+// 生成随机种子（优先读取系统随机源）
+uint64_t hash_random_seed(void);
+
+// 批量哈希：out[i]为第i个键的哈希值
+void hash_u64_bulk(const uint64_t *keys, size_t count, uint64_t *out);
+void hash_u32_bulk(const uint32_t *keys, size_t count, uint32_t *out);
+// count个连续存放、每个key_len字节的定长键
+void hash_bytes_bulk(const void *keys, size_t key_len, size_t count, uint64_t seed, uint64_t *out);
+
+// 批量接口当前使用的指令集；hash_set_simd_level限制其上限（用于测试与对比），
+// 不超过CPU支持的级别，返回实际生效的级别
+hash_simd_t hash_simd_level(void);
+hash_simd_t hash_set_simd_level(hash_simd_t level);
+
+#endif // __HASH_H__
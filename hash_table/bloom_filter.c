@@ -0,0 +1,345 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "bloom_filter.h"
+#include "hash/hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// 序列化头："BLF1"、k、块数、键数
+#define BF_MAGIC 0x31464C42u
+#define BF_HEADER_SIZE 24
+// 分块造成的额外误判按多分配的位数补偿：目标误判率每降低一个数量级多分配5%
+#define BF_BLOCK_OVERHEAD 0.05
+// 批量查询预取的提前量
+#define BF_PREFETCH_DISTANCE 8
+#define BF_LN2 0.69314718055994530942
+
+static size_t bf_block_of(bloom_filter_t *bf, uint64_t hash)
+{
+    // 高32位按块数等比缩放，避免取模
+    return (size_t)(((hash >> 32) * (uint64_t)bf->block_count) >> 32);
+}
+
+// 由低32位生成块内的k个位，按字合成掩码
+static void bf_masks(uint32_t hashes, uint64_t hash, uint64_t masks[BF_BLOCK_WORDS])
+{
+    uint32_t h = (uint32_t)hash;
+    for (size_t w = 0; w < BF_BLOCK_WORDS; w++)
+    {
+        masks[w] = 0;
+    }
+    for (uint32_t i = 0; i < hashes; i++)
+    {
+        h *= 0x9E3779B1u;
+        uint32_t bit = h >> 23;
+        masks[bit >> 6] |= 1ull << (bit & 63);
+    }
+}
+
+// 序列化的整数按小端逐字节读写，与主机字节序无关；小端主机上编译为单条读写
+static void bf_put_u32(uint8_t *p, uint32_t v)
+{
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void bf_put_u64(uint8_t *p, uint64_t v)
+{
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t bf_get_u32(const uint8_t *p)
+{
+    uint32_t v = 0;
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        v |= (uint32_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static uint64_t bf_get_u64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        v |= (uint64_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static bloom_filter_t *bf_alloc(size_t block_count, uint32_t hashes)
+{
+    if (block_count == 0 || block_count > UINT32_MAX || hashes == 0 || hashes > BF_MAX_HASHES)
+    {
+        return NULL;
+    }
+
+    bloom_filter_t *bf = (bloom_filter_t *)malloc(sizeof(bloom_filter_t));
+    if (bf == NULL)
+    {
+        return NULL;
+    }
+    void *mem = NULL;
+    if (posix_memalign(&mem, 64, block_count * BF_BLOCK_WORDS * sizeof(uint64_t)) != 0)
+    {
+        free(bf);
+        return NULL;
+    }
+    bf->words = (uint64_t *)mem;
+    bf->block_count = block_count;
+    bf->hashes = hashes;
+    bf_clear(bf);
+    return bf;
+}
+
+// 创建过滤器，expected为预计键数，fpr为目标误判率（0~1之间）
+bloom_filter_t *bf_create(size_t expected, double fpr)
+{
+    if (expected == 0 || !(fpr > 0.0 && fpr < 1.0))
+    {
+        return NULL;
+    }
+
+    // 标准布隆过滤器：每键-ln(p)/ln²2位，k取每键位数*ln2
+    double bits_per_key = -log(fpr) / (BF_LN2 * BF_LN2);
+    uint32_t hashes = (uint32_t)(bits_per_key * BF_LN2 + 0.5);
+    if (hashes < 1)
+    {
+        hashes = 1;
+    }
+    if (hashes > BF_MAX_HASHES)
+    {
+        hashes = BF_MAX_HASHES;
+    }
+
+    double overhead = 1.0 - BF_BLOCK_OVERHEAD * log10(fpr);
+    double bits = bits_per_key * overhead * (double)expected;
+    size_t block_count = (size_t)ceil(bits / BF_BLOCK_BITS);
+    return bf_alloc(block_count == 0 ? 1 : block_count, hashes);
+}
+
+// 销毁过滤器
+void bf_destroy(bloom_filter_t *bf)
+{
+    if (bf == NULL)
+    {
+        return;
+    }
+    free(bf->words);
+    free(bf);
+}
+
+// 清空过滤器
+void bf_clear(bloom_filter_t *bf)
+{
+    if (bf == NULL)
+    {
+        return;
+    }
+    memset(bf->words, 0, bf->block_count * BF_BLOCK_WORDS * sizeof(uint64_t));
+    bf->count = 0;
+}
+
+// 获取已添加的键数
+size_t bf_count(bloom_filter_t *bf)
+{
+    if (bf == NULL)
+    {
+        return 0;
+    }
+    return bf->count;
+}
+
+// 获取位数组大小（位）
+size_t bf_bits(bloom_filter_t *bf)
+{
+    if (bf == NULL)
+    {
+        return 0;
+    }
+    return bf->block_count * BF_BLOCK_BITS;
+}
+
+// 获取每个键设置的位数
+uint32_t bf_hash_count(bloom_filter_t *bf)
+{
+    if (bf == NULL)
+    {
+        return 0;
+    }
+    return bf->hashes;
+}
+
+// 添加字节串键
+void bf_add(bloom_filter_t *bf, const void *key, size_t len)
+{
+    if (bf == NULL)
+    {
+        return;
+    }
+    bf_add_hash(bf, hash_bytes(key, len));
+}
+
+// 查询字节串键，返回false时一定不存在
+bool bf_contains(bloom_filter_t *bf, const void *key, size_t len)
+{
+    if (bf == NULL)
+    {
+        return false;
+    }
+    return bf_contains_hash(bf, hash_bytes(key, len));
+}
+
+// 按哈希值添加
+void bf_add_hash(bloom_filter_t *bf, uint64_t hash)
+{
+    if (bf == NULL)
+    {
+        return;
+    }
+
+    uint64_t masks[BF_BLOCK_WORDS];
+    uint64_t *block = bf->words + bf_block_of(bf, hash) * BF_BLOCK_WORDS;
+    bf_masks(bf->hashes, hash, masks);
+    for (size_t w = 0; w < BF_BLOCK_WORDS; w++)
+    {
+        block[w] |= masks[w];
+    }
+    bf->count++;
+}
+
+// 按哈希值查询
+bool bf_contains_hash(bloom_filter_t *bf, uint64_t hash)
+{
+    if (bf == NULL)
+    {
+        return false;
+    }
+
+    uint64_t masks[BF_BLOCK_WORDS];
+    const uint64_t *block = bf->words + bf_block_of(bf, hash) * BF_BLOCK_WORDS;
+    bf_masks(bf->hashes, hash, masks);
+    // 不提前退出，八个字的判断没有分支
+    uint64_t missing = 0;
+    for (size_t w = 0; w < BF_BLOCK_WORDS; w++)
+    {
+        missing |= masks[w] & ~block[w];
+    }
+    return missing == 0;
+}
+
+// 批量添加哈希值
+void bf_add_bulk(bloom_filter_t *bf, const uint64_t *hashes, size_t count)
+{
+    if (bf == NULL || hashes == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i + BF_PREFETCH_DISTANCE < count)
+        {
+            __builtin_prefetch(bf->words + bf_block_of(bf, hashes[i + BF_PREFETCH_DISTANCE]) * BF_BLOCK_WORDS, 1);
+        }
+        bf_add_hash(bf, hashes[i]);
+    }
+}
+
+// 批量查询，out[i]为第i个哈希值的结果（out可为NULL），返回可能存在的个数
+// 提前预取后续键所在的块，使多次缓存未命中重叠
+size_t bf_contains_bulk(bloom_filter_t *bf, const uint64_t *hashes, size_t count, bool *out)
+{
+    if (bf == NULL || hashes == NULL)
+    {
+        return 0;
+    }
+
+    size_t positives = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i + BF_PREFETCH_DISTANCE < count)
+        {
+            __builtin_prefetch(bf->words + bf_block_of(bf, hashes[i + BF_PREFETCH_DISTANCE]) * BF_BLOCK_WORDS, 0);
+        }
+        bool found = bf_contains_hash(bf, hashes[i]);
+        positives += found;
+        if (out != NULL)
+        {
+            out[i] = found;
+        }
+    }
+    return positives;
+}
+
+// 获取序列化所需的字节数
+size_t bf_serialized_size(bloom_filter_t *bf)
+{
+    if (bf == NULL)
+    {
+        return 0;
+    }
+    return BF_HEADER_SIZE + bf->block_count * BF_BLOCK_WORDS * sizeof(uint64_t);
+}
+
+// 序列化到buf，返回写入的字节数，空间不足返回0
+size_t bf_serialize(bloom_filter_t *bf, void *buf, size_t len)
+{
+    size_t size = bf_serialized_size(bf);
+    if (bf == NULL || buf == NULL || len < size)
+    {
+        return 0;
+    }
+
+    uint8_t *p = (uint8_t *)buf;
+    bf_put_u32(p, BF_MAGIC);
+    bf_put_u32(p + 4, bf->hashes);
+    bf_put_u64(p + 8, bf->block_count);
+    bf_put_u64(p + 16, bf->count);
+    size_t words = bf->block_count * BF_BLOCK_WORDS;
+    for (size_t i = 0; i < words; i++)
+    {
+        bf_put_u64(p + BF_HEADER_SIZE + i * sizeof(uint64_t), bf->words[i]);
+    }
+    return size;
+}
+
+// 从buf反序列化出新的过滤器，格式错误返回NULL
+bloom_filter_t *bf_deserialize(const void *buf, size_t len)
+{
+    if (buf == NULL || len < BF_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    const uint8_t *p = (const uint8_t *)buf;
+    if (bf_get_u32(p) != BF_MAGIC)
+    {
+        return NULL;
+    }
+    uint64_t block_count = bf_get_u64(p + 8);
+    if (block_count == 0 || block_count > (len - BF_HEADER_SIZE) / (BF_BLOCK_WORDS * sizeof(uint64_t)) ||
+        len != BF_HEADER_SIZE + block_count * BF_BLOCK_WORDS * sizeof(uint64_t))
+    {
+        return NULL;
+    }
+
+    bloom_filter_t *bf = bf_alloc((size_t)block_count, bf_get_u32(p + 4));
+    if (bf == NULL)
+    {
+        return NULL;
+    }
+    size_t words = bf->block_count * BF_BLOCK_WORDS;
+    for (size_t i = 0; i < words; i++)
+    {
+        bf->words[i] = bf_get_u64(p + BF_HEADER_SIZE + i * sizeof(uint64_t));
+    }
+    bf->count = (size_t)bf_get_u64(p + 16);
+    return bf;
+}
@@ -0,0 +1,49 @@
+#ifndef __BLOOM_FILTER_H__
+#define __BLOOM_FILTER_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 分块布隆过滤器
+// 位数组按512位（一条缓存行）分块，每个键的k个位全部落在同一块内，
+// 添加和查询都只访问一条缓存行。块内分布不如标准布隆过滤器均匀，
+// 因此按目标误判率计算出的位数会多分配一些以抵消。
+// 只会误报（返回"可能存在"），不会漏报；不支持删除。
+// 可以直接传入字节串，也可以传入调用方算好的64位哈希值（须分布均匀，
+// 如hash/hash.h中的函数结果）；批量接口只接受哈希值，配合hash_*_bulk使用。
+// 序列化格式中的整数与位数组的字都按小端存储，与主机字节序无关，可跨进程、跨平台保存与加载。
+
+// 每块的位数与64位字数
+#define BF_BLOCK_BITS 512
+#define BF_BLOCK_WORDS (BF_BLOCK_BITS / 64)
+// 每个键设置的位数上限
+#define BF_MAX_HASHES 16
+
+typedef struct bloom_filter
+{
+    uint64_t *words;        // block_count * BF_BLOCK_WORDS个字，按缓存行对齐
+    size_t block_count;
+    uint32_t hashes;        // 每个键设置的位数k
+    size_t count;           // 已添加的键数（重复添加也计数）
+} bloom_filter_t;
+
+bloom_filter_t *bf_create(size_t expected, double fpr);
+void bf_destroy(bloom_filter_t *bf);
+void bf_clear(bloom_filter_t *bf);
+size_t bf_count(bloom_filter_t *bf);
+size_t bf_bits(bloom_filter_t *bf);
+uint32_t bf_hash_count(bloom_filter_t *bf);
+
+void bf_add(bloom_filter_t *bf, const void *key, size_t len);
+bool bf_contains(bloom_filter_t *bf, const void *key, size_t len);
+void bf_add_hash(bloom_filter_t *bf, uint64_t hash);
+bool bf_contains_hash(bloom_filter_t *bf, uint64_t hash);
+void bf_add_bulk(bloom_filter_t *bf, const uint64_t *hashes, size_t count);
+size_t bf_contains_bulk(bloom_filter_t *bf, const uint64_t *hashes, size_t count, bool *out);
+
+size_t bf_serialized_size(bloom_filter_t *bf);
+size_t bf_serialize(bloom_filter_t *bf, void *buf, size_t len);
+bloom_filter_t *bf_deserialize(const void *buf, size_t len);
+
+#endif // __BLOOM_FILTER_H__
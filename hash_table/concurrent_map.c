@@ -0,0 +1,452 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "concurrent_map.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CM_MIN_CAPACITY CM_STRIPES
+
+// 混合调用方哈希值，低位同时决定桶和分段锁
+static size_t cm_mix(size_t hash)
+{
+    uint64_t h = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h ^ (h >> 32));
+}
+
+static pthread_mutex_t *cm_stripe_lock(concurrent_map_t *cm, size_t mixed)
+{
+    return &cm->stripes[mixed & (CM_STRIPES - 1)].lock;
+}
+
+static cm_table_t *cm_table_alloc(size_t capacity)
+{
+    cm_table_t *table = (cm_table_t *)calloc(1, sizeof(cm_table_t) + capacity * sizeof(cm_node_t *));
+    if (table != NULL)
+    {
+        table->mask = capacity - 1;
+    }
+    return table;
+}
+
+// 释放桶数组及其中的全部节点（不含next指向的新表）
+static void cm_table_free(cm_table_t *table)
+{
+    for (size_t b = 0; b <= table->mask; b++)
+    {
+        cm_node_t *node = table->buckets[b];
+        while (node != NULL)
+        {
+            cm_node_t *next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+    free(table);
+}
+
+// 纪元回收回调：迁移完成的旧表中的节点都已复制到新表，整表一次释放
+static void cm_table_release(void *ptr, void *arg)
+{
+    (void)arg;
+    cm_table_free((cm_table_t *)ptr);
+}
+
+// 桶b是否已迁移到table->next
+static bool cm_moved(cm_table_t *table, size_t b)
+{
+    return b / CM_STRIPES < __atomic_load_n(&table->moved[b & (CM_STRIPES - 1)], __ATOMIC_ACQUIRE);
+}
+
+// 键当前所在的表：从table开始，所在的桶已迁移时转到新表
+static cm_table_t *cm_resolve(cm_table_t *table, size_t mixed)
+{
+    for (;;)
+    {
+        cm_table_t *next = __atomic_load_n(&table->next, __ATOMIC_ACQUIRE);
+        if (next == NULL || !cm_moved(table, mixed & table->mask))
+        {
+            return table;
+        }
+        table = next;
+    }
+}
+
+// 把旧桶b的链复制到新表的桶b与b+旧桶数（调用方持有b所在分段的锁）
+// 旧链保持不变，仍在其上遍历的读线程不受影响；内存不足时不修改新表并返回false
+static bool cm_migrate_bucket(cm_table_t *old, cm_table_t *table, size_t b)
+{
+    cm_node_t *heads[2] = {NULL, NULL};
+    for (cm_node_t *node = old->buckets[b]; node != NULL; node = node->next)
+    {
+        cm_node_t *copy = (cm_node_t *)malloc(sizeof(cm_node_t));
+        if (copy == NULL)
+        {
+            for (size_t i = 0; i < 2; i++)
+            {
+                while (heads[i] != NULL)
+                {
+                    cm_node_t *next = heads[i]->next;
+                    free(heads[i]);
+                    heads[i] = next;
+                }
+            }
+            return false;
+        }
+        *copy = *node;
+        size_t half = (copy->hash & table->mask) != b;
+        copy->next = heads[half];
+        heads[half] = copy;
+    }
+    // 新桶此前不可达，普通写即可；之后moved的释放写保证读线程看到完整的链
+    table->buckets[b] = heads[0];
+    table->buckets[b + old->mask + 1] = heads[1];
+    return true;
+}
+
+// 扩容：分配两倍大小的新表经旧表的next发布，再逐个分段迁移
+// 每次只持有一个分段的锁迁移至多CM_MIGRATE_BATCH个桶，其他分段的写不受影响，
+// 同一分段的写至多等待一批；全部迁移后切换当前表，不持有任何分段锁
+// observed为调用方看到的当前表桶数；与当前表不同说明已被其他线程扩容。
+// 内存不足时保持已迁移的部分，下次扩容从中断处继续
+static void cm_grow(concurrent_map_t *cm, size_t observed)
+{
+    if (__atomic_load_n(&cm->growing, __ATOMIC_RELAXED) || pthread_mutex_trylock(&cm->grow_lock) != 0)
+    {
+        return;
+    }
+    __atomic_store_n(&cm->growing, true, __ATOMIC_RELAXED);
+
+    // 当前表只在持有grow_lock时切换，这里读到的旧表不会被回收
+    cm_table_t *old = __atomic_load_n(&cm->table, __ATOMIC_ACQUIRE);
+    cm_table_t *table = old->next;
+    bool ok = old->mask + 1 == observed;
+    if (ok && table == NULL)
+    {
+        table = cm_table_alloc(observed * 2);
+        ok = table != NULL;
+        if (ok)
+        {
+            __atomic_store_n(&old->next, table, __ATOMIC_RELEASE);
+        }
+    }
+
+    size_t rows = observed / CM_STRIPES;
+    for (size_t s = 0; ok && s < CM_STRIPES; s++)
+    {
+        pthread_mutex_t *lock = &cm->stripes[s].lock;
+        size_t row = old->moved[s];
+        while (ok && row < rows)
+        {
+            pthread_mutex_lock(lock);
+            size_t end = row + CM_MIGRATE_BATCH < rows ? row + CM_MIGRATE_BATCH : rows;
+            for (; row < end; row++)
+            {
+                if (!cm_migrate_bucket(old, table, row * CM_STRIPES + s))
+                {
+                    ok = false;
+                    break;
+                }
+            }
+            __atomic_store_n(&old->moved[s], row, __ATOMIC_RELEASE);
+            pthread_mutex_unlock(lock);
+        }
+    }
+
+    if (ok)
+    {
+        // 仍拿着旧表的读写线程经已全部迁移的桶转到新表，旧表由纪元回收保护
+        __atomic_store_n(&cm->table, table, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&cm->growing, false, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&cm->grow_lock);
+
+    if (ok)
+    {
+        ebr_retire_with(&cm->ebr, old, cm_table_release, NULL);
+    }
+}
+
+// 插入，replace为false时键已存在则不修改并返回false
+static bool cm_insert(concurrent_map_t *cm, void *key, void *value, bool replace)
+{
+    size_t mixed = cm_mix(cm->hash(key));
+    pthread_mutex_t *lock = cm_stripe_lock(cm, mixed);
+
+    // 写线程同样处于读临界区中，拿着的表在切换后不会被立即回收；
+    // 桶的迁移持有该分段的锁，持锁期间键所在的表不变
+    ebr_guard_t guard = ebr_enter(&cm->ebr);
+    pthread_mutex_lock(lock);
+    cm_table_t *current = __atomic_load_n(&cm->table, __ATOMIC_ACQUIRE);
+    cm_table_t *table = cm_resolve(current, mixed);
+    cm_node_t **bucket = &table->buckets[mixed & table->mask];
+
+    for (cm_node_t *node = *bucket; node != NULL; node = node->next)
+    {
+        if (node->hash == mixed && cm->cmp(node->key, key) == 0)
+        {
+            if (replace)
+            {
+                __atomic_store_n(&node->value, value, __ATOMIC_RELEASE);
+            }
+            pthread_mutex_unlock(lock);
+            ebr_exit(&cm->ebr, guard);
+            return replace;
+        }
+    }
+
+    cm_node_t *node = (cm_node_t *)malloc(sizeof(cm_node_t));
+    if (node == NULL)
+    {
+        pthread_mutex_unlock(lock);
+        ebr_exit(&cm->ebr, guard);
+        return false;
+    }
+    node->key = key;
+    node->value = value;
+    node->hash = mixed;
+    node->next = *bucket;
+    // 节点内容先于链入对读线程可见
+    __atomic_store_n(bucket, node, __ATOMIC_RELEASE);
+    // 退出读临界区后当前表可能被其他线程切换并回收，不能再访问current
+    size_t buckets = current->mask + 1;
+    pthread_mutex_unlock(lock);
+    ebr_exit(&cm->ebr, guard);
+
+    size_t size = __atomic_add_fetch(&cm->size, 1, __ATOMIC_RELAXED);
+    if (size > buckets * CM_MAX_LOAD)
+    {
+        cm_grow(cm, buckets);
+    }
+    return true;
+}
+
+// 创建并发哈希表
+concurrent_map_t *cm_create(cm_hash_fn hash, cm_cmp_fn cmp)
+{
+    if (hash == NULL || cmp == NULL)
+    {
+        return NULL;
+    }
+
+    void *mem = NULL;
+    if (posix_memalign(&mem, 64, sizeof(concurrent_map_t)) != 0)
+    {
+        return NULL;
+    }
+    concurrent_map_t *cm = (concurrent_map_t *)mem;
+    memset(cm, 0, sizeof(concurrent_map_t));
+
+    cm->table = cm_table_alloc(CM_MIN_CAPACITY);
+    if (cm->table == NULL)
+    {
+        free(cm);
+        return NULL;
+    }
+    cm->hash = hash;
+    cm->cmp = cmp;
+    pthread_mutex_init(&cm->grow_lock, NULL);
+    for (size_t i = 0; i < CM_STRIPES; i++)
+    {
+        pthread_mutex_init(&cm->stripes[i].lock, NULL);
+    }
+    ebr_init(&cm->ebr);
+    return cm;
+}
+
+// 销毁并发哈希表（不释放键值本身），调用时不得有其他线程访问
+void cm_destroy(concurrent_map_t *cm)
+{
+    if (cm == NULL)
+    {
+        return;
+    }
+
+    // 中断的扩容：旧表中已迁移的桶是旧节点，新表中是它们的副本，两张表都要释放
+    if (cm->table->next != NULL)
+    {
+        cm_table_free(cm->table->next);
+    }
+    cm_table_free(cm->table);
+
+    ebr_destroy(&cm->ebr);
+
+    pthread_mutex_destroy(&cm->grow_lock);
+    for (size_t i = 0; i < CM_STRIPES; i++)
+    {
+        pthread_mutex_destroy(&cm->stripes[i].lock);
+    }
+    free(cm);
+}
+
+// 获取元素个数（并发修改时为近似值）
+size_t cm_size(concurrent_map_t *cm)
+{
+    if (cm == NULL)
+    {
+        return 0;
+    }
+    return __atomic_load_n(&cm->size, __ATOMIC_RELAXED);
+}
+
+// 检查是否为空（并发修改时为近似值）
+bool cm_is_empty(concurrent_map_t *cm)
+{
+    return cm_size(cm) == 0;
+}
+
+// 获取桶数
+size_t cm_capacity(concurrent_map_t *cm)
+{
+    if (cm == NULL)
+    {
+        return 0;
+    }
+    return __atomic_load_n(&cm->table, __ATOMIC_ACQUIRE)->mask + 1;
+}
+
+// 插入或替换
+bool cm_put(concurrent_map_t *cm, void *key, void *value)
+{
+    if (cm == NULL)
+    {
+        return false;
+    }
+    return cm_insert(cm, key, value, true);
+}
+
+// 键不存在时插入并返回true，已存在时不修改并返回false
+bool cm_put_if_absent(concurrent_map_t *cm, void *key, void *value)
+{
+    if (cm == NULL)
+    {
+        return false;
+    }
+    return cm_insert(cm, key, value, false);
+}
+
+// 获取键对应的值，不存在返回NULL
+void *cm_get(concurrent_map_t *cm, void *key)
+{
+    void *value = NULL;
+    cm_find(cm, key, &value);
+    return value;
+}
+
+// 查找键，存在时通过value返回对应的值（不加锁）
+bool cm_find(concurrent_map_t *cm, void *key, void **value)
+{
+    if (cm == NULL)
+    {
+        return false;
+    }
+
+    size_t mixed = cm_mix(cm->hash(key));
+    ebr_guard_t guard = ebr_enter(&cm->ebr);
+    bool found = false;
+
+    cm_table_t *table = cm_resolve(__atomic_load_n(&cm->table, __ATOMIC_ACQUIRE), mixed);
+    cm_node_t *node = __atomic_load_n(&table->buckets[mixed & table->mask], __ATOMIC_ACQUIRE);
+    while (node != NULL)
+    {
+        if (node->hash == mixed && cm->cmp(node->key, key) == 0)
+        {
+            if (value != NULL)
+            {
+                *value = __atomic_load_n(&node->value, __ATOMIC_ACQUIRE);
+            }
+            found = true;
+            break;
+        }
+        node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+    }
+
+    ebr_exit(&cm->ebr, guard);
+    return found;
+}
+
+// 检查键是否存在
+bool cm_contains(concurrent_map_t *cm, void *key)
+{
+    return cm_find(cm, key, NULL);
+}
+
+// 删除键，存在时通过value返回原值
+bool cm_remove(concurrent_map_t *cm, void *key, void **value)
+{
+    if (cm == NULL)
+    {
+        return false;
+    }
+
+    size_t mixed = cm_mix(cm->hash(key));
+    pthread_mutex_t *lock = cm_stripe_lock(cm, mixed);
+
+    ebr_guard_t guard = ebr_enter(&cm->ebr);
+    pthread_mutex_lock(lock);
+    cm_table_t *table = cm_resolve(__atomic_load_n(&cm->table, __ATOMIC_ACQUIRE), mixed);
+    cm_node_t **link = &table->buckets[mixed & table->mask];
+    cm_node_t *node = *link;
+    while (node != NULL && !(node->hash == mixed && cm->cmp(node->key, key) == 0))
+    {
+        link = &node->next;
+        node = *link;
+    }
+    if (node == NULL)
+    {
+        pthread_mutex_unlock(lock);
+        ebr_exit(&cm->ebr, guard);
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = node->value;
+    }
+    // 摘除后node->next保持不变，正在该节点上的读线程仍能继续遍历
+    __atomic_store_n(link, node->next, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(lock);
+    // 退休须在读临界区之外
+    ebr_exit(&cm->ebr, guard);
+
+    __atomic_sub_fetch(&cm->size, 1, __ATOMIC_RELAXED);
+
+    ebr_retire(&cm->ebr, node);
+    return true;
+}
+
+// 访问桶中的键值对，已迁移的桶转到新表中拆分出的两个桶
+static void cm_visit_bucket(cm_table_t *table, size_t b, void (*func)(void *key, void *value))
+{
+    cm_table_t *next = __atomic_load_n(&table->next, __ATOMIC_ACQUIRE);
+    if (next != NULL && cm_moved(table, b))
+    {
+        cm_visit_bucket(next, b, func);
+        cm_visit_bucket(next, b + table->mask + 1, func);
+        return;
+    }
+    cm_node_t *node = __atomic_load_n(&table->buckets[b], __ATOMIC_ACQUIRE);
+    while (node != NULL)
+    {
+        func(node->key, __atomic_load_n(&node->value, __ATOMIC_ACQUIRE));
+        node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+    }
+}
+
+// 遍历所有键值对（顺序不确定，不加锁）
+// 与写操作并发时，遍历开始前已存在且期间未删除的元素保证被访问到
+void cm_foreach(concurrent_map_t *cm, void (*func)(void *key, void *value))
+{
+    if (cm == NULL || func == NULL)
+    {
+        return;
+    }
+
+    ebr_guard_t guard = ebr_enter(&cm->ebr);
+
+    cm_table_t *table = __atomic_load_n(&cm->table, __ATOMIC_ACQUIRE);
+    for (size_t b = 0; b <= table->mask; b++)
+    {
+        cm_visit_bucket(table, b, func);
+    }
+
+    ebr_exit(&cm->ebr, guard);
+}
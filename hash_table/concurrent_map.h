@@ -0,0 +1,78 @@
+#ifndef __CONCURRENT_MAP_H__
+#define __CONCURRENT_MAP_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "sync/ebr.h"
+
+// 并发哈希表（读无锁）
+// 链式桶，读操作只做原子加载，不加任何锁；写操作按哈希值低位选取分段锁，
+// 不同分段的写互不阻塞。桶数为分段数的倍数，旧桶b拆分到的新桶b与b+旧桶数
+// 与b属于同一分段。扩容时旧表经next指向新表，触发扩容的线程逐个分段、
+// 每次持有该分段的锁迁移一小批桶（复制节点，旧链保持不变），
+// 并记录该分段已迁移的桶数；读写操作在旧表中遇到已迁移的桶时转到新表。
+// 全部迁移后才短暂持有全部分段锁切换当前表，旧表连同其中的节点一次性延迟释放。
+// 被删除的节点和旧表通过纪元回收（EBR）延迟释放，保证不会释放仍被读线程访问的内存。
+// 哈希与比较函数约定与hash_table.h相同，且可被多个线程同时调用。
+
+// 分段锁个数（2的幂），桶数不小于该值
+#define CM_STRIPES 64
+// 平均每桶元素数超过该值时扩容
+#define CM_MAX_LOAD 2
+// 扩容时每次持有分段锁迁移的桶数
+#define CM_MIGRATE_BATCH 16
+
+typedef size_t (*cm_hash_fn)(void *key);
+typedef int (*cm_cmp_fn)(void *a, void *b);
+
+typedef struct cm_node
+{
+    struct cm_node *next;   // 原子访问
+    void *key;
+    void *value;            // 原子访问
+    size_t hash;
+} cm_node_t;
+
+typedef struct cm_table
+{
+    size_t mask;            // 桶数-1
+    struct cm_table *next;  // 扩容中的新表，NULL表示未在扩容，原子访问
+    size_t moved[CM_STRIPES];   // 各分段已迁移到新表的桶数（按桶号从小到大），原子访问
+    cm_node_t *buckets[];   // 原子访问
+} cm_table_t;
+
+// 分段锁：独占缓存行，避免伪共享
+typedef struct cm_stripe
+{
+    pthread_mutex_t lock;
+} __attribute__((aligned(64))) cm_stripe_t;
+
+typedef struct concurrent_map
+{
+    cm_table_t *table;      // 当前桶数组，原子访问
+    size_t size;            // 元素个数，原子更新
+    cm_hash_fn hash;
+    cm_cmp_fn cmp;
+    pthread_mutex_t grow_lock;  // 同一时刻只有一个线程迁移
+    bool growing;           // 有线程正在迁移，原子访问
+    cm_stripe_t stripes[CM_STRIPES];
+    ebr_domain_t ebr;       // 被删除节点与旧桶数组的延迟回收
+} concurrent_map_t;
+
+concurrent_map_t *cm_create(cm_hash_fn hash, cm_cmp_fn cmp);
+void cm_destroy(concurrent_map_t *cm);
+size_t cm_size(concurrent_map_t *cm);
+bool cm_is_empty(concurrent_map_t *cm);
+size_t cm_capacity(concurrent_map_t *cm);
+
+bool cm_put(concurrent_map_t *cm, void *key, void *value);
+bool cm_put_if_absent(concurrent_map_t *cm, void *key, void *value);
+void *cm_get(concurrent_map_t *cm, void *key);
+bool cm_find(concurrent_map_t *cm, void *key, void **value);
+bool cm_contains(concurrent_map_t *cm, void *key);
+bool cm_remove(concurrent_map_t *cm, void *key, void **value);
+void cm_foreach(concurrent_map_t *cm, void (*func)(void *key, void *value));
+
+#endif // __CONCURRENT_MAP_H__
@@ -0,0 +1,569 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "cuckoo_filter.h"
+#include "hash/hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// 序列化头："CKF1"、指纹字节数、桶数、键数、victim标志、victim指纹、victim桶号
+#define CF_MAGIC 0x31464B43u
+#define CF_HEADER_SIZE 40
+// 按该装载率估算所需桶数
+#define CF_TARGET_LOAD 0.95
+// 批量查询预取的提前量
+#define CF_PREFETCH_DISTANCE 8
+
+static uint8_t *cf_slot(cuckoo_filter_t *cf, size_t index, size_t slot)
+{
+    return cf->table + (index * CF_BUCKET_SIZE + slot) * cf->fp_bytes;
+}
+
+static uint32_t cf_get(cuckoo_filter_t *cf, size_t index, size_t slot)
+{
+    const uint8_t *p = cf_slot(cf, index, slot);
+    switch (cf->fp_bytes)
+    {
+    case 1:
+        return p[0];
+    case 2:
+    {
+        uint16_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    default:
+    {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    }
+}
+
+static void cf_set(cuckoo_filter_t *cf, size_t index, size_t slot, uint32_t fp)
+{
+    uint8_t *p = cf_slot(cf, index, slot);
+    switch (cf->fp_bytes)
+    {
+    case 1:
+        p[0] = (uint8_t)fp;
+        break;
+    case 2:
+    {
+        uint16_t v = (uint16_t)fp;
+        memcpy(p, &v, sizeof(v));
+        break;
+    }
+    default:
+        memcpy(p, &fp, sizeof(fp));
+        break;
+    }
+}
+
+// 指纹取哈希值高32位，0保留给空槽
+static uint32_t cf_fingerprint(cuckoo_filter_t *cf, uint64_t hash)
+{
+    uint32_t fp = (uint32_t)(hash >> 32);
+    if (cf->fp_bytes < 4)
+    {
+        fp &= (1u << (cf->fp_bytes * 8)) - 1;
+    }
+    return fp == 0 ? 1 : fp;
+}
+
+static size_t cf_index(cuckoo_filter_t *cf, uint64_t hash)
+{
+    return (size_t)hash & (cf->bucket_count - 1);
+}
+
+// 另一个候选桶：异或指纹的哈希，两次运算回到原桶
+static size_t cf_alt_index(cuckoo_filter_t *cf, size_t index, uint32_t fp)
+{
+    return (index ^ (size_t)hash_u32(fp)) & (cf->bucket_count - 1);
+}
+
+// 桶内是否有该指纹：整桶按一个字读出，用"字内有零"技巧一次比较全部槽
+static bool cf_bucket_has(cuckoo_filter_t *cf, size_t index, uint32_t fp)
+{
+    const uint8_t *p = cf_slot(cf, index, 0);
+    switch (cf->fp_bytes)
+    {
+    case 1:
+    {
+        uint32_t word;
+        memcpy(&word, p, sizeof(word));
+        uint32_t x = word ^ (fp * 0x01010101u);
+        return ((x - 0x01010101u) & ~x & 0x80808080u) != 0;
+    }
+    case 2:
+    {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        uint64_t x = word ^ (fp * 0x0001000100010001ull);
+        return ((x - 0x0001000100010001ull) & ~x & 0x8000800080008000ull) != 0;
+    }
+    default:
+        for (size_t s = 0; s < CF_BUCKET_SIZE; s++)
+        {
+            if (cf_get(cf, index, s) == fp)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// 放入桶内空槽
+static bool cf_bucket_put(cuckoo_filter_t *cf, size_t index, uint32_t fp)
+{
+    for (size_t s = 0; s < CF_BUCKET_SIZE; s++)
+    {
+        if (cf_get(cf, index, s) == 0)
+        {
+            cf_set(cf, index, s, fp);
+            return true;
+        }
+    }
+    return false;
+}
+
+// 从桶内删除一个该指纹
+static bool cf_bucket_remove(cuckoo_filter_t *cf, size_t index, uint32_t fp)
+{
+    for (size_t s = 0; s < CF_BUCKET_SIZE; s++)
+    {
+        if (cf_get(cf, index, s) == fp)
+        {
+            cf_set(cf, index, s, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t cf_rand(cuckoo_filter_t *cf)
+{
+    uint64_t x = cf->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    cf->rng = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+// 在index及其候选桶中安置指纹，都满时随机踢出并搬移被踢出的指纹
+// 超过踢出上限时最后手上的指纹存为victim
+static void cf_place(cuckoo_filter_t *cf, size_t index, uint32_t fp)
+{
+    size_t alt = cf_alt_index(cf, index, fp);
+    if (cf_bucket_put(cf, index, fp) || cf_bucket_put(cf, alt, fp))
+    {
+        return;
+    }
+
+    uint64_t r = cf_rand(cf);
+    size_t i = (r & 1) ? index : alt;
+    for (size_t kick = 0; kick < CF_MAX_KICKS; kick++)
+    {
+        size_t slot = (size_t)(cf_rand(cf) >> 32) % CF_BUCKET_SIZE;
+        uint32_t old = cf_get(cf, i, slot);
+        cf_set(cf, i, slot, fp);
+        fp = old;
+        i = cf_alt_index(cf, i, fp);
+        if (cf_bucket_put(cf, i, fp))
+        {
+            return;
+        }
+    }
+    cf->has_victim = true;
+    cf->victim_index = i;
+    cf->victim_fp = fp;
+}
+
+static bool cf_victim_matches(cuckoo_filter_t *cf, size_t i1, size_t i2, uint32_t fp)
+{
+    return cf->has_victim && cf->victim_fp == fp && (cf->victim_index == i1 || cf->victim_index == i2);
+}
+
+// 序列化的整数按小端逐字节读写，与主机字节序无关；小端主机上编译为单条读写
+static void cf_put_u32(uint8_t *p, uint32_t v)
+{
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void cf_put_u64(uint8_t *p, uint64_t v)
+{
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t cf_get_u32(const uint8_t *p)
+{
+    uint32_t v = 0;
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        v |= (uint32_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static uint64_t cf_get_u64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < sizeof(v); i++)
+    {
+        v |= (uint64_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static cuckoo_filter_t *cf_alloc(size_t bucket_count, uint32_t fp_bytes)
+{
+    if (bucket_count == 0 || (bucket_count & (bucket_count - 1)) != 0 ||
+        (fp_bytes != 1 && fp_bytes != 2 && fp_bytes != 4) ||
+        bucket_count > SIZE_MAX / (CF_BUCKET_SIZE * fp_bytes))
+    {
+        return NULL;
+    }
+
+    cuckoo_filter_t *cf = (cuckoo_filter_t *)malloc(sizeof(cuckoo_filter_t));
+    if (cf == NULL)
+    {
+        return NULL;
+    }
+    void *mem = NULL;
+    if (posix_memalign(&mem, 64, bucket_count * CF_BUCKET_SIZE * fp_bytes) != 0)
+    {
+        free(cf);
+        return NULL;
+    }
+    cf->table = (uint8_t *)mem;
+    cf->bucket_count = bucket_count;
+    cf->fp_bytes = fp_bytes;
+    cf_clear(cf);
+    return cf;
+}
+
+// 创建过滤器，expected为预计键数，fpr为目标误判率（0~1之间）
+cuckoo_filter_t *cf_create(size_t expected, double fpr)
+{
+    if (expected == 0 || !(fpr > 0.0 && fpr < 1.0))
+    {
+        return NULL;
+    }
+
+    // 查询最多比较两个桶共8个指纹：误判率约为 8 / 2^f
+    double bits = ceil(log2(2.0 * CF_BUCKET_SIZE / fpr));
+    uint32_t fp_bytes = bits <= 8 ? 1 : (bits <= 16 ? 2 : 4);
+
+    size_t buckets = (size_t)ceil((double)expected / (CF_BUCKET_SIZE * CF_TARGET_LOAD));
+    size_t bucket_count = 1;
+    while (bucket_count < buckets)
+    {
+        bucket_count <<= 1;
+    }
+    return cf_alloc(bucket_count, fp_bytes);
+}
+
+// 销毁过滤器
+void cf_destroy(cuckoo_filter_t *cf)
+{
+    if (cf == NULL)
+    {
+        return;
+    }
+    free(cf->table);
+    free(cf);
+}
+
+// 清空过滤器
+void cf_clear(cuckoo_filter_t *cf)
+{
+    if (cf == NULL)
+    {
+        return;
+    }
+    memset(cf->table, 0, cf->bucket_count * CF_BUCKET_SIZE * cf->fp_bytes);
+    cf->count = 0;
+    cf->rng = 0x9E3779B97F4A7C15ull;
+    cf->has_victim = false;
+    cf->victim_index = 0;
+    cf->victim_fp = 0;
+}
+
+// 获取已添加的键数
+size_t cf_count(cuckoo_filter_t *cf)
+{
+    if (cf == NULL)
+    {
+        return 0;
+    }
+    return cf->count;
+}
+
+// 获取槽位总数
+size_t cf_capacity(cuckoo_filter_t *cf)
+{
+    if (cf == NULL)
+    {
+        return 0;
+    }
+    return cf->bucket_count * CF_BUCKET_SIZE;
+}
+
+// 获取指纹位数
+uint32_t cf_fingerprint_bits(cuckoo_filter_t *cf)
+{
+    if (cf == NULL)
+    {
+        return 0;
+    }
+    return cf->fp_bytes * 8;
+}
+
+// 添加字节串键，过滤器已满返回false
+bool cf_add(cuckoo_filter_t *cf, const void *key, size_t len)
+{
+    if (cf == NULL)
+    {
+        return false;
+    }
+    return cf_add_hash(cf, hash_bytes(key, len));
+}
+
+// 查询字节串键，返回false时一定不存在
+bool cf_contains(cuckoo_filter_t *cf, const void *key, size_t len)
+{
+    if (cf == NULL)
+    {
+        return false;
+    }
+    return cf_contains_hash(cf, hash_bytes(key, len));
+}
+
+// 删除字节串键
+bool cf_remove(cuckoo_filter_t *cf, const void *key, size_t len)
+{
+    if (cf == NULL)
+    {
+        return false;
+    }
+    return cf_remove_hash(cf, hash_bytes(key, len));
+}
+
+// 按哈希值添加，过滤器已满返回false
+// 同一键可重复添加（最多2*CF_BUCKET_SIZE次），每次添加需对应一次删除
+bool cf_add_hash(cuckoo_filter_t *cf, uint64_t hash)
+{
+    if (cf == NULL || cf->has_victim)
+    {
+        return false;
+    }
+    cf_place(cf, cf_index(cf, hash), cf_fingerprint(cf, hash));
+    cf->count++;
+    return true;
+}
+
+// 按哈希值查询
+bool cf_contains_hash(cuckoo_filter_t *cf, uint64_t hash)
+{
+    if (cf == NULL)
+    {
+        return false;
+    }
+
+    uint32_t fp = cf_fingerprint(cf, hash);
+    size_t i1 = cf_index(cf, hash);
+    size_t i2 = cf_alt_index(cf, i1, fp);
+    return cf_bucket_has(cf, i1, fp) || cf_bucket_has(cf, i2, fp) || cf_victim_matches(cf, i1, i2, fp);
+}
+
+// 按哈希值删除
+bool cf_remove_hash(cuckoo_filter_t *cf, uint64_t hash)
+{
+    if (cf == NULL)
+    {
+        return false;
+    }
+
+    uint32_t fp = cf_fingerprint(cf, hash);
+    size_t i1 = cf_index(cf, hash);
+    size_t i2 = cf_alt_index(cf, i1, fp);
+    if (cf_bucket_remove(cf, i1, fp) || cf_bucket_remove(cf, i2, fp))
+    {
+        cf->count--;
+        // 腾出了空槽，尝试重新安置victim
+        if (cf->has_victim)
+        {
+            cf->has_victim = false;
+            cf_place(cf, cf->victim_index, cf->victim_fp);
+        }
+        return true;
+    }
+    if (cf_victim_matches(cf, i1, i2, fp))
+    {
+        cf->has_victim = false;
+        cf->count--;
+        return true;
+    }
+    return false;
+}
+
+// 批量添加哈希值，返回成功添加的个数（已满后其余均失败）
+size_t cf_add_bulk(cuckoo_filter_t *cf, const uint64_t *hashes, size_t count)
+{
+    if (cf == NULL || hashes == NULL)
+    {
+        return 0;
+    }
+
+    size_t added = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i + CF_PREFETCH_DISTANCE < count)
+        {
+            __builtin_prefetch(cf_slot(cf, cf_index(cf, hashes[i + CF_PREFETCH_DISTANCE]), 0), 1);
+        }
+        added += cf_add_hash(cf, hashes[i]);
+    }
+    return added;
+}
+
+// 批量查询，out[i]为第i个哈希值的结果（out可为NULL），返回可能存在的个数
+// 提前预取后续键的两个候选桶，使多次缓存未命中重叠
+size_t cf_contains_bulk(cuckoo_filter_t *cf, const uint64_t *hashes, size_t count, bool *out)
+{
+    if (cf == NULL || hashes == NULL)
+    {
+        return 0;
+    }
+
+    size_t positives = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i + CF_PREFETCH_DISTANCE < count)
+        {
+            uint64_t ahead = hashes[i + CF_PREFETCH_DISTANCE];
+            size_t i1 = cf_index(cf, ahead);
+            __builtin_prefetch(cf_slot(cf, i1, 0), 0);
+            __builtin_prefetch(cf_slot(cf, cf_alt_index(cf, i1, cf_fingerprint(cf, ahead)), 0), 0);
+        }
+        bool found = cf_contains_hash(cf, hashes[i]);
+        positives += found;
+        if (out != NULL)
+        {
+            out[i] = found;
+        }
+    }
+    return positives;
+}
+
+// 获取序列化所需的字节数
+size_t cf_serialized_size(cuckoo_filter_t *cf)
+{
+    if (cf == NULL)
+    {
+        return 0;
+    }
+    return CF_HEADER_SIZE + cf->bucket_count * CF_BUCKET_SIZE * cf->fp_bytes;
+}
+
+// 序列化到buf，返回写入的字节数，空间不足返回0
+size_t cf_serialize(cuckoo_filter_t *cf, void *buf, size_t len)
+{
+    size_t size = cf_serialized_size(cf);
+    if (cf == NULL || buf == NULL || len < size)
+    {
+        return 0;
+    }
+
+    uint8_t *p = (uint8_t *)buf;
+    cf_put_u32(p, CF_MAGIC);
+    cf_put_u32(p + 4, cf->fp_bytes);
+    cf_put_u64(p + 8, cf->bucket_count);
+    cf_put_u64(p + 16, cf->count);
+    cf_put_u32(p + 24, cf->has_victim ? 1 : 0);
+    cf_put_u32(p + 28, cf->victim_fp);
+    cf_put_u64(p + 32, cf->victim_index);
+    // 指纹逐个按小端写出，单字节指纹与字节序无关，直接复制
+    if (cf->fp_bytes == 1)
+    {
+        memcpy(p + CF_HEADER_SIZE, cf->table, size - CF_HEADER_SIZE);
+        return size;
+    }
+    uint8_t *out = p + CF_HEADER_SIZE;
+    for (size_t i = 0; i < cf->bucket_count; i++)
+    {
+        for (size_t slot = 0; slot < CF_BUCKET_SIZE; slot++)
+        {
+            uint32_t fp = cf_get(cf, i, slot);
+            for (uint32_t b = 0; b < cf->fp_bytes; b++)
+            {
+                *out++ = (uint8_t)(fp >> (8 * b));
+            }
+        }
+    }
+    return size;
+}
+
+// 从buf反序列化出新的过滤器，格式错误返回NULL
+cuckoo_filter_t *cf_deserialize(const void *buf, size_t len)
+{
+    if (buf == NULL || len < CF_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    const uint8_t *p = (const uint8_t *)buf;
+    uint32_t fp_bytes = cf_get_u32(p + 4);
+    uint64_t bucket_count = cf_get_u64(p + 8);
+    if (cf_get_u32(p) != CF_MAGIC || (fp_bytes != 1 && fp_bytes != 2 && fp_bytes != 4) || bucket_count == 0 ||
+        bucket_count > (len - CF_HEADER_SIZE) / (CF_BUCKET_SIZE * fp_bytes) ||
+        len != CF_HEADER_SIZE + bucket_count * CF_BUCKET_SIZE * fp_bytes)
+    {
+        return NULL;
+    }
+
+    cuckoo_filter_t *cf = cf_alloc((size_t)bucket_count, fp_bytes);
+    if (cf == NULL)
+    {
+        return NULL;
+    }
+    const uint8_t *in = p + CF_HEADER_SIZE;
+    if (fp_bytes == 1)
+    {
+        memcpy(cf->table, in, len - CF_HEADER_SIZE);
+    }
+    else
+    {
+        for (size_t i = 0; i < cf->bucket_count; i++)
+        {
+            for (size_t slot = 0; slot < CF_BUCKET_SIZE; slot++)
+            {
+                uint32_t fp = 0;
+                for (uint32_t b = 0; b < fp_bytes; b++)
+                {
+                    fp |= (uint32_t)*in++ << (8 * b);
+                }
+                cf_set(cf, i, slot, fp);
+            }
+        }
+    }
+    cf->count = (size_t)cf_get_u64(p + 16);
+    cf->has_victim = cf_get_u32(p + 24) != 0;
+    cf->victim_fp = cf_get_u32(p + 28);
+    cf->victim_index = (size_t)cf_get_u64(p + 32);
+    if (cf->has_victim && (cf->victim_fp == 0 || cf->victim_index >= cf->bucket_count))
+    {
+        cf_destroy(cf);
+        return NULL;
+    }
+    return cf;
+}
@@ -0,0 +1,55 @@
+#ifndef __CUCKOO_FILTER_H__
+#define __CUCKOO_FILTER_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 布谷鸟过滤器
+// 每个键只存一个指纹，放在两个候选桶之一（每桶4个槽），
+// 第二个桶由第一个桶与指纹的哈希异或得到，因此不需要原键即可在两个桶间搬移。
+// 与布隆过滤器相比支持删除，且低误判率时更省空间；代价是可能插入失败：
+// 两个桶都满时随机踢出一个指纹重新安置，踢出次数超过上限即认为已满，
+// 最后一个无处安放的指纹暂存在victim中，之后的插入都返回false。
+// 指纹宽度（8/16/32位）按目标误判率选取，误判率约为 8 / 2^指纹位数。
+// 删除只能删除确实添加过的键，否则可能误删共享同一指纹的其他键。
+// 键与哈希值约定同bloom_filter.h，序列化格式中的整数与指纹都按小端存储，与主机字节序无关。
+
+// 每桶槽数
+#define CF_BUCKET_SIZE 4
+// 插入时最多踢出的次数
+#define CF_MAX_KICKS 500
+
+typedef struct cuckoo_filter
+{
+    uint8_t *table;         // bucket_count * CF_BUCKET_SIZE个指纹，0表示空槽
+    size_t bucket_count;    // 2的幂
+    uint32_t fp_bytes;      // 指纹字节数：1、2或4
+    size_t count;           // 已添加的键数
+    uint64_t rng;           // 选择踢出位置的随机数状态
+    bool has_victim;        // 是否有无处安放的指纹
+    size_t victim_index;
+    uint32_t victim_fp;
+} cuckoo_filter_t;
+
+cuckoo_filter_t *cf_create(size_t expected, double fpr);
+void cf_destroy(cuckoo_filter_t *cf);
+void cf_clear(cuckoo_filter_t *cf);
+size_t cf_count(cuckoo_filter_t *cf);
+size_t cf_capacity(cuckoo_filter_t *cf);
+uint32_t cf_fingerprint_bits(cuckoo_filter_t *cf);
+
+bool cf_add(cuckoo_filter_t *cf, const void *key, size_t len);
+bool cf_contains(cuckoo_filter_t *cf, const void *key, size_t len);
+bool cf_remove(cuckoo_filter_t *cf, const void *key, size_t len);
+bool cf_add_hash(cuckoo_filter_t *cf, uint64_t hash);
+bool cf_contains_hash(cuckoo_filter_t *cf, uint64_t hash);
+bool cf_remove_hash(cuckoo_filter_t *cf, uint64_t hash);
+size_t cf_add_bulk(cuckoo_filter_t *cf, const uint64_t *hashes, size_t count);
+size_t cf_contains_bulk(cuckoo_filter_t *cf, const uint64_t *hashes, size_t count, bool *out);
+
+size_t cf_serialized_size(cuckoo_filter_t *cf);
+size_t cf_serialize(cuckoo_filter_t *cf, void *buf, size_t len);
+cuckoo_filter_t *cf_deserialize(const void *buf, size_t len);
+
+#endif // __CUCKOO_FILTER_H__
@@ -0,0 +1,480 @@
+#include "hash_table.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define HT_MIN_CAPACITY 8
+#define HT_MIN_LOAD 0.1
+#define HT_MAX_LOAD 0.95
+
+// 斐波那契散列：将调用方哈希值的高低位充分混合后取高位作为槽号
+static size_t ht_home(size_t hash, size_t shift)
+{
+    return (size_t)(((uint64_t)hash * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+static size_t ht_threshold(size_t capacity, double max_load)
+{
+    size_t threshold = (size_t)((double)capacity * max_load);
+    return threshold < capacity ? threshold : capacity - 1;
+}
+
+// 满足count个元素所需的槽数，槽数组的字节数会溢出时返回0
+static size_t ht_capacity_for(size_t count, double max_load)
+{
+    size_t capacity = HT_MIN_CAPACITY;
+    while (ht_threshold(capacity, max_load) < count)
+    {
+        if (capacity > SIZE_MAX / 2 / sizeof(ht_entry_t))
+        {
+            return 0;
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static size_t ht_shift_for(size_t capacity)
+{
+    size_t bits = 0;
+    while (((size_t)1 << bits) < capacity)
+    {
+        bits++;
+    }
+    return 64 - bits;
+}
+
+// 将一个条目按Robin Hood规则放入槽数组（调用方保证键不存在且有空位）
+static void ht_place(ht_entry_t *entries, size_t capacity, size_t shift, ht_entry_t entry)
+{
+    size_t mask = capacity - 1;
+    size_t index = ht_home(entry.hash, shift);
+    entry.dist = 1;
+
+    for (;;)
+    {
+        ht_entry_t *slot = &entries[index];
+        if (slot->dist == 0)
+        {
+            *slot = entry;
+            return;
+        }
+        // 劫富济贫：当前槽中元素离家更近，则让位给待插入元素
+        if (slot->dist < entry.dist)
+        {
+            ht_entry_t tmp = *slot;
+            *slot = entry;
+            entry = tmp;
+        }
+        entry.dist++;
+        index = (index + 1) & mask;
+    }
+}
+
+// 在槽数组中查找键，不存在返回NULL
+static ht_entry_t *ht_probe(ht_entry_t *entries, size_t capacity, size_t shift, ht_cmp_fn cmp,
+                            void *key, size_t hash)
+{
+    size_t mask = capacity - 1;
+    size_t index = ht_home(hash, shift);
+
+    for (size_t dist = 1;; dist++)
+    {
+        ht_entry_t *slot = &entries[index];
+        // 遇到空槽或离家更近的元素，说明键不存在
+        if (slot->dist < dist)
+        {
+            return NULL;
+        }
+        if (slot->hash == hash && cmp(slot->key, key) == 0)
+        {
+            return slot;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+// 删除槽：后移回填，把后续离家的元素依次前移一格，直到空槽或已在家的元素
+static void ht_erase(ht_entry_t *entries, size_t capacity, size_t index)
+{
+    size_t mask = capacity - 1;
+    size_t next = (index + 1) & mask;
+    while (entries[next].dist > 1)
+    {
+        entries[index] = entries[next];
+        entries[index].dist--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    entries[index].dist = 0;
+}
+
+// 迁移至多budget个旧槽到新表，全部迁移完后释放旧表
+// 迁移一个槽会后移回填旧表，因此旧表始终是合法的Robin Hood表，
+// 且rehash_index之前的槽都为空
+static void ht_migrate(hash_table_t *ht, size_t budget)
+{
+    while (ht->old_entries != NULL && budget > 0)
+    {
+        if (ht->rehash_index == ht->old_capacity)
+        {
+            free(ht->old_entries);
+            ht->old_entries = NULL;
+            ht->old_capacity = 0;
+            break;
+        }
+
+        ht_entry_t *slot = &ht->old_entries[ht->rehash_index];
+        if (slot->dist == 0)
+        {
+            ht->rehash_index++;
+        }
+        else
+        {
+            ht_place(ht->entries, ht->capacity, ht->shift, *slot);
+            ht_erase(ht->old_entries, ht->old_capacity, ht->rehash_index);
+        }
+        budget--;
+    }
+}
+
+// 插入前的迁移量：至少rehash_step，并保证下次扩容前旧表已迁完
+// 剩余工作量不超过2*(old_capacity-rehash_index)+1（每个旧槽至多放置一个元素再跳过一次），
+// 按距扩容还能插入的元素数均摊。均摊量只减不增，扩容后约为2/max_load
+static size_t ht_put_budget(hash_table_t *ht)
+{
+    if (ht->old_entries == NULL)
+    {
+        return 0;
+    }
+    size_t remaining = 2 * (ht->old_capacity - ht->rehash_index) + 1;
+    size_t gap = ht->threshold > ht->size ? ht->threshold - ht->size : 1;
+    size_t need = (remaining + gap - 1) / gap;
+    return need > ht->rehash_step ? need : ht->rehash_step;
+}
+
+// 一次性完成未结束的迁移
+static void ht_finish_migration(hash_table_t *ht)
+{
+    ht_migrate(ht, SIZE_MAX);
+}
+
+// 重建为capacity个槽；渐进模式下只分配新表，旧表留待后续操作迁移
+static bool ht_rehash(hash_table_t *ht, size_t capacity)
+{
+    ht_finish_migration(ht);
+
+    ht_entry_t *entries = (ht_entry_t *)calloc(capacity, sizeof(ht_entry_t));
+    if (entries == NULL)
+    {
+        return false;
+    }
+
+    ht_entry_t *old = ht->entries;
+    size_t old_capacity = ht->capacity;
+    size_t old_shift = ht->shift;
+
+    ht->entries = entries;
+    ht->capacity = capacity;
+    ht->shift = ht_shift_for(capacity);
+    ht->threshold = ht_threshold(capacity, ht->max_load);
+
+    if (ht->rehash_step > 0 && old != NULL && ht->size > 0)
+    {
+        ht->old_entries = old;
+        ht->old_capacity = old_capacity;
+        ht->old_shift = old_shift;
+        ht->rehash_index = 0;
+        return true;
+    }
+
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old[i].dist != 0)
+        {
+            ht_place(ht->entries, ht->capacity, ht->shift, old[i]);
+        }
+    }
+    free(old);
+    return true;
+}
+
+// 查找键所在的槽（迁移期间依次检查新表和旧表），不存在返回NULL
+static ht_entry_t *ht_lookup(hash_table_t *ht, void *key, size_t hash, bool *in_old)
+{
+    ht_entry_t *slot = ht_probe(ht->entries, ht->capacity, ht->shift, ht->cmp, key, hash);
+    *in_old = false;
+    if (slot == NULL && ht->old_entries != NULL)
+    {
+        slot = ht_probe(ht->old_entries, ht->old_capacity, ht->old_shift, ht->cmp, key, hash);
+        *in_old = slot != NULL;
+    }
+    return slot;
+}
+
+// 创建哈希表（默认装载因子）
+hash_table_t *ht_create(ht_hash_fn hash, ht_cmp_fn cmp)
+{
+    return ht_create_with_load(hash, cmp, HT_DEFAULT_MAX_LOAD);
+}
+
+// 创建哈希表，max_load限制在[0.1, 0.95]之间
+hash_table_t *ht_create_with_load(ht_hash_fn hash, ht_cmp_fn cmp, double max_load)
+{
+    if (hash == NULL || cmp == NULL)
+    {
+        return NULL;
+    }
+    if (!(max_load >= HT_MIN_LOAD))
+    {
+        max_load = HT_MIN_LOAD;
+    }
+    if (max_load > HT_MAX_LOAD)
+    {
+        max_load = HT_MAX_LOAD;
+    }
+
+    hash_table_t *ht = (hash_table_t *)malloc(sizeof(hash_table_t));
+    if (ht == NULL)
+    {
+        return NULL;
+    }
+    ht->entries = NULL;
+    ht->capacity = 0;
+    ht->shift = 0;
+    ht->size = 0;
+    ht->max_load = max_load;
+    ht->hash = hash;
+    ht->cmp = cmp;
+    ht->rehash_step = 0;
+    ht->old_entries = NULL;
+    ht->old_capacity = 0;
+    ht->old_shift = 0;
+    ht->rehash_index = 0;
+
+    if (!ht_rehash(ht, HT_MIN_CAPACITY))
+    {
+        free(ht);
+        return NULL;
+    }
+    return ht;
+}
+
+// 销毁哈希表（不释放键值本身）
+void ht_destroy(hash_table_t *ht)
+{
+    if (ht == NULL)
+    {
+        return;
+    }
+    free(ht->old_entries);
+    free(ht->entries);
+    free(ht);
+}
+
+// 清空哈希表，保留容量
+void ht_clear(hash_table_t *ht)
+{
+    if (ht == NULL)
+    {
+        return;
+    }
+    free(ht->old_entries);
+    ht->old_entries = NULL;
+    ht->old_capacity = 0;
+    memset(ht->entries, 0, ht->capacity * sizeof(ht_entry_t));
+    ht->size = 0;
+}
+
+// 获取元素个数
+size_t ht_size(hash_table_t *ht)
+{
+    if (ht == NULL)
+    {
+        return 0;
+    }
+    return ht->size;
+}
+
+// 检查是否为空
+bool ht_is_empty(hash_table_t *ht)
+{
+    if (ht == NULL)
+    {
+        return true;
+    }
+    return ht->size == 0;
+}
+
+// 获取槽数
+size_t ht_capacity(hash_table_t *ht)
+{
+    if (ht == NULL)
+    {
+        return 0;
+    }
+    return ht->capacity;
+}
+
+// 设置渐进式rehash：step为每次操作迁移的旧槽数，0表示关闭（扩容时一次性rehash）
+void ht_set_rehash_step(hash_table_t *ht, size_t step)
+{
+    if (ht == NULL)
+    {
+        return;
+    }
+    ht->rehash_step = step;
+    if (step == 0)
+    {
+        ht_finish_migration(ht);
+    }
+}
+
+// 检查是否正在迁移旧表
+bool ht_is_rehashing(hash_table_t *ht)
+{
+    return ht != NULL && ht->old_entries != NULL;
+}
+
+// 预留空间，保证容纳count个元素前不再扩容
+bool ht_reserve(hash_table_t *ht, size_t count)
+{
+    if (ht == NULL)
+    {
+        return false;
+    }
+    size_t capacity = ht_capacity_for(count, ht->max_load);
+    if (capacity == 0)
+    {
+        return false;
+    }
+    if (capacity <= ht->capacity)
+    {
+        return true;
+    }
+    return ht_rehash(ht, capacity);
+}
+
+// 插入或替换
+bool ht_put(hash_table_t *ht, void *key, void *value)
+{
+    if (ht == NULL)
+    {
+        return false;
+    }
+
+    ht_migrate(ht, ht_put_budget(ht));
+
+    bool in_old;
+    size_t hash = ht->hash(key);
+    ht_entry_t *slot = ht_lookup(ht, key, hash, &in_old);
+    if (slot != NULL)
+    {
+        slot->value = value;
+        return true;
+    }
+
+    // 新表中的元素数不超过总数，以总数判断扩容即可保证新表有空位
+    if (ht->size >= ht->threshold && !ht_rehash(ht, ht->capacity * 2))
+    {
+        return false;
+    }
+
+    ht_entry_t entry = {key, value, hash, 0};
+    ht_place(ht->entries, ht->capacity, ht->shift, entry);
+    ht->size++;
+    return true;
+}
+
+// 获取键对应的值，不存在返回NULL
+void *ht_get(hash_table_t *ht, void *key)
+{
+    void *value = NULL;
+    ht_find(ht, key, &value);
+    return value;
+}
+
+// 查找键，存在时通过value返回对应的值
+bool ht_find(hash_table_t *ht, void *key, void **value)
+{
+    if (ht == NULL)
+    {
+        return false;
+    }
+
+    ht_migrate(ht, ht->rehash_step);
+
+    bool in_old;
+    ht_entry_t *slot = ht_lookup(ht, key, ht->hash(key), &in_old);
+    if (slot == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = slot->value;
+    }
+    return true;
+}
+
+// 检查键是否存在
+bool ht_contains(hash_table_t *ht, void *key)
+{
+    return ht_find(ht, key, NULL);
+}
+
+// 删除键，存在时通过value返回原值
+bool ht_remove(hash_table_t *ht, void *key, void **value)
+{
+    if (ht == NULL)
+    {
+        return false;
+    }
+
+    ht_migrate(ht, ht->rehash_step);
+
+    bool in_old;
+    ht_entry_t *slot = ht_lookup(ht, key, ht->hash(key), &in_old);
+    if (slot == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = slot->value;
+    }
+
+    if (in_old)
+    {
+        ht_erase(ht->old_entries, ht->old_capacity, (size_t)(slot - ht->old_entries));
+    }
+    else
+    {
+        ht_erase(ht->entries, ht->capacity, (size_t)(slot - ht->entries));
+    }
+    ht->size--;
+    return true;
+}
+
+// 遍历所有键值对（顺序不确定）
+void ht_foreach(hash_table_t *ht, void (*func)(void *key, void *value))
+{
+    if (ht == NULL || func == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < ht->capacity; i++)
+    {
+        if (ht->entries[i].dist != 0)
+        {
+            func(ht->entries[i].key, ht->entries[i].value);
+        }
+    }
+    for (size_t i = 0; ht->old_entries != NULL && i < ht->old_capacity; i++)
+    {
+        if (ht->old_entries[i].dist != 0)
+        {
+            func(ht->old_entries[i].key, ht->old_entries[i].value);
+        }
+    }
+}
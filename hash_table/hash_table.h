@@ -0,0 +1,66 @@
+#ifndef __HASH_TABLE_H__
+#define __HASH_TABLE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// 开放寻址哈希表（Robin Hood 线性探测）
+// 插入时探测距离较短的元素让位给较长者，删除时后移回填而不留墓碑，
+// 使探测长度保持很短。键值均为void *，哈希与比较函数由调用方提供，
+// cmp返回0表示两个键相等（与sl_search/dl_search的比较函数约定一致）。
+// 可选渐进式rehash：扩容时只分配新表，之后每次操作迁移有限个旧槽，
+// 迁移期间查找同时检查新旧两张表，单次操作的延迟与表大小无关。
+// 插入时按距下次扩容的余量加大迁移量，保证下次扩容前旧表已迁完。
+
+// 默认最大装载因子
+#define HT_DEFAULT_MAX_LOAD 0.8
+// 渐进式rehash时每次操作默认迁移的旧槽数
+#define HT_DEFAULT_REHASH_STEP 64
+
+typedef size_t (*ht_hash_fn)(void *key);
+typedef int (*ht_cmp_fn)(void *a, void *b);
+
+typedef struct ht_entry
+{
+    void *key;
+    void *value;
+    size_t hash;
+    size_t dist;      // 探测距离+1，0表示空槽
+} ht_entry_t;
+
+typedef struct hash_table
+{
+    ht_entry_t *entries;
+    size_t capacity;  // 槽数，2的幂
+    size_t shift;     // 斐波那契散列的右移位数
+    size_t size;
+    size_t threshold; // 超过该元素数时扩容
+    double max_load;
+    ht_hash_fn hash;
+    ht_cmp_fn cmp;
+    size_t rehash_step;       // 每次操作迁移的旧槽数，0表示一次性rehash
+    ht_entry_t *old_entries;  // 迁移中的旧表，NULL表示不在迁移
+    size_t old_capacity;
+    size_t old_shift;
+    size_t rehash_index;      // 旧表中下一个待迁移的槽，之前的槽均已为空
+} hash_table_t;
+
+hash_table_t *ht_create(ht_hash_fn hash, ht_cmp_fn cmp);
+hash_table_t *ht_create_with_load(ht_hash_fn hash, ht_cmp_fn cmp, double max_load);
+void ht_destroy(hash_table_t *ht);
+void ht_clear(hash_table_t *ht);
+size_t ht_size(hash_table_t *ht);
+bool ht_is_empty(hash_table_t *ht);
+size_t ht_capacity(hash_table_t *ht);
+void ht_set_rehash_step(hash_table_t *ht, size_t step);
+bool ht_is_rehashing(hash_table_t *ht);
+
+bool ht_reserve(hash_table_t *ht, size_t count);
+bool ht_put(hash_table_t *ht, void *key, void *value);
+void *ht_get(hash_table_t *ht, void *key);
+bool ht_find(hash_table_t *ht, void *key, void **value);
+bool ht_contains(hash_table_t *ht, void *key);
+bool ht_remove(hash_table_t *ht, void *key, void **value);
+void ht_foreach(hash_table_t *ht, void (*func)(void *key, void *value));
+
+#endif // __HASH_TABLE_H__
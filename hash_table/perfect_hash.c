@@ -0,0 +1,653 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "perfect_hash.h"
+#include "hash/hash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MPH_MAGIC 0x3148504Du   // "MPH1"
+#define MPH_VERSION 2
+// 字节序标记，按主机字节序写入；其他字节序的主机读到的是0x04030201
+#define MPH_BYTE_ORDER 0x01020304u
+// 每层位数组大小为剩余键数的倍数，越大层数越少、查询越快，空间越大
+// 修改时须同步修改perfect_hash.h中的MPH_MAX_KEYS
+#define MPH_GAMMA 2.0
+#define MPH_MAX_LEVELS 64
+// 出现64位哈希冲突时换种子重建的次数
+#define MPH_MAX_ATTEMPTS 8
+#define MPH_SEED_BASE 0x5F3759DF2B7E1516ull
+// 每个秩采样覆盖的字数（512位，一条缓存行）
+#define MPH_RANK_WORDS 8
+
+// 缓冲区头部，各区段偏移均相对缓冲区起始并按8字节对齐
+typedef struct mph_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byte_order;    // MPH_BYTE_ORDER
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t seed;
+    uint64_t level_count;
+    uint64_t levels_offset;
+    uint64_t bits_offset;
+    uint64_t bit_words;
+    uint64_t ranks_offset;
+    uint64_t entries_offset;
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint64_t total_size;
+} mph_header_t;
+
+// 排序用：哈希值与键序号
+typedef struct mph_keyed
+{
+    uint64_t hash;
+    size_t index;
+} mph_keyed_t;
+
+static size_t mph_align8(size_t n)
+{
+    return (n + 7) & ~(size_t)7;
+}
+
+static int mph_keyed_cmp(const void *a, const void *b)
+{
+    uint64_t x = ((const mph_keyed_t *)a)->hash;
+    uint64_t y = ((const mph_keyed_t *)b)->hash;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// 键在第level层的位置：取高32位乘法映射到[0, size)，避免取模除法
+static uint64_t mph_position(uint64_t hash, size_t level, uint64_t size)
+{
+    return ((hash_u64_seeded(hash, level) >> 32) * size) >> 32;
+}
+
+static bool mph_test_bit(const uint64_t *bits, uint64_t pos)
+{
+    return (bits[pos >> 6] >> (pos & 63)) & 1;
+}
+
+// 全部位数组中pos之前置1位的个数
+static size_t mph_rank(const uint64_t *bits, const uint64_t *ranks, uint64_t pos)
+{
+    size_t word = (size_t)(pos >> 6);
+    size_t rank = (size_t)ranks[word / MPH_RANK_WORDS];
+    for (size_t w = word - word % MPH_RANK_WORDS; w < word; w++)
+    {
+        rank += (size_t)__builtin_popcountll(bits[w]);
+    }
+    return rank + (size_t)__builtin_popcountll(bits[word] & ((1ull << (pos & 63)) - 1));
+}
+
+// 逐层查找键哈希值对应的序号
+static size_t mph_lookup(const uint64_t *levels, size_t level_count, const uint64_t *bits, const uint64_t *ranks,
+                         uint64_t hash)
+{
+    for (size_t level = 0; level < level_count; level++)
+    {
+        uint64_t pos = levels[level * 2] + mph_position(hash, level, levels[level * 2 + 1]);
+        if (mph_test_bit(bits, pos))
+        {
+            return mph_rank(bits, ranks, pos);
+        }
+    }
+    return MPH_NOT_FOUND;
+}
+
+// 检查[offset, offset+len)是否在size之内且按8字节对齐
+static bool mph_range_ok(uint64_t offset, uint64_t len, uint64_t size)
+{
+    return (offset & 7) == 0 && offset <= size && len <= size - offset;
+}
+
+// 创建构建器
+mph_builder_t *mph_builder_create(void)
+{
+    mph_builder_t *builder = (mph_builder_t *)malloc(sizeof(mph_builder_t));
+    if (builder == NULL)
+    {
+        return NULL;
+    }
+    builder->data = NULL;
+    builder->data_size = 0;
+    builder->data_capacity = 0;
+    builder->entries = NULL;
+    builder->count = 0;
+    builder->capacity = 0;
+    return builder;
+}
+
+// 销毁构建器（已生成的缓冲区不受影响）
+void mph_builder_destroy(mph_builder_t *builder)
+{
+    if (builder == NULL)
+    {
+        return;
+    }
+    free(builder->data);
+    free(builder->entries);
+    free(builder);
+}
+
+// 获取已添加的键数
+size_t mph_builder_size(mph_builder_t *builder)
+{
+    if (builder == NULL)
+    {
+        return 0;
+    }
+    return builder->count;
+}
+
+// 添加键值对（复制内容），键不能重复，重复会在mph_build时报错
+bool mph_builder_add(mph_builder_t *builder, const void *key, size_t key_len, const void *value, size_t value_len)
+{
+    if (builder == NULL || (key == NULL && key_len > 0) || (value == NULL && value_len > 0) ||
+        key_len > UINT32_MAX || value_len > UINT32_MAX || builder->count >= MPH_MAX_KEYS)
+    {
+        return false;
+    }
+
+    size_t need = builder->data_size + key_len + value_len;
+    if (need > builder->data_capacity)
+    {
+        size_t capacity = builder->data_capacity == 0 ? 4096 : builder->data_capacity;
+        while (capacity < need)
+        {
+            capacity *= 2;
+        }
+        uint8_t *data = (uint8_t *)realloc(builder->data, capacity);
+        if (data == NULL)
+        {
+            return false;
+        }
+        builder->data = data;
+        builder->data_capacity = capacity;
+    }
+    if (builder->count == builder->capacity)
+    {
+        size_t capacity = builder->capacity == 0 ? 64 : builder->capacity * 2;
+        mph_entry_t *entries = (mph_entry_t *)realloc(builder->entries, capacity * sizeof(mph_entry_t));
+        if (entries == NULL)
+        {
+            return false;
+        }
+        builder->entries = entries;
+        builder->capacity = capacity;
+    }
+
+    mph_entry_t *entry = &builder->entries[builder->count++];
+    entry->key_offset = builder->data_size;
+    entry->key_len = (uint32_t)key_len;
+    entry->value_len = (uint32_t)value_len;
+    if (key_len > 0)
+    {
+        memcpy(builder->data + builder->data_size, key, key_len);
+    }
+    if (value_len > 0)
+    {
+        memcpy(builder->data + builder->data_size + key_len, value, value_len);
+    }
+    builder->data_size = need;
+    return true;
+}
+
+// 计算全部键的哈希值并检查重复
+// 返回1表示成功，0表示有重复键，-1表示不同键的64位哈希冲突（需换种子）
+static int mph_hash_keys(mph_builder_t *builder, uint64_t seed, uint64_t *hashes, mph_keyed_t *sorted)
+{
+    for (size_t i = 0; i < builder->count; i++)
+    {
+        mph_entry_t *entry = &builder->entries[i];
+        hashes[i] = hash_bytes_seeded(builder->data + entry->key_offset, entry->key_len, seed);
+        sorted[i].hash = hashes[i];
+        sorted[i].index = i;
+    }
+    qsort(sorted, builder->count, sizeof(mph_keyed_t), mph_keyed_cmp);
+
+    int result = 1;
+    for (size_t i = 1; i < builder->count; i++)
+    {
+        if (sorted[i].hash != sorted[i - 1].hash)
+        {
+            continue;
+        }
+        mph_entry_t *a = &builder->entries[sorted[i].index];
+        mph_entry_t *b = &builder->entries[sorted[i - 1].index];
+        if (a->key_len == b->key_len &&
+            memcmp(builder->data + a->key_offset, builder->data + b->key_offset, a->key_len) == 0)
+        {
+            return 0;
+        }
+        result = -1;
+    }
+    return result;
+}
+
+// 分层构建位数组，成功时返回层数，*bits与*levels由调用方释放
+static size_t mph_build_levels(const uint64_t *hashes, size_t count, uint64_t **bits_out, size_t *bit_words_out,
+                               uint64_t *levels)
+{
+    uint64_t *remaining = (uint64_t *)malloc((count == 0 ? 1 : count) * sizeof(uint64_t));
+    uint64_t *bits = NULL;
+    size_t bit_words = 0;
+    size_t level = 0;
+
+    if (remaining == NULL)
+    {
+        return 0;
+    }
+    memcpy(remaining, hashes, count * sizeof(uint64_t));
+
+    while (count > 0 && level < MPH_MAX_LEVELS)
+    {
+        size_t words = (size_t)((double)count * MPH_GAMMA / 64.0) + 1;
+        uint64_t size = (uint64_t)words * 64;
+        if (size > UINT32_MAX)
+        {
+            // mph_position与mph_open都要求每层位数不超过UINT32_MAX
+            free(bits);
+            free(remaining);
+            return 0;
+        }
+        uint64_t *grown = (uint64_t *)realloc(bits, (bit_words + words) * sizeof(uint64_t));
+        uint64_t *collide = (uint64_t *)calloc(words, sizeof(uint64_t));
+        if (grown == NULL || collide == NULL)
+        {
+            free(collide);
+            free(grown == NULL ? bits : grown);
+            free(remaining);
+            return 0;
+        }
+        bits = grown;
+        uint64_t *own = bits + bit_words;
+        memset(own, 0, words * sizeof(uint64_t));
+
+        // 第一遍标记占用与冲突，只保留恰好被一个键占用的位置
+        for (size_t i = 0; i < count; i++)
+        {
+            uint64_t pos = mph_position(remaining[i], level, size);
+            uint64_t mask = 1ull << (pos & 63);
+            if (own[pos >> 6] & mask)
+            {
+                collide[pos >> 6] |= mask;
+            }
+            else
+            {
+                own[pos >> 6] |= mask;
+            }
+        }
+        for (size_t w = 0; w < words; w++)
+        {
+            own[w] &= ~collide[w];
+        }
+        free(collide);
+
+        // 第二遍把冲突的键留给下一层
+        size_t next = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!mph_test_bit(own, mph_position(remaining[i], level, size)))
+            {
+                remaining[next++] = remaining[i];
+            }
+        }
+
+        levels[level * 2] = (uint64_t)bit_words * 64;
+        levels[level * 2 + 1] = size;
+        bit_words += words;
+        count = next;
+        level++;
+    }
+    free(remaining);
+
+    if (count > 0)
+    {
+        free(bits);
+        return 0;
+    }
+    *bits_out = bits;
+    *bit_words_out = bit_words;
+    return level;
+}
+
+// 生成自包含缓冲区（调用方用free释放），*size返回字节数
+// 有重复键或内存不足时返回NULL
+void *mph_build(mph_builder_t *builder, size_t *size)
+{
+    if (builder == NULL || size == NULL)
+    {
+        return NULL;
+    }
+
+    size_t count = builder->count;
+    if (count > MPH_MAX_KEYS)
+    {
+        return NULL;
+    }
+    size_t alloc = count == 0 ? 1 : count;
+    uint64_t *hashes = (uint64_t *)malloc(alloc * sizeof(uint64_t));
+    mph_keyed_t *sorted = (mph_keyed_t *)malloc(alloc * sizeof(mph_keyed_t));
+    uint64_t levels[MPH_MAX_LEVELS * 2];
+    uint64_t *bits = NULL;
+    size_t bit_words = 0;
+    size_t level_count = 0;
+    uint64_t seed = MPH_SEED_BASE;
+    bool ok = false;
+
+    for (size_t attempt = 0; hashes != NULL && sorted != NULL && attempt < MPH_MAX_ATTEMPTS; attempt++)
+    {
+        seed = MPH_SEED_BASE + attempt;
+        int status = mph_hash_keys(builder, seed, hashes, sorted);
+        if (status == 0)
+        {
+            break;
+        }
+        if (status < 0)
+        {
+            continue;
+        }
+        if (count == 0)
+        {
+            ok = true;
+            break;
+        }
+        level_count = mph_build_levels(hashes, count, &bits, &bit_words, levels);
+        if (level_count > 0)
+        {
+            ok = true;
+            break;
+        }
+    }
+    free(sorted);
+    if (!ok)
+    {
+        free(hashes);
+        return NULL;
+    }
+
+    // 计算各区段布局
+    size_t rank_count = (bit_words + MPH_RANK_WORDS - 1) / MPH_RANK_WORDS;
+    mph_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MPH_MAGIC;
+    header.version = MPH_VERSION;
+    header.byte_order = MPH_BYTE_ORDER;
+    header.count = count;
+    header.seed = seed;
+    header.level_count = level_count;
+    header.levels_offset = mph_align8(sizeof(mph_header_t));
+    header.bits_offset = header.levels_offset + level_count * 2 * sizeof(uint64_t);
+    header.bit_words = bit_words;
+    header.ranks_offset = header.bits_offset + bit_words * sizeof(uint64_t);
+    header.entries_offset = header.ranks_offset + rank_count * sizeof(uint64_t);
+    header.data_offset = header.entries_offset + count * sizeof(mph_entry_t);
+    header.data_size = builder->data_size;
+    header.total_size = header.data_offset + mph_align8(builder->data_size);
+
+    uint8_t *buf = (uint8_t *)calloc(1, (size_t)header.total_size);
+    if (buf == NULL)
+    {
+        free(bits);
+        free(hashes);
+        return NULL;
+    }
+    memcpy(buf, &header, sizeof(header));
+    memcpy(buf + header.levels_offset, levels, level_count * 2 * sizeof(uint64_t));
+    if (bit_words > 0)
+    {
+        memcpy(buf + header.bits_offset, bits, bit_words * sizeof(uint64_t));
+    }
+
+    uint64_t *ranks = (uint64_t *)(buf + header.ranks_offset);
+    uint64_t total = 0;
+    for (size_t w = 0; w < bit_words; w++)
+    {
+        if (w % MPH_RANK_WORDS == 0)
+        {
+            ranks[w / MPH_RANK_WORDS] = total;
+        }
+        total += (uint64_t)__builtin_popcountll(bits[w]);
+    }
+
+    // 数据区保持添加顺序，按相近顺序查询的调用方仍有局部性；条目按序号存放
+    mph_entry_t *entries = (mph_entry_t *)(buf + header.entries_offset);
+    for (size_t i = 0; i < count; i++)
+    {
+        entries[mph_lookup(levels, level_count, bits, ranks, hashes[i])] = builder->entries[i];
+    }
+    if (builder->data_size > 0)
+    {
+        memcpy(buf + header.data_offset, builder->data, builder->data_size);
+    }
+
+    free(bits);
+    free(hashes);
+    *size = (size_t)header.total_size;
+    return buf;
+}
+
+// 把缓冲区写入文件
+bool mph_write_file(const void *buf, size_t size, const char *path)
+{
+    if (buf == NULL || path == NULL)
+    {
+        return false;
+    }
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    bool ok = fwrite(buf, 1, size, fp) == size;
+    if (fclose(fp) != 0)
+    {
+        ok = false;
+    }
+    return ok;
+}
+
+// 在已有缓冲区上建立只读视图（不复制），缓冲区须在mph_close之前保持有效
+// 格式校验失败或缓冲区由其他字节序的主机生成时返回NULL
+mph_table_t *mph_open(const void *buf, size_t size)
+{
+    if (buf == NULL || size < sizeof(mph_header_t) || ((uintptr_t)buf & 7) != 0)
+    {
+        return NULL;
+    }
+
+    const uint8_t *base = (const uint8_t *)buf;
+    mph_header_t header;
+    memcpy(&header, base, sizeof(header));
+    if (header.magic != MPH_MAGIC || header.version != MPH_VERSION || header.byte_order != MPH_BYTE_ORDER ||
+        header.total_size != size ||
+        header.level_count > MPH_MAX_LEVELS || header.bit_words > size / sizeof(uint64_t) ||
+        header.count > size / sizeof(mph_entry_t))
+    {
+        return NULL;
+    }
+    uint64_t rank_count = (header.bit_words + MPH_RANK_WORDS - 1) / MPH_RANK_WORDS;
+    if (!mph_range_ok(header.levels_offset, header.level_count * 2 * sizeof(uint64_t), size) ||
+        !mph_range_ok(header.bits_offset, header.bit_words * sizeof(uint64_t), size) ||
+        !mph_range_ok(header.ranks_offset, rank_count * sizeof(uint64_t), size) ||
+        !mph_range_ok(header.entries_offset, header.count * sizeof(mph_entry_t), size) ||
+        !mph_range_ok(header.data_offset, header.data_size, size) ||
+        (header.count > 0 && header.level_count == 0))
+    {
+        return NULL;
+    }
+
+    const uint64_t *levels = (const uint64_t *)(base + header.levels_offset);
+    for (size_t level = 0; level < header.level_count; level++)
+    {
+        uint64_t start = levels[level * 2];
+        uint64_t bits = levels[level * 2 + 1];
+        if ((start & 63) != 0 || bits == 0 || bits > UINT32_MAX || start > header.bit_words * 64 ||
+            bits > header.bit_words * 64 - start)
+        {
+            return NULL;
+        }
+    }
+
+    mph_table_t *table = (mph_table_t *)malloc(sizeof(mph_table_t));
+    if (table == NULL)
+    {
+        return NULL;
+    }
+    table->base = base;
+    table->size = size;
+    table->count = (size_t)header.count;
+    table->seed = header.seed;
+    table->level_count = (size_t)header.level_count;
+    table->levels = levels;
+    table->bits = (const uint64_t *)(base + header.bits_offset);
+    table->bit_words = (size_t)header.bit_words;
+    table->ranks = (const uint64_t *)(base + header.ranks_offset);
+    table->entries = (const mph_entry_t *)(base + header.entries_offset);
+    table->data = base + header.data_offset;
+    table->data_size = (size_t)header.data_size;
+    table->mapped = false;
+    return table;
+}
+
+// 只读映射文件并建立视图，mph_close时解除映射
+mph_table_t *mph_map_file(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    mph_table_t *table = mph_open(base, size);
+    if (table == NULL)
+    {
+        munmap(base, size);
+        return NULL;
+    }
+    table->mapped = true;
+    return table;
+}
+
+// 关闭视图，映射的文件同时解除映射
+void mph_close(mph_table_t *table)
+{
+    if (table == NULL)
+    {
+        return;
+    }
+    if (table->mapped)
+    {
+        munmap((void *)table->base, table->size);
+    }
+    free(table);
+}
+
+// 获取键数
+size_t mph_size(mph_table_t *table)
+{
+    if (table == NULL)
+    {
+        return 0;
+    }
+    return table->count;
+}
+
+// 获取键的序号（0..n-1），不存在返回MPH_NOT_FOUND
+size_t mph_index(mph_table_t *table, const void *key, size_t len)
+{
+    if (table == NULL || (key == NULL && len > 0))
+    {
+        return MPH_NOT_FOUND;
+    }
+
+    uint64_t hash = hash_bytes_seeded(key, len, table->seed);
+    size_t idx = mph_lookup(table->levels, table->level_count, table->bits, table->ranks, hash);
+    if (idx >= table->count)
+    {
+        return MPH_NOT_FOUND;
+    }
+
+    // 完美哈希对任意输入都给出序号，须与存储的键比较
+    const mph_entry_t *entry = &table->entries[idx];
+    if (entry->key_len != len || entry->key_offset > table->data_size ||
+        (uint64_t)entry->key_len + entry->value_len > table->data_size - entry->key_offset ||
+        memcmp(table->data + entry->key_offset, key, len) != 0)
+    {
+        return MPH_NOT_FOUND;
+    }
+    return idx;
+}
+
+// 查找键，存在时通过value与value_len返回值（指向缓冲区内部）
+bool mph_find(mph_table_t *table, const void *key, size_t len, const void **value, size_t *value_len)
+{
+    size_t idx = mph_index(table, key, len);
+    if (idx == MPH_NOT_FOUND)
+    {
+        return false;
+    }
+    const mph_entry_t *entry = &table->entries[idx];
+    if (value != NULL)
+    {
+        *value = table->data + entry->key_offset + entry->key_len;
+    }
+    if (value_len != NULL)
+    {
+        *value_len = entry->value_len;
+    }
+    return true;
+}
+
+// 检查键是否存在
+bool mph_contains(mph_table_t *table, const void *key, size_t len)
+{
+    return mph_index(table, key, len) != MPH_NOT_FOUND;
+}
+
+// 按序号遍历所有键值对
+void mph_foreach(mph_table_t *table,
+                 void (*func)(const void *key, size_t key_len, const void *value, size_t value_len))
+{
+    if (table == NULL || func == NULL)
+    {
+        return;
+    }
+    for (size_t idx = 0; idx < table->count; idx++)
+    {
+        const mph_entry_t *entry = &table->entries[idx];
+        if (entry->key_offset > table->data_size ||
+            (uint64_t)entry->key_len + entry->value_len > table->data_size - entry->key_offset)
+        {
+            continue;
+        }
+        const uint8_t *key = table->data + entry->key_offset;
+        func(key, entry->key_len, key + entry->key_len, entry->value_len);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef __PERFECT_HASH_H__
+#define __PERFECT_HASH_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 静态最小完美哈希表
+// 构建器收集一组固定的键值对（字节串），生成一个自包含的缓冲区：
+// 内部只用相对偏移不用指针，可直接写入文件，之后用mph_map_file只读映射，
+// 无需任何解析或重建即可查询，多个进程映射同一文件时共享物理内存。
+// 完美哈希采用BBHash的分层位数组：每层给剩余键各分配一个位置，
+// 只有一个键落入的位置置1，冲突的键进入下一层；键的序号等于其位置在
+// 全部位数组中的秩（之前置1位的个数），n个键恰好映射到0..n-1。
+// 完美哈希对不存在的键也会给出某个序号，因此查询时还要比较存储的键。
+// 缓冲区按主机字节序存储，查询时直接读取其中的整数，不做转换；头部记录字节序标记，
+// 其他字节序的主机生成的缓冲区在mph_open时被拒绝。缓冲区须8字节对齐（malloc与mmap的结果都满足）。
+
+// mph_index查不到时的返回值
+#define MPH_NOT_FOUND SIZE_MAX
+// 键数上限：第一层位数组约有键数*2+64位，层内位置按32位乘法映射，位数不得超过UINT32_MAX
+#define MPH_MAX_KEYS (((size_t)UINT32_MAX - 64) / 2)
+
+// 键值在数据区中的位置：值紧跟在键之后
+typedef struct mph_entry
+{
+    uint64_t key_offset;
+    uint32_t key_len;
+    uint32_t value_len;
+} mph_entry_t;
+
+// 构建器：复制并暂存键值
+typedef struct mph_builder
+{
+    uint8_t *data;          // 键值依次存放
+    size_t data_size;
+    size_t data_capacity;
+    mph_entry_t *entries;
+    size_t count;
+    size_t capacity;
+} mph_builder_t;
+
+// 只读视图：各指针指向缓冲区内部
+typedef struct mph_table
+{
+    const uint8_t *base;
+    size_t size;
+    size_t count;
+    uint64_t seed;
+    size_t level_count;
+    const uint64_t *levels;     // 每层两个数：起始位、位数
+    const uint64_t *bits;
+    size_t bit_words;
+    const uint64_t *ranks;      // 每512位之前置1位的个数
+    const mph_entry_t *entries;
+    const uint8_t *data;
+    size_t data_size;
+    bool mapped;                // base是否由mph_map_file映射
+} mph_table_t;
+
+mph_builder_t *mph_builder_create(void);
+void mph_builder_destroy(mph_builder_t *builder);
+size_t mph_builder_size(mph_builder_t *builder);
+bool mph_builder_add(mph_builder_t *builder, const void *key, size_t key_len, const void *value, size_t value_len);
+void *mph_build(mph_builder_t *builder, size_t *size);
+bool mph_write_file(const void *buf, size_t size, const char *path);
+
+mph_table_t *mph_open(const void *buf, size_t size);
+mph_table_t *mph_map_file(const char *path);
+void mph_close(mph_table_t *table);
+size_t mph_size(mph_table_t *table);
+
+size_t mph_index(mph_table_t *table, const void *key, size_t len);
+bool mph_find(mph_table_t *table, const void *key, size_t len, const void **value, size_t *value_len);
+bool mph_contains(mph_table_t *table, const void *key, size_t len);
+void mph_foreach(mph_table_t *table,
+                 void (*func)(const void *key, size_t key_len, const void *value, size_t value_len));
+
+#endif // __PERFECT_HASH_H__
@@ -0,0 +1,428 @@
+#include "string_map.h"
+#include "hash/hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SM_MIN_CAPACITY 8
+
+// 长度为0的键允许传入NULL
+static const char *sm_key_or_empty(const char *key)
+{
+    return key != NULL ? key : "";
+}
+
+static size_t sm_threshold(size_t capacity)
+{
+    size_t threshold = (size_t)((double)capacity * SM_DEFAULT_MAX_LOAD);
+    return threshold < capacity ? threshold : capacity - 1;
+}
+
+// 从内存池分配len+1字节并复制键（末尾补'\0'），失败返回NULL
+static const char *sm_pool_copy(sm_chunk_t **chunks, size_t *pool_bytes, const char *key, size_t len)
+{
+    size_t bytes = len + 1;
+    sm_chunk_t *chunk = *chunks;
+
+    if (chunk == NULL || chunk->capacity - chunk->used < bytes)
+    {
+        size_t capacity = bytes > SM_CHUNK_SIZE ? bytes : SM_CHUNK_SIZE;
+        sm_chunk_t *fresh = (sm_chunk_t *)malloc(sizeof(sm_chunk_t) + capacity);
+        if (fresh == NULL)
+        {
+            return NULL;
+        }
+        fresh->used = 0;
+        fresh->capacity = capacity;
+        // 独占一块的长键挂在当前块之后，不打断当前块的分配
+        if (chunk != NULL && bytes > SM_CHUNK_SIZE)
+        {
+            fresh->next = chunk->next;
+            chunk->next = fresh;
+        }
+        else
+        {
+            fresh->next = chunk;
+            *chunks = fresh;
+        }
+        chunk = fresh;
+    }
+
+    char *dst = chunk->data + chunk->used;
+    memcpy(dst, key, len);
+    dst[len] = '\0';
+    chunk->used += bytes;
+    *pool_bytes += bytes;
+    return dst;
+}
+
+static void sm_pool_free(sm_chunk_t *chunk)
+{
+    while (chunk != NULL)
+    {
+        sm_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+// 整理内存池：把现存的键复制到新池中，释放被删除键占用的空间
+// 内存不足时保持原状
+static void sm_compact(string_map_t *sm)
+{
+    sm_chunk_t *chunks = NULL;
+    size_t pool_bytes = 0;
+    const char **keys = (const char **)malloc(sm->capacity * sizeof(const char *));
+    if (keys == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < sm->capacity; i++)
+    {
+        if (sm->slots[i].dist != 0)
+        {
+            keys[i] = sm_pool_copy(&chunks, &pool_bytes, sm->slots[i].key, sm->slots[i].len);
+            if (keys[i] == NULL)
+            {
+                sm_pool_free(chunks);
+                free(keys);
+                return;
+            }
+        }
+    }
+    for (size_t i = 0; i < sm->capacity; i++)
+    {
+        if (sm->slots[i].dist != 0)
+        {
+            sm->slots[i].key = keys[i];
+        }
+    }
+    free(keys);
+
+    sm_pool_free(sm->chunks);
+    sm->chunks = chunks;
+    sm->pool_bytes = pool_bytes;
+}
+
+// 按Robin Hood规则放入槽（调用方保证键不存在且有空位）
+static void sm_place(string_map_t *sm, sm_slot_t entry)
+{
+    size_t mask = sm->capacity - 1;
+    size_t index = (size_t)(entry.hash >> sm->shift);
+    entry.dist = 1;
+
+    for (;;)
+    {
+        sm_slot_t *slot = &sm->slots[index];
+        if (slot->dist == 0)
+        {
+            *slot = entry;
+            return;
+        }
+        if (slot->dist < entry.dist)
+        {
+            sm_slot_t tmp = *slot;
+            *slot = entry;
+            entry = tmp;
+        }
+        entry.dist++;
+        index = (index + 1) & mask;
+    }
+}
+
+// 重建为capacity个槽
+static bool sm_rehash(string_map_t *sm, size_t capacity)
+{
+    sm_slot_t *slots = (sm_slot_t *)calloc(capacity, sizeof(sm_slot_t));
+    if (slots == NULL)
+    {
+        return false;
+    }
+
+    sm_slot_t *old = sm->slots;
+    size_t old_capacity = sm->capacity;
+
+    size_t bits = 0;
+    while (((size_t)1 << bits) < capacity)
+    {
+        bits++;
+    }
+    sm->slots = slots;
+    sm->capacity = capacity;
+    sm->shift = 64 - bits;
+    sm->threshold = sm_threshold(capacity);
+
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old[i].dist != 0)
+        {
+            sm_place(sm, old[i]);
+        }
+    }
+    free(old);
+    return true;
+}
+
+// 查找键所在的槽，不存在返回NULL
+// 先比较哈希值和长度，只有二者都相等时才比较键的字节
+static sm_slot_t *sm_lookup(string_map_t *sm, const char *key, size_t len, uint64_t hash)
+{
+    size_t mask = sm->capacity - 1;
+    size_t index = (size_t)(hash >> sm->shift);
+
+    for (uint32_t dist = 1;; dist++)
+    {
+        sm_slot_t *slot = &sm->slots[index];
+        if (slot->dist < dist)
+        {
+            return NULL;
+        }
+        if (slot->hash == hash && slot->len == len && memcmp(slot->key, key, len) == 0)
+        {
+            return slot;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+// 创建字符串键哈希表
+string_map_t *sm_create(void)
+{
+    string_map_t *sm = (string_map_t *)malloc(sizeof(string_map_t));
+    if (sm == NULL)
+    {
+        return NULL;
+    }
+    sm->slots = NULL;
+    sm->capacity = 0;
+    sm->shift = 0;
+    sm->size = 0;
+    sm->chunks = NULL;
+    sm->live_bytes = 0;
+    sm->pool_bytes = 0;
+
+    if (!sm_rehash(sm, SM_MIN_CAPACITY))
+    {
+        free(sm);
+        return NULL;
+    }
+    return sm;
+}
+
+// 销毁哈希表（不释放值本身）
+void sm_destroy(string_map_t *sm)
+{
+    if (sm == NULL)
+    {
+        return;
+    }
+    sm_pool_free(sm->chunks);
+    free(sm->slots);
+    free(sm);
+}
+
+// 清空哈希表，保留槽数，释放内存池
+void sm_clear(string_map_t *sm)
+{
+    if (sm == NULL)
+    {
+        return;
+    }
+    memset(sm->slots, 0, sm->capacity * sizeof(sm_slot_t));
+    sm_pool_free(sm->chunks);
+    sm->chunks = NULL;
+    sm->size = 0;
+    sm->live_bytes = 0;
+    sm->pool_bytes = 0;
+}
+
+// 获取元素个数
+size_t sm_size(string_map_t *sm)
+{
+    if (sm == NULL)
+    {
+        return 0;
+    }
+    return sm->size;
+}
+
+// 检查是否为空
+bool sm_is_empty(string_map_t *sm)
+{
+    if (sm == NULL)
+    {
+        return true;
+    }
+    return sm->size == 0;
+}
+
+// 获取槽数
+size_t sm_capacity(string_map_t *sm)
+{
+    if (sm == NULL)
+    {
+        return 0;
+    }
+    return sm->capacity;
+}
+
+// 获取内存池中已使用的字节数（含被删除但尚未回收的键）
+size_t sm_pool_bytes(string_map_t *sm)
+{
+    if (sm == NULL)
+    {
+        return 0;
+    }
+    return sm->pool_bytes;
+}
+
+// 预留空间，保证容纳count个元素前不再扩容
+bool sm_reserve(string_map_t *sm, size_t count)
+{
+    if (sm == NULL)
+    {
+        return false;
+    }
+    size_t capacity = sm->capacity;
+    while (sm_threshold(capacity) < count)
+    {
+        // 槽数组的字节数会溢出
+        if (capacity > SIZE_MAX / 2 / sizeof(sm_slot_t))
+        {
+            return false;
+        }
+        capacity *= 2;
+    }
+    if (capacity == sm->capacity)
+    {
+        return true;
+    }
+    return sm_rehash(sm, capacity);
+}
+
+// 插入或替换，键被复制到内存池中
+bool sm_put(string_map_t *sm, const char *key, size_t len, void *value)
+{
+    if (sm == NULL || (key == NULL && len > 0) || len > UINT32_MAX - 1)
+    {
+        return false;
+    }
+    key = sm_key_or_empty(key);
+
+    uint64_t hash = hash_bytes(key, len);
+    sm_slot_t *slot = sm_lookup(sm, key, len, hash);
+    if (slot != NULL)
+    {
+        slot->value = value;
+        return true;
+    }
+
+    if (sm->size >= sm->threshold && !sm_rehash(sm, sm->capacity * 2))
+    {
+        return false;
+    }
+    const char *copy = sm_pool_copy(&sm->chunks, &sm->pool_bytes, key, len);
+    if (copy == NULL)
+    {
+        return false;
+    }
+
+    sm_slot_t entry = {hash, copy, value, (uint32_t)len, 0};
+    sm_place(sm, entry);
+    sm->size++;
+    sm->live_bytes += len + 1;
+
+    // 被删除的键占了池中一半以上的空间时整理，整理的代价由之前的删除均摊
+    // 放在复制之后，key指向池中已删除的键时也是安全的
+    if (sm->pool_bytes - sm->live_bytes > sm->live_bytes + SM_CHUNK_SIZE)
+    {
+        sm_compact(sm);
+    }
+    return true;
+}
+
+// 获取键对应的值，不存在返回NULL
+void *sm_get(string_map_t *sm, const char *key, size_t len)
+{
+    void *value = NULL;
+    sm_find(sm, key, len, &value);
+    return value;
+}
+
+// 查找键，存在时通过value返回对应的值
+bool sm_find(string_map_t *sm, const char *key, size_t len, void **value)
+{
+    if (sm == NULL || (key == NULL && len > 0))
+    {
+        return false;
+    }
+    key = sm_key_or_empty(key);
+    sm_slot_t *slot = sm_lookup(sm, key, len, hash_bytes(key, len));
+    if (slot == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = slot->value;
+    }
+    return true;
+}
+
+// 检查键是否存在
+bool sm_contains(string_map_t *sm, const char *key, size_t len)
+{
+    return sm_find(sm, key, len, NULL);
+}
+
+// 删除键，存在时通过value返回原值
+bool sm_remove(string_map_t *sm, const char *key, size_t len, void **value)
+{
+    if (sm == NULL || (key == NULL && len > 0))
+    {
+        return false;
+    }
+    key = sm_key_or_empty(key);
+
+    sm_slot_t *slot = sm_lookup(sm, key, len, hash_bytes(key, len));
+    if (slot == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = slot->value;
+    }
+    sm->live_bytes -= slot->len + 1;
+
+    // 后移回填
+    size_t mask = sm->capacity - 1;
+    size_t index = (size_t)(slot - sm->slots);
+    size_t next = (index + 1) & mask;
+    while (sm->slots[next].dist > 1)
+    {
+        sm->slots[index] = sm->slots[next];
+        sm->slots[index].dist--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    sm->slots[index].dist = 0;
+    sm->size--;
+    return true;
+}
+
+// 遍历所有键值对（顺序不确定），key以'\0'结尾
+void sm_foreach(string_map_t *sm, void (*func)(const char *key, size_t len, void *value))
+{
+    if (sm == NULL || func == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < sm->capacity; i++)
+    {
+        if (sm->slots[i].dist != 0)
+        {
+            func(sm->slots[i].key, sm->slots[i].len, sm->slots[i].value);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef __STRING_MAP_H__
+#define __STRING_MAP_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 字符串键哈希表（Robin Hood 线性探测）
+// 插入时键被复制到内部分块内存池中，无需为每个键单独malloc；
+// 每个槽保存键的完整64位哈希值和长度，探测时二者不等即可跳过，
+// 不必访问键的字节。键以(指针, 长度)传入，不要求以'\0'结尾，
+// 可以包含'\0'。池中的键以'\0'结尾，遍历时可直接当作C字符串使用。
+// 删除的键在池中占用的空间在浪费超过一半时整理回收，或clear时释放。
+
+// 默认最大装载因子
+#define SM_DEFAULT_MAX_LOAD 0.8
+// 内存池分块大小，超过该长度的键单独分配一块
+#define SM_CHUNK_SIZE 65536
+
+typedef struct sm_slot
+{
+    uint64_t hash;
+    const char *key;    // 指向内存池
+    void *value;
+    uint32_t len;
+    uint32_t dist;      // 探测距离+1，0表示空槽
+} sm_slot_t;
+
+typedef struct sm_chunk
+{
+    struct sm_chunk *next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} sm_chunk_t;
+
+typedef struct string_map
+{
+    sm_slot_t *slots;
+    size_t capacity;    // 槽数，2的幂
+    size_t shift;       // 取哈希值高位作为槽号的右移位数
+    size_t size;
+    size_t threshold;   // 超过该元素数时扩容
+    sm_chunk_t *chunks; // 内存池，头部为当前分配块
+    size_t live_bytes;  // 现存键占用的池空间
+    size_t pool_bytes;  // 池中已分配的总空间
+} string_map_t;
+
+string_map_t *sm_create(void);
+void sm_destroy(string_map_t *sm);
+void sm_clear(string_map_t *sm);
+size_t sm_size(string_map_t *sm);
+bool sm_is_empty(string_map_t *sm);
+size_t sm_capacity(string_map_t *sm);
+size_t sm_pool_bytes(string_map_t *sm);
+
+bool sm_reserve(string_map_t *sm, size_t count);
+bool sm_put(string_map_t *sm, const char *key, size_t len, void *value);
+void *sm_get(string_map_t *sm, const char *key, size_t len);
+bool sm_find(string_map_t *sm, const char *key, size_t len, void **value);
+bool sm_contains(string_map_t *sm, const char *key, size_t len);
+bool sm_remove(string_map_t *sm, const char *key, size_t len, void **value);
+void sm_foreach(string_map_t *sm, void (*func)(const char *key, size_t len, void *value));
+
+#endif // __STRING_MAP_H__
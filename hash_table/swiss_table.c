@@ -0,0 +1,392 @@
+#include "swiss_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ST_USE_SSE2 1
+#else
+#define ST_USE_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 控制字取值：非负数为已占用槽的7位哈希片段
+#define ST_EMPTY ((int8_t)-128)
+#define ST_DELETED ((int8_t)-2)
+
+#define ST_MIN_CAPACITY ST_GROUP_SIZE
+
+// 最低位1的下标
+static unsigned st_ctz(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// 组内控制字等于h2的槽位掩码
+static uint32_t st_match(const int8_t *group, int8_t h2)
+{
+#if ST_USE_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < ST_GROUP_SIZE; i++)
+    {
+        mask |= (uint32_t)(group[i] == h2) << i;
+    }
+    return mask;
+#endif
+}
+
+// 组内空槽掩码
+static uint32_t st_match_empty(const int8_t *group)
+{
+    return st_match(group, ST_EMPTY);
+}
+
+// 组内空槽或已删除槽掩码（两者均小于-1）
+static uint32_t st_match_free(const int8_t *group)
+{
+#if ST_USE_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < ST_GROUP_SIZE; i++)
+    {
+        mask |= (uint32_t)(group[i] < -1) << i;
+    }
+    return mask;
+#endif
+}
+
+// 混合调用方哈希值：低位用于选组(h1)，7位片段存入控制字(h2)
+static size_t st_mix(size_t hash)
+{
+    uint64_t h = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h ^ (h >> 32));
+}
+
+static size_t st_growth_limit(size_t capacity)
+{
+    return capacity / ST_MAX_LOAD_DEN * ST_MAX_LOAD_NUM;
+}
+
+// 查找键所在槽位，不存在返回capacity
+static size_t st_lookup(swiss_table_t *st, void *key, size_t mixed)
+{
+    size_t group_mask = st->capacity / ST_GROUP_SIZE - 1;
+    size_t group = (mixed >> 7) & group_mask;
+    int8_t h2 = (int8_t)(mixed & 0x7F);
+
+    for (size_t step = 1;; step++)
+    {
+        const int8_t *ctrl = st->ctrl + group * ST_GROUP_SIZE;
+        uint32_t mask = st_match(ctrl, h2);
+        while (mask != 0)
+        {
+            size_t index = group * ST_GROUP_SIZE + st_ctz(mask);
+            if (st->cmp(st->slots[index].key, key) == 0)
+            {
+                return index;
+            }
+            mask &= mask - 1;
+        }
+        // 组内有空槽说明探测序列到此为止
+        if (st_match_empty(ctrl) != 0)
+        {
+            return st->capacity;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+// 插入（调用方保证键不存在且growth_left > 0）
+static void st_insert_new(swiss_table_t *st, void *key, void *value, size_t mixed)
+{
+    size_t group_mask = st->capacity / ST_GROUP_SIZE - 1;
+    size_t group = (mixed >> 7) & group_mask;
+
+    for (size_t step = 1;; step++)
+    {
+        int8_t *ctrl = st->ctrl + group * ST_GROUP_SIZE;
+        uint32_t mask = st_match_free(ctrl);
+        if (mask != 0)
+        {
+            unsigned offset = st_ctz(mask);
+            if (ctrl[offset] == ST_EMPTY)
+            {
+                st->growth_left--;
+            }
+            ctrl[offset] = (int8_t)(mixed & 0x7F);
+            st->slots[group * ST_GROUP_SIZE + offset].key = key;
+            st->slots[group * ST_GROUP_SIZE + offset].value = value;
+            st->size++;
+            return;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+// 重建为capacity个槽，同时清除所有已删除标记
+static bool st_rehash(swiss_table_t *st, size_t capacity)
+{
+    int8_t *ctrl = (int8_t *)malloc(capacity);
+    st_slot_t *slots = (st_slot_t *)malloc(capacity * sizeof(st_slot_t));
+    if (ctrl == NULL || slots == NULL)
+    {
+        free(ctrl);
+        free(slots);
+        return false;
+    }
+    memset(ctrl, ST_EMPTY, capacity);
+
+    int8_t *old_ctrl = st->ctrl;
+    st_slot_t *old_slots = st->slots;
+    size_t old_capacity = st->capacity;
+
+    st->ctrl = ctrl;
+    st->slots = slots;
+    st->capacity = capacity;
+    st->size = 0;
+    st->growth_left = st_growth_limit(capacity);
+
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_ctrl[i] >= 0)
+        {
+            st_insert_new(st, old_slots[i].key, old_slots[i].value, st_mix(st->hash(old_slots[i].key)));
+        }
+    }
+    free(old_ctrl);
+    free(old_slots);
+    return true;
+}
+
+// 创建分组探测哈希表
+swiss_table_t *st_create(st_hash_fn hash, st_cmp_fn cmp)
+{
+    if (hash == NULL || cmp == NULL)
+    {
+        return NULL;
+    }
+
+    swiss_table_t *st = (swiss_table_t *)malloc(sizeof(swiss_table_t));
+    if (st == NULL)
+    {
+        return NULL;
+    }
+    st->ctrl = NULL;
+    st->slots = NULL;
+    st->capacity = 0;
+    st->size = 0;
+    st->growth_left = 0;
+    st->hash = hash;
+    st->cmp = cmp;
+
+    if (!st_rehash(st, ST_MIN_CAPACITY))
+    {
+        free(st);
+        return NULL;
+    }
+    return st;
+}
+
+// 销毁哈希表（不释放键值本身）
+void st_destroy(swiss_table_t *st)
+{
+    if (st == NULL)
+    {
+        return;
+    }
+    free(st->ctrl);
+    free(st->slots);
+    free(st);
+}
+
+// 清空哈希表，保留容量
+void st_clear(swiss_table_t *st)
+{
+    if (st == NULL)
+    {
+        return;
+    }
+    memset(st->ctrl, ST_EMPTY, st->capacity);
+    st->size = 0;
+    st->growth_left = st_growth_limit(st->capacity);
+}
+
+// 获取元素个数
+size_t st_size(swiss_table_t *st)
+{
+    if (st == NULL)
+    {
+        return 0;
+    }
+    return st->size;
+}
+
+// 检查是否为空
+bool st_is_empty(swiss_table_t *st)
+{
+    if (st == NULL)
+    {
+        return true;
+    }
+    return st->size == 0;
+}
+
+// 获取槽数
+size_t st_capacity(swiss_table_t *st)
+{
+    if (st == NULL)
+    {
+        return 0;
+    }
+    return st->capacity;
+}
+
+// 预留空间，保证容纳count个元素前不再扩容
+bool st_reserve(swiss_table_t *st, size_t count)
+{
+    if (st == NULL)
+    {
+        return false;
+    }
+    size_t capacity = st->capacity;
+    while (st_growth_limit(capacity) < count)
+    {
+        // 控制字与槽数组的字节数会溢出
+        if (capacity > SIZE_MAX / 2 / (sizeof(st_slot_t) + 1))
+        {
+            return false;
+        }
+        capacity *= 2;
+    }
+    if (capacity == st->capacity)
+    {
+        return true;
+    }
+    return st_rehash(st, capacity);
+}
+
+// 插入或替换
+bool st_put(swiss_table_t *st, void *key, void *value)
+{
+    if (st == NULL)
+    {
+        return false;
+    }
+
+    size_t mixed = st_mix(st->hash(key));
+    size_t index = st_lookup(st, key, mixed);
+    if (index != st->capacity)
+    {
+        st->slots[index].value = value;
+        return true;
+    }
+
+    if (st->growth_left == 0)
+    {
+        // 已删除槽占了一半以上的余量时原地重建即可，否则扩容
+        size_t capacity = st->size * 2 <= st_growth_limit(st->capacity) ? st->capacity : st->capacity * 2;
+        if (!st_rehash(st, capacity))
+        {
+            return false;
+        }
+    }
+
+    st_insert_new(st, key, value, mixed);
+    return true;
+}
+
+// 获取键对应的值，不存在返回NULL
+void *st_get(swiss_table_t *st, void *key)
+{
+    void *value = NULL;
+    st_find(st, key, &value);
+    return value;
+}
+
+// 查找键，存在时通过value返回对应的值
+bool st_find(swiss_table_t *st, void *key, void **value)
+{
+    if (st == NULL)
+    {
+        return false;
+    }
+    size_t index = st_lookup(st, key, st_mix(st->hash(key)));
+    if (index == st->capacity)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = st->slots[index].value;
+    }
+    return true;
+}
+
+// 检查键是否存在
+bool st_contains(swiss_table_t *st, void *key)
+{
+    return st_find(st, key, NULL);
+}
+
+// 删除键，存在时通过value返回原值
+bool st_remove(swiss_table_t *st, void *key, void **value)
+{
+    if (st == NULL)
+    {
+        return false;
+    }
+
+    size_t index = st_lookup(st, key, st_mix(st->hash(key)));
+    if (index == st->capacity)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = st->slots[index].value;
+    }
+
+    // 组内仍有空槽时，任何探测都会在本组停下，可直接标记为空
+    int8_t *group = st->ctrl + (index & ~(size_t)(ST_GROUP_SIZE - 1));
+    if (st_match_empty(group) != 0)
+    {
+        st->ctrl[index] = ST_EMPTY;
+        st->growth_left++;
+    }
+    else
+    {
+        st->ctrl[index] = ST_DELETED;
+    }
+    st->size--;
+    return true;
+}
+
+// 遍历所有键值对（顺序不确定）
+void st_foreach(swiss_table_t *st, void (*func)(void *key, void *value))
+{
+    if (st == NULL || func == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < st->capacity; i++)
+    {
+        if (st->ctrl[i] >= 0)
+        {
+            func(st->slots[i].key, st->slots[i].value);
+        }
+    }
+}
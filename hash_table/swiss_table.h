@@ -0,0 +1,53 @@
+#ifndef __SWISS_TABLE_H__
+#define __SWISS_TABLE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 分组探测哈希表（Swiss table风格）
+// 每个槽对应一个1字节控制字：空、已删除，或哈希值的7位片段。
+// 查找时一次比较16个控制字（SSE2，无SSE2时退化为逐字节比较），
+// 只有片段相同的槽才调用比较函数。哈希与比较函数约定与hash_table.h相同。
+
+#define ST_GROUP_SIZE 16
+// 最大装载因子 7/8
+#define ST_MAX_LOAD_NUM 7
+#define ST_MAX_LOAD_DEN 8
+
+typedef size_t (*st_hash_fn)(void *key);
+typedef int (*st_cmp_fn)(void *a, void *b);
+
+typedef struct st_slot
+{
+    void *key;
+    void *value;
+} st_slot_t;
+
+typedef struct swiss_table
+{
+    int8_t *ctrl;         // 控制字数组，每16个一组
+    st_slot_t *slots;
+    size_t capacity;      // 槽数，ST_GROUP_SIZE的2的幂倍
+    size_t size;
+    size_t growth_left;   // 还能占用多少空槽（已删除槽不计入）
+    st_hash_fn hash;
+    st_cmp_fn cmp;
+} swiss_table_t;
+
+swiss_table_t *st_create(st_hash_fn hash, st_cmp_fn cmp);
+void st_destroy(swiss_table_t *st);
+void st_clear(swiss_table_t *st);
+size_t st_size(swiss_table_t *st);
+bool st_is_empty(swiss_table_t *st);
+size_t st_capacity(swiss_table_t *st);
+
+bool st_reserve(swiss_table_t *st, size_t count);
+bool st_put(swiss_table_t *st, void *key, void *value);
+void *st_get(swiss_table_t *st, void *key);
+bool st_find(swiss_table_t *st, void *key, void **value);
+bool st_contains(swiss_table_t *st, void *key);
+bool st_remove(swiss_table_t *st, void *key, void **value);
+void st_foreach(swiss_table_t *st, void (*func)(void *key, void *value));
+
+#endif // __SWISS_TABLE_H__
@@ -0,0 +1,334 @@
+#include "k_way_merge.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+// 败者树：叶节点k..2k-1对应各路，内部节点1..k-1记录该处比赛的败者
+typedef struct km_tree
+{
+    size_t k;
+    size_t *losers;     // losers[0]为当前胜者
+    size_t *winners;    // 建树时各内部节点的胜者
+    void **keys;        // 各路当前的首元素
+    void **cursors;     // 各路的读取位置：链表节点或数组下标
+    bool *done;         // 各路是否已取尽
+    int (*cmp)(void *a, void *b);
+    void *heap;         // 路数超过KM_STACK_WAYS时申请的内存
+} km_tree_t;
+
+// 路数不超过KM_STACK_WAYS时使用的栈上空间
+typedef struct km_scratch
+{
+    size_t losers[KM_STACK_WAYS];
+    size_t winners[KM_STACK_WAYS];
+    void *keys[KM_STACK_WAYS];
+    void *cursors[KM_STACK_WAYS];
+    bool done[KM_STACK_WAYS];
+} km_scratch_t;
+
+static bool km_tree_init(km_tree_t *tree, size_t k, int (*cmp)(void *a, void *b), km_scratch_t *scratch)
+{
+    tree->k = k;
+    tree->cmp = cmp;
+    tree->heap = NULL;
+    if (k <= KM_STACK_WAYS)
+    {
+        tree->losers = scratch->losers;
+        tree->winners = scratch->winners;
+        tree->keys = scratch->keys;
+        tree->cursors = scratch->cursors;
+        tree->done = scratch->done;
+        return true;
+    }
+
+    size_t per_way = 2 * sizeof(size_t) + 2 * sizeof(void *) + sizeof(bool);
+    if (k > SIZE_MAX / per_way)
+    {
+        return false;
+    }
+    char *block = (char *)malloc(k * per_way);
+    if (block == NULL)
+    {
+        return false;
+    }
+    tree->heap = block;
+    tree->losers = (size_t *)block;
+    tree->winners = tree->losers + k;
+    tree->keys = (void **)(tree->winners + k);
+    tree->cursors = tree->keys + k;
+    tree->done = (bool *)(tree->cursors + k);
+    return true;
+}
+
+// a是否排在b之前：取尽的路排在最后，相等时路序小的在前，保证稳定
+static bool km_beats(const km_tree_t *tree, size_t a, size_t b)
+{
+    if (tree->done[a])
+    {
+        return false;
+    }
+    if (tree->done[b])
+    {
+        return true;
+    }
+    int c = tree->cmp(tree->keys[a], tree->keys[b]);
+    return c < 0 || (c == 0 && a < b);
+}
+
+// 自底向上建树，O(k)
+static void km_build(km_tree_t *tree)
+{
+    size_t k = tree->k;
+
+    for (size_t node = k - 1; node > 0; node--)
+    {
+        size_t left = node * 2;
+        size_t right = left + 1;
+        size_t a = left >= k ? left - k : tree->winners[left];
+        size_t b = right >= k ? right - k : tree->winners[right];
+        if (km_beats(tree, b, a))
+        {
+            size_t tmp = a;
+            a = b;
+            b = tmp;
+        }
+        tree->winners[node] = a;
+        tree->losers[node] = b;
+    }
+    tree->losers[0] = k == 1 ? 0 : tree->winners[1];
+}
+
+// 胜者所在的路前进一个元素后，沿其到根的路径与各败者重赛
+static void km_replay(km_tree_t *tree, size_t winner)
+{
+    for (size_t node = (winner + tree->k) / 2; node > 0; node /= 2)
+    {
+        if (km_beats(tree, tree->losers[node], winner))
+        {
+            size_t tmp = tree->losers[node];
+            tree->losers[node] = winner;
+            winner = tmp;
+        }
+    }
+    tree->losers[0] = winner;
+}
+
+// 合并k个有序单链表，全部节点按序接到dst末尾，输入链表被清空
+// dst可以是输入之一；lists中不能有重复的链表
+bool km_merge_sl(sl_list_t *dst, sl_list_t **lists, size_t k, int (*cmp)(void *a, void *b))
+{
+    if (dst == NULL || (lists == NULL && k > 0) || cmp == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < k; i++)
+    {
+        if (lists[i] == NULL)
+        {
+            return false;
+        }
+    }
+    if (k == 0)
+    {
+        return true;
+    }
+
+    km_scratch_t scratch;
+    km_tree_t tree;
+    if (!km_tree_init(&tree, k, cmp, &scratch))
+    {
+        return false;
+    }
+
+    // 先摘下所有输入的节点，dst为输入之一时也能正确处理
+    size_t total = 0;
+    for (size_t i = 0; i < k; i++)
+    {
+        sl_node_t *head = lists[i]->head;
+        tree.cursors[i] = head;
+        tree.done[i] = head == NULL;
+        tree.keys[i] = head == NULL ? NULL : head->data;
+        total += lists[i]->size;
+        lists[i]->head = NULL;
+        lists[i]->tail = NULL;
+        lists[i]->size = 0;
+    }
+    km_build(&tree);
+
+    sl_node_t *tail = dst->tail;
+    for (;;)
+    {
+        size_t w = tree.losers[0];
+        if (tree.done[w])
+        {
+            break;
+        }
+        sl_node_t *node = (sl_node_t *)tree.cursors[w];
+        sl_node_t *next = node->next;
+        if (tail == NULL)
+        {
+            dst->head = node;
+        }
+        else
+        {
+            tail->next = node;
+        }
+        tail = node;
+
+        tree.cursors[w] = next;
+        if (next == NULL)
+        {
+            tree.done[w] = true;
+        }
+        else
+        {
+            tree.keys[w] = next->data;
+        }
+        km_replay(&tree, w);
+    }
+    if (tail != NULL)
+    {
+        tail->next = NULL;
+    }
+    dst->tail = tail;
+    dst->size += total;
+
+    free(tree.heap);
+    return true;
+}
+
+// 合并k个有序双向链表，全部节点按序接到dst末尾，输入链表被清空
+// dst可以是输入之一；lists中不能有重复的链表
+bool km_merge_dl(dl_list_t *dst, dl_list_t **lists, size_t k, int (*cmp)(void *a, void *b))
+{
+    if (dst == NULL || (lists == NULL && k > 0) || cmp == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < k; i++)
+    {
+        if (lists[i] == NULL)
+        {
+            return false;
+        }
+    }
+    if (k == 0)
+    {
+        return true;
+    }
+
+    km_scratch_t scratch;
+    km_tree_t tree;
+    if (!km_tree_init(&tree, k, cmp, &scratch))
+    {
+        return false;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < k; i++)
+    {
+        dl_node_t *head = lists[i]->head;
+        tree.cursors[i] = head;
+        tree.done[i] = head == NULL;
+        tree.keys[i] = head == NULL ? NULL : head->data;
+        total += lists[i]->size;
+        lists[i]->head = NULL;
+        lists[i]->tail = NULL;
+        lists[i]->size = 0;
+    }
+    km_build(&tree);
+
+    dl_node_t *tail = dst->tail;
+    for (;;)
+    {
+        size_t w = tree.losers[0];
+        if (tree.done[w])
+        {
+            break;
+        }
+        dl_node_t *node = (dl_node_t *)tree.cursors[w];
+        dl_node_t *next = node->next;
+        node->prev = tail;
+        if (tail == NULL)
+        {
+            dst->head = node;
+        }
+        else
+        {
+            tail->next = node;
+        }
+        tail = node;
+
+        tree.cursors[w] = next;
+        if (next == NULL)
+        {
+            tree.done[w] = true;
+        }
+        else
+        {
+            tree.keys[w] = next->data;
+        }
+        km_replay(&tree, w);
+    }
+    if (tail != NULL)
+    {
+        tail->next = NULL;
+    }
+    dst->tail = tail;
+    dst->size += total;
+
+    free(tree.heap);
+    return true;
+}
+
+// 合并k个有序数组，arrays[i]长度为lens[i]，结果写入out（容量至少为总长度）
+// 返回写入的元素个数，参数错误或内存不足返回0
+size_t km_merge_arrays(void **out, void **const *arrays, const size_t *lens, size_t k,
+                       int (*cmp)(void *a, void *b))
+{
+    if (out == NULL || arrays == NULL || lens == NULL || cmp == NULL || k == 0)
+    {
+        return 0;
+    }
+
+    km_scratch_t scratch;
+    km_tree_t tree;
+    if (!km_tree_init(&tree, k, cmp, &scratch))
+    {
+        return 0;
+    }
+
+    // 数组路的读取位置直接存下标
+    for (size_t i = 0; i < k; i++)
+    {
+        tree.cursors[i] = (void *)0;
+        tree.done[i] = lens[i] == 0 || arrays[i] == NULL;
+        tree.keys[i] = tree.done[i] ? NULL : arrays[i][0];
+    }
+    km_build(&tree);
+
+    size_t count = 0;
+    for (;;)
+    {
+        size_t w = tree.losers[0];
+        if (tree.done[w])
+        {
+            break;
+        }
+        out[count++] = tree.keys[w];
+
+        size_t pos = (size_t)(uintptr_t)tree.cursors[w] + 1;
+        tree.cursors[w] = (void *)(uintptr_t)pos;
+        if (pos == lens[w])
+        {
+            tree.done[w] = true;
+        }
+        else
+        {
+            tree.keys[w] = arrays[w][pos];
+        }
+        km_replay(&tree, w);
+    }
+
+    free(tree.heap);
+    return count;
+}
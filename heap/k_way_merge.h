@@ -0,0 +1,23 @@
+#ifndef __K_WAY_MERGE_H__
+#define __K_WAY_MERGE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "linked_list/single_list.h"
+#include "linked_list/double_list.h"
+
+// 不超过该路数时败者树放在栈上，合并过程不申请内存
+#define KM_STACK_WAYS 64
+
+// K路归并
+// 把k个已按cmp升序排列的链表或数组合并为一个有序序列，只需一趟线性扫描。
+// 由败者树选出各路当前的最小元素：每输出一个元素只需沿树上行log2(k)次比较。
+// 合并是稳定的：相等元素按输入的路序、路内的原顺序输出。
+// 链表通过重新链接节点合并，不申请、不复制节点。
+
+bool km_merge_sl(sl_list_t *dst, sl_list_t **lists, size_t k, int (*cmp)(void *a, void *b));
+bool km_merge_dl(dl_list_t *dst, dl_list_t **lists, size_t k, int (*cmp)(void *a, void *b));
+size_t km_merge_arrays(void **out, void **const *arrays, const size_t *lens, size_t k,
+                       int (*cmp)(void *a, void *b));
+
+#endif // __K_WAY_MERGE_H__
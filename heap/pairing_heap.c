@@ -0,0 +1,264 @@
+#include "pairing_heap.h"
+#include <stdlib.h>
+
+// 合并两棵树：优先级低的根成为另一根的最左子节点，返回新根
+// 调用方负责设置新根的prev与next
+static ph_node_t *ph_link(int (*cmp)(void *a, void *b), ph_node_t *a, ph_node_t *b)
+{
+    if (cmp(b->data, a->data) < 0)
+    {
+        ph_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL)
+    {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+// 两趟合并兄弟链表：先从左到右两两合并，再从右到左依次并入
+// 第一趟的结果借用prev串成逆序链，不需要额外空间
+static ph_node_t *ph_merge_pairs(int (*cmp)(void *a, void *b), ph_node_t *first)
+{
+    if (first == NULL)
+    {
+        return NULL;
+    }
+
+    ph_node_t *tail = NULL;
+    while (first != NULL)
+    {
+        ph_node_t *a = first;
+        ph_node_t *b = a->next;
+        if (b == NULL)
+        {
+            a->prev = tail;
+            tail = a;
+            break;
+        }
+        first = b->next;
+        ph_node_t *merged = ph_link(cmp, a, b);
+        merged->prev = tail;
+        tail = merged;
+    }
+
+    ph_node_t *root = tail;
+    tail = tail->prev;
+    while (tail != NULL)
+    {
+        ph_node_t *prev = tail->prev;
+        root = ph_link(cmp, tail, root);
+        tail = prev;
+    }
+    root->prev = NULL;
+    root->next = NULL;
+    return root;
+}
+
+// 把节点（连同其子树）从父节点或兄弟链表中摘下
+static void ph_cut(ph_node_t *node)
+{
+    // 最左子节点的prev指向父节点
+    if (node->prev->child == node)
+    {
+        node->prev->child = node->next;
+    }
+    else
+    {
+        node->prev->next = node->next;
+    }
+    if (node->next != NULL)
+    {
+        node->next->prev = node->prev;
+    }
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+// 创建配对堆
+pairing_heap_t *ph_create(int (*cmp)(void *a, void *b))
+{
+    if (cmp == NULL)
+    {
+        return NULL;
+    }
+
+    pairing_heap_t *ph = (pairing_heap_t *)malloc(sizeof(pairing_heap_t));
+    if (ph == NULL)
+    {
+        return NULL;
+    }
+    ph->pool = np_create(sizeof(ph_node_t), 0);
+    if (ph->pool == NULL)
+    {
+        free(ph);
+        return NULL;
+    }
+    ph->root = NULL;
+    ph->size = 0;
+    ph->cmp = cmp;
+    return ph;
+}
+
+// 销毁配对堆（不释放元素本身）
+void ph_destroy(pairing_heap_t *ph)
+{
+    if (ph == NULL)
+    {
+        return;
+    }
+    np_destroy(ph->pool);
+    free(ph);
+}
+
+// 清空配对堆，所有句柄失效
+void ph_clear(pairing_heap_t *ph)
+{
+    if (ph == NULL)
+    {
+        return;
+    }
+    np_clear(ph->pool);
+    ph->root = NULL;
+    ph->size = 0;
+}
+
+// 获取元素个数
+size_t ph_size(pairing_heap_t *ph)
+{
+    if (ph == NULL)
+    {
+        return 0;
+    }
+    return ph->size;
+}
+
+// 判断是否为空
+bool ph_is_empty(pairing_heap_t *ph)
+{
+    if (ph == NULL)
+    {
+        return true;
+    }
+    return ph->size == 0;
+}
+
+// 插入元素，O(1)，返回节点句柄，内存不足返回NULL
+ph_node_t *ph_push(pairing_heap_t *ph, void *data)
+{
+    if (ph == NULL)
+    {
+        return NULL;
+    }
+
+    ph_node_t *node = (ph_node_t *)np_alloc(ph->pool);
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    node->data = data;
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+
+    ph->root = ph->root == NULL ? node : ph_link(ph->cmp, ph->root, node);
+    ph->root->prev = NULL;
+    ph->size++;
+    return node;
+}
+
+// 获取堆顶元素
+void *ph_peek(pairing_heap_t *ph)
+{
+    if (ph == NULL || ph->root == NULL)
+    {
+        return NULL;
+    }
+    return ph->root->data;
+}
+
+// 弹出堆顶元素，均摊O(log n)
+void *ph_pop(pairing_heap_t *ph)
+{
+    if (ph == NULL || ph->root == NULL)
+    {
+        return NULL;
+    }
+
+    ph_node_t *root = ph->root;
+    void *data = root->data;
+    ph->root = ph_merge_pairs(ph->cmp, root->child);
+    np_free(ph->pool, root);
+    ph->size--;
+    return data;
+}
+
+// 节点元素的优先级已被调用方提高后，调整其在堆中的位置
+// 不会下沉，因此不能用于降低优先级（先ph_remove再ph_push）
+bool ph_decrease_key(pairing_heap_t *ph, ph_node_t *node)
+{
+    if (ph == NULL || node == NULL)
+    {
+        return false;
+    }
+    if (node == ph->root)
+    {
+        return true;
+    }
+
+    ph_cut(node);
+    ph->root = ph_link(ph->cmp, ph->root, node);
+    ph->root->prev = NULL;
+    return true;
+}
+
+// 删除任意节点，返回其元素
+void *ph_remove(pairing_heap_t *ph, ph_node_t *node)
+{
+    if (ph == NULL || node == NULL)
+    {
+        return NULL;
+    }
+    if (node == ph->root)
+    {
+        return ph_pop(ph);
+    }
+
+    void *data = node->data;
+    ph_cut(node);
+    ph_node_t *children = ph_merge_pairs(ph->cmp, node->child);
+    if (children != NULL)
+    {
+        ph->root = ph_link(ph->cmp, ph->root, children);
+        ph->root->prev = NULL;
+    }
+    np_free(ph->pool, node);
+    ph->size--;
+    return data;
+}
+
+// 把src的全部元素并入dst，O(1)；src变为空堆，其句柄改属dst
+// 两个堆须使用相同的比较函数
+bool ph_meld(pairing_heap_t *dst, pairing_heap_t *src)
+{
+    if (dst == NULL || src == NULL || dst == src || !np_merge(dst->pool, src->pool))
+    {
+        return false;
+    }
+
+    if (src->root != NULL)
+    {
+        dst->root = dst->root == NULL ? src->root : ph_link(dst->cmp, dst->root, src->root);
+        dst->root->prev = NULL;
+    }
+    dst->size += src->size;
+    src->root = NULL;
+    src->size = 0;
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef __PAIRING_HEAP_H__
+#define __PAIRING_HEAP_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "pool/node_pool.h"
+
+// 配对堆
+// cmp(a, b) < 0 表示a的优先级高于b，堆顶为优先级最高的元素。
+// 每个元素对应一个节点，ph_push返回的节点即句柄：元素优先级提高后
+// 用ph_decrease_key原地调整（均摊O(log n)，实际接近O(1)），也可用ph_remove删除任意元素。
+// ph_meld把另一个堆整体并入，O(1)。节点从堆自带的节点池分配，
+// 弹出或删除后句柄失效。
+typedef struct ph_node
+{
+    void *data;
+    struct ph_node *child;  // 最左子节点
+    struct ph_node *next;   // 右兄弟
+    struct ph_node *prev;   // 左兄弟；最左子节点指向父节点
+} ph_node_t;
+
+typedef struct pairing_heap
+{
+    ph_node_t *root;
+    size_t size;
+    int (*cmp)(void *a, void *b);
+    node_pool_t *pool;
+} pairing_heap_t;
+
+pairing_heap_t *ph_create(int (*cmp)(void *a, void *b));
+void ph_destroy(pairing_heap_t *ph);
+void ph_clear(pairing_heap_t *ph);
+size_t ph_size(pairing_heap_t *ph);
+bool ph_is_empty(pairing_heap_t *ph);
+
+ph_node_t *ph_push(pairing_heap_t *ph, void *data);
+void *ph_peek(pairing_heap_t *ph);
+void *ph_pop(pairing_heap_t *ph);
+bool ph_decrease_key(pairing_heap_t *ph, ph_node_t *node);
+void *ph_remove(pairing_heap_t *ph, ph_node_t *node);
+bool ph_meld(pairing_heap_t *dst, pairing_heap_t *src);
+
+#endif // __PAIRING_HEAP_H__
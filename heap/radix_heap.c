@@ -0,0 +1,210 @@
+#include "radix_heap.h"
+#include <stdlib.h>
+
+#define RH_INITIAL_CAPACITY 16
+
+// 键所在的桶：与last相等为0，否则为最高不同位的位置加1
+static size_t rh_bucket_index(uint64_t key, uint64_t last)
+{
+    return key == last ? 0 : 64 - (size_t)__builtin_clzll(key ^ last);
+}
+
+static bool rh_bucket_append(rh_bucket_t *bucket, uint64_t key, void *value)
+{
+    if (bucket->size == bucket->capacity)
+    {
+        size_t capacity = bucket->capacity == 0 ? RH_INITIAL_CAPACITY : bucket->capacity * 2;
+        if (capacity > SIZE_MAX / sizeof(rh_item_t))
+        {
+            return false;
+        }
+        rh_item_t *items = (rh_item_t *)realloc(bucket->items, capacity * sizeof(rh_item_t));
+        if (items == NULL)
+        {
+            return false;
+        }
+        bucket->items = items;
+        bucket->capacity = capacity;
+    }
+    bucket->items[bucket->size].key = key;
+    bucket->items[bucket->size].value = value;
+    bucket->size++;
+    return true;
+}
+
+// 0号桶为空时，取第一个非空桶的最小键作为新的last，把该桶的元素重新分到更低的桶
+// 新桶号一定小于原桶号，因此只需在原地遍历一遍
+static bool rh_refill(radix_heap_t *rh)
+{
+    if (rh->buckets[0].size > 0)
+    {
+        return true;
+    }
+    if (rh->nonempty == 0)
+    {
+        return false;
+    }
+
+    size_t index = (size_t)__builtin_ctzll(rh->nonempty) + 1;
+    rh_bucket_t *bucket = &rh->buckets[index];
+    uint64_t min = bucket->items[0].key;
+    for (size_t i = 1; i < bucket->size; i++)
+    {
+        if (bucket->items[i].key < min)
+        {
+            min = bucket->items[i].key;
+        }
+    }
+
+    // 内存不足时撤销已搬移的部分，保持原状
+    size_t saved[RH_BUCKETS];
+    for (size_t i = 0; i < index; i++)
+    {
+        saved[i] = rh->buckets[i].size;
+    }
+    uint64_t nonempty = rh->nonempty;
+
+    for (size_t i = 0; i < bucket->size; i++)
+    {
+        rh_item_t *item = &bucket->items[i];
+        size_t target = rh_bucket_index(item->key, min);
+        if (!rh_bucket_append(&rh->buckets[target], item->key, item->value))
+        {
+            for (size_t j = 0; j < index; j++)
+            {
+                rh->buckets[j].size = saved[j];
+            }
+            rh->nonempty = nonempty;
+            return false;
+        }
+        if (target > 0)
+        {
+            rh->nonempty |= 1ull << (target - 1);
+        }
+    }
+    rh->last = min;
+    bucket->size = 0;
+    rh->nonempty &= ~(1ull << (index - 1));
+    return true;
+}
+
+// 创建基数堆
+radix_heap_t *rh_create(void)
+{
+    return (radix_heap_t *)calloc(1, sizeof(radix_heap_t));
+}
+
+// 销毁基数堆（不释放值本身）
+void rh_destroy(radix_heap_t *rh)
+{
+    if (rh == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < RH_BUCKETS; i++)
+    {
+        free(rh->buckets[i].items);
+    }
+    free(rh);
+}
+
+// 清空基数堆，保留桶的容量，last重置为0
+void rh_clear(radix_heap_t *rh)
+{
+    if (rh == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < RH_BUCKETS; i++)
+    {
+        rh->buckets[i].size = 0;
+    }
+    rh->nonempty = 0;
+    rh->last = 0;
+    rh->size = 0;
+}
+
+// 获取元素个数
+size_t rh_size(radix_heap_t *rh)
+{
+    if (rh == NULL)
+    {
+        return 0;
+    }
+    return rh->size;
+}
+
+// 判断是否为空
+bool rh_is_empty(radix_heap_t *rh)
+{
+    if (rh == NULL)
+    {
+        return true;
+    }
+    return rh->size == 0;
+}
+
+// 获取当前允许插入的最小键
+uint64_t rh_last_key(radix_heap_t *rh)
+{
+    if (rh == NULL)
+    {
+        return 0;
+    }
+    return rh->last;
+}
+
+// 插入元素，键小于rh_last_key或内存不足时返回false
+bool rh_push(radix_heap_t *rh, uint64_t key, void *value)
+{
+    if (rh == NULL || key < rh->last)
+    {
+        return false;
+    }
+
+    size_t index = rh_bucket_index(key, rh->last);
+    if (!rh_bucket_append(&rh->buckets[index], key, value))
+    {
+        return false;
+    }
+    if (index > 0)
+    {
+        rh->nonempty |= 1ull << (index - 1);
+    }
+    rh->size++;
+    return true;
+}
+
+// 获取最小键的元素但不弹出，空堆或重新分桶时内存不足返回false
+// 可能触发重新分桶并推进last，之后不能再插入小于该键的元素
+bool rh_peek(radix_heap_t *rh, uint64_t *key, void **value)
+{
+    if (rh == NULL || !rh_refill(rh))
+    {
+        return false;
+    }
+
+    rh_bucket_t *bucket = &rh->buckets[0];
+    rh_item_t *item = &bucket->items[bucket->size - 1];
+    if (key != NULL)
+    {
+        *key = item->key;
+    }
+    if (value != NULL)
+    {
+        *value = item->value;
+    }
+    return true;
+}
+
+// 弹出最小键的元素，失败条件同rh_peek；键相同的元素之间不保证顺序
+bool rh_pop(radix_heap_t *rh, uint64_t *key, void **value)
+{
+    if (!rh_peek(rh, key, value))
+    {
+        return false;
+    }
+    rh->buckets[0].size--;
+    rh->size--;
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef __RADIX_HEAP_H__
+#define __RADIX_HEAP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 桶数：与上次弹出的键相等的放0号桶，其余按最高不同位放1..64号桶
+#define RH_BUCKETS 65
+
+// 基数堆（单调优先队列）
+// 键为64位无符号整数，约定插入的键不小于最近一次弹出的键（事件时间戳、Dijkstra距离），
+// 违反约定的插入被拒绝。元素按与上次弹出键的最高不同位分桶，弹出时只在0号桶为空时
+// 把第一个非空桶按新的最小键重新分到更低的桶中；每个元素最多下移64次，
+// 均摊O(log C)（C为键的最大跨度），且只做整数比较。
+// 每个桶是可增长的数组，容量在弹出与清空后保留复用，不为每个元素单独申请内存。
+typedef struct rh_item
+{
+    uint64_t key;
+    void *value;
+} rh_item_t;
+
+typedef struct rh_bucket
+{
+    rh_item_t *items;
+    size_t size;
+    size_t capacity;
+} rh_bucket_t;
+
+typedef struct radix_heap
+{
+    rh_bucket_t buckets[RH_BUCKETS];
+    uint64_t nonempty;  // 1..64号桶是否非空，第i-1位对应i号桶
+    uint64_t last;      // 最近一次弹出的键，插入的键不能小于它
+    size_t size;
+} radix_heap_t;
+
+radix_heap_t *rh_create(void);
+void rh_destroy(radix_heap_t *rh);
+void rh_clear(radix_heap_t *rh);
+size_t rh_size(radix_heap_t *rh);
+bool rh_is_empty(radix_heap_t *rh);
+uint64_t rh_last_key(radix_heap_t *rh);
+
+bool rh_push(radix_heap_t *rh, uint64_t key, void *value);
+bool rh_peek(radix_heap_t *rh, uint64_t *key, void **value);
+bool rh_pop(radix_heap_t *rh, uint64_t *key, void **value);
+
+#endif // __RADIX_HEAP_H__
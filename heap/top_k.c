@@ -0,0 +1,265 @@
+#include "top_k.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// 上浮：堆顶为按cmp排在最后的元素
+static void tk_sift_up(void **items, size_t index, int (*cmp)(void *a, void *b))
+{
+    void *item = items[index];
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (cmp(item, items[parent]) <= 0)
+        {
+            break;
+        }
+        items[index] = items[parent];
+        index = parent;
+    }
+    items[index] = item;
+}
+
+// 下沉：采用空穴法，把item放入以index为根、大小为size的子堆
+static void tk_sift_down(void **items, size_t size, size_t index, void *item, int (*cmp)(void *a, void *b))
+{
+    for (;;)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && cmp(items[child + 1], items[child]) > 0)
+        {
+            child++;
+        }
+        if (cmp(item, items[child]) >= 0)
+        {
+            break;
+        }
+        items[index] = items[child];
+        index = child;
+    }
+    items[index] = item;
+}
+
+// 堆满后的快速路径：不优于阈值的直接拒绝，否则替换堆顶并下沉
+static bool tk_replace_top(top_k_t *tk, void *item)
+{
+    if (tk->cmp(item, tk->items[0]) >= 0)
+    {
+        tk->rejected++;
+        return false;
+    }
+    tk_sift_down(tk->items, tk->size, 0, item, tk->cmp);
+    return true;
+}
+
+// 创建Top-K选择器，保留按cmp排在最前的k个元素
+top_k_t *tk_create(size_t k, int (*cmp)(void *a, void *b))
+{
+    if (k == 0 || cmp == NULL || k > SIZE_MAX / sizeof(void *))
+    {
+        return NULL;
+    }
+
+    top_k_t *tk = (top_k_t *)malloc(sizeof(top_k_t));
+    if (tk == NULL)
+    {
+        return NULL;
+    }
+    tk->items = (void **)malloc(k * sizeof(void *));
+    if (tk->items == NULL)
+    {
+        free(tk);
+        return NULL;
+    }
+    tk->size = 0;
+    tk->k = k;
+    tk->cmp = cmp;
+    tk->seen = 0;
+    tk->rejected = 0;
+    return tk;
+}
+
+// 销毁选择器（不释放元素本身）
+void tk_destroy(top_k_t *tk)
+{
+    if (tk == NULL)
+    {
+        return;
+    }
+    free(tk->items);
+    free(tk);
+}
+
+// 清空已保留的元素与统计
+void tk_clear(top_k_t *tk)
+{
+    if (tk == NULL)
+    {
+        return;
+    }
+    tk->size = 0;
+    tk->seen = 0;
+    tk->rejected = 0;
+}
+
+// 获取当前保留的元素数（不超过k）
+size_t tk_size(top_k_t *tk)
+{
+    if (tk == NULL)
+    {
+        return 0;
+    }
+    return tk->size;
+}
+
+// 获取k
+size_t tk_k(top_k_t *tk)
+{
+    if (tk == NULL)
+    {
+        return 0;
+    }
+    return tk->k;
+}
+
+// 获取已接收的元素数
+size_t tk_seen(top_k_t *tk)
+{
+    if (tk == NULL)
+    {
+        return 0;
+    }
+    return tk->seen;
+}
+
+// 获取被阈值直接拒绝的元素数
+size_t tk_rejected(top_k_t *tk)
+{
+    if (tk == NULL)
+    {
+        return 0;
+    }
+    return tk->rejected;
+}
+
+// 接收一个元素，返回是否被保留（之后仍可能被更优的元素挤出）
+bool tk_offer(top_k_t *tk, void *item)
+{
+    if (tk == NULL)
+    {
+        return false;
+    }
+
+    tk->seen++;
+    if (tk->size < tk->k)
+    {
+        tk->items[tk->size] = item;
+        tk_sift_up(tk->items, tk->size, tk->cmp);
+        tk->size++;
+        return true;
+    }
+    return tk_replace_top(tk, item);
+}
+
+// 批量接收数组中的元素，返回被保留的个数
+size_t tk_offer_array(top_k_t *tk, void **items, size_t count)
+{
+    if (tk == NULL || (items == NULL && count > 0))
+    {
+        return 0;
+    }
+
+    size_t kept = 0;
+    size_t i = 0;
+    for (; i < count && tk->size < tk->k; i++)
+    {
+        kept += tk_offer(tk, items[i]);
+    }
+
+    // 堆满后阈值只在替换堆顶时变化，拒绝路径只有一次比较
+    int (*cmp)(void *a, void *b) = tk->cmp;
+    void *threshold = tk->size > 0 ? tk->items[0] : NULL;
+    size_t rejected = 0;
+    tk->seen += count - i;
+    for (; i < count; i++)
+    {
+        if (cmp(items[i], threshold) >= 0)
+        {
+            rejected++;
+            continue;
+        }
+        tk_sift_down(tk->items, tk->size, 0, items[i], cmp);
+        threshold = tk->items[0];
+        kept++;
+    }
+    tk->rejected += rejected;
+    return kept;
+}
+
+// 批量接收单链表中的元素（不修改链表），返回被保留的个数
+size_t tk_offer_sl(top_k_t *tk, sl_list_t *list)
+{
+    if (tk == NULL || list == NULL)
+    {
+        return 0;
+    }
+
+    size_t kept = 0;
+    for (sl_node_t *node = list->head; node != NULL; node = node->next)
+    {
+        kept += tk_offer(tk, node->data);
+    }
+    return kept;
+}
+
+// 批量接收双向链表中的元素（不修改链表），返回被保留的个数
+size_t tk_offer_dl(top_k_t *tk, dl_list_t *list)
+{
+    if (tk == NULL || list == NULL)
+    {
+        return 0;
+    }
+
+    size_t kept = 0;
+    for (dl_node_t *node = list->head; node != NULL; node = node->next)
+    {
+        kept += tk_offer(tk, node->data);
+    }
+    return kept;
+}
+
+// 获取阈值：堆满时为当前保留的最靠后的元素，未满时返回NULL（任何元素都会被保留）
+void *tk_threshold(top_k_t *tk)
+{
+    if (tk == NULL || tk->size < tk->k)
+    {
+        return NULL;
+    }
+    return tk->items[0];
+}
+
+// 按cmp升序把保留的元素写入out（容量至少为tk_size），返回个数
+// 不改变选择器状态，之后可以继续接收元素
+size_t tk_result(top_k_t *tk, void **out)
+{
+    if (tk == NULL || out == NULL)
+    {
+        return 0;
+    }
+
+    // 复制的数组本身就是堆，直接做堆排序的出堆阶段
+    size_t size = tk->size;
+    memcpy(out, tk->items, size * sizeof(void *));
+    for (size_t end = size; end > 1; end--)
+    {
+        void *top = out[0];
+        tk_sift_down(out, end - 1, 0, out[end - 1], tk->cmp);
+        out[end - 1] = top;
+    }
+    return size;
+}
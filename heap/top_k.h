@@ -0,0 +1,40 @@
+#ifndef __TOP_K_H__
+#define __TOP_K_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "linked_list/single_list.h"
+#include "linked_list/double_list.h"
+
+// 流式Top-K选择
+// 逐个或批量接收元素，只保留按cmp排在最前的k个：cmp(a, b) < 0 表示a排在b前。
+// 内部为大小不超过k的二叉堆，堆顶是当前保留的元素中最靠后的一个（阈值），
+// 堆满后新元素先与阈值比较，不优于阈值的直接丢弃，因此大部分元素只需一次比较。
+// 处理n个元素为O(n log k)，内存O(k)；与阈值相等的元素保留先到者。
+// 只保存元素指针，不复制、不释放元素。
+typedef struct top_k
+{
+    void **items;
+    size_t size;
+    size_t k;
+    int (*cmp)(void *a, void *b);
+    size_t seen;        // 已接收的元素数
+    size_t rejected;    // 堆满后被阈值直接拒绝的元素数
+} top_k_t;
+
+top_k_t *tk_create(size_t k, int (*cmp)(void *a, void *b));
+void tk_destroy(top_k_t *tk);
+void tk_clear(top_k_t *tk);
+size_t tk_size(top_k_t *tk);
+size_t tk_k(top_k_t *tk);
+size_t tk_seen(top_k_t *tk);
+size_t tk_rejected(top_k_t *tk);
+
+bool tk_offer(top_k_t *tk, void *item);
+size_t tk_offer_array(top_k_t *tk, void **items, size_t count);
+size_t tk_offer_sl(top_k_t *tk, sl_list_t *list);
+size_t tk_offer_dl(top_k_t *tk, dl_list_t *list);
+void *tk_threshold(top_k_t *tk);
+size_t tk_result(top_k_t *tk, void **out);
+
+#endif // __TOP_K_H__
@@ -0,0 +1,234 @@
+#include "node_pool.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+// 块头部占用的字节数，保证块内第一个节点按最大基本类型对齐
+#define NP_HEADER_SIZE ((sizeof(np_chunk_t) + 15) & ~(size_t)15)
+
+// 空闲节点的链表指针存放在节点起始处
+static void *np_next_free(void *node)
+{
+    return *(void **)node;
+}
+
+static void np_set_next_free(void *node, void *next)
+{
+    *(void **)node = next;
+}
+
+// 创建节点池，chunk_nodes为0时使用默认值
+node_pool_t *np_create(size_t node_size, size_t chunk_nodes)
+{
+    if (node_size == 0)
+    {
+        return NULL;
+    }
+    if (chunk_nodes == 0)
+    {
+        chunk_nodes = NP_DEFAULT_CHUNK_NODES;
+    }
+
+    size_t align = sizeof(void *);
+    if (node_size > SIZE_MAX - align)
+    {
+        return NULL;
+    }
+    node_size = (node_size + align - 1) & ~(align - 1);
+    if (chunk_nodes > (SIZE_MAX - NP_HEADER_SIZE) / node_size)
+    {
+        return NULL;
+    }
+
+    node_pool_t *pool = (node_pool_t *)malloc(sizeof(node_pool_t));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+    pool->node_size = node_size;
+    pool->chunk_nodes = chunk_nodes;
+    pool->chunks = NULL;
+    pool->chunks_tail = NULL;
+    pool->chunk_count = 0;
+    pool->cursor = NULL;
+    pool->remaining = 0;
+    pool->free_head = NULL;
+    pool->free_tail = NULL;
+    pool->in_use = 0;
+    return pool;
+}
+
+// 销毁节点池，所有节点一并失效
+void np_destroy(node_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+    np_clear(pool);
+    free(pool);
+}
+
+// 归还所有块，所有节点一并失效
+void np_clear(node_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    np_chunk_t *chunk = pool->chunks;
+    while (chunk != NULL)
+    {
+        np_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    pool->chunks = NULL;
+    pool->chunks_tail = NULL;
+    pool->chunk_count = 0;
+    pool->cursor = NULL;
+    pool->remaining = 0;
+    pool->free_head = NULL;
+    pool->free_tail = NULL;
+    pool->in_use = 0;
+}
+
+// 获取节点大小（取整后）
+size_t np_node_size(node_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return 0;
+    }
+    return pool->node_size;
+}
+
+// 获取已分配未释放的节点数
+size_t np_in_use(node_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return 0;
+    }
+    return pool->in_use;
+}
+
+// 获取池占用的内存字节数
+size_t np_bytes(node_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return 0;
+    }
+    return pool->chunk_count * (NP_HEADER_SIZE + pool->chunk_nodes * pool->node_size);
+}
+
+// 分配一个节点（内容未初始化），内存不足返回NULL
+void *np_alloc(node_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    void *node = pool->free_head;
+    if (node != NULL)
+    {
+        pool->free_head = np_next_free(node);
+        if (pool->free_head == NULL)
+        {
+            pool->free_tail = NULL;
+        }
+        pool->in_use++;
+        return node;
+    }
+
+    if (pool->remaining == 0)
+    {
+        np_chunk_t *chunk = (np_chunk_t *)malloc(NP_HEADER_SIZE + pool->chunk_nodes * pool->node_size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+        if (pool->chunks_tail == NULL)
+        {
+            pool->chunks_tail = chunk;
+        }
+        pool->chunk_count++;
+        pool->cursor = (char *)chunk + NP_HEADER_SIZE;
+        pool->remaining = pool->chunk_nodes;
+    }
+
+    node = pool->cursor;
+    pool->cursor += pool->node_size;
+    pool->remaining--;
+    pool->in_use++;
+    return node;
+}
+
+// 释放节点，节点须由同一个池（或已并入该池的池）分配
+void np_free(node_pool_t *pool, void *node)
+{
+    if (pool == NULL || node == NULL)
+    {
+        return;
+    }
+
+    np_set_next_free(node, pool->free_head);
+    if (pool->free_head == NULL)
+    {
+        pool->free_tail = node;
+    }
+    pool->free_head = node;
+    pool->in_use--;
+}
+
+// 把src的全部块与空闲节点并入dst，O(1)；之后src为空，其节点改由dst释放
+// 两个池的节点大小须一致；src当前块中未切分的部分不再使用
+bool np_merge(node_pool_t *dst, node_pool_t *src)
+{
+    if (dst == NULL || src == NULL || dst == src || dst->node_size != src->node_size)
+    {
+        return false;
+    }
+
+    if (src->chunks != NULL)
+    {
+        // 把src的块接在dst链表尾部，保持dst当前切分的块在头部
+        if (dst->chunks == NULL)
+        {
+            dst->chunks = src->chunks;
+            dst->cursor = src->cursor;
+            dst->remaining = src->remaining;
+        }
+        else
+        {
+            dst->chunks_tail->next = src->chunks;
+        }
+        dst->chunks_tail = src->chunks_tail;
+        dst->chunk_count += src->chunk_count;
+    }
+
+    if (src->free_head != NULL)
+    {
+        np_set_next_free(src->free_tail, dst->free_head);
+        if (dst->free_head == NULL)
+        {
+            dst->free_tail = src->free_tail;
+        }
+        dst->free_head = src->free_head;
+    }
+    dst->in_use += src->in_use;
+
+    src->chunks = NULL;
+    src->chunks_tail = NULL;
+    src->chunk_count = 0;
+    src->cursor = NULL;
+    src->remaining = 0;
+    src->free_head = NULL;
+    src->free_tail = NULL;
+    src->in_use = 0;
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef __NODE_POOL_H__
+#define __NODE_POOL_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// 默认每块的节点数
+#define NP_DEFAULT_CHUNK_NODES 256
+
+// 定长节点池
+// 按块批量申请内存，节点从块中顺序切出，释放的节点串成空闲链表优先复用，
+// 避免链式结构每个节点一次malloc/free；块只在np_clear或np_destroy时归还。
+// 节点按指针大小对齐，空闲节点起始处被用作链表指针。
+// 非线程安全，由所属数据结构负责同步。
+typedef struct np_chunk
+{
+    struct np_chunk *next;
+} np_chunk_t;
+
+typedef struct node_pool
+{
+    size_t node_size;       // 向上取整到指针大小的倍数
+    size_t chunk_nodes;
+    np_chunk_t *chunks;     // 头部为当前切分的块
+    np_chunk_t *chunks_tail;
+    size_t chunk_count;
+    char *cursor;           // 当前块中下一个未切分的节点
+    size_t remaining;       // 当前块中未切分的节点数
+    void *free_head;
+    void *free_tail;        // 合并空闲链表时用于O(1)拼接
+    size_t in_use;
+} node_pool_t;
+
+node_pool_t *np_create(size_t node_size, size_t chunk_nodes);
+void np_destroy(node_pool_t *pool);
+void np_clear(node_pool_t *pool);
+size_t np_node_size(node_pool_t *pool);
+size_t np_in_use(node_pool_t *pool);
+size_t np_bytes(node_pool_t *pool);
+
+void *np_alloc(node_pool_t *pool);
+void np_free(node_pool_t *pool, void *node);
+bool np_merge(node_pool_t *dst, node_pool_t *src);
+
+#endif // __NODE_POOL_H__
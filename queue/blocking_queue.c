@@ -0,0 +1,353 @@
+#define _GNU_SOURCE
+
+#include "blocking_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+
+#if BQ_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 计算截止时间（单调时钟）
+static void bq_deadline(struct timespec *deadline, long timeout_ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout_ms / 1000;
+    deadline->tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+// 计算距截止时间的剩余时间，已超时返回false
+static bool bq_remaining(const struct timespec *deadline, struct timespec *remaining)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    remaining->tv_sec = deadline->tv_sec - now.tv_sec;
+    remaining->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+    if (remaining->tv_nsec < 0)
+    {
+        remaining->tv_sec--;
+        remaining->tv_nsec += 1000000000L;
+    }
+    return remaining->tv_sec > 0 || (remaining->tv_sec == 0 && remaining->tv_nsec > 0);
+}
+
+#if BQ_USE_FUTEX
+
+static void bq_futex_wait(uint32_t *word, uint32_t expected, const struct timespec *timeout)
+{
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+}
+
+static void bq_futex_wake(uint32_t *word, int count)
+{
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+// 挂起等待（调用时持有锁，返回时重新持有锁）
+// 已超时返回false；被唤醒或虚假唤醒返回true，由调用方重新检查条件
+static bool bq_wait(blocking_queue_t *queue, bool consumer, const struct timespec *deadline)
+{
+    uint32_t *word = consumer ? &queue->not_empty_seq : &queue->not_full_seq;
+    size_t *waiting = consumer ? &queue->waiting_consumers : &queue->waiting_producers;
+    struct timespec remaining;
+
+    if (deadline != NULL && !bq_remaining(deadline, &remaining))
+    {
+        return false;
+    }
+
+    // 在锁内读取序号：此后任何唤醒都会先改变序号，futex不会错过通知
+    uint32_t seq = __atomic_load_n(word, __ATOMIC_ACQUIRE);
+    (*waiting)++;
+    pthread_mutex_unlock(&queue->lock);
+    bq_futex_wait(word, seq, deadline != NULL ? &remaining : NULL);
+    pthread_mutex_lock(&queue->lock);
+    (*waiting)--;
+    return true;
+}
+
+// 通知等待者（调用时持有锁），返回需要在解锁后唤醒的线程数
+static int bq_notify(blocking_queue_t *queue, bool consumer, size_t count)
+{
+    size_t waiting = consumer ? queue->waiting_consumers : queue->waiting_producers;
+    if (waiting == 0)
+    {
+        return 0;
+    }
+    __atomic_add_fetch(consumer ? &queue->not_empty_seq : &queue->not_full_seq, 1, __ATOMIC_RELEASE);
+    if (count > waiting)
+    {
+        count = waiting;
+    }
+    return count > INT_MAX ? INT_MAX : (int)count;
+}
+
+// 解锁后唤醒
+static void bq_wake(blocking_queue_t *queue, bool consumer, int count)
+{
+    if (count > 0)
+    {
+        bq_futex_wake(consumer ? &queue->not_empty_seq : &queue->not_full_seq, count);
+    }
+}
+
+#else
+
+static bool bq_wait(blocking_queue_t *queue, bool consumer, const struct timespec *deadline)
+{
+    pthread_cond_t *cond = consumer ? &queue->not_empty : &queue->not_full;
+    struct timespec remaining;
+
+    if (deadline == NULL)
+    {
+        pthread_cond_wait(cond, &queue->lock);
+        return true;
+    }
+    if (!bq_remaining(deadline, &remaining))
+    {
+        return false;
+    }
+    pthread_cond_timedwait(cond, &queue->lock, deadline);
+    return true;
+}
+
+static int bq_notify(blocking_queue_t *queue, bool consumer, size_t count)
+{
+    (void)queue;
+    (void)consumer;
+    return count > INT_MAX ? INT_MAX : (int)count;
+}
+
+static void bq_wake(blocking_queue_t *queue, bool consumer, int count)
+{
+    pthread_cond_t *cond = consumer ? &queue->not_empty : &queue->not_full;
+    if (count == 1)
+    {
+        pthread_cond_signal(cond);
+    }
+    else if (count > 1)
+    {
+        pthread_cond_broadcast(cond);
+    }
+}
+
+#endif
+
+// 创建阻塞队列
+blocking_queue_t *bq_create(size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return NULL;
+    }
+
+    blocking_queue_t *queue = (blocking_queue_t *)malloc(sizeof(blocking_queue_t));
+    if (queue == NULL)
+    {
+        return NULL;
+    }
+    queue->buffer = (void **)malloc(capacity * sizeof(void *));
+    if (queue->buffer == NULL)
+    {
+        free(queue);
+        return NULL;
+    }
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->count = 0;
+    queue->closed = false;
+    pthread_mutex_init(&queue->lock, NULL);
+#if BQ_USE_FUTEX
+    queue->not_empty_seq = 0;
+    queue->not_full_seq = 0;
+    queue->waiting_consumers = 0;
+    queue->waiting_producers = 0;
+#else
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&queue->not_empty, &attr);
+    pthread_cond_init(&queue->not_full, &attr);
+    pthread_condattr_destroy(&attr);
+#endif
+    return queue;
+}
+
+// 销毁阻塞队列（不释放元素本身），调用时不得有线程在等待
+void bq_destroy(blocking_queue_t *queue)
+{
+    if (queue == NULL)
+    {
+        return;
+    }
+#if !BQ_USE_FUTEX
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+#endif
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->buffer);
+    free(queue);
+}
+
+// 获取元素个数
+size_t bq_size(blocking_queue_t *queue)
+{
+    if (queue == NULL)
+    {
+        return 0;
+    }
+    pthread_mutex_lock(&queue->lock);
+    size_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+// 获取容量
+size_t bq_capacity(blocking_queue_t *queue)
+{
+    if (queue == NULL)
+    {
+        return 0;
+    }
+    return queue->capacity;
+}
+
+// 检查是否为空
+bool bq_is_empty(blocking_queue_t *queue)
+{
+    return bq_size(queue) == 0;
+}
+
+// 关闭队列：唤醒所有等待者，之后入队失败，出队取完剩余元素后失败
+void bq_close(blocking_queue_t *queue)
+{
+    if (queue == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = true;
+    int consumers = bq_notify(queue, true, SIZE_MAX);
+    int producers = bq_notify(queue, false, SIZE_MAX);
+    pthread_mutex_unlock(&queue->lock);
+    bq_wake(queue, true, consumers);
+    bq_wake(queue, false, producers);
+}
+
+// 检查是否已关闭
+bool bq_is_closed(blocking_queue_t *queue)
+{
+    if (queue == NULL)
+    {
+        return true;
+    }
+    pthread_mutex_lock(&queue->lock);
+    bool closed = queue->closed;
+    pthread_mutex_unlock(&queue->lock);
+    return closed;
+}
+
+// 入队，队列满时按timeout_ms等待，超时或队列关闭返回false
+bool bq_push(blocking_queue_t *queue, void *data, long timeout_ms)
+{
+    if (queue == NULL)
+    {
+        return false;
+    }
+
+    struct timespec deadline;
+    if (timeout_ms > 0)
+    {
+        bq_deadline(&deadline, timeout_ms);
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    while (!queue->closed && queue->count == queue->capacity)
+    {
+        if (timeout_ms == 0 || !bq_wait(queue, false, timeout_ms > 0 ? &deadline : NULL))
+        {
+            pthread_mutex_unlock(&queue->lock);
+            return false;
+        }
+    }
+    if (queue->closed)
+    {
+        pthread_mutex_unlock(&queue->lock);
+        return false;
+    }
+
+    queue->buffer[(queue->head + queue->count) % queue->capacity] = data;
+    queue->count++;
+    int wake = bq_notify(queue, true, 1);
+    pthread_mutex_unlock(&queue->lock);
+    bq_wake(queue, true, wake);
+    return true;
+}
+
+// 出队，队列空时按timeout_ms等待，超时或队列已关闭且为空返回false
+bool bq_pop(blocking_queue_t *queue, void **data, long timeout_ms)
+{
+    void *item = NULL;
+    if (bq_pop_batch(queue, &item, 1, timeout_ms) == 0)
+    {
+        return false;
+    }
+    if (data != NULL)
+    {
+        *data = item;
+    }
+    return true;
+}
+
+// 批量出队：等待至少一个元素可用，然后一次取出至多max个
+// 返回取出的元素个数，超时或队列已关闭且为空返回0
+size_t bq_pop_batch(blocking_queue_t *queue, void **out, size_t max, long timeout_ms)
+{
+    if (queue == NULL || out == NULL || max == 0)
+    {
+        return 0;
+    }
+
+    struct timespec deadline;
+    if (timeout_ms > 0)
+    {
+        bq_deadline(&deadline, timeout_ms);
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0)
+    {
+        if (queue->closed || timeout_ms == 0 ||
+            !bq_wait(queue, true, timeout_ms > 0 ? &deadline : NULL))
+        {
+            pthread_mutex_unlock(&queue->lock);
+            return 0;
+        }
+    }
+
+    size_t n = queue->count < max ? queue->count : max;
+    size_t first = queue->capacity - queue->head;
+    if (first > n)
+    {
+        first = n;
+    }
+    memcpy(out, queue->buffer + queue->head, first * sizeof(void *));
+    memcpy(out + first, queue->buffer, (n - first) * sizeof(void *));
+    queue->head = (queue->head + n) % queue->capacity;
+    queue->count -= n;
+
+    int wake = bq_notify(queue, false, n);
+    pthread_mutex_unlock(&queue->lock);
+    bq_wake(queue, false, wake);
+    return n;
+}
@@ -0,0 +1,55 @@
+#ifndef __BLOCKING_QUEUE_H__
+#define __BLOCKING_QUEUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// 有界阻塞队列
+// 队列满时生产者挂起、队列空时消费者挂起，支持超时等待与批量出队。
+// Linux下使用futex挂起等待线程，其他平台退化为条件变量；
+// 定义BQ_NO_FUTEX可强制使用条件变量。
+
+#if defined(__linux__) && !defined(BQ_NO_FUTEX)
+#define BQ_USE_FUTEX 1
+#else
+#define BQ_USE_FUTEX 0
+#endif
+
+// 超时参数：永久等待
+#define BQ_WAIT_FOREVER (-1L)
+
+typedef struct blocking_queue
+{
+    void **buffer;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    bool closed;
+    pthread_mutex_t lock;
+#if BQ_USE_FUTEX
+    uint32_t not_empty_seq;   // futex字：有新元素入队时递增
+    uint32_t not_full_seq;    // futex字：有元素出队时递增
+    size_t waiting_consumers;
+    size_t waiting_producers;
+#else
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+#endif
+} blocking_queue_t;
+
+blocking_queue_t *bq_create(size_t capacity);
+void bq_destroy(blocking_queue_t *queue);
+size_t bq_size(blocking_queue_t *queue);
+size_t bq_capacity(blocking_queue_t *queue);
+bool bq_is_empty(blocking_queue_t *queue);
+void bq_close(blocking_queue_t *queue);
+bool bq_is_closed(blocking_queue_t *queue);
+
+// timeout_ms：0为非阻塞尝试，BQ_WAIT_FOREVER为永久等待
+bool bq_push(blocking_queue_t *queue, void *data, long timeout_ms);
+bool bq_pop(blocking_queue_t *queue, void **data, long timeout_ms);
+size_t bq_pop_batch(blocking_queue_t *queue, void **out, size_t max, long timeout_ms);
+
+#endif // __BLOCKING_QUEUE_H__
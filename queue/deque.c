@@ -0,0 +1,316 @@
+#include "deque.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define DQ_CHUNK_MASK (DQ_CHUNK_SIZE - 1)
+#define DQ_INITIAL_MAP 8
+
+// 获取一个块：优先复用缓存的空闲块
+static void **dq_chunk_alloc(deque_t *dq)
+{
+    if (dq->spare != NULL)
+    {
+        void **chunk = dq->spare;
+        dq->spare = NULL;
+        return chunk;
+    }
+    return (void **)malloc(DQ_CHUNK_SIZE * sizeof(void *));
+}
+
+// 释放映射表中的一个块
+static void dq_chunk_release(deque_t *dq, size_t index)
+{
+    if (dq->spare == NULL)
+    {
+        dq->spare = dq->map[index];
+    }
+    else
+    {
+        free(dq->map[index]);
+    }
+    dq->map[index] = NULL;
+}
+
+// 重新布局映射表：将已用块移动到中间，空间不足时扩容
+static bool dq_remap(deque_t *dq)
+{
+    size_t first = dq->begin >> DQ_CHUNK_SHIFT;
+    size_t used = dq->size == 0 ? 0 : ((dq->begin + dq->size - 1) >> DQ_CHUNK_SHIFT) - first + 1;
+    size_t capacity = dq->map_capacity;
+
+    if (capacity < 2 * (used + 2))
+    {
+        capacity = 2 * (used + 2);
+        void ***map = (void ***)calloc(capacity, sizeof(void **));
+        if (map == NULL)
+        {
+            return false;
+        }
+        size_t new_first = (capacity - used) / 2;
+        memcpy(map + new_first, dq->map + first, used * sizeof(void **));
+        free(dq->map);
+        dq->map = map;
+        dq->map_capacity = capacity;
+        dq->begin = (new_first << DQ_CHUNK_SHIFT) | (dq->begin & DQ_CHUNK_MASK);
+        return true;
+    }
+
+    size_t new_first = (capacity - used) / 2;
+    memmove(dq->map + new_first, dq->map + first, used * sizeof(void **));
+    if (new_first > first)
+    {
+        size_t clear = new_first - first < used ? new_first - first : used;
+        memset(dq->map + first, 0, clear * sizeof(void **));
+    }
+    else if (new_first < first)
+    {
+        size_t start = new_first + used > first ? new_first + used : first;
+        memset(dq->map + start, 0, (first + used - start) * sizeof(void **));
+    }
+    dq->begin = (new_first << DQ_CHUNK_SHIFT) | (dq->begin & DQ_CHUNK_MASK);
+    return true;
+}
+
+// 元素清空后将起点重置到映射表中部
+static void dq_reset_begin(deque_t *dq)
+{
+    dq->begin = (dq->map_capacity / 2) << DQ_CHUNK_SHIFT;
+}
+
+// 创建双端队列
+deque_t *dq_create(void)
+{
+    deque_t *dq = (deque_t *)malloc(sizeof(deque_t));
+    if (dq == NULL)
+    {
+        return NULL;
+    }
+    dq->map = (void ***)calloc(DQ_INITIAL_MAP, sizeof(void **));
+    if (dq->map == NULL)
+    {
+        free(dq);
+        return NULL;
+    }
+    dq->map_capacity = DQ_INITIAL_MAP;
+    dq->size = 0;
+    dq->spare = NULL;
+    dq_reset_begin(dq);
+    return dq;
+}
+
+// 销毁双端队列（不释放元素本身）
+void dq_destroy(deque_t *dq)
+{
+    if (dq == NULL)
+    {
+        return;
+    }
+    dq_clear(dq);
+    free(dq->spare);
+    free(dq->map);
+    free(dq);
+}
+
+// 清空双端队列
+void dq_clear(deque_t *dq)
+{
+    if (dq == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < dq->map_capacity; i++)
+    {
+        if (dq->map[i] != NULL)
+        {
+            dq_chunk_release(dq, i);
+        }
+    }
+    dq->size = 0;
+    dq_reset_begin(dq);
+}
+
+// 获取元素个数
+size_t dq_size(deque_t *dq)
+{
+    if (dq == NULL)
+    {
+        return 0;
+    }
+    return dq->size;
+}
+
+// 检查是否为空
+bool dq_is_empty(deque_t *dq)
+{
+    if (dq == NULL)
+    {
+        return true;
+    }
+    return dq->size == 0;
+}
+
+// 在头部插入
+bool dq_add_first(deque_t *dq, void *data)
+{
+    if (dq == NULL)
+    {
+        return false;
+    }
+
+    if (dq->begin == 0 && !dq_remap(dq))
+    {
+        return false;
+    }
+
+    size_t pos = dq->begin - 1;
+    size_t chunk = pos >> DQ_CHUNK_SHIFT;
+    if (dq->map[chunk] == NULL)
+    {
+        dq->map[chunk] = dq_chunk_alloc(dq);
+        if (dq->map[chunk] == NULL)
+        {
+            return false;
+        }
+    }
+
+    dq->map[chunk][pos & DQ_CHUNK_MASK] = data;
+    dq->begin = pos;
+    dq->size++;
+    return true;
+}
+
+// 在尾部插入
+bool dq_add_last(deque_t *dq, void *data)
+{
+    if (dq == NULL)
+    {
+        return false;
+    }
+
+    size_t pos = dq->begin + dq->size;
+    if ((pos >> DQ_CHUNK_SHIFT) >= dq->map_capacity)
+    {
+        if (!dq_remap(dq))
+        {
+            return false;
+        }
+        pos = dq->begin + dq->size;
+    }
+
+    size_t chunk = pos >> DQ_CHUNK_SHIFT;
+    if (dq->map[chunk] == NULL)
+    {
+        dq->map[chunk] = dq_chunk_alloc(dq);
+        if (dq->map[chunk] == NULL)
+        {
+            return false;
+        }
+    }
+
+    dq->map[chunk][pos & DQ_CHUNK_MASK] = data;
+    dq->size++;
+    return true;
+}
+
+// 移除头部元素
+void *dq_remove_first(deque_t *dq)
+{
+    if (dq == NULL || dq->size == 0)
+    {
+        return NULL;
+    }
+
+    size_t pos = dq->begin;
+    void *data = dq->map[pos >> DQ_CHUNK_SHIFT][pos & DQ_CHUNK_MASK];
+    dq->begin++;
+    dq->size--;
+
+    // 离开当前块或队列变空时归还该块
+    if (dq->size == 0)
+    {
+        dq_chunk_release(dq, pos >> DQ_CHUNK_SHIFT);
+        dq_reset_begin(dq);
+    }
+    else if ((dq->begin & DQ_CHUNK_MASK) == 0)
+    {
+        dq_chunk_release(dq, pos >> DQ_CHUNK_SHIFT);
+    }
+    return data;
+}
+
+// 移除尾部元素
+void *dq_remove_last(deque_t *dq)
+{
+    if (dq == NULL || dq->size == 0)
+    {
+        return NULL;
+    }
+
+    dq->size--;
+    size_t pos = dq->begin + dq->size;
+    void *data = dq->map[pos >> DQ_CHUNK_SHIFT][pos & DQ_CHUNK_MASK];
+
+    if (dq->size == 0)
+    {
+        dq_chunk_release(dq, pos >> DQ_CHUNK_SHIFT);
+        dq_reset_begin(dq);
+    }
+    else if ((pos & DQ_CHUNK_MASK) == 0)
+    {
+        dq_chunk_release(dq, pos >> DQ_CHUNK_SHIFT);
+    }
+    return data;
+}
+
+// 按下标获取元素
+void *dq_get(deque_t *dq, size_t index)
+{
+    if (dq == NULL || index >= dq->size)
+    {
+        return NULL;
+    }
+    size_t pos = dq->begin + index;
+    return dq->map[pos >> DQ_CHUNK_SHIFT][pos & DQ_CHUNK_MASK];
+}
+
+// 获取头部元素
+void *dq_get_first(deque_t *dq)
+{
+    return dq_get(dq, 0);
+}
+
+// 获取尾部元素
+void *dq_get_last(deque_t *dq)
+{
+    if (dq == NULL || dq->size == 0)
+    {
+        return NULL;
+    }
+    return dq_get(dq, dq->size - 1);
+}
+
+// 按下标修改元素
+bool dq_set(deque_t *dq, size_t index, void *data)
+{
+    if (dq == NULL || index >= dq->size)
+    {
+        return false;
+    }
+    size_t pos = dq->begin + index;
+    dq->map[pos >> DQ_CHUNK_SHIFT][pos & DQ_CHUNK_MASK] = data;
+    return true;
+}
+
+// 从头到尾遍历
+void dq_foreach(deque_t *dq, void (*func)(void *data))
+{
+    if (dq == NULL || func == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < dq->size; i++)
+    {
+        size_t pos = dq->begin + i;
+        func(dq->map[pos >> DQ_CHUNK_SHIFT][pos & DQ_CHUNK_MASK]);
+    }
+}
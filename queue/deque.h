@@ -0,0 +1,40 @@
+#ifndef __DEQUE_H__
+#define __DEQUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// 分块双端队列
+// 元素存放在定长块中，块指针存放在居中的块映射表里；
+// 两端插入删除均摊O(1)，按下标访问O(1)，不为单个元素分配内存。
+
+// 每块元素个数（2的幂）
+#define DQ_CHUNK_SHIFT 7
+#define DQ_CHUNK_SIZE ((size_t)1 << DQ_CHUNK_SHIFT)
+
+typedef struct deque
+{
+    void ***map;          // 块映射表，未使用的槽为NULL
+    size_t map_capacity;
+    size_t begin;         // 首元素在虚拟数组中的位置：块号 * DQ_CHUNK_SIZE + 块内偏移
+    size_t size;
+    void **spare;         // 缓存一个空闲块，避免在块边界反复申请释放
+} deque_t;
+
+deque_t *dq_create(void);
+void dq_destroy(deque_t *dq);
+void dq_clear(deque_t *dq);
+size_t dq_size(deque_t *dq);
+bool dq_is_empty(deque_t *dq);
+
+bool dq_add_first(deque_t *dq, void *data);
+bool dq_add_last(deque_t *dq, void *data);
+void *dq_remove_first(deque_t *dq);
+void *dq_remove_last(deque_t *dq);
+void *dq_get(deque_t *dq, size_t index);
+void *dq_get_first(deque_t *dq);
+void *dq_get_last(deque_t *dq);
+bool dq_set(deque_t *dq, size_t index, void *data);
+void dq_foreach(deque_t *dq, void (*func)(void *data));
+
+#endif // __DEQUE_H__
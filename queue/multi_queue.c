@@ -0,0 +1,317 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "multi_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MQ_ARITY 4
+#define MQ_INITIAL_CAPACITY 64
+// 两选一弹出的最大尝试次数，超过后退化为顺序扫描
+#define MQ_POP_ATTEMPTS 64
+
+// 线程私有随机数状态
+static __thread uint64_t mq_seed;
+
+static uint64_t mq_rand(void)
+{
+    uint64_t x = mq_seed;
+    if (x == 0)
+    {
+        // 以线程栈地址作为种子，保证各线程序列不同
+        x = (uint64_t)(uintptr_t)&x * 0x9E3779B97F4A7C15ull | 1;
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    mq_seed = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+// 分片堆：4叉堆，上浮
+static void mq_heap_sift_up(mq_entry_t *heap, size_t index)
+{
+    mq_entry_t item = heap[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / MQ_ARITY;
+        if (heap[parent].priority <= item.priority)
+        {
+            break;
+        }
+        heap[index] = heap[parent];
+        index = parent;
+    }
+    heap[index] = item;
+}
+
+// 分片堆：下沉
+static void mq_heap_sift_down(mq_entry_t *heap, size_t size, size_t index)
+{
+    mq_entry_t item = heap[index];
+    for (;;)
+    {
+        size_t first = index * MQ_ARITY + 1;
+        if (first >= size)
+        {
+            break;
+        }
+        size_t last = first + MQ_ARITY < size ? first + MQ_ARITY : size;
+        size_t best = first;
+        for (size_t child = first + 1; child < last; child++)
+        {
+            if (heap[child].priority < heap[best].priority)
+            {
+                best = child;
+            }
+        }
+        if (heap[best].priority >= item.priority)
+        {
+            break;
+        }
+        heap[index] = heap[best];
+        index = best;
+    }
+    heap[index] = item;
+}
+
+// 在已加锁的分片中插入
+static bool mq_shard_push(mq_shard_t *shard, uint64_t priority, void *data)
+{
+    if (shard->size == shard->capacity)
+    {
+        size_t capacity = shard->capacity * 2;
+        mq_entry_t *heap = (mq_entry_t *)realloc(shard->heap, capacity * sizeof(mq_entry_t));
+        if (heap == NULL)
+        {
+            return false;
+        }
+        shard->heap = heap;
+        shard->capacity = capacity;
+    }
+
+    shard->heap[shard->size].priority = priority;
+    shard->heap[shard->size].data = data;
+    mq_heap_sift_up(shard->heap, shard->size);
+    __atomic_store_n(&shard->top, shard->heap[0].priority, __ATOMIC_RELEASE);
+    __atomic_store_n(&shard->size, shard->size + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// 从已加锁的非空分片中弹出堆顶
+static void mq_shard_pop(mq_shard_t *shard, uint64_t *priority, void **data)
+{
+    mq_entry_t top = shard->heap[0];
+    size_t size = shard->size - 1;
+    if (size > 0)
+    {
+        shard->heap[0] = shard->heap[size];
+        mq_heap_sift_down(shard->heap, size, 0);
+    }
+    __atomic_store_n(&shard->size, size, __ATOMIC_RELEASE);
+    __atomic_store_n(&shard->top, size > 0 ? shard->heap[0].priority : MQ_EMPTY_TOP, __ATOMIC_RELEASE);
+
+    if (priority != NULL)
+    {
+        *priority = top.priority;
+    }
+    if (data != NULL)
+    {
+        *data = top.data;
+    }
+}
+
+// 创建MultiQueue，shard_count为0时按CPU数自动选择
+multi_queue_t *mq_create(size_t shard_count)
+{
+    if (shard_count == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        shard_count = (size_t)(cpus > 0 ? cpus : 1) * MQ_SHARDS_PER_CPU;
+    }
+
+    multi_queue_t *mq = (multi_queue_t *)malloc(sizeof(multi_queue_t));
+    if (mq == NULL)
+    {
+        return NULL;
+    }
+
+    void *shards = NULL;
+    if (posix_memalign(&shards, 64, shard_count * sizeof(mq_shard_t)) != 0)
+    {
+        free(mq);
+        return NULL;
+    }
+    memset(shards, 0, shard_count * sizeof(mq_shard_t));
+    mq->shards = (mq_shard_t *)shards;
+    mq->shard_count = shard_count;
+    mq->size = 0;
+
+    for (size_t i = 0; i < shard_count; i++)
+    {
+        mq_shard_t *shard = &mq->shards[i];
+        shard->heap = (mq_entry_t *)malloc(MQ_INITIAL_CAPACITY * sizeof(mq_entry_t));
+        if (shard->heap == NULL)
+        {
+            mq->shard_count = i;
+            mq_destroy(mq);
+            return NULL;
+        }
+        shard->capacity = MQ_INITIAL_CAPACITY;
+        shard->size = 0;
+        shard->top = MQ_EMPTY_TOP;
+        pthread_mutex_init(&shard->lock, NULL);
+    }
+
+    return mq;
+}
+
+// 销毁MultiQueue（不释放元素本身），调用时不得有其他线程访问
+void mq_destroy(multi_queue_t *mq)
+{
+    if (mq == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < mq->shard_count; i++)
+    {
+        pthread_mutex_destroy(&mq->shards[i].lock);
+        free(mq->shards[i].heap);
+    }
+    free(mq->shards);
+    free(mq);
+}
+
+// 获取近似元素个数
+size_t mq_size(multi_queue_t *mq)
+{
+    if (mq == NULL)
+    {
+        return 0;
+    }
+    return __atomic_load_n(&mq->size, __ATOMIC_RELAXED);
+}
+
+// 检查是否为空（近似）
+bool mq_is_empty(multi_queue_t *mq)
+{
+    return mq_size(mq) == 0;
+}
+
+// 获取分片数
+size_t mq_shard_count(multi_queue_t *mq)
+{
+    if (mq == NULL)
+    {
+        return 0;
+    }
+    return mq->shard_count;
+}
+
+// 插入元素：随机选择一个未被占用的分片
+bool mq_push(multi_queue_t *mq, uint64_t priority, void *data)
+{
+    if (mq == NULL)
+    {
+        return false;
+    }
+
+    mq_shard_t *shard = NULL;
+    for (size_t attempt = 0; attempt < mq->shard_count; attempt++)
+    {
+        mq_shard_t *candidate = &mq->shards[mq_rand() % mq->shard_count];
+        if (pthread_mutex_trylock(&candidate->lock) == 0)
+        {
+            shard = candidate;
+            break;
+        }
+    }
+    if (shard == NULL)
+    {
+        shard = &mq->shards[mq_rand() % mq->shard_count];
+        pthread_mutex_lock(&shard->lock);
+    }
+
+    // 解锁前计数：元素被弹出（随后计数减1）之前计数已经加1，计数不会先减到0以下而回绕
+    bool ok = mq_shard_push(shard, priority, data);
+    if (ok)
+    {
+        __atomic_add_fetch(&mq->size, 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return ok;
+}
+
+// 弹出元素：随机取两个分片，锁住堆顶较小者并弹出
+// 队列为空时返回false
+bool mq_pop(multi_queue_t *mq, uint64_t *priority, void **data)
+{
+    if (mq == NULL)
+    {
+        return false;
+    }
+
+    for (size_t attempt = 0; attempt < MQ_POP_ATTEMPTS; attempt++)
+    {
+        if (__atomic_load_n(&mq->size, __ATOMIC_RELAXED) == 0)
+        {
+            return false;
+        }
+
+        // 优先级可以是UINT64_MAX，因此按size而不是堆顶缓存判断分片是否为空
+        mq_shard_t *a = &mq->shards[mq_rand() % mq->shard_count];
+        mq_shard_t *b = &mq->shards[mq_rand() % mq->shard_count];
+        bool empty_a = __atomic_load_n(&a->size, __ATOMIC_ACQUIRE) == 0;
+        bool empty_b = __atomic_load_n(&b->size, __ATOMIC_ACQUIRE) == 0;
+        if (empty_a && empty_b)
+        {
+            continue;
+        }
+        mq_shard_t *shard;
+        if (empty_a || empty_b)
+        {
+            shard = empty_a ? b : a;
+        }
+        else
+        {
+            uint64_t top_a = __atomic_load_n(&a->top, __ATOMIC_ACQUIRE);
+            uint64_t top_b = __atomic_load_n(&b->top, __ATOMIC_ACQUIRE);
+            shard = top_a <= top_b ? a : b;
+        }
+
+        if (pthread_mutex_trylock(&shard->lock) != 0)
+        {
+            continue;
+        }
+        if (shard->size == 0)
+        {
+            pthread_mutex_unlock(&shard->lock);
+            continue;
+        }
+
+        mq_shard_pop(shard, priority, data);
+        pthread_mutex_unlock(&shard->lock);
+        __atomic_sub_fetch(&mq->size, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+
+    // 随机选择多次失败（元素稀少或竞争激烈），顺序扫描所有分片
+    for (size_t i = 0; i < mq->shard_count; i++)
+    {
+        mq_shard_t *shard = &mq->shards[i];
+        if (__atomic_load_n(&shard->size, __ATOMIC_ACQUIRE) == 0)
+        {
+            continue;
+        }
+        pthread_mutex_lock(&shard->lock);
+        if (shard->size > 0)
+        {
+            mq_shard_pop(shard, priority, data);
+            pthread_mutex_unlock(&shard->lock);
+            __atomic_sub_fetch(&mq->size, 1, __ATOMIC_RELAXED);
+            return true;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+    return false;
+}
@@ -0,0 +1,51 @@
+#ifndef __MULTI_QUEUE_H__
+#define __MULTI_QUEUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// 并发松弛优先队列（MultiQueue）
+// 元素分散在多个加锁的分片堆中，弹出时随机取两个分片比较堆顶，
+// 取较小者。不保证严格的全局顺序，但弹出元素的期望排名误差为O(分片数)。
+// 优先级为无符号64位整数（含UINT64_MAX），数值越小优先级越高。
+
+// 每个CPU对应的默认分片数
+#define MQ_SHARDS_PER_CPU 2
+// 空分片的堆顶缓存值，只用于比较；分片是否为空看size
+#define MQ_EMPTY_TOP UINT64_MAX
+
+typedef struct mq_entry
+{
+    uint64_t priority;
+    void *data;
+} mq_entry_t;
+
+// 分片：独占一条缓存行的头部，避免伪共享
+typedef struct mq_shard
+{
+    pthread_mutex_t lock;
+    mq_entry_t *heap;
+    size_t size;     // 加锁修改，无锁读取
+    size_t capacity;
+    uint64_t top;    // 堆顶优先级缓存，无锁读取
+} __attribute__((aligned(64))) mq_shard_t;
+
+typedef struct multi_queue
+{
+    mq_shard_t *shards;
+    size_t shard_count;
+    size_t size;     // 近似元素总数，原子更新
+} multi_queue_t;
+
+multi_queue_t *mq_create(size_t shard_count);
+void mq_destroy(multi_queue_t *mq);
+size_t mq_size(multi_queue_t *mq);
+bool mq_is_empty(multi_queue_t *mq);
+size_t mq_shard_count(multi_queue_t *mq);
+
+bool mq_push(multi_queue_t *mq, uint64_t priority, void *data);
+bool mq_pop(multi_queue_t *mq, uint64_t *priority, void **data);
+
+#endif // __MULTI_QUEUE_H__
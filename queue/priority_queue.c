@@ -0,0 +1,244 @@
+#include "priority_queue.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PQ_INITIAL_CAPACITY 16
+
+// 分配按缓存行对齐的元素数组：让data[1]位于缓存行起点，
+// 这样下标为 d*i+1 .. d*i+d 的同组子节点不会跨越缓存行
+static bool pq_alloc(priority_queue_t *pq, size_t capacity)
+{
+    if (capacity > (SIZE_MAX - PQ_CACHE_LINE) / sizeof(void *))
+    {
+        return false;
+    }
+
+    void *raw = malloc(capacity * sizeof(void *) + PQ_CACHE_LINE);
+    if (raw == NULL)
+    {
+        return false;
+    }
+
+    uintptr_t first = (uintptr_t)raw + sizeof(void *);
+    uintptr_t aligned = (first + PQ_CACHE_LINE - 1) & ~(uintptr_t)(PQ_CACHE_LINE - 1);
+    void **data = (void **)(aligned - sizeof(void *));
+
+    if (pq->size > 0)
+    {
+        memcpy(data, pq->data, pq->size * sizeof(void *));
+    }
+    free(pq->raw);
+
+    pq->raw = raw;
+    pq->data = data;
+    pq->capacity = capacity;
+    return true;
+}
+
+// 上浮：采用空穴法，减少交换次数
+static void pq_sift_up(priority_queue_t *pq, size_t index)
+{
+    void **data = pq->data;
+    void *item = data[index];
+    size_t arity = pq->arity;
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / arity;
+        if (pq->cmp(item, data[parent]) >= 0)
+        {
+            break;
+        }
+        data[index] = data[parent];
+        index = parent;
+    }
+    data[index] = item;
+}
+
+// 下沉：在同一缓存行内的子节点中选出优先级最高者
+static void pq_sift_down(priority_queue_t *pq, size_t index)
+{
+    void **data = pq->data;
+    void *item = data[index];
+    size_t size = pq->size;
+    size_t arity = pq->arity;
+
+    for (;;)
+    {
+        size_t first = index * arity + 1;
+        if (first >= size)
+        {
+            break;
+        }
+
+        size_t last = first + arity;
+        if (last > size)
+        {
+            last = size;
+        }
+
+        size_t best = first;
+        for (size_t child = first + 1; child < last; child++)
+        {
+            if (pq->cmp(data[child], data[best]) < 0)
+            {
+                best = child;
+            }
+        }
+
+        if (pq->cmp(data[best], item) >= 0)
+        {
+            break;
+        }
+        data[index] = data[best];
+        index = best;
+    }
+    data[index] = item;
+}
+
+// 创建优先队列（默认分叉数）
+priority_queue_t *pq_create(int (*cmp)(void *a, void *b))
+{
+    return pq_create_with_arity(cmp, PQ_DEFAULT_ARITY);
+}
+
+// 创建指定分叉数的优先队列，arity为2时即普通二叉堆
+priority_queue_t *pq_create_with_arity(int (*cmp)(void *a, void *b), size_t arity)
+{
+    if (cmp == NULL || arity < 2 || arity > PQ_MAX_ARITY)
+    {
+        return NULL;
+    }
+
+    priority_queue_t *pq = (priority_queue_t *)malloc(sizeof(priority_queue_t));
+    if (pq == NULL)
+    {
+        return NULL;
+    }
+    pq->data = NULL;
+    pq->raw = NULL;
+    pq->size = 0;
+    pq->capacity = 0;
+    pq->arity = arity;
+    pq->cmp = cmp;
+
+    if (!pq_alloc(pq, PQ_INITIAL_CAPACITY))
+    {
+        free(pq);
+        return NULL;
+    }
+    return pq;
+}
+
+// 销毁优先队列（不释放元素本身）
+void pq_destroy(priority_queue_t *pq)
+{
+    if (pq == NULL)
+    {
+        return;
+    }
+    free(pq->raw);
+    free(pq);
+}
+
+// 清空优先队列
+void pq_clear(priority_queue_t *pq)
+{
+    if (pq == NULL)
+    {
+        return;
+    }
+    pq->size = 0;
+}
+
+// 获取元素个数
+size_t pq_size(priority_queue_t *pq)
+{
+    if (pq == NULL)
+    {
+        return 0;
+    }
+    return pq->size;
+}
+
+// 检查是否为空
+bool pq_is_empty(priority_queue_t *pq)
+{
+    if (pq == NULL)
+    {
+        return true;
+    }
+    return pq->size == 0;
+}
+
+// 获取分叉数
+size_t pq_arity(priority_queue_t *pq)
+{
+    if (pq == NULL)
+    {
+        return 0;
+    }
+    return pq->arity;
+}
+
+// 预留容量
+bool pq_reserve(priority_queue_t *pq, size_t capacity)
+{
+    if (pq == NULL)
+    {
+        return false;
+    }
+    if (capacity <= pq->capacity)
+    {
+        return true;
+    }
+    return pq_alloc(pq, capacity);
+}
+
+// 插入元素
+bool pq_push(priority_queue_t *pq, void *data)
+{
+    if (pq == NULL)
+    {
+        return false;
+    }
+
+    if (pq->size == pq->capacity && !pq_alloc(pq, pq->capacity * 2))
+    {
+        return false;
+    }
+
+    pq->data[pq->size] = data;
+    pq->size++;
+    pq_sift_up(pq, pq->size - 1);
+    return true;
+}
+
+// 弹出堆顶元素
+void *pq_pop(priority_queue_t *pq)
+{
+    if (pq == NULL || pq->size == 0)
+    {
+        return NULL;
+    }
+
+    void *top = pq->data[0];
+    pq->size--;
+    if (pq->size > 0)
+    {
+        pq->data[0] = pq->data[pq->size];
+        pq_sift_down(pq, 0);
+    }
+    return top;
+}
+
+// 查看堆顶元素
+void *pq_peek(priority_queue_t *pq)
+{
+    if (pq == NULL || pq->size == 0)
+    {
+        return NULL;
+    }
+    return pq->data[0];
+}
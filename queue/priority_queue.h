@@ -0,0 +1,39 @@
+#ifndef __PRIORITY_QUEUE_H__
+#define __PRIORITY_QUEUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// 默认分叉数：4个子节点指针(32字节)落在同一缓存行内
+#define PQ_DEFAULT_ARITY 4
+// 允许的最大分叉数
+#define PQ_MAX_ARITY 64
+// 缓存行大小
+#define PQ_CACHE_LINE 64
+
+// 优先队列（d叉堆）
+// cmp(a, b) < 0 表示a的优先级高于b，堆顶为优先级最高的元素
+typedef struct priority_queue
+{
+    void **data;     // 元素数组，data[1]按缓存行对齐，使同一父节点的子节点共享缓存行
+    void *raw;       // 原始分配地址
+    size_t size;
+    size_t capacity;
+    size_t arity;
+    int (*cmp)(void *a, void *b);
+} priority_queue_t;
+
+priority_queue_t *pq_create(int (*cmp)(void *a, void *b));
+priority_queue_t *pq_create_with_arity(int (*cmp)(void *a, void *b), size_t arity);
+void pq_destroy(priority_queue_t *pq);
+void pq_clear(priority_queue_t *pq);
+size_t pq_size(priority_queue_t *pq);
+bool pq_is_empty(priority_queue_t *pq);
+size_t pq_arity(priority_queue_t *pq);
+
+bool pq_reserve(priority_queue_t *pq, size_t capacity);
+bool pq_push(priority_queue_t *pq, void *data);
+void *pq_pop(priority_queue_t *pq);
+void *pq_peek(priority_queue_t *pq);
+
+#endif // __PRIORITY_QUEUE_H__
@@ -0,0 +1,342 @@
+#include "timing_wheel.h"
+#include <stdlib.h>
+
+#define TW_LEVEL0_MASK ((uint64_t)TW_LEVEL0_SIZE - 1)
+#define TW_LEVEL_MASK ((uint64_t)TW_LEVEL_SIZE - 1)
+// 第level层(>=1)槽位下标的起始位
+#define TW_LEVEL_SHIFT(level) (TW_LEVEL0_BITS + ((level) - 1) * TW_LEVEL_BITS)
+// 时间轮可表示的最大时间跨度
+#define TW_MAX_SPAN ((uint64_t)1 << TW_LEVEL_SHIFT(TW_LEVELS))
+
+// 定时器所在层：从链表地址推算，不在时间轮中返回-1
+static int tw_level_of(timing_wheel_t *tw, dl_list_t *list)
+{
+    uintptr_t addr = (uintptr_t)list;
+    uintptr_t level0 = (uintptr_t)tw->level0;
+    uintptr_t levels = (uintptr_t)tw->levels;
+
+    if (addr >= level0 && addr < level0 + sizeof(tw->level0))
+    {
+        return 0;
+    }
+    if (addr >= levels && addr < levels + sizeof(tw->levels))
+    {
+        return (int)((addr - levels) / sizeof(tw->levels[0])) + 1;
+    }
+    return -1;
+}
+
+// 按到期时间将定时器放入对应层的槽位
+static void tw_place(timing_wheel_t *tw, tw_timer_t *timer)
+{
+    uint64_t expires = timer->expires < tw->now ? tw->now : timer->expires;
+    uint64_t delta = expires - tw->now;
+    dl_list_t *slot;
+    size_t level;
+
+    if (delta < TW_LEVEL0_SIZE)
+    {
+        level = 0;
+        slot = &tw->level0[expires & TW_LEVEL0_MASK];
+    }
+    else
+    {
+        for (level = 1; level < TW_LEVELS - 1; level++)
+        {
+            if (delta < ((uint64_t)1 << TW_LEVEL_SHIFT(level + 1)))
+            {
+                break;
+            }
+        }
+        if (delta >= TW_MAX_SPAN)
+        {
+            // 超出范围：放在最远的槽中，级联时会重新计算
+            expires = tw->now + TW_MAX_SPAN - 1;
+        }
+        slot = &tw->levels[level - 1][(expires >> TW_LEVEL_SHIFT(level)) & TW_LEVEL_MASK];
+    }
+
+    dl_add_last(slot, &timer->node);
+    timer->list = slot;
+    tw->level_count[level]++;
+    tw->count++;
+}
+
+// 将高层槽位中的定时器重新分配到低层
+static void tw_cascade(timing_wheel_t *tw, size_t level, size_t index)
+{
+    dl_list_t *slot = &tw->levels[level - 1][index];
+    size_t moved = slot->size;
+    dl_node_t *node = slot->head;
+
+    slot->head = NULL;
+    slot->tail = NULL;
+    slot->size = 0;
+    tw->level_count[level] -= moved;
+    tw->count -= moved;
+
+    while (node != NULL)
+    {
+        dl_node_t *next = node->next;
+        tw_place(tw, (tw_timer_t *)node->data);
+        node = next;
+    }
+}
+
+// 处理一个tick：必要时级联，并将到期定时器整体移入expired
+static void tw_tick(timing_wheel_t *tw, dl_list_t *expired)
+{
+    size_t index = (size_t)(tw->now & TW_LEVEL0_MASK);
+
+    if (index == 0)
+    {
+        for (size_t level = 1; level < TW_LEVELS; level++)
+        {
+            size_t slot = (size_t)((tw->now >> TW_LEVEL_SHIFT(level)) & TW_LEVEL_MASK);
+            tw_cascade(tw, level, slot);
+            if (slot != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    dl_list_t *slot = &tw->level0[index];
+    if (slot->size > 0)
+    {
+        for (dl_node_t *node = slot->head; node != NULL; node = node->next)
+        {
+            ((tw_timer_t *)node->data)->list = expired;
+        }
+
+        // 整条链表拼接到expired尾部
+        if (expired->tail != NULL)
+        {
+            expired->tail->next = slot->head;
+            slot->head->prev = expired->tail;
+        }
+        else
+        {
+            expired->head = slot->head;
+        }
+        expired->tail = slot->tail;
+        expired->size += slot->size;
+
+        tw->level_count[0] -= slot->size;
+        tw->count -= slot->size;
+        slot->head = NULL;
+        slot->tail = NULL;
+        slot->size = 0;
+    }
+
+    tw->now++;
+}
+
+// 推进到now（含），到期定时器移入expired，返回移入的数量
+// stop_on_expire为true时，在第一个产生到期定时器的tick之后返回
+static size_t tw_run_until(timing_wheel_t *tw, uint64_t now, dl_list_t *expired, bool stop_on_expire)
+{
+    size_t before = expired->size;
+
+    while (tw->now <= now)
+    {
+        if (tw->count == 0)
+        {
+            tw->now = now + 1;
+            break;
+        }
+
+        // 低于level的各层均为空时，直到下一次级联第level层之前都无事可做
+        size_t level = 0;
+        while (tw->level_count[level] == 0)
+        {
+            level++;
+        }
+        if (level > 0)
+        {
+            uint64_t mask = ((uint64_t)1 << TW_LEVEL_SHIFT(level)) - 1;
+            if ((tw->now & mask) != 0)
+            {
+                uint64_t next = (tw->now | mask) + 1;
+                tw->now = next <= now ? next : now + 1;
+                continue;
+            }
+        }
+
+        tw_tick(tw, expired);
+        if (stop_on_expire && expired->size > before)
+        {
+            break;
+        }
+    }
+
+    return expired->size - before;
+}
+
+// 创建时间轮，now为第一个待处理的tick
+timing_wheel_t *tw_create(uint64_t now)
+{
+    timing_wheel_t *tw = (timing_wheel_t *)calloc(1, sizeof(timing_wheel_t));
+    if (tw == NULL)
+    {
+        return NULL;
+    }
+    tw->now = now;
+    return tw;
+}
+
+// 销毁时间轮（不释放定时器，挂起的定时器变为未调度状态）
+void tw_destroy(timing_wheel_t *tw)
+{
+    if (tw == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < TW_LEVEL0_SIZE; i++)
+    {
+        for (dl_node_t *node = tw->level0[i].head; node != NULL; node = node->next)
+        {
+            ((tw_timer_t *)node->data)->list = NULL;
+        }
+    }
+    for (size_t level = 0; level < TW_LEVELS - 1; level++)
+    {
+        for (size_t i = 0; i < TW_LEVEL_SIZE; i++)
+        {
+            for (dl_node_t *node = tw->levels[level][i].head; node != NULL; node = node->next)
+            {
+                ((tw_timer_t *)node->data)->list = NULL;
+            }
+        }
+    }
+    free(tw);
+}
+
+// 获取挂起的定时器数量
+size_t tw_size(timing_wheel_t *tw)
+{
+    if (tw == NULL)
+    {
+        return 0;
+    }
+    return tw->count;
+}
+
+// 获取下一个待处理的tick
+uint64_t tw_now(timing_wheel_t *tw)
+{
+    if (tw == NULL)
+    {
+        return 0;
+    }
+    return tw->now;
+}
+
+// 初始化定时器
+void tw_timer_init(tw_timer_t *timer, tw_callback_t callback, void *arg)
+{
+    if (timer == NULL)
+    {
+        return;
+    }
+    timer->node.prev = NULL;
+    timer->node.next = NULL;
+    timer->node.data = timer;
+    timer->list = NULL;
+    timer->expires = 0;
+    timer->callback = callback;
+    timer->arg = arg;
+}
+
+// 检查定时器是否已调度且尚未触发
+bool tw_timer_pending(tw_timer_t *timer)
+{
+    return timer != NULL && timer->list != NULL;
+}
+
+// 调度定时器在expires时刻到期，已调度的定时器会被重新调度
+bool tw_schedule(timing_wheel_t *tw, tw_timer_t *timer, uint64_t expires)
+{
+    if (tw == NULL || timer == NULL)
+    {
+        return false;
+    }
+
+    if (timer->list != NULL)
+    {
+        tw_cancel(tw, timer);
+    }
+    timer->expires = expires;
+    tw_place(tw, timer);
+    return true;
+}
+
+// 取消定时器，未调度时返回false
+bool tw_cancel(timing_wheel_t *tw, tw_timer_t *timer)
+{
+    if (tw == NULL || timer == NULL || timer->list == NULL)
+    {
+        return false;
+    }
+
+    int level = tw_level_of(tw, timer->list);
+    dl_remove(timer->list, &timer->node);
+    timer->list = NULL;
+
+    if (level >= 0)
+    {
+        tw->level_count[level]--;
+        tw->count--;
+    }
+    return true;
+}
+
+// 推进到now（含），依次调用到期定时器的回调，返回触发的数量
+// 回调中可以重新调度自身或取消其他定时器
+size_t tw_advance(timing_wheel_t *tw, uint64_t now)
+{
+    if (tw == NULL)
+    {
+        return 0;
+    }
+
+    size_t fired = 0;
+    dl_list_t expired = {NULL, NULL, 0};
+
+    // 每次只取出一个tick的到期定时器，保证回调中新调度的定时器按时间顺序触发
+    while (tw_run_until(tw, now, &expired, true) > 0)
+    {
+        dl_node_t *node;
+        while ((node = dl_remove_first(&expired)) != NULL)
+        {
+            tw_timer_t *timer = (tw_timer_t *)node->data;
+            timer->list = NULL;
+            fired++;
+            if (timer->callback != NULL)
+            {
+                timer->callback(timer, timer->arg);
+            }
+        }
+    }
+    return fired;
+}
+
+// 推进到now（含），将到期定时器整体移入调用方的expired链表以便批量处理
+// 移出的定时器变为未调度状态，返回移入的数量
+size_t tw_collect_expired(timing_wheel_t *tw, uint64_t now, dl_list_t *expired)
+{
+    if (tw == NULL || expired == NULL)
+    {
+        return 0;
+    }
+
+    dl_node_t *last = expired->tail;
+    size_t count = tw_run_until(tw, now, expired, false);
+
+    for (dl_node_t *node = last != NULL ? last->next : expired->head; node != NULL; node = node->next)
+    {
+        ((tw_timer_t *)node->data)->list = NULL;
+    }
+    return count;
+}
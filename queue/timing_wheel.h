@@ -0,0 +1,55 @@
+#ifndef __TIMING_WHEEL_H__
+#define __TIMING_WHEEL_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "linked_list/double_list.h"
+
+// 分层时间轮
+// 第0层256个槽，每个槽对应1个tick；之后每层64个槽，每个槽覆盖上一层一整圈。
+// 定时器内嵌dl_node_t挂在槽位链表上，调度与取消O(1)，推进时间均摊O(1)。
+// 超出最高层范围的定时器先放在最远的槽中，级联时重新计算位置。
+
+#define TW_LEVEL0_BITS 8
+#define TW_LEVEL_BITS 6
+#define TW_LEVELS 5
+#define TW_LEVEL0_SIZE (1u << TW_LEVEL0_BITS)
+#define TW_LEVEL_SIZE (1u << TW_LEVEL_BITS)
+
+struct tw_timer;
+typedef void (*tw_callback_t)(struct tw_timer *timer, void *arg);
+
+// 定时器：由调用方分配（通常内嵌在连接等对象中）
+typedef struct tw_timer
+{
+    dl_node_t node;       // 槽位链表节点，node.data指向定时器自身
+    dl_list_t *list;      // 当前所在链表，未调度时为NULL
+    uint64_t expires;     // 到期tick（绝对时间）
+    tw_callback_t callback;
+    void *arg;
+} tw_timer_t;
+
+typedef struct timing_wheel
+{
+    uint64_t now;         // 下一个待处理的tick，之前的tick均已处理
+    size_t count;         // 挂起的定时器数量
+    size_t level_count[TW_LEVELS];
+    dl_list_t level0[TW_LEVEL0_SIZE];
+    dl_list_t levels[TW_LEVELS - 1][TW_LEVEL_SIZE];
+} timing_wheel_t;
+
+timing_wheel_t *tw_create(uint64_t now);
+void tw_destroy(timing_wheel_t *tw);
+size_t tw_size(timing_wheel_t *tw);
+uint64_t tw_now(timing_wheel_t *tw);
+
+void tw_timer_init(tw_timer_t *timer, tw_callback_t callback, void *arg);
+bool tw_timer_pending(tw_timer_t *timer);
+bool tw_schedule(timing_wheel_t *tw, tw_timer_t *timer, uint64_t expires);
+bool tw_cancel(timing_wheel_t *tw, tw_timer_t *timer);
+
+size_t tw_advance(timing_wheel_t *tw, uint64_t now);
+size_t tw_collect_expired(timing_wheel_t *tw, uint64_t now, dl_list_t *expired);
+
+#endif // __TIMING_WHEEL_H__
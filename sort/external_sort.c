@@ -0,0 +1,516 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "external_sort.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// 临时文件中的一个顺串：起始字节偏移与字节数
+typedef struct es_run
+{
+    uint64_t offset;
+    uint64_t bytes;
+} es_run_t;
+
+// 临时文件及其中的顺串
+typedef struct es_temp
+{
+    int fd;
+    uint64_t size;
+    es_run_t *runs;
+    size_t count;
+    size_t capacity;
+} es_temp_t;
+
+// 归并时一路的读取状态
+typedef struct es_reader
+{
+    uint64_t next;  // 下一次读取的文件偏移
+    uint64_t end;
+    char *buf;
+    size_t pos;
+    size_t len;
+    size_t cap;
+} es_reader_t;
+
+// 归并输出：写到流或临时文件末尾
+typedef struct es_writer
+{
+    FILE *fp;
+    es_temp_t *temp;
+    char *buf;
+    size_t len;
+    size_t cap;
+} es_writer_t;
+
+// 一次排序的公共状态
+typedef struct es_context
+{
+    const es_config_t *config;
+    es_stats_t *stats;
+    char *memory;       // 生成顺串时的排序缓冲，归并时切分为各路缓冲
+    size_t capacity;    // memory的字节数，是记录大小的整数倍
+    size_t fan_in;      // 一趟最多归并的路数
+} es_context_t;
+
+static uint64_t es_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 在temp_dir下创建临时文件并立即unlink，只保留文件描述符
+static bool es_temp_open(es_temp_t *temp, const char *dir)
+{
+    memset(temp, 0, sizeof(*temp));
+    temp->fd = -1;
+    if (dir == NULL || dir[0] == '\0')
+    {
+        dir = getenv("TMPDIR");
+    }
+    if (dir == NULL || dir[0] == '\0')
+    {
+        dir = "/tmp";
+    }
+
+    size_t len = strlen(dir) + sizeof("/es_XXXXXX");
+    char *path = (char *)malloc(len);
+    if (path == NULL)
+    {
+        return false;
+    }
+    snprintf(path, len, "%s/es_XXXXXX", dir);
+    temp->fd = mkstemp(path);
+    if (temp->fd >= 0)
+    {
+        unlink(path);
+    }
+    free(path);
+    return temp->fd >= 0;
+}
+
+static void es_temp_close(es_temp_t *temp)
+{
+    if (temp->fd >= 0)
+    {
+        close(temp->fd);
+    }
+    free(temp->runs);
+    memset(temp, 0, sizeof(*temp));
+    temp->fd = -1;
+}
+
+static bool es_temp_add_run(es_temp_t *temp, uint64_t offset, uint64_t bytes)
+{
+    if (temp->count == temp->capacity)
+    {
+        size_t capacity = temp->capacity == 0 ? 16 : temp->capacity * 2;
+        es_run_t *runs = (es_run_t *)realloc(temp->runs, capacity * sizeof(es_run_t));
+        if (runs == NULL)
+        {
+            return false;
+        }
+        temp->runs = runs;
+        temp->capacity = capacity;
+    }
+    temp->runs[temp->count].offset = offset;
+    temp->runs[temp->count].bytes = bytes;
+    temp->count++;
+    return true;
+}
+
+// 在临时文件末尾追加数据，处理部分写入与信号中断
+static bool es_temp_append(es_temp_t *temp, const char *data, size_t bytes, es_stats_t *stats)
+{
+    while (bytes > 0)
+    {
+        ssize_t n = pwrite(temp->fd, data, bytes, (off_t)temp->size);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        bytes -= (size_t)n;
+        temp->size += (uint64_t)n;
+        stats->bytes_written += (uint64_t)n;
+    }
+    return true;
+}
+
+// 从流中读满bytes字节或读到文件末尾，返回读到的字节数
+static size_t es_read_full(FILE *in, char *buf, size_t bytes)
+{
+    size_t total = 0;
+    while (total < bytes)
+    {
+        size_t n = fread(buf + total, 1, bytes - total, in);
+        if (n == 0)
+        {
+            break;
+        }
+        total += n;
+    }
+    return total;
+}
+
+static bool es_write_stream(FILE *out, const char *data, size_t bytes, es_stats_t *stats)
+{
+    if (bytes > 0 && fwrite(data, 1, bytes, out) != bytes)
+    {
+        return false;
+    }
+    stats->bytes_written += bytes;
+    return true;
+}
+
+static bool es_writer_flush(es_writer_t *writer, es_stats_t *stats)
+{
+    bool ok = writer->fp != NULL ? es_write_stream(writer->fp, writer->buf, writer->len, stats)
+                                 : es_temp_append(writer->temp, writer->buf, writer->len, stats);
+    writer->len = 0;
+    return ok;
+}
+
+// 读入下一块，返回false表示出错；读完时len为0
+static bool es_reader_fill(es_reader_t *reader, int fd, es_stats_t *stats)
+{
+    uint64_t remain = reader->end - reader->next;
+    size_t want = remain < reader->cap ? (size_t)remain : reader->cap;
+    size_t got = 0;
+
+    while (got < want)
+    {
+        ssize_t n = pread(fd, reader->buf + got, want - got, (off_t)(reader->next + got));
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        if (n == 0)
+        {
+            return false;
+        }
+        got += (size_t)n;
+    }
+    reader->next += got;
+    reader->pos = 0;
+    reader->len = got;
+    stats->bytes_read += got;
+    return true;
+}
+
+// 堆中a路的当前记录是否排在b路之前
+static bool es_less(es_reader_t *readers, size_t a, size_t b, int (*cmp)(const void *, const void *))
+{
+    return cmp(readers[a].buf + readers[a].pos, readers[b].buf + readers[b].pos) < 0;
+}
+
+static void es_sift_down(size_t *heap, size_t size, size_t index, es_reader_t *readers,
+                         int (*cmp)(const void *, const void *))
+{
+    size_t item = heap[index];
+    for (;;)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && es_less(readers, heap[child + 1], heap[child], cmp))
+        {
+            child++;
+        }
+        if (!es_less(readers, heap[child], item, cmp))
+        {
+            break;
+        }
+        heap[index] = heap[child];
+        index = child;
+    }
+    heap[index] = item;
+}
+
+// 把src中的count个顺串归并后交给writer，内存缓冲平均分给各路与输出
+static bool es_merge(es_context_t *ctx, es_temp_t *src, const es_run_t *runs, size_t count,
+                     es_writer_t *writer)
+{
+    size_t record_size = ctx->config->record_size;
+    int (*cmp)(const void *, const void *) = ctx->config->cmp;
+    size_t share = ctx->capacity / (count + 1) / record_size * record_size;
+
+    es_reader_t *readers = (es_reader_t *)malloc(count * sizeof(es_reader_t));
+    size_t *heap = (size_t *)malloc(count * sizeof(size_t));
+    if (readers == NULL || heap == NULL)
+    {
+        free(readers);
+        free(heap);
+        return false;
+    }
+
+    bool ok = true;
+    size_t size = 0;
+    for (size_t i = 0; i < count && ok; i++)
+    {
+        readers[i].next = runs[i].offset;
+        readers[i].end = runs[i].offset + runs[i].bytes;
+        readers[i].buf = ctx->memory + i * share;
+        readers[i].cap = share;
+        ok = es_reader_fill(&readers[i], src->fd, ctx->stats);
+        if (ok && readers[i].len > 0)
+        {
+            heap[size++] = i;
+        }
+    }
+    writer->buf = ctx->memory + count * share;
+    writer->cap = share;
+    writer->len = 0;
+
+    for (size_t i = size / 2; ok && i-- > 0;)
+    {
+        es_sift_down(heap, size, i, readers, cmp);
+    }
+
+    while (ok && size > 0)
+    {
+        es_reader_t *top = &readers[heap[0]];
+        if (writer->len == writer->cap && !es_writer_flush(writer, ctx->stats))
+        {
+            ok = false;
+            break;
+        }
+        memcpy(writer->buf + writer->len, top->buf + top->pos, record_size);
+        writer->len += record_size;
+
+        top->pos += record_size;
+        if (top->pos == top->len)
+        {
+            if (!es_reader_fill(top, src->fd, ctx->stats))
+            {
+                ok = false;
+                break;
+            }
+            if (top->len == 0)
+            {
+                heap[0] = heap[--size];
+            }
+        }
+        es_sift_down(heap, size, 0, readers, cmp);
+    }
+    if (ok)
+    {
+        ok = es_writer_flush(writer, ctx->stats);
+    }
+
+    free(readers);
+    free(heap);
+    return ok;
+}
+
+// 每次读入一整块内存排序，写成临时文件中的一个顺串
+// 第一块就读完全部输入时直接写到out，*done置为true
+static bool es_make_runs(es_context_t *ctx, FILE *in, FILE *out, es_temp_t *temp, bool *done)
+{
+    size_t record_size = ctx->config->record_size;
+    es_stats_t *stats = ctx->stats;
+    uint64_t start = es_now_ns();
+
+    *done = false;
+    for (;;)
+    {
+        size_t got = es_read_full(in, ctx->memory, ctx->capacity);
+        if (ferror(in) || got % record_size != 0)
+        {
+            return false;
+        }
+        stats->bytes_read += got;
+        if (got == 0)
+        {
+            break;
+        }
+
+        // 探测是否已到末尾，只有一块时不需要临时文件
+        bool last = got < ctx->capacity;
+        if (!last)
+        {
+            int c = fgetc(in);
+            last = c == EOF;
+            if (!last && ungetc(c, in) == EOF)
+            {
+                return false;
+            }
+        }
+
+        size_t records = got / record_size;
+        uint64_t sort_start = es_now_ns();
+        qsort(ctx->memory, records, record_size, ctx->config->cmp);
+        stats->sort_ns += es_now_ns() - sort_start;
+        stats->records += records;
+        stats->runs++;
+
+        if (last && temp->fd < 0)
+        {
+            *done = true;
+            bool ok = es_write_stream(out, ctx->memory, got, stats);
+            stats->run_ns = es_now_ns() - start;
+            return ok;
+        }
+        if (temp->fd < 0 && !es_temp_open(temp, ctx->config->temp_dir))
+        {
+            return false;
+        }
+        uint64_t offset = temp->size;
+        if (!es_temp_append(temp, ctx->memory, got, stats) || !es_temp_add_run(temp, offset, got))
+        {
+            return false;
+        }
+        if (last)
+        {
+            break;
+        }
+    }
+    if (temp->fd < 0)
+    {
+        *done = true;
+    }
+    stats->run_ns = es_now_ns() - start;
+    return true;
+}
+
+// 顺串多于一趟能归并的路数时，每fan_in个归并成一个新顺串，直到只剩一趟
+static bool es_merge_all(es_context_t *ctx, es_temp_t *src, FILE *out)
+{
+    es_stats_t *stats = ctx->stats;
+    uint64_t start = es_now_ns();
+    bool ok = true;
+
+    while (ok && src->count > ctx->fan_in)
+    {
+        es_temp_t dst;
+        if (!es_temp_open(&dst, ctx->config->temp_dir))
+        {
+            ok = false;
+            break;
+        }
+        es_writer_t writer = {NULL, &dst, NULL, 0, 0};
+        for (size_t first = 0; ok && first < src->count; first += ctx->fan_in)
+        {
+            size_t count = src->count - first < ctx->fan_in ? src->count - first : ctx->fan_in;
+            uint64_t offset = dst.size;
+            ok = es_merge(ctx, src, src->runs + first, count, &writer)
+                 && es_temp_add_run(&dst, offset, dst.size - offset);
+        }
+        es_temp_close(src);
+        *src = dst;
+        stats->merge_passes++;
+    }
+
+    if (ok)
+    {
+        es_writer_t writer = {out, NULL, NULL, 0, 0};
+        ok = es_merge(ctx, src, src->runs, src->count, &writer);
+        stats->merge_passes++;
+    }
+    stats->merge_ns = es_now_ns() - start;
+    return ok;
+}
+
+// 排序in中的定长记录并写到out，成功返回true
+// 输入长度不是记录大小的整数倍、读写失败或内存不足时返回false，此时out中的内容不完整
+// stats可以为NULL
+bool es_sort_stream(FILE *in, FILE *out, const es_config_t *config, es_stats_t *stats)
+{
+    es_stats_t local;
+    if (stats == NULL)
+    {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (in == NULL || out == NULL || config == NULL || config->cmp == NULL || config->record_size == 0)
+    {
+        return false;
+    }
+
+    size_t record_size = config->record_size;
+    size_t memory = config->memory == 0 ? ES_DEFAULT_MEMORY : config->memory;
+    size_t block = config->block == 0 ? ES_DEFAULT_BLOCK : config->block;
+    // 至少要容纳两路输入加一路输出各一条记录
+    if (memory / record_size < 3)
+    {
+        return false;
+    }
+
+    es_context_t ctx;
+    ctx.config = config;
+    ctx.stats = stats;
+    ctx.capacity = memory / record_size * record_size;
+    block = block < record_size ? record_size : block / record_size * record_size;
+    ctx.fan_in = ctx.capacity / block;
+    ctx.fan_in = ctx.fan_in < 3 ? 2 : ctx.fan_in - 1;
+    ctx.memory = (char *)malloc(ctx.capacity);
+    if (ctx.memory == NULL)
+    {
+        return false;
+    }
+
+    es_temp_t temp;
+    memset(&temp, 0, sizeof(temp));
+    temp.fd = -1;
+    bool done = false;
+    bool ok = es_make_runs(&ctx, in, out, &temp, &done);
+    if (ok && !done)
+    {
+        ok = es_merge_all(&ctx, &temp, out);
+    }
+    if (ok && fflush(out) != 0)
+    {
+        ok = false;
+    }
+
+    es_temp_close(&temp);
+    free(ctx.memory);
+    return ok;
+}
+
+// 排序文件in_path并写到out_path，两者不能是同一个文件
+bool es_sort_file(const char *in_path, const char *out_path, const es_config_t *config,
+                  es_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        memset(stats, 0, sizeof(*stats));
+    }
+    if (in_path == NULL || out_path == NULL)
+    {
+        return false;
+    }
+
+    FILE *in = fopen(in_path, "rb");
+    if (in == NULL)
+    {
+        return false;
+    }
+    FILE *out = fopen(out_path, "wb");
+    if (out == NULL)
+    {
+        fclose(in);
+        return false;
+    }
+
+    bool ok = es_sort_stream(in, out, config, stats);
+    fclose(in);
+    if (fclose(out) != 0)
+    {
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,45 @@
+#ifndef __EXTERNAL_SORT_H__
+#define __EXTERNAL_SORT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define ES_DEFAULT_MEMORY (64u << 20)  // 默认内存预算64MB
+#define ES_DEFAULT_BLOCK  (1u << 20)   // 默认每次读写1MB
+
+// 外部排序
+// 对定长记录组成的文件或流排序，数据量可以远大于内存。分两个阶段：
+// 1. 生成顺串：每次读入不超过内存预算的记录，在内存中排序后顺序写入临时文件；
+// 2. 多路归并：用按各顺串当前记录排序的二叉堆归并，每路一个大块读缓冲，
+//    输出也整块写出；顺串数超过一次能归并的路数时分多趟归并。
+// 全部输入能装进内存预算时不产生临时文件，直接排序后写出。
+// 临时文件创建后立即unlink，进程异常退出也不会残留。记录之间不保证稳定。
+typedef struct es_config
+{
+    size_t record_size;                         // 每条记录的字节数
+    int (*cmp)(const void *a, const void *b);   // 记录比较函数，与qsort兼容
+    size_t memory;                              // 内存预算（字节），0为ES_DEFAULT_MEMORY
+    size_t block;                               // 归并时每路缓冲的目标大小，0为ES_DEFAULT_BLOCK
+    const char *temp_dir;                       // 临时文件目录，NULL时取TMPDIR环境变量或/tmp
+} es_config_t;
+
+// 排序统计：各阶段耗时与读写字节数（含临时文件）
+typedef struct es_stats
+{
+    uint64_t records;
+    size_t runs;            // 生成的顺串数
+    size_t merge_passes;    // 归并趟数，全部在内存中完成时为0
+    uint64_t run_ns;        // 生成顺串阶段耗时（含读入与写出）
+    uint64_t sort_ns;       // 其中内存排序的耗时
+    uint64_t merge_ns;      // 归并阶段耗时
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+} es_stats_t;
+
+bool es_sort_stream(FILE *in, FILE *out, const es_config_t *config, es_stats_t *stats);
+bool es_sort_file(const char *in_path, const char *out_path, const es_config_t *config,
+                  es_stats_t *stats);
+
+#endif // __EXTERNAL_SORT_H__
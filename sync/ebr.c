@@ -0,0 +1,266 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ebr.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+// 读计数槽位分配：线程首次进入读临界区时取得槽位，线程退出时归还
+static pthread_once_t ebr_slot_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ebr_slot_key;
+static pthread_mutex_t ebr_slot_lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t ebr_free_slots[EBR_MAX_THREADS];
+static size_t ebr_free_count;
+// 曾分配过的槽位数，推进纪元时只需扫描这些槽位与共用槽，原子访问
+static size_t ebr_slot_high;
+// 线程的槽位+1，0表示尚未分配
+static __thread size_t ebr_thread_slot;
+
+static void ebr_slot_release(void *arg)
+{
+    pthread_mutex_lock(&ebr_slot_lock);
+    ebr_free_slots[ebr_free_count++] = (size_t)(uintptr_t)arg - 1;
+    pthread_mutex_unlock(&ebr_slot_lock);
+}
+
+static void ebr_slot_key_init(void)
+{
+    pthread_key_create(&ebr_slot_key, ebr_slot_release);
+}
+
+static size_t ebr_reader_slot(void)
+{
+    if (ebr_thread_slot == 0)
+    {
+        pthread_once(&ebr_slot_once, ebr_slot_key_init);
+        size_t slot = EBR_MAX_THREADS;
+        pthread_mutex_lock(&ebr_slot_lock);
+        if (ebr_free_count > 0)
+        {
+            slot = ebr_free_slots[--ebr_free_count];
+        }
+        else if (ebr_slot_high < EBR_MAX_THREADS)
+        {
+            slot = ebr_slot_high;
+            // 先于本线程读取纪元可见，推进纪元的线程不会漏扫这个槽位
+            __atomic_store_n(&ebr_slot_high, slot + 1, __ATOMIC_SEQ_CST);
+        }
+        pthread_mutex_unlock(&ebr_slot_lock);
+        if (slot < EBR_MAX_THREADS)
+        {
+            pthread_setspecific(ebr_slot_key, (void *)(uintptr_t)(slot + 1));
+        }
+        ebr_thread_slot = slot + 1;
+    }
+    return ebr_thread_slot - 1;
+}
+
+static void ebr_release(ebr_retired_t *item)
+{
+    if (item->free_fn != NULL)
+    {
+        item->free_fn(item->ptr, item->arg);
+    }
+    else
+    {
+        free(item->ptr);
+    }
+}
+
+// 尝试将纪元从epoch推进到epoch+1，返回纪元是否已大于epoch
+// 需要纪元epoch-1已无读线程；推进后epoch-1时退休的指针不再可达
+static bool ebr_try_advance(ebr_domain_t *domain, size_t epoch)
+{
+    size_t parity = (epoch + 1) & 1;
+    size_t high = __atomic_load_n(&ebr_slot_high, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&domain->readers[EBR_MAX_THREADS].active[parity], __ATOMIC_SEQ_CST) != 0)
+    {
+        return __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST) > epoch;
+    }
+    for (size_t i = 0; i < high; i++)
+    {
+        if (__atomic_load_n(&domain->readers[i].active[parity], __ATOMIC_SEQ_CST) != 0)
+        {
+            return __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST) > epoch;
+        }
+    }
+    // 纪元只增不减，CAS失败说明其他线程已推进
+    size_t expected = epoch;
+    __atomic_compare_exchange_n(&domain->epoch, &expected, epoch + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return true;
+}
+
+// 等待纪元推进到target
+static void ebr_wait_epoch(ebr_domain_t *domain, size_t target)
+{
+    size_t epoch;
+    while ((epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST)) < target)
+    {
+        if (!ebr_try_advance(domain, epoch))
+        {
+            sched_yield();
+        }
+    }
+}
+
+// 释放列表中已不可达的指针（调用方持有limbo->lock）
+static void ebr_limbo_reclaim(ebr_domain_t *domain, ebr_limbo_t *limbo)
+{
+    size_t epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+    while (limbo->head < limbo->count && limbo->items[limbo->head].epoch + 2 <= epoch)
+    {
+        ebr_release(&limbo->items[limbo->head++]);
+    }
+    if (limbo->head == limbo->count)
+    {
+        limbo->head = 0;
+        limbo->count = 0;
+    }
+    limbo->next_scan = limbo->count - limbo->head + EBR_RECLAIM_BATCH;
+}
+
+// 初始化待回收列表
+void ebr_limbo_init(ebr_limbo_t *limbo)
+{
+    memset(limbo, 0, sizeof(ebr_limbo_t));
+    limbo->next_scan = EBR_RECLAIM_BATCH;
+    pthread_mutex_init(&limbo->lock, NULL);
+}
+
+// 销毁待回收列表，立即释放全部待回收指针，调用时不得有读线程
+void ebr_limbo_destroy(ebr_limbo_t *limbo)
+{
+    for (size_t i = limbo->head; i < limbo->count; i++)
+    {
+        ebr_release(&limbo->items[i]);
+    }
+    free(limbo->items);
+    limbo->items = NULL;
+    limbo->head = 0;
+    limbo->count = 0;
+    limbo->capacity = 0;
+    pthread_mutex_destroy(&limbo->lock);
+}
+
+// 初始化回收域
+void ebr_init(ebr_domain_t *domain)
+{
+    memset(domain, 0, sizeof(ebr_domain_t));
+    ebr_limbo_init(&domain->limbo);
+}
+
+// 销毁回收域，立即释放自带列表中的全部待回收指针，调用时不得有读线程
+void ebr_destroy(ebr_domain_t *domain)
+{
+    ebr_limbo_destroy(&domain->limbo);
+}
+
+// 进入读临界区
+// 先在当前纪元的奇偶组计数，再确认纪元未变；变了说明可能错过推进检查，需重试。
+// 由此保证活跃读线程只可能登记在当前纪元或前一个纪元。
+// 独占槽只有本线程写，计数用普通的原子写；写与之后的纪元读之间需要全序，用seq_cst
+ebr_guard_t ebr_enter(ebr_domain_t *domain)
+{
+    ebr_guard_t guard;
+    guard.slot = ebr_reader_slot();
+    for (;;)
+    {
+        guard.epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+        size_t *active = &domain->readers[guard.slot].active[guard.epoch & 1];
+        if (guard.slot < EBR_MAX_THREADS)
+        {
+            __atomic_store_n(active, __atomic_load_n(active, __ATOMIC_RELAXED) + 1, __ATOMIC_SEQ_CST);
+        }
+        else
+        {
+            __atomic_fetch_add(active, 1, __ATOMIC_SEQ_CST);
+        }
+        if (__atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST) == guard.epoch)
+        {
+            return guard;
+        }
+        ebr_exit(domain, guard);
+    }
+}
+
+// 退出读临界区
+void ebr_exit(ebr_domain_t *domain, ebr_guard_t guard)
+{
+    size_t *active = &domain->readers[guard.slot].active[guard.epoch & 1];
+    if (guard.slot < EBR_MAX_THREADS)
+    {
+        __atomic_store_n(active, __atomic_load_n(active, __ATOMIC_RELAXED) - 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_fetch_sub(active, 1, __ATOMIC_RELEASE);
+    }
+}
+
+// 退休一个已摘除的指针，之后用free()释放
+void ebr_retire(ebr_domain_t *domain, void *ptr)
+{
+    ebr_retire_to(domain, &domain->limbo, ptr, NULL, NULL);
+}
+
+// 退休一个已摘除的指针，待所有可能看到它的读线程退出后调用free_fn(ptr, arg)
+// 调用方不得处于读临界区中
+void ebr_retire_with(ebr_domain_t *domain, void *ptr, ebr_free_fn free_fn, void *arg)
+{
+    ebr_retire_to(domain, &domain->limbo, ptr, free_fn, arg);
+}
+
+// 退休到指定的待回收列表；free_fn在某个退休到同一列表的线程中调用
+// 调用方不得处于读临界区中
+void ebr_retire_to(ebr_domain_t *domain, ebr_limbo_t *limbo, void *ptr, ebr_free_fn free_fn, void *arg)
+{
+    size_t epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+    ebr_retired_t item = {ptr, free_fn, arg, epoch};
+
+    pthread_mutex_lock(&limbo->lock);
+    if (limbo->count == limbo->capacity && limbo->head > 0)
+    {
+        memmove(limbo->items, limbo->items + limbo->head, (limbo->count - limbo->head) * sizeof(ebr_retired_t));
+        limbo->count -= limbo->head;
+        limbo->head = 0;
+    }
+    if (limbo->count == limbo->capacity)
+    {
+        size_t capacity = limbo->capacity == 0 ? EBR_RECLAIM_BATCH : limbo->capacity * 2;
+        ebr_retired_t *items = (ebr_retired_t *)realloc(limbo->items, capacity * sizeof(ebr_retired_t));
+        if (items == NULL)
+        {
+            // 内存不足：同步等待纪元推进两次后直接释放
+            pthread_mutex_unlock(&limbo->lock);
+            ebr_wait_epoch(domain, epoch + 2);
+            ebr_release(&item);
+            return;
+        }
+        limbo->items = items;
+        limbo->capacity = capacity;
+    }
+    limbo->items[limbo->count++] = item;
+
+    // 待回收指针较多时尝试推进两次，释放最老的一批
+    if (limbo->count - limbo->head >= limbo->next_scan)
+    {
+        epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+        if (ebr_try_advance(domain, epoch))
+        {
+            ebr_try_advance(domain, epoch + 1);
+        }
+        ebr_limbo_reclaim(domain, limbo);
+    }
+    pthread_mutex_unlock(&limbo->lock);
+}
+
+// 等待当前所有读临界区结束，并释放此前退休到自带列表的全部指针
+// 调用方不得处于读临界区中
+void ebr_synchronize(ebr_domain_t *domain)
+{
+    pthread_mutex_lock(&domain->limbo.lock);
+    ebr_wait_epoch(domain, __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST) + 2);
+    ebr_limbo_reclaim(domain, &domain->limbo);
+    pthread_mutex_unlock(&domain->limbo.lock);
+}
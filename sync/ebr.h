@@ -0,0 +1,79 @@
+#ifndef __EBR_H__
+#define __EBR_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+// 纪元回收（Epoch-Based Reclamation）
+// 读线程在访问共享结构前进入读临界区，写线程摘除节点后将其"退休"，
+// 待所有可能看到该节点的读线程都退出后才真正释放。
+// 每个线程在每个回收域中有一个独占缓存行的读计数槽，进入与退出只写自己的槽，
+// 不加锁，也没有原子读改写；线程退出后槽位被新线程复用。
+// 同时存在的线程超过EBR_MAX_THREADS时，多出的线程共用一个以原子加减计数的槽。
+// 退休的指针连同退休时的纪元放入待回收列表，纪元推进两次后释放；
+// 纪元以CAS推进，不加锁，扫描读计数槽的代价按EBR_RECLAIM_BATCH次退休分摊。
+// 回收域自带一个待回收列表（ebr_retire）；多个写线程频繁退休时，
+// 调用方可为每个分片建一个ebr_limbo_t并用ebr_retire_to退休，避免争用同一把锁。
+
+// 独占读计数槽的线程数上限（所有回收域共用同一套槽位编号）
+#define EBR_MAX_THREADS 256
+// 待回收列表每新增这么多指针尝试推进一次纪元
+#define EBR_RECLAIM_BATCH 128
+
+typedef void (*ebr_free_fn)(void *ptr, void *arg);
+
+// 读线程计数：按纪元奇偶分两组
+typedef struct ebr_reader_slot
+{
+    size_t active[2];
+} __attribute__((aligned(64))) ebr_reader_slot_t;
+
+typedef struct ebr_retired
+{
+    void *ptr;
+    ebr_free_fn free_fn;    // NULL表示用free()释放
+    void *arg;
+    size_t epoch;           // 退休时的纪元
+} ebr_retired_t;
+
+// 待回收列表：items[head, count)按退休纪元非降序排列
+typedef struct ebr_limbo
+{
+    pthread_mutex_t lock;
+    ebr_retired_t *items;
+    size_t head;
+    size_t count;
+    size_t capacity;
+    size_t next_scan;       // 待回收数达到该值时尝试推进纪元
+} ebr_limbo_t;
+
+typedef struct ebr_domain
+{
+    size_t epoch;           // 全局纪元，原子访问
+    ebr_reader_slot_t readers[EBR_MAX_THREADS + 1];    // 最后一个槽由超出上限的线程共用
+    ebr_limbo_t limbo;      // ebr_retire使用的待回收列表
+} ebr_domain_t;
+
+// 读临界区凭证
+typedef struct ebr_guard
+{
+    size_t slot;
+    size_t epoch;
+} ebr_guard_t;
+
+void ebr_init(ebr_domain_t *domain);
+void ebr_destroy(ebr_domain_t *domain);
+
+ebr_guard_t ebr_enter(ebr_domain_t *domain);
+void ebr_exit(ebr_domain_t *domain, ebr_guard_t guard);
+
+void ebr_retire(ebr_domain_t *domain, void *ptr);
+void ebr_retire_with(ebr_domain_t *domain, void *ptr, ebr_free_fn free_fn, void *arg);
+void ebr_synchronize(ebr_domain_t *domain);
+
+void ebr_limbo_init(ebr_limbo_t *limbo);
+void ebr_limbo_destroy(ebr_limbo_t *limbo);
+void ebr_retire_to(ebr_domain_t *domain, ebr_limbo_t *limbo, void *ptr, ebr_free_fn free_fn, void *arg);
+
+#endif // __EBR_H__
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "tree/art.h"
+#include "Unity/src/unity.h"
+
+#define RANDOM_KEYS 4000
+#define MAX_KEY_LEN 24
+
+#define V(x) ((void *)(uintptr_t)(x))
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+typedef struct ref_key
+{
+    unsigned char bytes[MAX_KEY_LEN];
+    size_t len;
+} ref_key_t;
+
+typedef struct collect
+{
+    ref_key_t keys[RANDOM_KEYS];
+    uintptr_t values[RANDOM_KEYS];
+    size_t count;
+    size_t limit;
+} collect_t;
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static int ref_cmp(const void *a, const void *b)
+{
+    const ref_key_t *x = (const ref_key_t *)a;
+    const ref_key_t *y = (const ref_key_t *)b;
+    size_t n = x->len < y->len ? x->len : y->len;
+    int c = memcmp(x->bytes, y->bytes, n);
+    if (c != 0)
+    {
+        return c;
+    }
+    return (x->len > y->len) - (x->len < y->len);
+}
+
+static bool collect_visit(const unsigned char *key, size_t len, void *value, void *arg)
+{
+    collect_t *out = (collect_t *)arg;
+    TEST_ASSERT_TRUE(len <= MAX_KEY_LEN);
+    memcpy(out->keys[out->count].bytes, key, len);
+    out->keys[out->count].len = len;
+    out->values[out->count] = (uintptr_t)value;
+    out->count++;
+    return out->limit == 0 || out->count < out->limit;
+}
+
+static bool count_only_visit(const unsigned char *key, size_t len, void *value, void *arg)
+{
+    (void)key;
+    (void)len;
+    (void)value;
+    (void)arg;
+    return true;
+}
+
+static size_t foreach_count;
+
+static void count_visit(const unsigned char *key, size_t len, void *value)
+{
+    (void)key;
+    (void)len;
+    (void)value;
+    foreach_count++;
+}
+
+// 测试创建
+void test_art_create_should_start_empty(void)
+{
+    art_tree_t *art = art_create();
+
+    TEST_ASSERT_NOT_NULL(art);
+    TEST_ASSERT_TRUE(art_is_empty(art));
+    TEST_ASSERT_NULL(art_get(art, "a", 1));
+    TEST_ASSERT_FALSE(art_remove(art, "a", 1, NULL));
+    TEST_ASSERT_FALSE(art_longest_prefix(art, "a", 1, NULL, NULL));
+    art_destroy(art);
+}
+
+// 测试键互为前缀：短键挂在内部节点上，删除后节点收缩
+void test_art_prefix_keys_should_coexist(void)
+{
+    art_tree_t *art = art_create();
+    const char *keys[] = {"", "a", "ab", "abc", "abd", "b", "abcdefghijklmnopqrstuvwxyz"};
+    void *value = NULL;
+
+    for (size_t i = 0; i < 7; i++)
+    {
+        TEST_ASSERT_TRUE(art_put(art, keys[i], strlen(keys[i]), V(i + 1)));
+    }
+    TEST_ASSERT_EQUAL(7, art_size(art));
+    for (size_t i = 0; i < 7; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR(V(i + 1), art_get(art, keys[i], strlen(keys[i])));
+    }
+    TEST_ASSERT_NULL(art_get(art, "abcd", 4));
+    TEST_ASSERT_NULL(art_get(art, "abcdefghijklmnopqrstuvwxyZ", 26));
+    TEST_ASSERT_NULL(art_get(art, "abcdefghijklmnopqrstuvwxy", 25));
+
+    // 更新不增加键数
+    TEST_ASSERT_TRUE(art_put(art, "ab", 2, V(100)));
+    TEST_ASSERT_EQUAL(7, art_size(art));
+    TEST_ASSERT_EQUAL_PTR(V(100), art_get(art, "ab", 2));
+
+    TEST_ASSERT_TRUE(art_remove(art, "ab", 2, &value));
+    TEST_ASSERT_EQUAL_PTR(V(100), value);
+    TEST_ASSERT_FALSE(art_find(art, "ab", 2, NULL));
+    TEST_ASSERT_EQUAL_PTR(V(4), art_get(art, "abc", 3));
+    TEST_ASSERT_TRUE(art_remove(art, "abc", 3, NULL));
+    TEST_ASSERT_TRUE(art_remove(art, "abd", 3, NULL));
+    TEST_ASSERT_EQUAL_PTR(V(7), art_get(art, keys[6], 26));
+    TEST_ASSERT_TRUE(art_remove(art, "", 0, NULL));
+    TEST_ASSERT_EQUAL_PTR(V(2), art_get(art, "a", 1));
+    TEST_ASSERT_EQUAL(3, art_size(art));
+
+    foreach_count = 0;
+    art_foreach(art, count_visit);
+    TEST_ASSERT_EQUAL(3, foreach_count);
+    art_destroy(art);
+}
+
+// 测试随机二进制键：增删查与有序遍历始终与排序后的参照数组一致，节点经历各级增长与收缩
+void test_art_random_keys_should_match_sorted_reference(void)
+{
+    art_tree_t *art = art_create();
+    ref_key_t *ref = (ref_key_t *)calloc(RANDOM_KEYS, sizeof(ref_key_t));
+    collect_t *seen = (collect_t *)calloc(1, sizeof(collect_t));
+    uint64_t seed = 7;
+    size_t count = 0;
+
+    for (size_t i = 0; i < RANDOM_KEYS; i++)
+    {
+        // 首字节取值范围大以产生Node256，后续字节取值小以产生长公共前缀和键互为前缀
+        ref_key_t key;
+        key.len = 1 + next_rand(&seed) % MAX_KEY_LEN;
+        key.bytes[0] = (unsigned char)(next_rand(&seed) % 200);
+        for (size_t b = 1; b < key.len; b++)
+        {
+            key.bytes[b] = (unsigned char)(b < 14 ? 0 : next_rand(&seed) % 3);
+        }
+        bool exists = art_find(art, key.bytes, key.len, NULL);
+        TEST_ASSERT_TRUE(art_put(art, key.bytes, key.len, V(i)));
+        if (!exists)
+        {
+            ref[count++] = key;
+        }
+    }
+    TEST_ASSERT_EQUAL(count, art_size(art));
+    qsort(ref, count, sizeof(ref_key_t), ref_cmp);
+
+    art_scan_prefix(art, NULL, 0, collect_visit, seen);
+    TEST_ASSERT_EQUAL(count, seen->count);
+    for (size_t i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(0, ref_cmp(&ref[i], &seen->keys[i]));
+        TEST_ASSERT_EQUAL_PTR(V(seen->values[i]), art_get(art, ref[i].bytes, ref[i].len));
+    }
+
+    // 删除一半，剩余的键仍可查到且有序
+    for (size_t i = 0; i < count; i += 2)
+    {
+        TEST_ASSERT_TRUE(art_remove(art, ref[i].bytes, ref[i].len, NULL));
+        TEST_ASSERT_FALSE(art_find(art, ref[i].bytes, ref[i].len, NULL));
+    }
+    seen->count = 0;
+    art_scan_prefix(art, NULL, 0, collect_visit, seen);
+    TEST_ASSERT_EQUAL(count / 2, seen->count);
+    for (size_t i = 1, j = 0; i < count; i += 2, j++)
+    {
+        TEST_ASSERT_EQUAL(0, ref_cmp(&ref[i], &seen->keys[j]));
+        TEST_ASSERT_TRUE(art_find(art, ref[i].bytes, ref[i].len, NULL));
+    }
+
+    // 全部删除后树为空
+    for (size_t i = 1; i < count; i += 2)
+    {
+        TEST_ASSERT_TRUE(art_remove(art, ref[i].bytes, ref[i].len, NULL));
+    }
+    TEST_ASSERT_TRUE(art_is_empty(art));
+    TEST_ASSERT_NULL(art->root);
+    free(ref);
+    free(seen);
+    art_destroy(art);
+}
+
+// 测试前缀扫描：前缀可在压缩路径中途结束，回调返回false时停止
+void test_art_scan_prefix_should_visit_matching_keys_in_order(void)
+{
+    art_tree_t *art = art_create();
+    collect_t *seen = (collect_t *)calloc(1, sizeof(collect_t));
+    const char *keys[] = {"/api/v1/users", "/api/v1/users/42", "/api/v1/orders", "/api/v2/users", "/static/app.js",
+                          "/api"};
+
+    for (size_t i = 0; i < 6; i++)
+    {
+        art_put(art, keys[i], strlen(keys[i]), V(i));
+    }
+
+    TEST_ASSERT_EQUAL(3, art_scan_prefix(art, "/api/v1/", 8, collect_visit, seen));
+    TEST_ASSERT_EQUAL(3, seen->count);
+    TEST_ASSERT_EQUAL_MEMORY("/api/v1/orders", seen->keys[0].bytes, 14);
+    TEST_ASSERT_EQUAL_MEMORY("/api/v1/users", seen->keys[1].bytes, 13);
+    TEST_ASSERT_EQUAL(13, seen->keys[1].len);
+    TEST_ASSERT_EQUAL(16, seen->keys[2].len);
+
+    seen->count = 0;
+    TEST_ASSERT_EQUAL(5, art_scan_prefix(art, "/a", 2, collect_visit, seen));
+    TEST_ASSERT_EQUAL(4, seen->keys[0].len);
+
+    seen->count = 0;
+    TEST_ASSERT_EQUAL(1, art_scan_prefix(art, "/api/v1/users/", 14, collect_visit, seen));
+    TEST_ASSERT_EQUAL(0, art_scan_prefix(art, "/api/v3", 7, collect_visit, seen));
+    TEST_ASSERT_EQUAL(0, art_scan_prefix(art, "/static/app.jsx", 15, collect_visit, seen));
+
+    seen->count = 0;
+    seen->limit = 2;
+    TEST_ASSERT_EQUAL(2, art_scan_prefix(art, "", 0, collect_visit, seen));
+    free(seen);
+    art_destroy(art);
+}
+
+// 测试最长前缀匹配：按请求路径找到最具体的路由
+void test_art_longest_prefix_should_pick_most_specific_route(void)
+{
+    art_tree_t *art = art_create();
+    size_t match = 0;
+    void *value = NULL;
+
+    art_put(art, "/", 1, V(1));
+    art_put(art, "/api/", 5, V(2));
+    art_put(art, "/api/v1/users/", 14, V(3));
+    art_put(art, "/api/v1/users/admin/settings/notifications", 42, V(4));
+
+    TEST_ASSERT_TRUE(art_longest_prefix(art, "/api/v1/users/42", 16, &match, &value));
+    TEST_ASSERT_EQUAL(14, match);
+    TEST_ASSERT_EQUAL_PTR(V(3), value);
+    TEST_ASSERT_TRUE(art_longest_prefix(art, "/api/v2/x", 9, &match, &value));
+    TEST_ASSERT_EQUAL_PTR(V(2), value);
+    TEST_ASSERT_TRUE(art_longest_prefix(art, "/api/v1/users/admin/settings/notificationZ", 42, &match, &value));
+    TEST_ASSERT_EQUAL(14, match);
+    TEST_ASSERT_TRUE(art_longest_prefix(art, "/api/v1/users/admin/settings/notifications/email", 48, &match, &value));
+    TEST_ASSERT_EQUAL_PTR(V(4), value);
+    TEST_ASSERT_TRUE(art_longest_prefix(art, "/index.html", 11, &match, &value));
+    TEST_ASSERT_EQUAL(1, match);
+    TEST_ASSERT_FALSE(art_longest_prefix(art, "api", 3, &match, &value));
+    art_destroy(art);
+}
+
+// 测试大量键：覆盖Node4到Node256的增长，清空后可重用
+void test_art_many_keys_should_grow_and_clear(void)
+{
+    art_tree_t *art = art_create();
+    char key[32];
+
+    for (int i = 0; i < 100000; i++)
+    {
+        int len = snprintf(key, sizeof(key), "/route/%d", i);
+        TEST_ASSERT_TRUE(art_put(art, key, (size_t)len, V(i)));
+    }
+    TEST_ASSERT_EQUAL(100000, art_size(art));
+    for (int i = 0; i < 100000; i += 7)
+    {
+        int len = snprintf(key, sizeof(key), "/route/%d", i);
+        TEST_ASSERT_EQUAL_PTR(V(i), art_get(art, key, (size_t)len));
+    }
+    TEST_ASSERT_EQUAL(11111, art_scan_prefix(art, "/route/1", 8, count_only_visit, NULL));
+
+    art_clear(art);
+    TEST_ASSERT_TRUE(art_is_empty(art));
+    TEST_ASSERT_TRUE(art_put(art, "x", 1, V(1)));
+    TEST_ASSERT_EQUAL(1, art_size(art));
+    art_destroy(art);
+}
+
+// 测试空指针
+void test_art_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(art_put(NULL, "a", 1, NULL));
+    TEST_ASSERT_NULL(art_get(NULL, "a", 1));
+    TEST_ASSERT_FALSE(art_find(NULL, "a", 1, NULL));
+    TEST_ASSERT_FALSE(art_remove(NULL, "a", 1, NULL));
+    TEST_ASSERT_FALSE(art_longest_prefix(NULL, "a", 1, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, art_scan_prefix(NULL, "a", 1, collect_visit, NULL));
+    TEST_ASSERT_EQUAL(0, art_size(NULL));
+    TEST_ASSERT_TRUE(art_is_empty(NULL));
+    art_foreach(NULL, count_visit);
+    art_clear(NULL);
+    art_destroy(NULL);
+
+    art_tree_t *art = art_create();
+    TEST_ASSERT_FALSE(art_put(art, NULL, 1, NULL));
+    TEST_ASSERT_TRUE(art_put(art, NULL, 0, V(5)));
+    TEST_ASSERT_EQUAL_PTR(V(5), art_get(art, "", 0));
+    art_destroy(art);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_art_create_should_start_empty);
+    RUN_TEST(test_art_prefix_keys_should_coexist);
+    RUN_TEST(test_art_random_keys_should_match_sorted_reference);
+    RUN_TEST(test_art_scan_prefix_should_visit_matching_keys_in_order);
+    RUN_TEST(test_art_longest_prefix_should_pick_most_specific_route);
+    RUN_TEST(test_art_many_keys_should_grow_and_clear);
+    RUN_TEST(test_art_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
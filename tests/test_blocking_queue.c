@@ -0,0 +1,238 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include "queue/blocking_queue.h"
+#include "Unity/src/unity.h"
+
+#define PRODUCER_COUNT 3
+#define ITEMS_PER_PRODUCER 10000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static long elapsed_ms(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+
+// 测试创建
+void test_bq_create_should_create_empty_queue(void)
+{
+    blocking_queue_t *queue = bq_create(4);
+
+    TEST_ASSERT_NOT_NULL(queue);
+    TEST_ASSERT_EQUAL(4, bq_capacity(queue));
+    TEST_ASSERT_EQUAL(0, bq_size(queue));
+    TEST_ASSERT_TRUE(bq_is_empty(queue));
+    TEST_ASSERT_FALSE(bq_is_closed(queue));
+    TEST_ASSERT_NULL(bq_create(0));
+
+    bq_destroy(queue);
+}
+
+// 测试先进先出与环形回绕
+void test_bq_push_pop_should_be_fifo(void)
+{
+    blocking_queue_t *queue = bq_create(3);
+    int values[5] = {1, 2, 3, 4, 5};
+    void *item = NULL;
+
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            TEST_ASSERT_TRUE(bq_push(queue, &values[i + round % 3], 0));
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            TEST_ASSERT_TRUE(bq_pop(queue, &item, 0));
+            TEST_ASSERT_EQUAL_PTR(&values[i + round % 3], item);
+        }
+    }
+
+    bq_destroy(queue);
+}
+
+// 测试非阻塞与超时
+void test_bq_should_time_out_when_empty_or_full(void)
+{
+    blocking_queue_t *queue = bq_create(1);
+    void *item = NULL;
+    struct timespec start;
+
+    TEST_ASSERT_FALSE(bq_pop(queue, &item, 0));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    TEST_ASSERT_FALSE(bq_pop(queue, &item, 50));
+    TEST_ASSERT_TRUE(elapsed_ms(&start) >= 45);
+
+    TEST_ASSERT_TRUE(bq_push(queue, NULL, 0));
+    TEST_ASSERT_FALSE(bq_push(queue, NULL, 0));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    TEST_ASSERT_FALSE(bq_push(queue, NULL, 50));
+    TEST_ASSERT_TRUE(elapsed_ms(&start) >= 45);
+
+    bq_destroy(queue);
+}
+
+// 测试批量出队
+void test_bq_pop_batch_should_take_up_to_max_items(void)
+{
+    blocking_queue_t *queue = bq_create(8);
+    void *out[8];
+
+    for (uintptr_t i = 1; i <= 6; i++)
+    {
+        bq_push(queue, (void *)i, 0);
+    }
+
+    TEST_ASSERT_EQUAL(4, bq_pop_batch(queue, out, 4, 0));
+    TEST_ASSERT_EQUAL_PTR((void *)1, out[0]);
+    TEST_ASSERT_EQUAL_PTR((void *)4, out[3]);
+
+    // 回绕后批量取出
+    for (uintptr_t i = 7; i <= 10; i++)
+    {
+        bq_push(queue, (void *)i, 0);
+    }
+    TEST_ASSERT_EQUAL(6, bq_pop_batch(queue, out, 8, 0));
+    for (uintptr_t i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)(i + 5), out[i]);
+    }
+    TEST_ASSERT_EQUAL(0, bq_pop_batch(queue, out, 8, 0));
+
+    bq_destroy(queue);
+}
+
+static void *producer_run(void *arg)
+{
+    blocking_queue_t *queue = (blocking_queue_t *)arg;
+    for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER; i++)
+    {
+        bq_push(queue, (void *)i, BQ_WAIT_FOREVER);
+    }
+    return NULL;
+}
+
+// 测试多生产者与批量消费者
+void test_bq_producers_and_batch_consumer_should_transfer_all_items(void)
+{
+    blocking_queue_t *queue = bq_create(16);
+    pthread_t producers[PRODUCER_COUNT];
+
+    for (int i = 0; i < PRODUCER_COUNT; i++)
+    {
+        pthread_create(&producers[i], NULL, producer_run, queue);
+    }
+
+    uint64_t sum = 0;
+    size_t received = 0;
+    void *out[32];
+    while (received < PRODUCER_COUNT * ITEMS_PER_PRODUCER)
+    {
+        size_t n = bq_pop_batch(queue, out, 32, 1000);
+        TEST_ASSERT_TRUE(n > 0);
+        for (size_t i = 0; i < n; i++)
+        {
+            sum += (uintptr_t)out[i];
+        }
+        received += n;
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+
+    uint64_t expected = (uint64_t)PRODUCER_COUNT * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2;
+    TEST_ASSERT_EQUAL_UINT64(expected, sum);
+
+    bq_destroy(queue);
+}
+
+static void *blocked_consumer_run(void *arg)
+{
+    blocking_queue_t *queue = (blocking_queue_t *)arg;
+    void *item = NULL;
+    return bq_pop(queue, &item, BQ_WAIT_FOREVER) ? (void *)1 : NULL;
+}
+
+// 测试关闭队列唤醒挂起的消费者
+void test_bq_close_should_wake_blocked_consumers(void)
+{
+    blocking_queue_t *queue = bq_create(4);
+    pthread_t consumer;
+    void *result = (void *)1;
+
+    pthread_create(&consumer, NULL, blocked_consumer_run, queue);
+    struct timespec pause = {0, 20000000L};
+    nanosleep(&pause, NULL);
+    bq_close(queue);
+    pthread_join(consumer, &result);
+
+    TEST_ASSERT_NULL(result);
+    TEST_ASSERT_TRUE(bq_is_closed(queue));
+    TEST_ASSERT_FALSE(bq_push(queue, NULL, 0));
+
+    bq_destroy(queue);
+}
+
+// 测试关闭后仍可取完剩余元素
+void test_bq_close_should_drain_remaining_items(void)
+{
+    blocking_queue_t *queue = bq_create(4);
+    void *item = NULL;
+
+    bq_push(queue, (void *)7, 0);
+    bq_close(queue);
+
+    TEST_ASSERT_TRUE(bq_pop(queue, &item, BQ_WAIT_FOREVER));
+    TEST_ASSERT_EQUAL_PTR((void *)7, item);
+    TEST_ASSERT_FALSE(bq_pop(queue, &item, BQ_WAIT_FOREVER));
+
+    bq_destroy(queue);
+}
+
+// 测试空指针
+void test_bq_edge_cases_should_handle_null_inputs(void)
+{
+    void *out[1];
+
+    TEST_ASSERT_FALSE(bq_push(NULL, NULL, 0));
+    TEST_ASSERT_FALSE(bq_pop(NULL, NULL, 0));
+    TEST_ASSERT_EQUAL(0, bq_pop_batch(NULL, out, 1, 0));
+    TEST_ASSERT_EQUAL(0, bq_size(NULL));
+    TEST_ASSERT_TRUE(bq_is_closed(NULL));
+    bq_close(NULL);
+    bq_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bq_create_should_create_empty_queue);
+    RUN_TEST(test_bq_push_pop_should_be_fifo);
+    RUN_TEST(test_bq_should_time_out_when_empty_or_full);
+    RUN_TEST(test_bq_pop_batch_should_take_up_to_max_items);
+    RUN_TEST(test_bq_producers_and_batch_consumer_should_transfer_all_items);
+    RUN_TEST(test_bq_close_should_wake_blocked_consumers);
+    RUN_TEST(test_bq_close_should_drain_remaining_items);
+    RUN_TEST(test_bq_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
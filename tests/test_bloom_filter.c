@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "hash_table/bloom_filter.h"
+#include "hash/hash.h"
+#include "Unity/src/unity.h"
+
+#define KEY_COUNT 20000
+#define PROBE_COUNT 200000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 统计不在过滤器中的键被误报的比例
+static double measure_fpr(bloom_filter_t *bf)
+{
+    size_t positives = 0;
+    for (uint64_t i = 0; i < PROBE_COUNT; i++)
+    {
+        positives += bf_contains_hash(bf, hash_u64(i + 1000000000ull));
+    }
+    return (double)positives / PROBE_COUNT;
+}
+
+// 测试创建与参数
+void test_bf_create_should_size_for_target_rate(void)
+{
+    bloom_filter_t *bf = bf_create(1000, 0.01);
+
+    TEST_ASSERT_NOT_NULL(bf);
+    TEST_ASSERT_EQUAL(0, bf_count(bf));
+    TEST_ASSERT_EQUAL(0, bf_bits(bf) % BF_BLOCK_BITS);
+    // 1%误判率约需每键9.6位、k=7
+    TEST_ASSERT_TRUE(bf_bits(bf) >= 9600);
+    TEST_ASSERT_EQUAL(7, bf_hash_count(bf));
+    TEST_ASSERT_FALSE(bf_contains(bf, "a", 1));
+    bf_destroy(bf);
+
+    TEST_ASSERT_NULL(bf_create(0, 0.01));
+    TEST_ASSERT_NULL(bf_create(100, 0.0));
+    TEST_ASSERT_NULL(bf_create(100, 1.0));
+}
+
+// 测试已添加的键一定能查到，误判率接近目标
+void test_bf_should_have_no_false_negatives(void)
+{
+    static const double rates[] = {0.1, 0.01, 0.001};
+
+    for (size_t r = 0; r < 3; r++)
+    {
+        bloom_filter_t *bf = bf_create(KEY_COUNT, rates[r]);
+        for (uint64_t i = 0; i < KEY_COUNT; i++)
+        {
+            bf_add_hash(bf, hash_u64(i));
+        }
+        TEST_ASSERT_EQUAL(KEY_COUNT, bf_count(bf));
+        for (uint64_t i = 0; i < KEY_COUNT; i++)
+        {
+            TEST_ASSERT_TRUE(bf_contains_hash(bf, hash_u64(i)));
+        }
+        TEST_ASSERT_TRUE(measure_fpr(bf) < rates[r] * 1.5);
+        bf_destroy(bf);
+    }
+}
+
+// 测试字节串键
+void test_bf_string_keys(void)
+{
+    bloom_filter_t *bf = bf_create(100, 0.01);
+    char key[32];
+
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(key, sizeof(key), "user:%d", i);
+        bf_add(bf, key, strlen(key));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(key, sizeof(key), "user:%d", i);
+        TEST_ASSERT_TRUE(bf_contains(bf, key, strlen(key)));
+    }
+
+    bf_clear(bf);
+    TEST_ASSERT_EQUAL(0, bf_count(bf));
+    TEST_ASSERT_FALSE(bf_contains(bf, "user:1", 6));
+    bf_destroy(bf);
+}
+
+// 测试批量接口与逐个调用结果一致
+void test_bf_bulk_should_match_single(void)
+{
+    bloom_filter_t *single = bf_create(KEY_COUNT, 0.01);
+    bloom_filter_t *bulk = bf_create(KEY_COUNT, 0.01);
+    uint64_t *keys = (uint64_t *)malloc(2 * KEY_COUNT * sizeof(uint64_t));
+    uint64_t *hashes = (uint64_t *)malloc(2 * KEY_COUNT * sizeof(uint64_t));
+    bool *out = (bool *)malloc(2 * KEY_COUNT * sizeof(bool));
+
+    for (uint64_t i = 0; i < 2 * KEY_COUNT; i++)
+    {
+        keys[i] = i;
+    }
+    hash_u64_bulk(keys, 2 * KEY_COUNT, hashes);
+    for (size_t i = 0; i < KEY_COUNT; i++)
+    {
+        bf_add_hash(single, hashes[i]);
+    }
+    bf_add_bulk(bulk, hashes, KEY_COUNT);
+    TEST_ASSERT_EQUAL(KEY_COUNT, bf_count(bulk));
+
+    size_t positives = bf_contains_bulk(bulk, hashes, 2 * KEY_COUNT, out);
+    size_t expected = 0;
+    for (size_t i = 0; i < 2 * KEY_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(bf_contains_hash(single, hashes[i]), out[i]);
+        expected += out[i];
+    }
+    TEST_ASSERT_EQUAL(expected, positives);
+    TEST_ASSERT_TRUE(positives >= KEY_COUNT);
+    TEST_ASSERT_EQUAL(positives, bf_contains_bulk(bulk, hashes, 2 * KEY_COUNT, NULL));
+
+    free(out);
+    free(hashes);
+    free(keys);
+    bf_destroy(bulk);
+    bf_destroy(single);
+}
+
+// 测试序列化往返与格式校验
+void test_bf_serialize_roundtrip(void)
+{
+    bloom_filter_t *bf = bf_create(KEY_COUNT, 0.01);
+    for (uint64_t i = 0; i < KEY_COUNT; i++)
+    {
+        bf_add_hash(bf, hash_u64(i));
+    }
+
+    size_t size = bf_serialized_size(bf);
+    uint8_t *buf = (uint8_t *)malloc(size);
+    TEST_ASSERT_EQUAL(0, bf_serialize(bf, buf, size - 1));
+    TEST_ASSERT_EQUAL(size, bf_serialize(bf, buf, size));
+
+    bloom_filter_t *copy = bf_deserialize(buf, size);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_EQUAL(bf_count(bf), bf_count(copy));
+    TEST_ASSERT_EQUAL(bf_bits(bf), bf_bits(copy));
+    TEST_ASSERT_EQUAL(bf_hash_count(bf), bf_hash_count(copy));
+    for (uint64_t i = 0; i < 2 * KEY_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(bf_contains_hash(bf, hash_u64(i)), bf_contains_hash(copy, hash_u64(i)));
+    }
+
+    // 按小端存储：魔数为"BLF1"，位数组的每个字低字节在前
+    TEST_ASSERT_EQUAL_MEMORY("BLF1", buf, 4);
+    TEST_ASSERT_EQUAL(bf_hash_count(bf), buf[4]);
+    bool little_endian = true;
+    for (size_t i = 0; i < bf_bits(bf) / 64; i++)
+    {
+        for (size_t b = 0; b < 8; b++)
+        {
+            little_endian &= buf[24 + i * 8 + b] == (uint8_t)(bf->words[i] >> (8 * b));
+        }
+    }
+    TEST_ASSERT_TRUE(little_endian);
+
+    // 长度不符、魔数错误都拒绝
+    TEST_ASSERT_NULL(bf_deserialize(buf, size - 1));
+    TEST_ASSERT_NULL(bf_deserialize(buf, 8));
+    buf[0] ^= 0xFF;
+    TEST_ASSERT_NULL(bf_deserialize(buf, size));
+
+    free(buf);
+    bf_destroy(copy);
+    bf_destroy(bf);
+}
+
+// 测试空指针
+void test_bf_edge_cases_should_handle_null_inputs(void)
+{
+    bf_add(NULL, "a", 1);
+    bf_add_hash(NULL, 1);
+    bf_add_bulk(NULL, NULL, 0);
+    TEST_ASSERT_FALSE(bf_contains(NULL, "a", 1));
+    TEST_ASSERT_FALSE(bf_contains_hash(NULL, 1));
+    TEST_ASSERT_EQUAL(0, bf_contains_bulk(NULL, NULL, 0, NULL));
+    TEST_ASSERT_EQUAL(0, bf_count(NULL));
+    TEST_ASSERT_EQUAL(0, bf_bits(NULL));
+    TEST_ASSERT_EQUAL(0, bf_serialized_size(NULL));
+    TEST_ASSERT_EQUAL(0, bf_serialize(NULL, NULL, 0));
+    TEST_ASSERT_NULL(bf_deserialize(NULL, 0));
+    bf_clear(NULL);
+    bf_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bf_create_should_size_for_target_rate);
+    RUN_TEST(test_bf_should_have_no_false_negatives);
+    RUN_TEST(test_bf_string_keys);
+    RUN_TEST(test_bf_bulk_should_match_single);
+    RUN_TEST(test_bf_serialize_roundtrip);
+    RUN_TEST(test_bf_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
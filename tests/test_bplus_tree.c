@@ -0,0 +1,394 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "tree/bplus_tree.h"
+#include "Unity/src/unity.h"
+
+#define KEY_RANGE 20000
+#define OP_COUNT 60000
+
+#define P(x) ((void *)(uintptr_t)(x))
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 降序比较，用于确认通用键确实按cmp排序
+static int desc_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x < y) - (x > y);
+}
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static int key_order(bplus_tree_t *bpt, uint64_t a, uint64_t b)
+{
+    if (bpt->cmp != NULL)
+    {
+        return bpt->cmp(P(a), P(b));
+    }
+    return (a > b) - (a < b);
+}
+
+// 检查子树：节点内有序、键落在父节点给出的区间内、非根节点不少于BPT_MIN_KEYS
+// （末尾追加时分裂出的最右叶节点除外）、填充槽为UINT64_MAX、所有叶节点在同一层；
+// 返回子树中的元素数
+static size_t check_node(bplus_tree_t *bpt, bpt_node_t *node, size_t level, bool has_low, uint64_t low,
+                         bool has_high, uint64_t high, bpt_leaf_t **prev_leaf)
+{
+    TEST_ASSERT_EQUAL(level == 1, node->leaf);
+    if (node != bpt->root && node != &bpt->last->base)
+    {
+        TEST_ASSERT_TRUE(node->count >= BPT_MIN_KEYS);
+    }
+    TEST_ASSERT_TRUE(node->count <= BPT_NODE_KEYS);
+    for (size_t i = node->count; i < BPT_NODE_KEYS; i++)
+    {
+        TEST_ASSERT_TRUE(node->keys[i] == UINT64_MAX);
+    }
+    for (size_t i = 0; i < node->count; i++)
+    {
+        if (i > 0)
+        {
+            TEST_ASSERT_TRUE(key_order(bpt, node->keys[i - 1], node->keys[i]) < 0);
+        }
+        if (has_low)
+        {
+            TEST_ASSERT_TRUE(key_order(bpt, node->keys[i], low) >= 0);
+        }
+        if (has_high)
+        {
+            TEST_ASSERT_TRUE(key_order(bpt, node->keys[i], high) < 0);
+        }
+    }
+
+    if (node->leaf)
+    {
+        bpt_leaf_t *leaf = (bpt_leaf_t *)node;
+        TEST_ASSERT_TRUE(leaf->prev == *prev_leaf);
+        if (*prev_leaf == NULL)
+        {
+            TEST_ASSERT_TRUE(bpt->first == leaf);
+        }
+        else
+        {
+            TEST_ASSERT_TRUE((*prev_leaf)->next == leaf);
+        }
+        *prev_leaf = leaf;
+        return node->count;
+    }
+
+    bpt_inner_t *inner = (bpt_inner_t *)node;
+    size_t total = 0;
+    for (size_t i = 0; i <= node->count; i++)
+    {
+        bool child_has_low = i > 0 ? true : has_low;
+        uint64_t child_low = i > 0 ? node->keys[i - 1] : low;
+        bool child_has_high = i < node->count ? true : has_high;
+        uint64_t child_high = i < node->count ? node->keys[i] : high;
+        total += check_node(bpt, inner->children[i], level - 1, child_has_low, child_low, child_has_high,
+                            child_high, prev_leaf);
+    }
+    return total;
+}
+
+static void check_tree(bplus_tree_t *bpt)
+{
+    bpt_leaf_t *prev = NULL;
+    size_t total = check_node(bpt, bpt->root, bpt->height, false, 0, false, 0, &prev);
+    TEST_ASSERT_EQUAL(bpt->size, total);
+    TEST_ASSERT_TRUE(bpt->last == prev);
+    TEST_ASSERT_NULL(prev->next);
+}
+
+// 随机插入删除，与参照数组比较；generic为true时用降序cmp的void *键
+static void run_random_ops(bplus_tree_t *bpt, bool generic, uint64_t seed)
+{
+    uintptr_t *present = (uintptr_t *)calloc(KEY_RANGE, sizeof(uintptr_t));
+    size_t expected = 0;
+
+    for (size_t i = 0; i < OP_COUNT; i++)
+    {
+        uintptr_t key = next_rand(&seed) % KEY_RANGE;
+        // 前半段以插入为主，后半段以删除为主，使树先长高再收缩
+        bool insert = next_rand(&seed) % 10 < (i < OP_COUNT / 2 ? 7u : 2u);
+        if (insert)
+        {
+            bool ok = generic ? bpt_put(bpt, P(key), P(key + 1)) : bpt_put_u64(bpt, key, P(key + 1));
+            TEST_ASSERT_TRUE(ok);
+            expected += present[key] == 0;
+            present[key] = key + 1;
+        }
+        else
+        {
+            void *value = NULL;
+            bool removed = generic ? bpt_remove(bpt, P(key), &value) : bpt_remove_u64(bpt, key, &value);
+            TEST_ASSERT_EQUAL(present[key] != 0, removed);
+            if (removed)
+            {
+                TEST_ASSERT_EQUAL_PTR(P(key + 1), value);
+                present[key] = 0;
+                expected--;
+            }
+        }
+        if (i % 5000 == 0)
+        {
+            check_tree(bpt);
+        }
+    }
+    check_tree(bpt);
+    TEST_ASSERT_EQUAL(expected, bpt_size(bpt));
+
+    for (uintptr_t key = 0; key < KEY_RANGE; key++)
+    {
+        void *value = NULL;
+        bool found = generic ? bpt_find(bpt, P(key), &value) : bpt_find_u64(bpt, key, &value);
+        TEST_ASSERT_EQUAL(present[key] != 0, found);
+        if (found)
+        {
+            TEST_ASSERT_EQUAL_PTR(P(present[key]), value);
+        }
+    }
+    free(present);
+}
+
+// 测试创建
+void test_bpt_create_should_start_empty(void)
+{
+    bplus_tree_t *bpt = bpt_create_u64();
+
+    TEST_ASSERT_NOT_NULL(bpt);
+    TEST_ASSERT_TRUE(bpt_is_empty(bpt));
+    TEST_ASSERT_EQUAL(1, bpt_height(bpt));
+    TEST_ASSERT_FALSE(bpt_iter_valid(bpt_first(bpt)));
+    TEST_ASSERT_FALSE(bpt_iter_valid(bpt_lower_bound_u64(bpt, 0)));
+    TEST_ASSERT_FALSE(bpt_find_u64(bpt, 0, NULL));
+    TEST_ASSERT_NULL(bpt_create(NULL));
+    bpt_destroy(bpt);
+}
+
+// 测试插入、替换与删除，包括边界键0与UINT64_MAX
+void test_bpt_put_u64_should_insert_and_replace(void)
+{
+    bplus_tree_t *bpt = bpt_create_u64();
+    void *value = NULL;
+
+    TEST_ASSERT_TRUE(bpt_put_u64(bpt, 5, P(50)));
+    TEST_ASSERT_TRUE(bpt_put_u64(bpt, 0, P(1)));
+    TEST_ASSERT_TRUE(bpt_put_u64(bpt, UINT64_MAX, P(2)));
+    TEST_ASSERT_TRUE(bpt_put_u64(bpt, 5, P(51)));
+    TEST_ASSERT_EQUAL(3, bpt_size(bpt));
+
+    TEST_ASSERT_TRUE(bpt_find_u64(bpt, 5, &value));
+    TEST_ASSERT_EQUAL_PTR(P(51), value);
+    TEST_ASSERT_TRUE(bpt_find_u64(bpt, UINT64_MAX, &value));
+    TEST_ASSERT_EQUAL_PTR(P(2), value);
+    TEST_ASSERT_TRUE(bpt_find_u64(bpt, 0, NULL));
+    TEST_ASSERT_FALSE(bpt_find_u64(bpt, 6, NULL));
+
+    TEST_ASSERT_TRUE(bpt_remove_u64(bpt, UINT64_MAX, &value));
+    TEST_ASSERT_EQUAL_PTR(P(2), value);
+    TEST_ASSERT_FALSE(bpt_remove_u64(bpt, UINT64_MAX, NULL));
+    TEST_ASSERT_EQUAL(2, bpt_size(bpt));
+    check_tree(bpt);
+    bpt_destroy(bpt);
+}
+
+// 测试uint64_t键的随机插入删除
+void test_bpt_u64_random_ops_should_keep_invariants(void)
+{
+    bplus_tree_t *bpt = bpt_create_u64();
+    run_random_ops(bpt, false, 7);
+    bpt_destroy(bpt);
+}
+
+// 测试CPU支持的每个指令集级别：全64位范围的键（含最高位为1）查找与下界结果一致
+void test_bpt_u64_every_simd_level_should_agree(void)
+{
+    enum { N = 20000 };
+    uint64_t *keys = (uint64_t *)malloc(N * sizeof(uint64_t));
+    bpt_simd_t supported = bpt_simd_level();
+    for (int level = BPT_SIMD_NONE; level <= (int)supported; level++)
+    {
+        TEST_ASSERT_EQUAL(level, bpt_set_simd_level((bpt_simd_t)level));
+        bplus_tree_t *bpt = bpt_create_u64();
+        uint64_t seed = 99;
+        for (size_t i = 0; i < N; i++)
+        {
+            // 偶数键，奇数用作不存在的探测键
+            keys[i] = next_rand(&seed) & ~(uint64_t)1;
+            TEST_ASSERT_TRUE(bpt_put_u64(bpt, keys[i], P(i)));
+        }
+        check_tree(bpt);
+        for (size_t i = 0; i < N; i++)
+        {
+            TEST_ASSERT_TRUE(bpt_find_u64(bpt, keys[i], NULL));
+            TEST_ASSERT_FALSE(bpt_find_u64(bpt, keys[i] + 1, NULL));
+            bpt_iter_t it = bpt_lower_bound_u64(bpt, keys[i] + 1);
+            TEST_ASSERT_TRUE(!bpt_iter_valid(it) || bpt_iter_key_u64(it) > keys[i]);
+        }
+        for (size_t i = 0; i < N; i += 2)
+        {
+            TEST_ASSERT_TRUE(bpt_remove_u64(bpt, keys[i], NULL));
+        }
+        check_tree(bpt);
+        bpt_destroy(bpt);
+    }
+    TEST_ASSERT_EQUAL(supported, bpt_set_simd_level(BPT_SIMD_AVX2));
+    free(keys);
+}
+
+// 测试通用键按cmp排序
+void test_bpt_generic_random_ops_should_follow_comparator(void)
+{
+    bplus_tree_t *bpt = bpt_create(desc_cmp);
+
+    run_random_ops(bpt, true, 13);
+    // 降序cmp下迭代顺序为键的降序
+    uintptr_t prev = UINTPTR_MAX;
+    size_t count = 0;
+    for (bpt_iter_t it = bpt_first(bpt); bpt_iter_valid(it); bpt_iter_next(&it))
+    {
+        uintptr_t key = (uintptr_t)bpt_iter_key(it);
+        TEST_ASSERT_TRUE(key < prev);
+        TEST_ASSERT_EQUAL_PTR(P(key + 1), bpt_iter_value(it));
+        prev = key;
+        count++;
+    }
+    TEST_ASSERT_EQUAL(bpt_size(bpt), count);
+    bpt_destroy(bpt);
+}
+
+// 测试顺序插入使叶节点保持满载，逐个删除后树收缩回单个叶节点
+void test_bpt_sequential_insert_should_fill_leaves(void)
+{
+    bplus_tree_t *bpt = bpt_create_u64();
+
+    for (uint64_t key = 0; key < 32 * 1000; key++)
+    {
+        bpt_put_u64(bpt, key, NULL);
+    }
+    check_tree(bpt);
+    size_t leaves = 0;
+    for (bpt_leaf_t *leaf = bpt->first; leaf != NULL; leaf = leaf->next)
+    {
+        leaves++;
+    }
+    TEST_ASSERT_EQUAL(1000, leaves);
+
+    for (uint64_t key = 0; key < 32 * 1000; key++)
+    {
+        TEST_ASSERT_TRUE(bpt_remove_u64(bpt, key, NULL));
+    }
+    check_tree(bpt);
+    TEST_ASSERT_TRUE(bpt_is_empty(bpt));
+    TEST_ASSERT_EQUAL(1, bpt_height(bpt));
+    bpt_destroy(bpt);
+}
+
+// 测试范围复制、分批继续与迭代器
+void test_bpt_range_should_copy_half_open_interval(void)
+{
+    bplus_tree_t *bpt = bpt_create_u64();
+    uint64_t keys[256];
+    void *values[256];
+
+    for (uint64_t key = 0; key < 10000; key += 2)
+    {
+        bpt_put_u64(bpt, key, P(key * 10));
+    }
+    TEST_ASSERT_EQUAL(3, bpt_range_u64(bpt, 11, 17, keys, values, 256));
+    TEST_ASSERT_EQUAL(12, keys[0]);
+    TEST_ASSERT_EQUAL(16, keys[2]);
+    TEST_ASSERT_EQUAL_PTR(P(140), values[1]);
+    TEST_ASSERT_EQUAL(0, bpt_range_u64(bpt, 20, 20, keys, values, 256));
+    TEST_ASSERT_EQUAL(0, bpt_range_u64(bpt, 9999, UINT64_MAX, keys, NULL, 256));
+
+    // 分批读取全部元素，跨越多个叶节点
+    uint64_t low = 0;
+    size_t total = 0;
+    size_t got;
+    while ((got = bpt_range_u64(bpt, low, UINT64_MAX, keys, NULL, 256)) > 0)
+    {
+        for (size_t i = 0; i < got; i++)
+        {
+            TEST_ASSERT_EQUAL((total + i) * 2, keys[i]);
+        }
+        total += got;
+        low = keys[got - 1] + 1;
+    }
+    TEST_ASSERT_EQUAL(5000, total);
+
+    bpt_iter_t it = bpt_lower_bound_u64(bpt, 4001);
+    TEST_ASSERT_TRUE(bpt_iter_valid(it));
+    TEST_ASSERT_EQUAL(4002, bpt_iter_key_u64(it));
+    bpt_iter_next(&it);
+    TEST_ASSERT_EQUAL(4004, bpt_iter_key_u64(it));
+    TEST_ASSERT_FALSE(bpt_iter_valid(bpt_lower_bound_u64(bpt, 9999)));
+
+    bpt_clear(bpt);
+    TEST_ASSERT_TRUE(bpt_is_empty(bpt));
+    TEST_ASSERT_EQUAL(0, bpt_range_u64(bpt, 0, UINT64_MAX, keys, values, 256));
+    TEST_ASSERT_TRUE(bpt_put_u64(bpt, 1, NULL));
+    check_tree(bpt);
+    bpt_destroy(bpt);
+}
+
+// 测试两种键的接口不能混用，以及空指针
+void test_bpt_edge_cases_should_reject_mismatched_calls(void)
+{
+    bplus_tree_t *u = bpt_create_u64();
+    bplus_tree_t *g = bpt_create(desc_cmp);
+    void *keys[4];
+
+    TEST_ASSERT_FALSE(bpt_put(u, P(1), NULL));
+    TEST_ASSERT_FALSE(bpt_put_u64(g, 1, NULL));
+    TEST_ASSERT_FALSE(bpt_find(u, P(1), NULL));
+    TEST_ASSERT_FALSE(bpt_remove_u64(g, 1, NULL));
+    TEST_ASSERT_EQUAL(0, bpt_range(u, P(0), P(1), keys, NULL, 4));
+    TEST_ASSERT_TRUE(bpt_put(g, P(3), NULL));
+    TEST_ASSERT_TRUE(bpt_put(g, P(9), NULL));
+    // 降序：[9, 3) 只含9
+    TEST_ASSERT_EQUAL(1, bpt_range(g, P(9), P(3), keys, NULL, 4));
+    TEST_ASSERT_EQUAL_PTR(P(9), keys[0]);
+
+    TEST_ASSERT_FALSE(bpt_put_u64(NULL, 1, NULL));
+    TEST_ASSERT_FALSE(bpt_find(NULL, P(1), NULL));
+    TEST_ASSERT_EQUAL(0, bpt_size(NULL));
+    TEST_ASSERT_TRUE(bpt_is_empty(NULL));
+    TEST_ASSERT_FALSE(bpt_iter_valid(bpt_first(NULL)));
+    bpt_iter_next(NULL);
+    bpt_clear(NULL);
+    bpt_destroy(NULL);
+    bpt_destroy(u);
+    bpt_destroy(g);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bpt_create_should_start_empty);
+    RUN_TEST(test_bpt_put_u64_should_insert_and_replace);
+    RUN_TEST(test_bpt_u64_random_ops_should_keep_invariants);
+    RUN_TEST(test_bpt_u64_every_simd_level_should_agree);
+    RUN_TEST(test_bpt_generic_random_ops_should_follow_comparator);
+    RUN_TEST(test_bpt_sequential_insert_should_fill_leaves);
+    RUN_TEST(test_bpt_range_should_copy_half_open_interval);
+    RUN_TEST(test_bpt_edge_cases_should_reject_mismatched_calls);
+
+    return UNITY_END();
+}
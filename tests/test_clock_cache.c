@@ -0,0 +1,347 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "cache/clock_cache.h"
+#include "Unity/src/unity.h"
+
+#define THREAD_COUNT 8
+#define OPS_PER_THREAD 50000
+#define KEY_SPACE 4096
+
+// 以指针值作为整数键
+size_t int_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+int int_cmp(void *a, void *b)
+{
+    return (uintptr_t)a == (uintptr_t)b ? 0 : 1;
+}
+
+// 记录回调（回调延迟执行，统一在cc_destroy后检查）
+static size_t reason_counts[4];
+static uintptr_t evicted_keys[64];
+static size_t evicted_count;
+
+static void record_evict(void *key, void *value, cc_reason_t reason, void *arg)
+{
+    (void)value;
+    (void)arg;
+    reason_counts[reason]++;
+    if (reason == CC_EVICTED)
+    {
+        evicted_keys[evicted_count++] = (uintptr_t)key;
+    }
+}
+
+// 释放值并计数（多线程调用）
+static void free_evict(void *key, void *value, cc_reason_t reason, void *arg)
+{
+    (void)key;
+    (void)reason;
+    free(value);
+    __atomic_fetch_add((size_t *)arg, 1, __ATOMIC_RELAXED);
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+    for (size_t i = 0; i < 4; i++)
+    {
+        reason_counts[i] = 0;
+    }
+    evicted_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建与分片数
+void test_cc_create_should_create_empty_cache(void)
+{
+    clock_cache_t *cache = cc_create(10, 4, int_hash, int_cmp, NULL, NULL);
+
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_EQUAL(0, cc_size(cache));
+    TEST_ASSERT_EQUAL(10, cc_capacity(cache));
+    TEST_ASSERT_EQUAL(4, cc_shard_count(cache));
+    TEST_ASSERT_NULL(cc_get(cache, (void *)1));
+    cc_destroy(cache);
+
+    // 分片数取2的幂且不超过容量
+    cache = cc_create(3, 64, int_hash, int_cmp, NULL, NULL);
+    TEST_ASSERT_EQUAL(2, cc_shard_count(cache));
+    cc_destroy(cache);
+    cache = cc_create(1000, 0, int_hash, int_cmp, NULL, NULL);
+    TEST_ASSERT_EQUAL(CC_DEFAULT_SHARDS, cc_shard_count(cache));
+    cc_destroy(cache);
+
+    TEST_ASSERT_NULL(cc_create(0, 1, int_hash, int_cmp, NULL, NULL));
+}
+
+// 测试CLOCK淘汰：引用位为1的条目获得第二次机会
+void test_cc_should_evict_with_second_chance(void)
+{
+    clock_cache_t *cache = cc_create(4, 1, int_hash, int_cmp, record_evict, NULL);
+
+    for (uintptr_t i = 1; i <= 4; i++)
+    {
+        TEST_ASSERT_TRUE(cc_put(cache, (void *)i, (void *)(i * 10)));
+    }
+    // 访问1与2，指针扫过时清零跳过，淘汰3
+    TEST_ASSERT_EQUAL_PTR((void *)10, cc_get(cache, (void *)1));
+    TEST_ASSERT_EQUAL_PTR((void *)20, cc_get(cache, (void *)2));
+    cc_put(cache, (void *)5, (void *)50);
+    TEST_ASSERT_EQUAL(4, cc_size(cache));
+    TEST_ASSERT_FALSE(cc_contains(cache, (void *)3));
+
+    // 指针停在4：4未被访问，直接淘汰
+    cc_put(cache, (void *)6, (void *)60);
+    TEST_ASSERT_FALSE(cc_contains(cache, (void *)4));
+
+    // 1与2的引用位已被清零，依次淘汰
+    cc_put(cache, (void *)7, (void *)70);
+    TEST_ASSERT_FALSE(cc_contains(cache, (void *)1));
+    TEST_ASSERT_TRUE(cc_contains(cache, (void *)2));
+    TEST_ASSERT_TRUE(cc_contains(cache, (void *)5));
+
+    cc_stats_t stats;
+    cc_stats(cache, &stats);
+    TEST_ASSERT_EQUAL(3, stats.evictions);
+    TEST_ASSERT_EQUAL(7, stats.inserts);
+
+    cc_destroy(cache);
+    TEST_ASSERT_EQUAL(3, reason_counts[CC_EVICTED]);
+    TEST_ASSERT_EQUAL(4, reason_counts[CC_CLEARED]);
+    TEST_ASSERT_EQUAL(3, evicted_keys[0]);
+    TEST_ASSERT_EQUAL(4, evicted_keys[1]);
+    TEST_ASSERT_EQUAL(1, evicted_keys[2]);
+}
+
+// 测试替换、删除与清空
+void test_cc_replace_remove_and_clear(void)
+{
+    clock_cache_t *cache = cc_create(8, 2, int_hash, int_cmp, record_evict, NULL);
+
+    cc_put(cache, (void *)1, (void *)10);
+    cc_put(cache, (void *)2, (void *)20);
+    cc_put(cache, (void *)1, (void *)11);
+    TEST_ASSERT_EQUAL(2, cc_size(cache));
+    TEST_ASSERT_EQUAL_PTR((void *)11, cc_get(cache, (void *)1));
+
+    TEST_ASSERT_TRUE(cc_remove(cache, (void *)1));
+    TEST_ASSERT_FALSE(cc_remove(cache, (void *)1));
+    TEST_ASSERT_FALSE(cc_contains(cache, (void *)1));
+    TEST_ASSERT_EQUAL(1, cc_size(cache));
+
+    // 删除后环上空位可继续使用
+    for (uintptr_t i = 10; i < 17; i++)
+    {
+        cc_put(cache, (void *)i, (void *)i);
+    }
+    TEST_ASSERT_TRUE(cc_size(cache) <= 8);
+
+    cc_clear(cache);
+    TEST_ASSERT_EQUAL(0, cc_size(cache));
+    TEST_ASSERT_FALSE(cc_contains(cache, (void *)2));
+    cc_put(cache, (void *)3, (void *)30);
+    TEST_ASSERT_EQUAL_PTR((void *)30, cc_get(cache, (void *)3));
+
+    cc_destroy(cache);
+    TEST_ASSERT_EQUAL(1, reason_counts[CC_REPLACED]);
+    TEST_ASSERT_EQUAL(1, reason_counts[CC_REMOVED]);
+    // 其余9个条目（2、10~16、3）或被淘汰或被清空
+    TEST_ASSERT_EQUAL(9, reason_counts[CC_EVICTED] + reason_counts[CC_CLEARED]);
+}
+
+// 测试各分片统计与抽样计时
+void test_cc_stats_should_count_per_shard(void)
+{
+    clock_cache_t *cache = cc_create(256, 4, int_hash, int_cmp, NULL, NULL);
+
+    // 读统计默认关闭，插入与淘汰次数始终统计
+    cc_put(cache, (void *)1, (void *)1);
+    cc_get(cache, (void *)1);
+    cc_get(cache, (void *)2);
+    cc_stats_t total;
+    cc_stats(cache, &total);
+    TEST_ASSERT_EQUAL(0, total.hits);
+    TEST_ASSERT_EQUAL(0, total.misses);
+    TEST_ASSERT_EQUAL(0, total.lookup_samples);
+    TEST_ASSERT_EQUAL(0, total.insert_samples);
+    TEST_ASSERT_EQUAL(1, total.inserts);
+    cc_remove(cache, (void *)1);
+
+    cc_set_counting(cache, true);
+    cc_set_sampling(cache, 1);
+    for (uintptr_t i = 1; i <= 32; i++)
+    {
+        cc_put(cache, (void *)i, (void *)i);
+    }
+    for (uintptr_t i = 1; i <= 48; i++)
+    {
+        cc_get(cache, (void *)i);
+    }
+    // contains不计入统计
+    cc_contains(cache, (void *)1);
+
+    cc_stats(cache, &total);
+    TEST_ASSERT_EQUAL(32, total.hits);
+    TEST_ASSERT_EQUAL(16, total.misses);
+    TEST_ASSERT_EQUAL(33, total.inserts);
+    TEST_ASSERT_EQUAL(32, total.size);
+    TEST_ASSERT_EQUAL(256, total.capacity);
+    TEST_ASSERT_EQUAL(48, total.lookup_samples);
+    TEST_ASSERT_EQUAL(32, total.insert_samples);
+    TEST_ASSERT_TRUE(total.lookup_ns >= total.lookup_max_ns);
+
+    cc_stats_t sum = {0};
+    for (size_t s = 0; s < cc_shard_count(cache); s++)
+    {
+        cc_stats_t stats;
+        TEST_ASSERT_TRUE(cc_shard_stats(cache, s, &stats));
+        TEST_ASSERT_EQUAL(64, stats.capacity);
+        sum.hits += stats.hits;
+        sum.misses += stats.misses;
+        sum.size += stats.size;
+    }
+    TEST_ASSERT_EQUAL(total.hits, sum.hits);
+    TEST_ASSERT_EQUAL(total.misses, sum.misses);
+    TEST_ASSERT_EQUAL(total.size, sum.size);
+    TEST_ASSERT_FALSE(cc_shard_stats(cache, 4, &sum));
+
+    // 关闭抽样后不再计时
+    cc_set_sampling(cache, 0);
+    cc_get(cache, (void *)1);
+    cc_stats(cache, &total);
+    TEST_ASSERT_EQUAL(33, total.hits);
+    TEST_ASSERT_EQUAL(48, total.lookup_samples);
+
+    // 关闭计数后命中不再计入
+    cc_set_counting(cache, false);
+    cc_get(cache, (void *)1);
+    cc_stats(cache, &total);
+    TEST_ASSERT_EQUAL(33, total.hits);
+
+    cc_destroy(cache);
+}
+
+typedef struct
+{
+    clock_cache_t *cache;
+    uint64_t seed;
+    size_t puts;
+    size_t errors;
+} worker_t;
+
+// 读多写少：读到的值在pin期间有效且内容正确
+static void *worker_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    for (size_t i = 0; i < OPS_PER_THREAD; i++)
+    {
+        w->seed = w->seed * 6364136223846793005ull + 1442695040888963407ull;
+        uintptr_t key = (uintptr_t)(w->seed >> 33) % KEY_SPACE + 1;
+        if ((w->seed >> 20) % 10 == 0)
+        {
+            uintptr_t *value = (uintptr_t *)malloc(sizeof(uintptr_t));
+            *value = key;
+            if (cc_put(w->cache, (void *)key, value))
+            {
+                w->puts++;
+            }
+            else
+            {
+                free(value);
+                w->errors++;
+            }
+        }
+        else if ((w->seed >> 20) % 50 == 1)
+        {
+            cc_remove(w->cache, (void *)key);
+        }
+        else
+        {
+            cc_guard_t guard = cc_pin(w->cache);
+            uintptr_t *value = (uintptr_t *)cc_get(w->cache, (void *)key);
+            if (value != NULL && *value != key)
+            {
+                w->errors++;
+            }
+            cc_unpin(w->cache, guard);
+        }
+    }
+    return NULL;
+}
+
+// 测试多线程并发读写，值只在没有读线程访问后才被回调释放
+void test_cc_concurrent_access_should_be_consistent(void)
+{
+    size_t released = 0;
+    clock_cache_t *cache = cc_create(KEY_SPACE / 4, 16, int_hash, int_cmp, free_evict, &released);
+    cc_set_counting(cache, true);
+    pthread_t threads[THREAD_COUNT];
+    worker_t workers[THREAD_COUNT];
+
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        workers[i].cache = cache;
+        workers[i].seed = (uint64_t)i * 7919 + 1;
+        workers[i].puts = 0;
+        workers[i].errors = 0;
+        pthread_create(&threads[i], NULL, worker_run, &workers[i]);
+    }
+    size_t puts = 0;
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT_EQUAL(0, workers[i].errors);
+        puts += workers[i].puts;
+    }
+
+    cc_stats_t stats;
+    cc_stats(cache, &stats);
+    TEST_ASSERT_TRUE(cc_size(cache) <= KEY_SPACE / 4);
+    TEST_ASSERT_TRUE(stats.hits > 0);
+    TEST_ASSERT_TRUE(stats.evictions > 0);
+
+    // 每次成功的put都恰好对应一次回调释放
+    cc_destroy(cache);
+    TEST_ASSERT_EQUAL(puts, released);
+}
+
+// 测试空指针
+void test_cc_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_NULL(cc_create(1, 1, NULL, int_cmp, NULL, NULL));
+    TEST_ASSERT_FALSE(cc_put(NULL, NULL, NULL));
+    TEST_ASSERT_NULL(cc_get(NULL, NULL));
+    TEST_ASSERT_FALSE(cc_contains(NULL, NULL));
+    TEST_ASSERT_FALSE(cc_remove(NULL, NULL));
+    TEST_ASSERT_EQUAL(0, cc_size(NULL));
+    TEST_ASSERT_EQUAL(0, cc_capacity(NULL));
+    TEST_ASSERT_FALSE(cc_shard_stats(NULL, 0, NULL));
+    cc_unpin(NULL, cc_pin(NULL));
+    cc_set_sampling(NULL, 1);
+    cc_set_counting(NULL, true);
+    cc_stats(NULL, NULL);
+    cc_clear(NULL);
+    cc_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_cc_create_should_create_empty_cache);
+    RUN_TEST(test_cc_should_evict_with_second_chance);
+    RUN_TEST(test_cc_replace_remove_and_clear);
+    RUN_TEST(test_cc_stats_should_count_per_shard);
+    RUN_TEST(test_cc_concurrent_access_should_be_consistent);
+    RUN_TEST(test_cc_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
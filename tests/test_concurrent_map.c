@@ -0,0 +1,298 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "hash_table/concurrent_map.h"
+#include "Unity/src/unity.h"
+
+#define READER_COUNT 4
+#define WRITER_COUNT 4
+#define STABLE_KEYS 1000
+#define KEYS_PER_WRITER 20000
+
+// 以指针值作为整数键
+size_t int_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+int int_cmp(void *a, void *b)
+{
+    return (uintptr_t)a == (uintptr_t)b ? 0 : 1;
+}
+
+static uintptr_t visit_sum;
+
+static void visit(void *key, void *value)
+{
+    (void)key;
+    visit_sum += (uintptr_t)value;
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建
+void test_cm_create_should_create_empty_map(void)
+{
+    concurrent_map_t *cm = cm_create(int_hash, int_cmp);
+
+    TEST_ASSERT_NOT_NULL(cm);
+    TEST_ASSERT_EQUAL(0, cm_size(cm));
+    TEST_ASSERT_TRUE(cm_is_empty(cm));
+    TEST_ASSERT_EQUAL(CM_STRIPES, cm_capacity(cm));
+    TEST_ASSERT_FALSE(cm_contains(cm, (void *)1));
+    TEST_ASSERT_NULL(cm_create(NULL, int_cmp));
+
+    cm_destroy(cm);
+}
+
+// 测试插入、替换、条件插入与删除
+void test_cm_put_get_remove_should_work(void)
+{
+    concurrent_map_t *cm = cm_create(int_hash, int_cmp);
+
+    TEST_ASSERT_TRUE(cm_put(cm, (void *)1, (void *)10));
+    TEST_ASSERT_TRUE(cm_put(cm, (void *)2, (void *)20));
+    TEST_ASSERT_EQUAL_PTR((void *)10, cm_get(cm, (void *)1));
+
+    TEST_ASSERT_TRUE(cm_put(cm, (void *)1, (void *)11));
+    TEST_ASSERT_EQUAL_PTR((void *)11, cm_get(cm, (void *)1));
+    TEST_ASSERT_FALSE(cm_put_if_absent(cm, (void *)1, (void *)12));
+    TEST_ASSERT_EQUAL_PTR((void *)11, cm_get(cm, (void *)1));
+    TEST_ASSERT_TRUE(cm_put_if_absent(cm, (void *)3, (void *)30));
+    TEST_ASSERT_EQUAL(3, cm_size(cm));
+
+    void *value = NULL;
+    TEST_ASSERT_TRUE(cm_remove(cm, (void *)1, &value));
+    TEST_ASSERT_EQUAL_PTR((void *)11, value);
+    TEST_ASSERT_FALSE(cm_remove(cm, (void *)1, NULL));
+    TEST_ASSERT_FALSE(cm_find(cm, (void *)1, &value));
+    TEST_ASSERT_EQUAL(2, cm_size(cm));
+
+    cm_destroy(cm);
+}
+
+// 测试扩容后内容不变
+void test_cm_grow_should_keep_all_entries(void)
+{
+    concurrent_map_t *cm = cm_create(int_hash, int_cmp);
+    size_t n = 50000;
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_TRUE(cm_put(cm, (void *)i, (void *)(i * 2)));
+    }
+    TEST_ASSERT_EQUAL(n, cm_size(cm));
+    TEST_ASSERT_TRUE(cm_capacity(cm) * CM_MAX_LOAD >= n);
+
+    for (uintptr_t i = 1; i <= n; i += 2)
+    {
+        TEST_ASSERT_TRUE(cm_remove(cm, (void *)i, NULL));
+    }
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR(i % 2 == 0 ? (void *)(i * 2) : NULL, cm_get(cm, (void *)i));
+    }
+
+    visit_sum = 0;
+    cm_foreach(cm, visit);
+    TEST_ASSERT_EQUAL((n / 2) * (n / 2 + 1) * 2, visit_sum);
+
+    cm_destroy(cm);
+}
+
+typedef struct
+{
+    concurrent_map_t *cm;
+    uintptr_t base;
+    int *stop;
+    size_t errors;
+} worker_t;
+
+// 读线程：稳定键必须始终可见且值正确
+static void *reader_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    uintptr_t key = 1;
+    while (!__atomic_load_n(w->stop, __ATOMIC_ACQUIRE))
+    {
+        void *value = NULL;
+        if (!cm_find(w->cm, (void *)key, &value) || value != (void *)(key * 3))
+        {
+            w->errors++;
+        }
+        key = key % STABLE_KEYS + 1;
+    }
+    return NULL;
+}
+
+// 写线程：在各自的键区间插入，再删除一半，期间触发多次扩容
+static void *writer_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    for (uintptr_t i = 0; i < KEYS_PER_WRITER; i++)
+    {
+        if (!cm_put(w->cm, (void *)(w->base + i), (void *)(w->base + i)))
+        {
+            w->errors++;
+        }
+    }
+    for (uintptr_t i = 0; i < KEYS_PER_WRITER; i += 2)
+    {
+        if (!cm_remove(w->cm, (void *)(w->base + i), NULL))
+        {
+            w->errors++;
+        }
+    }
+    return NULL;
+}
+
+// 测试多线程读写并发，读线程不受写和扩容影响
+void test_cm_concurrent_readers_and_writers_should_be_consistent(void)
+{
+    concurrent_map_t *cm = cm_create(int_hash, int_cmp);
+    pthread_t readers[READER_COUNT];
+    pthread_t writers[WRITER_COUNT];
+    worker_t reader_args[READER_COUNT] = {{0}};
+    worker_t writer_args[WRITER_COUNT] = {{0}};
+    int stop = 0;
+
+    for (uintptr_t key = 1; key <= STABLE_KEYS; key++)
+    {
+        cm_put(cm, (void *)key, (void *)(key * 3));
+    }
+
+    for (int i = 0; i < READER_COUNT; i++)
+    {
+        reader_args[i].cm = cm;
+        reader_args[i].stop = &stop;
+        pthread_create(&readers[i], NULL, reader_run, &reader_args[i]);
+    }
+    for (int i = 0; i < WRITER_COUNT; i++)
+    {
+        writer_args[i].cm = cm;
+        writer_args[i].base = (uintptr_t)(i + 1) * 1000000;
+        pthread_create(&writers[i], NULL, writer_run, &writer_args[i]);
+    }
+
+    for (int i = 0; i < WRITER_COUNT; i++)
+    {
+        pthread_join(writers[i], NULL);
+        TEST_ASSERT_EQUAL(0, writer_args[i].errors);
+    }
+    __atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < READER_COUNT; i++)
+    {
+        pthread_join(readers[i], NULL);
+        TEST_ASSERT_EQUAL(0, reader_args[i].errors);
+    }
+
+    TEST_ASSERT_EQUAL(STABLE_KEYS + WRITER_COUNT * KEYS_PER_WRITER / 2, cm_size(cm));
+    for (int i = 0; i < WRITER_COUNT; i++)
+    {
+        uintptr_t base = writer_args[i].base;
+        for (uintptr_t k = 0; k < KEYS_PER_WRITER; k++)
+        {
+            TEST_ASSERT_EQUAL(k % 2 == 1, cm_contains(cm, (void *)(base + k)));
+        }
+    }
+
+    cm_destroy(cm);
+}
+
+typedef struct
+{
+    concurrent_map_t *cm;
+    int stop;
+    size_t during;      // 扩容迁移期间完成的操作数
+    size_t errors;
+} grow_probe_t;
+
+// 在自己的键区间反复插入、查找、删除，并统计扩容迁移期间完成的操作
+static void *probe_run(void *arg)
+{
+    grow_probe_t *probe = (grow_probe_t *)arg;
+    uintptr_t base = (uintptr_t)1 << 40;
+    for (uintptr_t i = 0; !__atomic_load_n(&probe->stop, __ATOMIC_ACQUIRE); i++)
+    {
+        void *key = (void *)(base + i % 1000);
+        void *value = NULL;
+        if (!cm_put(probe->cm, key, key) || !cm_find(probe->cm, key, &value) || value != key ||
+            !cm_remove(probe->cm, key, NULL))
+        {
+            probe->errors++;
+        }
+        ebr_guard_t guard = ebr_enter(&probe->cm->ebr);
+        cm_table_t *table = __atomic_load_n(&probe->cm->table, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&table->next, __ATOMIC_ACQUIRE) != NULL)
+        {
+            probe->during++;
+        }
+        ebr_exit(&probe->cm->ebr, guard);
+    }
+    return NULL;
+}
+
+// 测试扩容逐段迁移：迁移期间其他写线程照常完成操作，迁移完成后内容完整
+void test_cm_writers_should_progress_during_grow(void)
+{
+    concurrent_map_t *cm = cm_create(int_hash, int_cmp);
+    grow_probe_t probe = {cm, 0, 0, 0};
+    pthread_t thread;
+    pthread_create(&thread, NULL, probe_run, &probe);
+
+    // 单核上探测线程只在插入线程被抢占时运行，插入到观察到迁移期间的操作为止
+    uintptr_t n = 0;
+    while (n < ((uintptr_t)1 << 22) && (n < 100000 || __atomic_load_n(&probe.during, __ATOMIC_RELAXED) == 0))
+    {
+        n++;
+        TEST_ASSERT_TRUE(cm_put(cm, (void *)n, (void *)(n * 2)));
+    }
+    __atomic_store_n(&probe.stop, 1, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_EQUAL(0, probe.errors);
+    TEST_ASSERT_TRUE(probe.during > 0);
+    TEST_ASSERT_EQUAL(n, cm_size(cm));
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)(i * 2), cm_get(cm, (void *)i));
+    }
+
+    cm_destroy(cm);
+}
+
+// 测试空指针
+void test_cm_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(cm_put(NULL, NULL, NULL));
+    TEST_ASSERT_FALSE(cm_put_if_absent(NULL, NULL, NULL));
+    TEST_ASSERT_NULL(cm_get(NULL, NULL));
+    TEST_ASSERT_FALSE(cm_remove(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, cm_size(NULL));
+    TEST_ASSERT_EQUAL(0, cm_capacity(NULL));
+    TEST_ASSERT_TRUE(cm_is_empty(NULL));
+    cm_foreach(NULL, visit);
+    cm_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_cm_create_should_create_empty_map);
+    RUN_TEST(test_cm_put_get_remove_should_work);
+    RUN_TEST(test_cm_grow_should_keep_all_entries);
+    RUN_TEST(test_cm_concurrent_readers_and_writers_should_be_consistent);
+    RUN_TEST(test_cm_writers_should_progress_during_grow);
+    RUN_TEST(test_cm_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,256 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "hash_table/cuckoo_filter.h"
+#include "hash/hash.h"
+#include "Unity/src/unity.h"
+
+#define KEY_COUNT 20000
+#define PROBE_COUNT 200000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double measure_fpr(cuckoo_filter_t *cf)
+{
+    size_t positives = 0;
+    for (uint64_t i = 0; i < PROBE_COUNT; i++)
+    {
+        positives += cf_contains_hash(cf, hash_u64(i + 1000000000ull));
+    }
+    return (double)positives / PROBE_COUNT;
+}
+
+// 测试创建：指纹宽度随目标误判率变化
+void test_cf_create_should_pick_fingerprint_width(void)
+{
+    cuckoo_filter_t *cf = cf_create(1000, 0.05);
+    TEST_ASSERT_NOT_NULL(cf);
+    TEST_ASSERT_EQUAL(8, cf_fingerprint_bits(cf));
+    TEST_ASSERT_EQUAL(0, cf_count(cf));
+    TEST_ASSERT_TRUE(cf_capacity(cf) >= 1000);
+    TEST_ASSERT_FALSE(cf_contains(cf, "a", 1));
+    cf_destroy(cf);
+
+    cf = cf_create(1000, 0.001);
+    TEST_ASSERT_EQUAL(16, cf_fingerprint_bits(cf));
+    cf_destroy(cf);
+    cf = cf_create(1000, 1e-6);
+    TEST_ASSERT_EQUAL(32, cf_fingerprint_bits(cf));
+    cf_destroy(cf);
+
+    TEST_ASSERT_NULL(cf_create(0, 0.01));
+    TEST_ASSERT_NULL(cf_create(100, 1.5));
+}
+
+// 测试已添加的键一定能查到，误判率不超过目标
+void test_cf_should_have_no_false_negatives(void)
+{
+    static const double rates[] = {0.05, 0.001};
+
+    for (size_t r = 0; r < 2; r++)
+    {
+        cuckoo_filter_t *cf = cf_create(KEY_COUNT, rates[r]);
+        for (uint64_t i = 0; i < KEY_COUNT; i++)
+        {
+            TEST_ASSERT_TRUE(cf_add_hash(cf, hash_u64(i)));
+        }
+        TEST_ASSERT_EQUAL(KEY_COUNT, cf_count(cf));
+        for (uint64_t i = 0; i < KEY_COUNT; i++)
+        {
+            TEST_ASSERT_TRUE(cf_contains_hash(cf, hash_u64(i)));
+        }
+        TEST_ASSERT_TRUE(measure_fpr(cf) < rates[r]);
+        cf_destroy(cf);
+    }
+}
+
+// 测试删除
+void test_cf_remove_should_forget_keys(void)
+{
+    cuckoo_filter_t *cf = cf_create(KEY_COUNT, 0.001);
+    for (uint64_t i = 0; i < KEY_COUNT; i++)
+    {
+        cf_add_hash(cf, hash_u64(i));
+    }
+    for (uint64_t i = 0; i < KEY_COUNT; i += 2)
+    {
+        TEST_ASSERT_TRUE(cf_remove_hash(cf, hash_u64(i)));
+    }
+    TEST_ASSERT_EQUAL(KEY_COUNT / 2, cf_count(cf));
+
+    size_t remaining = 0;
+    for (uint64_t i = 0; i < KEY_COUNT; i++)
+    {
+        bool found = cf_contains_hash(cf, hash_u64(i));
+        if (i % 2 == 1)
+        {
+            TEST_ASSERT_TRUE(found);
+        }
+        remaining += found;
+    }
+    // 删除的键只可能以误判的形式出现
+    TEST_ASSERT_TRUE(remaining < KEY_COUNT / 2 + KEY_COUNT / 100);
+
+    // 重复添加需要对应次数的删除
+    TEST_ASSERT_TRUE(cf_add(cf, "dup", 3));
+    TEST_ASSERT_TRUE(cf_add(cf, "dup", 3));
+    TEST_ASSERT_TRUE(cf_remove(cf, "dup", 3));
+    TEST_ASSERT_TRUE(cf_contains(cf, "dup", 3));
+    TEST_ASSERT_TRUE(cf_remove(cf, "dup", 3));
+    TEST_ASSERT_FALSE(cf_remove(cf, "dup", 3));
+
+    cf_destroy(cf);
+}
+
+// 测试填满后插入失败，删除后恢复
+void test_cf_full_filter_should_reject_then_recover(void)
+{
+    cuckoo_filter_t *cf = cf_create(64, 0.001);
+    size_t capacity = cf_capacity(cf);
+    uint64_t added = 0;
+
+    while (cf_add_hash(cf, hash_u64(added)))
+    {
+        added++;
+        TEST_ASSERT_TRUE(added <= capacity);
+    }
+    // 装载率应在90%以上
+    TEST_ASSERT_TRUE(added * 10 >= capacity * 9);
+    TEST_ASSERT_EQUAL(added, cf_count(cf));
+    for (uint64_t i = 0; i < added; i++)
+    {
+        TEST_ASSERT_TRUE(cf_contains_hash(cf, hash_u64(i)));
+    }
+
+    // 删除一个键后victim被重新安置，可以继续添加
+    TEST_ASSERT_TRUE(cf_remove_hash(cf, hash_u64(0)));
+    TEST_ASSERT_EQUAL(added - 1, cf_count(cf));
+    for (uint64_t i = 1; i < added; i++)
+    {
+        TEST_ASSERT_TRUE(cf_contains_hash(cf, hash_u64(i)));
+    }
+
+    cf_clear(cf);
+    TEST_ASSERT_EQUAL(0, cf_count(cf));
+    TEST_ASSERT_TRUE(cf_add_hash(cf, hash_u64(1)));
+    cf_destroy(cf);
+}
+
+// 测试批量接口与逐个调用结果一致
+void test_cf_bulk_should_match_single(void)
+{
+    cuckoo_filter_t *cf = cf_create(KEY_COUNT, 0.01);
+    uint64_t *keys = (uint64_t *)malloc(2 * KEY_COUNT * sizeof(uint64_t));
+    uint64_t *hashes = (uint64_t *)malloc(2 * KEY_COUNT * sizeof(uint64_t));
+    bool *out = (bool *)malloc(2 * KEY_COUNT * sizeof(bool));
+
+    for (uint64_t i = 0; i < 2 * KEY_COUNT; i++)
+    {
+        keys[i] = i;
+    }
+    hash_u64_bulk(keys, 2 * KEY_COUNT, hashes);
+    TEST_ASSERT_EQUAL(KEY_COUNT, cf_add_bulk(cf, hashes, KEY_COUNT));
+
+    size_t positives = cf_contains_bulk(cf, hashes, 2 * KEY_COUNT, out);
+    size_t expected = 0;
+    for (size_t i = 0; i < 2 * KEY_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(cf_contains_hash(cf, hashes[i]), out[i]);
+        TEST_ASSERT_TRUE(i >= KEY_COUNT || out[i]);
+        expected += out[i];
+    }
+    TEST_ASSERT_EQUAL(expected, positives);
+
+    free(out);
+    free(hashes);
+    free(keys);
+    cf_destroy(cf);
+}
+
+// 测试序列化往返与格式校验
+void test_cf_serialize_roundtrip(void)
+{
+    cuckoo_filter_t *cf = cf_create(KEY_COUNT, 0.01);
+    for (uint64_t i = 0; i < KEY_COUNT; i++)
+    {
+        cf_add_hash(cf, hash_u64(i));
+    }
+
+    size_t size = cf_serialized_size(cf);
+    uint8_t *buf = (uint8_t *)malloc(size);
+    TEST_ASSERT_EQUAL(0, cf_serialize(cf, buf, size - 1));
+    TEST_ASSERT_EQUAL(size, cf_serialize(cf, buf, size));
+
+    cuckoo_filter_t *copy = cf_deserialize(buf, size);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_EQUAL(cf_count(cf), cf_count(copy));
+    TEST_ASSERT_EQUAL(cf_capacity(cf), cf_capacity(copy));
+    for (uint64_t i = 0; i < 2 * KEY_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(cf_contains_hash(cf, hash_u64(i)), cf_contains_hash(copy, hash_u64(i)));
+    }
+    // 反序列化的过滤器仍可删除
+    TEST_ASSERT_TRUE(cf_remove_hash(copy, hash_u64(0)));
+
+    // 按小端存储：魔数为"CKF1"，多字节指纹低字节在前
+    TEST_ASSERT_EQUAL_MEMORY("CKF1", buf, 4);
+    TEST_ASSERT_EQUAL(2, cf->fp_bytes);
+    bool little_endian = true;
+    for (size_t i = 0; i < cf_capacity(cf); i++)
+    {
+        uint16_t fp;
+        memcpy(&fp, cf->table + i * 2, sizeof(fp));
+        little_endian &= buf[40 + i * 2] == (uint8_t)fp && buf[40 + i * 2 + 1] == (uint8_t)(fp >> 8);
+    }
+    TEST_ASSERT_TRUE(little_endian);
+
+    TEST_ASSERT_NULL(cf_deserialize(buf, size - 1));
+    TEST_ASSERT_NULL(cf_deserialize(buf, 16));
+    buf[4] = 3;
+    TEST_ASSERT_NULL(cf_deserialize(buf, size));
+
+    free(buf);
+    cf_destroy(copy);
+    cf_destroy(cf);
+}
+
+// 测试空指针
+void test_cf_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(cf_add(NULL, "a", 1));
+    TEST_ASSERT_FALSE(cf_add_hash(NULL, 1));
+    TEST_ASSERT_FALSE(cf_contains(NULL, "a", 1));
+    TEST_ASSERT_FALSE(cf_remove(NULL, "a", 1));
+    TEST_ASSERT_EQUAL(0, cf_add_bulk(NULL, NULL, 0));
+    TEST_ASSERT_EQUAL(0, cf_contains_bulk(NULL, NULL, 0, NULL));
+    TEST_ASSERT_EQUAL(0, cf_count(NULL));
+    TEST_ASSERT_EQUAL(0, cf_capacity(NULL));
+    TEST_ASSERT_EQUAL(0, cf_serialize(NULL, NULL, 0));
+    TEST_ASSERT_NULL(cf_deserialize(NULL, 0));
+    cf_clear(NULL);
+    cf_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_cf_create_should_pick_fingerprint_width);
+    RUN_TEST(test_cf_should_have_no_false_negatives);
+    RUN_TEST(test_cf_remove_should_forget_keys);
+    RUN_TEST(test_cf_full_filter_should_reject_then_recover);
+    RUN_TEST(test_cf_bulk_should_match_single);
+    RUN_TEST(test_cf_serialize_roundtrip);
+    RUN_TEST(test_cf_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
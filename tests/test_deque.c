@@ -0,0 +1,190 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "queue/deque.h"
+#include "Unity/src/unity.h"
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static uintptr_t sum;
+
+static void add_to_sum(void *data)
+{
+    sum += (uintptr_t)data;
+}
+
+// 测试创建空队列
+void test_dq_create_should_create_empty_deque(void)
+{
+    deque_t *dq = dq_create();
+
+    TEST_ASSERT_NOT_NULL(dq);
+    TEST_ASSERT_EQUAL(0, dq_size(dq));
+    TEST_ASSERT_TRUE(dq_is_empty(dq));
+    TEST_ASSERT_NULL(dq_get_first(dq));
+    TEST_ASSERT_NULL(dq_get_last(dq));
+    TEST_ASSERT_NULL(dq_remove_first(dq));
+    TEST_ASSERT_NULL(dq_remove_last(dq));
+
+    dq_destroy(dq);
+}
+
+// 测试两端插入与下标访问
+void test_dq_add_both_ends_should_keep_order(void)
+{
+    deque_t *dq = dq_create();
+
+    dq_add_last(dq, (void *)2);
+    dq_add_last(dq, (void *)3);
+    dq_add_first(dq, (void *)1);
+
+    TEST_ASSERT_EQUAL(3, dq_size(dq));
+    TEST_ASSERT_EQUAL_PTR((void *)1, dq_get(dq, 0));
+    TEST_ASSERT_EQUAL_PTR((void *)2, dq_get(dq, 1));
+    TEST_ASSERT_EQUAL_PTR((void *)3, dq_get(dq, 2));
+    TEST_ASSERT_NULL(dq_get(dq, 3));
+    TEST_ASSERT_EQUAL_PTR((void *)1, dq_get_first(dq));
+    TEST_ASSERT_EQUAL_PTR((void *)3, dq_get_last(dq));
+
+    TEST_ASSERT_TRUE(dq_set(dq, 1, (void *)20));
+    TEST_ASSERT_EQUAL_PTR((void *)20, dq_get(dq, 1));
+    TEST_ASSERT_FALSE(dq_set(dq, 3, NULL));
+
+    dq_destroy(dq);
+}
+
+// 测试跨越多个块的头部插入（触发映射表重新布局）
+void test_dq_add_first_should_grow_across_chunks(void)
+{
+    deque_t *dq = dq_create();
+    size_t n = DQ_CHUNK_SIZE * 40 + 3;
+
+    for (uintptr_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_TRUE(dq_add_first(dq, (void *)i));
+    }
+    TEST_ASSERT_EQUAL(n, dq_size(dq));
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)(uintptr_t)(n - 1 - i), dq_get(dq, i));
+    }
+    for (uintptr_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)i, dq_remove_last(dq));
+    }
+    TEST_ASSERT_TRUE(dq_is_empty(dq));
+
+    dq_destroy(dq);
+}
+
+// 测试随机操作与参照模型一致
+void test_dq_random_operations_should_match_model(void)
+{
+    deque_t *dq = dq_create();
+    size_t capacity = 200000;
+    uintptr_t *model = malloc(capacity * sizeof(uintptr_t));
+    size_t head = capacity / 2;
+    size_t tail = capacity / 2;
+    uint32_t seed = 7;
+
+    for (uintptr_t i = 1; i <= 60000; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        switch ((seed >> 16) % 5)
+        {
+        case 0:
+        case 1:
+            dq_add_last(dq, (void *)i);
+            model[tail++] = i;
+            break;
+        case 2:
+            dq_add_first(dq, (void *)i);
+            model[--head] = i;
+            break;
+        case 3:
+            if (head < tail)
+            {
+                TEST_ASSERT_EQUAL_PTR((void *)model[head++], dq_remove_first(dq));
+            }
+            break;
+        default:
+            if (head < tail)
+            {
+                TEST_ASSERT_EQUAL_PTR((void *)model[--tail], dq_remove_last(dq));
+            }
+            break;
+        }
+        TEST_ASSERT_EQUAL(tail - head, dq_size(dq));
+    }
+
+    for (size_t i = head; i < tail; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)model[i], dq_get(dq, i - head));
+    }
+
+    free(model);
+    dq_destroy(dq);
+}
+
+// 测试滑动窗口式的交替进出
+void test_dq_sliding_window_should_reuse_chunks(void)
+{
+    deque_t *dq = dq_create();
+
+    for (uintptr_t i = 1; i <= 100000; i++)
+    {
+        dq_add_last(dq, (void *)i);
+        if (dq_size(dq) > 100)
+        {
+            TEST_ASSERT_EQUAL_PTR((void *)(i - 100), dq_remove_first(dq));
+        }
+    }
+    TEST_ASSERT_EQUAL(100, dq_size(dq));
+    TEST_ASSERT_TRUE(dq->map_capacity <= 64);
+
+    sum = 0;
+    dq_foreach(dq, add_to_sum);
+    TEST_ASSERT_EQUAL((99901 + 100000) * 50, sum);
+
+    dq_clear(dq);
+    TEST_ASSERT_TRUE(dq_is_empty(dq));
+    TEST_ASSERT_TRUE(dq_add_first(dq, (void *)5));
+    TEST_ASSERT_EQUAL_PTR((void *)5, dq_get_last(dq));
+
+    dq_destroy(dq);
+}
+
+// 测试空指针
+void test_dq_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(dq_add_first(NULL, NULL));
+    TEST_ASSERT_FALSE(dq_add_last(NULL, NULL));
+    TEST_ASSERT_NULL(dq_remove_first(NULL));
+    TEST_ASSERT_NULL(dq_remove_last(NULL));
+    TEST_ASSERT_NULL(dq_get(NULL, 0));
+    TEST_ASSERT_EQUAL(0, dq_size(NULL));
+    TEST_ASSERT_TRUE(dq_is_empty(NULL));
+    dq_foreach(NULL, add_to_sum);
+    dq_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_dq_create_should_create_empty_deque);
+    RUN_TEST(test_dq_add_both_ends_should_keep_order);
+    RUN_TEST(test_dq_add_first_should_grow_across_chunks);
+    RUN_TEST(test_dq_random_operations_should_match_model);
+    RUN_TEST(test_dq_sliding_window_should_reuse_chunks);
+    RUN_TEST(test_dq_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
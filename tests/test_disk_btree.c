@@ -0,0 +1,605 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "tree/disk_btree.h"
+#include "hash/hash.h"
+#include "Unity/src/unity.h"
+
+#define KEY_RANGE 20000
+#define STEP_COUNT 60000
+#define BULK_COUNT 100000
+#define REOPEN_COUNT 30000
+#define PATH_SIZE 64                // 数据文件路径缓冲区大小
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// 在/tmp下创建空文件作为数据文件
+static void make_path(char *path)
+{
+    strcpy(path, "/tmp/test_disk_btree_XXXXXX");
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+}
+
+static void wal_path(const char *path, char *out, size_t size)
+{
+    snprintf(out, size, "%s-wal", path);
+}
+
+static void remove_files(const char *path)
+{
+    char wal[PATH_SIZE + sizeof("-wal")];
+    wal_path(path, wal, sizeof(wal));
+    unlink(path);
+    unlink(wal);
+}
+
+static uint8_t *read_file(const char *path, size_t *size)
+{
+    FILE *fp = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fseek(fp, 0, SEEK_END);
+    *size = (size_t)ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    uint8_t *buf = (uint8_t *)malloc(*size + 1);
+    TEST_ASSERT_EQUAL(*size, fread(buf, 1, *size, fp));
+    fclose(fp);
+    return buf;
+}
+
+static void write_file(const char *path, const void *buf, size_t size)
+{
+    FILE *fp = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    TEST_ASSERT_EQUAL(size, fwrite(buf, 1, size, fp));
+    fclose(fp);
+}
+
+static long file_size(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+// 按升序扫描全部元素，与参照数组核对
+static void check_against_reference(disk_btree_t *dbt, const bool *present, const uint64_t *values)
+{
+    uint64_t *keys = (uint64_t *)malloc(KEY_RANGE * sizeof(uint64_t));
+    uint64_t *vals = (uint64_t *)malloc(KEY_RANGE * sizeof(uint64_t));
+    size_t n = dbt_range(dbt, 0, UINT64_MAX, keys, vals, KEY_RANGE);
+    size_t j = 0;
+    for (uint64_t k = 0; k < KEY_RANGE; k++)
+    {
+        if (present[k])
+        {
+            TEST_ASSERT_TRUE(j < n);
+            TEST_ASSERT_EQUAL_UINT64(k, keys[j]);
+            TEST_ASSERT_EQUAL_UINT64(values[k], vals[j]);
+            j++;
+        }
+    }
+    TEST_ASSERT_EQUAL(j, n);
+    TEST_ASSERT_EQUAL(n, dbt_size(dbt));
+    free(keys);
+    free(vals);
+}
+
+// 测试创建、关闭后重新打开仍能查询
+void test_dbt_reopen_should_keep_committed_data(void)
+{
+    char path[PATH_SIZE];
+    make_path(path);
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+    uint64_t value = 0;
+
+    TEST_ASSERT_NOT_NULL(dbt);
+    TEST_ASSERT_TRUE(dbt_is_empty(dbt));
+    TEST_ASSERT_FALSE(dbt_get(dbt, 1, &value));
+    for (uint64_t k = 0; k < REOPEN_COUNT; k++)
+    {
+        TEST_ASSERT_TRUE(dbt_put(dbt, hash_u64(k), k));
+    }
+    TEST_ASSERT_TRUE(dbt_put(dbt, hash_u64(7), 700));
+    TEST_ASSERT_EQUAL(REOPEN_COUNT, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+    TEST_ASSERT_EQUAL(0, file_size(path) % DBT_PAGE_SIZE);
+
+    dbt = dbt_open(path, 0, DBT_MIN_CACHE);
+    TEST_ASSERT_NOT_NULL(dbt);
+    TEST_ASSERT_EQUAL(REOPEN_COUNT, dbt_size(dbt));
+    TEST_ASSERT_EQUAL(2, dbt_height(dbt));
+    for (uint64_t k = 0; k < REOPEN_COUNT; k++)
+    {
+        TEST_ASSERT_TRUE(dbt_get(dbt, hash_u64(k), &value));
+        TEST_ASSERT_EQUAL_UINT64(k == 7 ? 700 : k, value);
+    }
+    TEST_ASSERT_TRUE(dbt->stats.evictions > 0);
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+    remove_files(path);
+}
+
+// 测试小缓存下的随机插入删除：淘汰与自动提交都发生，内容始终与参照数组一致
+void test_dbt_random_operations_should_match_reference(void)
+{
+    char path[PATH_SIZE];
+    make_path(path);
+    disk_btree_t *dbt = dbt_open(path, 0, DBT_MIN_CACHE);
+    bool *present = (bool *)calloc(KEY_RANGE, sizeof(bool));
+    uint64_t *values = (uint64_t *)calloc(KEY_RANGE, sizeof(uint64_t));
+    uint64_t seed = 17;
+
+    for (size_t step = 0; step < STEP_COUNT; step++)
+    {
+        uint64_t r = next_rand(&seed);
+        uint64_t key = r % KEY_RANGE;
+        // 前半段以插入为主，后半段以删除为主，使节点经历分裂与合并
+        bool insert = (r >> 32) % 100 < (step < STEP_COUNT / 2 ? 70u : 25u);
+        if (insert)
+        {
+            TEST_ASSERT_TRUE(dbt_put(dbt, key, r));
+            present[key] = true;
+            values[key] = r;
+        }
+        else
+        {
+            uint64_t removed = 0;
+            TEST_ASSERT_EQUAL(present[key], dbt_remove(dbt, key, &removed));
+            if (present[key])
+            {
+                TEST_ASSERT_EQUAL_UINT64(values[key], removed);
+            }
+            present[key] = false;
+        }
+        if (step % 9973 == 0)
+        {
+            check_against_reference(dbt, present, values);
+        }
+    }
+    check_against_reference(dbt, present, values);
+    TEST_ASSERT_TRUE(dbt->stats.commits > 0);
+    TEST_ASSERT_TRUE(dbt->stats.evictions > 0);
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    // 重新打开后内容不变；全部删除后释放的页都进入空闲链表
+    dbt = dbt_open(path, 0, 0);
+    check_against_reference(dbt, present, values);
+    for (uint64_t k = 0; k < KEY_RANGE; k++)
+    {
+        TEST_ASSERT_EQUAL(present[k], dbt_remove(dbt, k, NULL));
+    }
+    TEST_ASSERT_TRUE(dbt_is_empty(dbt));
+    TEST_ASSERT_EQUAL(0, dbt_height(dbt));
+    TEST_ASSERT_TRUE(dbt->meta.free_head != 0);
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+    free(present);
+    free(values);
+    remove_files(path);
+}
+
+// 测试回滚与进程崩溃：未提交的修改都不可见
+void test_dbt_uncommitted_changes_should_be_discarded(void)
+{
+    char path[PATH_SIZE];
+    make_path(path);
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+
+    for (uint64_t k = 0; k < 1000; k++)
+    {
+        dbt_put(dbt, k, k);
+    }
+    TEST_ASSERT_TRUE(dbt_commit(dbt));
+    for (uint64_t k = 1000; k < 2000; k++)
+    {
+        dbt_put(dbt, k, k);
+    }
+    dbt_remove(dbt, 5, NULL);
+    TEST_ASSERT_TRUE(dbt_rollback(dbt));
+    TEST_ASSERT_EQUAL(1000, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, NULL));
+    TEST_ASSERT_FALSE(dbt_get(dbt, 1500, NULL));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    // 子进程提交一批后再修改，不关闭直接退出
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE(pid >= 0);
+    if (pid == 0)
+    {
+        disk_btree_t *child = dbt_open(path, 0, 0);
+        for (uint64_t k = 2000; k < 3000; k++)
+        {
+            dbt_put(child, k, k);
+        }
+        dbt_commit(child);
+        for (uint64_t k = 0; k < 3000; k += 2)
+        {
+            dbt_remove(child, k, NULL);
+        }
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(2000, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 0, NULL));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 2998, NULL));
+    TEST_ASSERT_FALSE(dbt_get(dbt, 3000, NULL));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+    remove_files(path);
+}
+
+// 按文档格式把new_image中与old_image不同的页写成日志；commit为false时不写提交记录
+static void write_wal(const char *path, const uint8_t *old_image, size_t old_size, const uint8_t *new_image,
+                      size_t new_size, bool commit, bool corrupt)
+{
+    char wal[PATH_SIZE + sizeof("-wal")];
+    wal_path(path, wal, sizeof(wal));
+    FILE *fp = fopen(wal, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    uint64_t records = 0;
+    uint64_t combined = 0;
+    for (size_t page = 0; page < new_size / DBT_PAGE_SIZE; page++)
+    {
+        const uint8_t *image = new_image + page * DBT_PAGE_SIZE;
+        if (page * DBT_PAGE_SIZE < old_size && memcmp(image, old_image + page * DBT_PAGE_SIZE, DBT_PAGE_SIZE) == 0)
+        {
+            continue;
+        }
+        dbt_wal_record_t record = {DBT_WAL_PAGE, page, hash_bytes_seeded(image, DBT_PAGE_SIZE, page)};
+        combined = hash_combine(combined, record.checksum);
+        records++;
+        fwrite(&record, sizeof(record), 1, fp);
+        uint8_t copy[DBT_PAGE_SIZE];
+        memcpy(copy, image, DBT_PAGE_SIZE);
+        if (corrupt && records == 2)
+        {
+            copy[100] ^= 1;
+        }
+        fwrite(copy, DBT_PAGE_SIZE, 1, fp);
+    }
+    if (commit)
+    {
+        dbt_wal_record_t record = {DBT_WAL_COMMIT, records, combined};
+        fwrite(&record, sizeof(record), 1, fp);
+    }
+    fclose(fp);
+}
+
+// 测试日志重放：模拟日志已落盘、数据文件未写回时崩溃；不完整或损坏的日志被丢弃
+void test_dbt_open_should_replay_committed_wal(void)
+{
+    char path[PATH_SIZE];
+    char wal[sizeof(path) + sizeof("-wal")];
+    make_path(path);
+    wal_path(path, wal, sizeof(wal));
+    size_t old_size;
+    size_t new_size;
+    uint64_t value = 0;
+
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+    for (uint64_t k = 0; k < 1000; k++)
+    {
+        dbt_put(dbt, k, k);
+    }
+    dbt_close(dbt);
+    uint8_t *old_image = read_file(path, &old_size);
+
+    dbt = dbt_open(path, 0, 0);
+    dbt_put(dbt, 5000, 1);
+    dbt_put(dbt, 5, 55);
+    dbt_close(dbt);
+    uint8_t *new_image = read_file(path, &new_size);
+
+    // 完整的日志：打开时重放
+    write_file(path, old_image, old_size);
+    write_wal(path, old_image, old_size, new_image, new_size, true, false);
+    TEST_ASSERT_NULL(dbt_open(path, DBT_READONLY, 0));
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_NOT_NULL(dbt);
+    TEST_ASSERT_EQUAL(0, file_size(wal));
+    TEST_ASSERT_EQUAL(1001, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5000, &value));
+    TEST_ASSERT_EQUAL_UINT64(1, value);
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, &value));
+    TEST_ASSERT_EQUAL_UINT64(55, value);
+    dbt_close(dbt);
+
+    // 没有提交记录：丢弃
+    write_file(path, old_image, old_size);
+    write_wal(path, old_image, old_size, new_image, new_size, false, false);
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(0, file_size(wal));
+    TEST_ASSERT_EQUAL(1000, dbt_size(dbt));
+    TEST_ASSERT_FALSE(dbt_get(dbt, 5000, NULL));
+    dbt_close(dbt);
+
+    // 页映像校验失败：丢弃
+    write_file(path, old_image, old_size);
+    write_wal(path, old_image, old_size, new_image, new_size, true, true);
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(1000, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, &value));
+    TEST_ASSERT_EQUAL_UINT64(5, value);
+    dbt_close(dbt);
+
+    free(old_image);
+    free(new_image);
+    remove_files(path);
+}
+
+// 测试日志落盘后写回数据文件失败：提交仍然成功且不可回滚，写回恢复后继续写入
+void test_dbt_commit_should_stand_after_write_back_failure(void)
+{
+    char path[PATH_SIZE];
+    char wal[sizeof(path) + sizeof("-wal")];
+    make_path(path);
+    wal_path(path, wal, sizeof(wal));
+    uint64_t value = 0;
+
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+    for (uint64_t k = 0; k < 1000; k++)
+    {
+        dbt_put(dbt, k, k);
+    }
+    TEST_ASSERT_TRUE(dbt_commit(dbt));
+
+    // 把数据文件换成只读描述符，写回失败而日志仍可写
+    int saved = dup(dbt->fd);
+    int readonly = open(path, O_RDONLY);
+    dup2(readonly, dbt->fd);
+    close(readonly);
+    TEST_ASSERT_TRUE(dbt_put(dbt, 5000, 1));
+    TEST_ASSERT_TRUE(dbt_put(dbt, 5, 55));
+    TEST_ASSERT_TRUE(dbt_commit(dbt));
+    TEST_ASSERT_TRUE(file_size(wal) > 0);
+
+    // 写回完成前写操作失败，回滚不丢弃已提交的修改
+    TEST_ASSERT_FALSE(dbt_put(dbt, 6000, 1));
+    TEST_ASSERT_FALSE(dbt_remove(dbt, 5, NULL));
+    TEST_ASSERT_TRUE(dbt_rollback(dbt));
+    TEST_ASSERT_EQUAL(1001, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5000, &value));
+    TEST_ASSERT_EQUAL_UINT64(1, value);
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, &value));
+    TEST_ASSERT_EQUAL_UINT64(55, value);
+    TEST_ASSERT_FALSE(dbt_get(dbt, 6000, NULL));
+
+    // 写回恢复后下一次写操作先完成写回
+    dup2(saved, dbt->fd);
+    close(saved);
+    TEST_ASSERT_TRUE(dbt_put(dbt, 6000, 2));
+    TEST_ASSERT_EQUAL(0, file_size(wal));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(1002, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, &value));
+    TEST_ASSERT_EQUAL_UINT64(55, value);
+    TEST_ASSERT_TRUE(dbt_get(dbt, 6000, &value));
+    TEST_ASSERT_EQUAL_UINT64(2, value);
+    dbt_close(dbt);
+
+    // 写回始终失败时关闭，下次打开从日志重放已提交的修改
+    dbt = dbt_open(path, 0, 0);
+    readonly = open(path, O_RDONLY);
+    dup2(readonly, dbt->fd);
+    close(readonly);
+    TEST_ASSERT_TRUE(dbt_put(dbt, 7000, 3));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+    TEST_ASSERT_TRUE(file_size(wal) > 0);
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(0, file_size(wal));
+    TEST_ASSERT_EQUAL(1003, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 7000, &value));
+    TEST_ASSERT_EQUAL_UINT64(3, value);
+    dbt_close(dbt);
+
+    remove_files(path);
+}
+
+// 测试写日志中途失败时清空日志，清空也失败时拒绝之后的修改
+void test_dbt_commit_should_clear_wal_after_append_failure(void)
+{
+    char path[PATH_SIZE];
+    char wal[sizeof(path) + sizeof("-wal")];
+    make_path(path);
+    wal_path(path, wal, sizeof(wal));
+    uint64_t value = 0;
+
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+    for (uint64_t k = 0; k < 1000; k++)
+    {
+        dbt_put(dbt, k, k);
+    }
+    TEST_ASSERT_TRUE(dbt_commit(dbt));
+    for (uint64_t k = 1000; k < 2000; k++)
+    {
+        dbt_put(dbt, k, k);
+    }
+    TEST_ASSERT_TRUE(dbt_put(dbt, 5, 55));
+
+    // 限制文件大小，日志写入第二条页记录时失败
+    struct rlimit saved_limit;
+    getrlimit(RLIMIT_FSIZE, &saved_limit);
+    struct rlimit limit = saved_limit;
+    limit.rlim_cur = 2 * DBT_PAGE_SIZE;
+    signal(SIGXFSZ, SIG_IGN);
+    setrlimit(RLIMIT_FSIZE, &limit);
+    bool committed = dbt_commit(dbt);
+    setrlimit(RLIMIT_FSIZE, &saved_limit);
+    signal(SIGXFSZ, SIG_DFL);
+    TEST_ASSERT_FALSE(committed);
+    TEST_ASSERT_EQUAL(0, file_size(wal));
+
+    // 修改仍在缓存中，可以再次提交
+    TEST_ASSERT_EQUAL(2000, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_commit(dbt));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(2000, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, &value));
+    TEST_ASSERT_EQUAL_UINT64(55, value);
+
+    // 把日志换成只读描述符，写日志与清空日志都失败
+    TEST_ASSERT_TRUE(dbt_put(dbt, 3000, 1));
+    int saved = dup(dbt->wal_fd);
+    int readonly = open(wal, O_RDONLY);
+    dup2(readonly, dbt->wal_fd);
+    close(readonly);
+    TEST_ASSERT_FALSE(dbt_commit(dbt));
+
+    // 日志恢复可写后仍拒绝修改、提交与回滚
+    dup2(saved, dbt->wal_fd);
+    close(saved);
+    TEST_ASSERT_FALSE(dbt_put(dbt, 3001, 1));
+    TEST_ASSERT_FALSE(dbt_remove(dbt, 5, NULL));
+    TEST_ASSERT_FALSE(dbt_rollback(dbt));
+    TEST_ASSERT_FALSE(dbt_commit(dbt));
+    TEST_ASSERT_TRUE(dbt_get(dbt, 5, &value));
+    TEST_ASSERT_FALSE(dbt_close(dbt));
+
+    dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_EQUAL(2000, dbt_size(dbt));
+    TEST_ASSERT_FALSE(dbt_get(dbt, 3000, NULL));
+    dbt_close(dbt);
+
+    remove_files(path);
+}
+
+// 测试批量构建后以mmap只读打开查询，再可写打开继续修改
+void test_dbt_bulk_load_should_support_mmap_reads(void)
+{
+    char path[PATH_SIZE];
+    make_path(path);
+    uint64_t *keys = (uint64_t *)malloc(BULK_COUNT * sizeof(uint64_t));
+    uint64_t *values = (uint64_t *)malloc(BULK_COUNT * sizeof(uint64_t));
+    uint64_t out_keys[600];
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < BULK_COUNT; i++)
+    {
+        keys[i] = i * 3;
+        values[i] = i;
+    }
+    disk_btree_t *dbt = dbt_open(path, 0, 0);
+    TEST_ASSERT_FALSE(dbt_bulk_load(dbt, values, keys, 0) && dbt_bulk_load(dbt, (uint64_t[]){2, 1}, keys, 2));
+    TEST_ASSERT_TRUE(dbt_bulk_load(dbt, keys, values, BULK_COUNT));
+    TEST_ASSERT_FALSE(dbt_bulk_load(dbt, keys, values, BULK_COUNT));
+    TEST_ASSERT_EQUAL(BULK_COUNT, dbt_size(dbt));
+    TEST_ASSERT_EQUAL(3, dbt_height(dbt));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    dbt = dbt_open(path, DBT_MMAP, 0);
+    TEST_ASSERT_NOT_NULL(dbt);
+    TEST_ASSERT_NOT_NULL(dbt->map);
+    for (size_t i = 0; i < BULK_COUNT; i += 7)
+    {
+        TEST_ASSERT_TRUE(dbt_get(dbt, keys[i], &value));
+        TEST_ASSERT_EQUAL_UINT64(i, value);
+        TEST_ASSERT_FALSE(dbt_get(dbt, keys[i] + 1, NULL));
+    }
+    // 跨越多个叶节点的范围，分批继续
+    size_t n = dbt_range(dbt, 1000, 3000, out_keys, NULL, 600);
+    TEST_ASSERT_EQUAL(600, n);
+    TEST_ASSERT_EQUAL_UINT64(1002, out_keys[0]);
+    n = dbt_range(dbt, out_keys[599] + 1, 3000, out_keys, NULL, 600);
+    TEST_ASSERT_EQUAL(66, n);
+    TEST_ASSERT_EQUAL_UINT64(2997, out_keys[65]);
+    TEST_ASSERT_FALSE(dbt_put(dbt, 1, 1));
+    TEST_ASSERT_FALSE(dbt_remove(dbt, 0, NULL));
+    TEST_ASSERT_FALSE(dbt_commit(dbt));
+    TEST_ASSERT_EQUAL(0, dbt->stats.misses);
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    dbt = dbt_open(path, 0, DBT_MIN_CACHE);
+    for (size_t i = 0; i < BULK_COUNT; i += 2)
+    {
+        TEST_ASSERT_TRUE(dbt_put(dbt, keys[i] + 1, i));
+        TEST_ASSERT_TRUE(dbt_remove(dbt, keys[i + 1], NULL));
+    }
+    TEST_ASSERT_EQUAL(BULK_COUNT, dbt_size(dbt));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    dbt = dbt_open(path, DBT_READONLY, 0);
+    TEST_ASSERT_TRUE(dbt_get(dbt, keys[10] + 1, &value));
+    TEST_ASSERT_EQUAL_UINT64(10, value);
+    TEST_ASSERT_FALSE(dbt_get(dbt, keys[11], NULL));
+    TEST_ASSERT_FALSE(dbt_put(dbt, 1, 1));
+    TEST_ASSERT_TRUE(dbt_close(dbt));
+
+    free(keys);
+    free(values);
+    remove_files(path);
+}
+
+// 测试无效文件与空指针
+void test_dbt_edge_cases_should_handle_invalid_inputs(void)
+{
+    char path[PATH_SIZE];
+    make_path(path);
+
+    // 空文件不能只读打开，格式不对的文件不能打开
+    TEST_ASSERT_NULL(dbt_open(path, DBT_READONLY, 0));
+    TEST_ASSERT_NULL(dbt_open(path, DBT_MMAP, 0));
+    uint8_t junk[DBT_PAGE_SIZE];
+    memset(junk, 0xAB, sizeof(junk));
+    write_file(path, junk, sizeof(junk));
+    TEST_ASSERT_NULL(dbt_open(path, 0, 0));
+    TEST_ASSERT_NULL(dbt_open("/nonexistent/disk_btree", 0, 0));
+    TEST_ASSERT_NULL(dbt_open(NULL, 0, 0));
+
+    TEST_ASSERT_FALSE(dbt_put(NULL, 1, 1));
+    TEST_ASSERT_FALSE(dbt_get(NULL, 1, NULL));
+    TEST_ASSERT_FALSE(dbt_remove(NULL, 1, NULL));
+    TEST_ASSERT_EQUAL(0, dbt_range(NULL, 0, 10, NULL, NULL, 10));
+    TEST_ASSERT_FALSE(dbt_bulk_load(NULL, NULL, NULL, 0));
+    TEST_ASSERT_FALSE(dbt_commit(NULL));
+    TEST_ASSERT_FALSE(dbt_rollback(NULL));
+    TEST_ASSERT_FALSE(dbt_close(NULL));
+    TEST_ASSERT_EQUAL(0, dbt_size(NULL));
+    TEST_ASSERT_TRUE(dbt_is_empty(NULL));
+    TEST_ASSERT_EQUAL(0, dbt_height(NULL));
+    remove_files(path);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_dbt_reopen_should_keep_committed_data);
+    RUN_TEST(test_dbt_random_operations_should_match_reference);
+    RUN_TEST(test_dbt_uncommitted_changes_should_be_discarded);
+    RUN_TEST(test_dbt_open_should_replay_committed_wal);
+    RUN_TEST(test_dbt_commit_should_stand_after_write_back_failure);
+    RUN_TEST(test_dbt_commit_should_clear_wal_after_append_failure);
+    RUN_TEST(test_dbt_bulk_load_should_support_mmap_reads);
+    RUN_TEST(test_dbt_edge_cases_should_handle_invalid_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "sync/ebr.h"
+#include "Unity/src/unity.h"
+
+#define RETIRE_THREADS 4
+#define RETIRES_PER_THREAD 20000
+
+static ebr_domain_t domain;
+static size_t released;
+
+static void count_release(void *ptr, void *arg)
+{
+    (void)ptr;
+    __atomic_add_fetch((size_t *)arg, 1, __ATOMIC_RELAXED);
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+    ebr_init(&domain);
+    released = 0;
+}
+
+void tearDown(void)
+{
+    ebr_destroy(&domain);
+}
+
+// 进入读临界区后等待go置位再退出
+typedef struct
+{
+    int entered;
+    int go;
+} holder_t;
+
+static void *hold_reader(void *arg)
+{
+    holder_t *holder = (holder_t *)arg;
+    ebr_guard_t guard = ebr_enter(&domain);
+    __atomic_add_fetch(&holder->entered, 1, __ATOMIC_SEQ_CST);
+    while (!__atomic_load_n(&holder->go, __ATOMIC_SEQ_CST))
+    {
+        sched_yield();
+    }
+    ebr_exit(&domain, guard);
+    return NULL;
+}
+
+// 退休足够多次以触发纪元推进检查
+static void retire_batch(size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        ebr_retire_with(&domain, (void *)(uintptr_t)(i + 1), count_release, &released);
+    }
+}
+
+// 测试读线程未退出时不释放，退出后释放
+void test_ebr_retire_should_wait_for_readers(void)
+{
+    holder_t holder = {0, 0};
+    pthread_t thread;
+    pthread_create(&thread, NULL, hold_reader, &holder);
+    while (__atomic_load_n(&holder.entered, __ATOMIC_SEQ_CST) == 0)
+    {
+        sched_yield();
+    }
+
+    retire_batch(4 * EBR_RECLAIM_BATCH);
+    TEST_ASSERT_EQUAL(0, __atomic_load_n(&released, __ATOMIC_RELAXED));
+
+    __atomic_store_n(&holder.go, 1, __ATOMIC_SEQ_CST);
+    pthread_join(thread, NULL);
+    ebr_synchronize(&domain);
+    TEST_ASSERT_EQUAL(4 * EBR_RECLAIM_BATCH, released);
+}
+
+// 测试同时存在的线程超过独占槽上限时，多出的线程共用的槽同样阻止释放
+void test_ebr_threads_beyond_limit_should_share_slot(void)
+{
+    enum { THREADS = EBR_MAX_THREADS + 8 };
+    holder_t holder = {0, 0};
+    pthread_t *threads = (pthread_t *)malloc(THREADS * sizeof(pthread_t));
+    for (size_t i = 0; i < THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, hold_reader, &holder);
+    }
+    while (__atomic_load_n(&holder.entered, __ATOMIC_SEQ_CST) < THREADS)
+    {
+        sched_yield();
+    }
+
+    retire_batch(4 * EBR_RECLAIM_BATCH);
+    TEST_ASSERT_EQUAL(0, __atomic_load_n(&released, __ATOMIC_RELAXED));
+
+    __atomic_store_n(&holder.go, 1, __ATOMIC_SEQ_CST);
+    for (size_t i = 0; i < THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    ebr_synchronize(&domain);
+    TEST_ASSERT_EQUAL(4 * EBR_RECLAIM_BATCH, released);
+
+    // 退出线程的槽位被新线程复用
+    holder_t again = {0, 1};
+    pthread_t thread;
+    pthread_create(&thread, NULL, hold_reader, &again);
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQUAL(1, again.entered);
+}
+
+// 共享节点：写线程替换后退休旧节点，读线程检查读到的节点未被释放
+typedef struct
+{
+    uint64_t magic;
+} node_t;
+
+#define NODE_LIVE 0x4c495645ull
+#define NODE_DEAD 0x44454144ull
+
+static node_t *shared[2];
+static ebr_limbo_t limbos[2];
+static int stop;
+
+static void node_release(void *ptr, void *arg)
+{
+    node_t *node = (node_t *)ptr;
+    node->magic = NODE_DEAD;
+    free(node);
+    __atomic_add_fetch((size_t *)arg, 1, __ATOMIC_RELAXED);
+}
+
+static void *read_nodes(void *arg)
+{
+    size_t *errors = (size_t *)arg;
+    while (!__atomic_load_n(&stop, __ATOMIC_RELAXED))
+    {
+        ebr_guard_t guard = ebr_enter(&domain);
+        for (size_t i = 0; i < 2; i++)
+        {
+            node_t *node = __atomic_load_n(&shared[i], __ATOMIC_ACQUIRE);
+            if (node->magic != NODE_LIVE)
+            {
+                (*errors)++;
+            }
+        }
+        ebr_exit(&domain, guard);
+    }
+    return NULL;
+}
+
+static void *replace_nodes(void *arg)
+{
+    size_t index = (size_t)(uintptr_t)arg % 2;
+    for (size_t i = 0; i < RETIRES_PER_THREAD; i++)
+    {
+        node_t *node = (node_t *)malloc(sizeof(node_t));
+        node->magic = NODE_LIVE;
+        node_t *old = __atomic_exchange_n(&shared[index], node, __ATOMIC_ACQ_REL);
+        ebr_retire_to(&domain, &limbos[index], old, node_release, &released);
+    }
+    return NULL;
+}
+
+// 测试多个写线程退休到各自的待回收列表，读线程不会读到已释放的节点
+void test_ebr_retire_to_limbos_should_be_safe(void)
+{
+    size_t errors[2] = {0, 0};
+    pthread_t readers[2];
+    pthread_t writers[RETIRE_THREADS];
+    stop = 0;
+    for (size_t i = 0; i < 2; i++)
+    {
+        ebr_limbo_init(&limbos[i]);
+        shared[i] = (node_t *)malloc(sizeof(node_t));
+        shared[i]->magic = NODE_LIVE;
+        pthread_create(&readers[i], NULL, read_nodes, &errors[i]);
+    }
+    for (size_t i = 0; i < RETIRE_THREADS; i++)
+    {
+        pthread_create(&writers[i], NULL, replace_nodes, (void *)(uintptr_t)i);
+    }
+    for (size_t i = 0; i < RETIRE_THREADS; i++)
+    {
+        pthread_join(writers[i], NULL);
+    }
+    __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < 2; i++)
+    {
+        pthread_join(readers[i], NULL);
+        TEST_ASSERT_EQUAL(0, errors[i]);
+    }
+
+    // 销毁列表时释放剩余部分，每个被替换的节点恰好释放一次
+    for (size_t i = 0; i < 2; i++)
+    {
+        ebr_limbo_destroy(&limbos[i]);
+        free(shared[i]);
+    }
+    TEST_ASSERT_EQUAL(RETIRE_THREADS * RETIRES_PER_THREAD, released);
+}
+
+// 测试嵌套的读临界区
+void test_ebr_nested_guards_should_release_after_exit(void)
+{
+    ebr_guard_t outer = ebr_enter(&domain);
+    ebr_guard_t inner = ebr_enter(&domain);
+    ebr_exit(&domain, inner);
+    ebr_exit(&domain, outer);
+
+    retire_batch(EBR_RECLAIM_BATCH);
+    ebr_synchronize(&domain);
+    TEST_ASSERT_EQUAL(EBR_RECLAIM_BATCH, released);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ebr_retire_should_wait_for_readers);
+    RUN_TEST(test_ebr_threads_beyond_limit_should_share_slot);
+    RUN_TEST(test_ebr_retire_to_limbos_should_be_safe);
+    RUN_TEST(test_ebr_nested_guards_should_release_after_exit);
+
+    return UNITY_END();
+}
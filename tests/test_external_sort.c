@@ -0,0 +1,267 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "sort/external_sort.h"
+#include "Unity/src/unity.h"
+
+#define RECORD_COUNT 20000
+
+// 测试用记录：按key排序，seq用于检查记录是否完整搬移
+typedef struct record
+{
+    uint64_t key;
+    uint32_t seq;
+    uint32_t check;
+} record_t;
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int record_cmp(const void *a, const void *b)
+{
+    const record_t *ra = (const record_t *)a;
+    const record_t *rb = (const record_t *)b;
+    return (ra->key > rb->key) - (ra->key < rb->key);
+}
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// 生成count条记录写入临时文件，key的范围较小以产生重复键
+static FILE *make_input(size_t count, uint64_t seed)
+{
+    FILE *in = tmpfile();
+    TEST_ASSERT_NOT_NULL(in);
+    for (size_t i = 0; i < count; i++)
+    {
+        record_t r;
+        r.key = next_rand(&seed) % (count / 2 + 1);
+        r.seq = (uint32_t)i;
+        r.check = (uint32_t)(r.key * 2654435761u) ^ r.seq;
+        fwrite(&r, sizeof(r), 1, in);
+    }
+    rewind(in);
+    return in;
+}
+
+// 检查输出有序，且恰好包含输入的每条记录各一次
+static void assert_sorted_output(FILE *out, size_t count)
+{
+    rewind(out);
+    uint8_t *seen = (uint8_t *)calloc(count, 1);
+    TEST_ASSERT_NOT_NULL(seen);
+
+    record_t prev = {0, 0, 0};
+    record_t r;
+    size_t n = 0;
+    while (fread(&r, sizeof(r), 1, out) == 1)
+    {
+        TEST_ASSERT_TRUE(r.key >= prev.key);
+        TEST_ASSERT_TRUE(r.seq < count);
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)(r.key * 2654435761u) ^ r.seq, r.check);
+        TEST_ASSERT_EQUAL(0, seen[r.seq]);
+        seen[r.seq] = 1;
+        prev = r;
+        n++;
+    }
+    TEST_ASSERT_EQUAL(count, n);
+    free(seen);
+}
+
+static es_config_t make_config(size_t memory, size_t block)
+{
+    es_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.record_size = sizeof(record_t);
+    config.cmp = record_cmp;
+    config.memory = memory;
+    config.block = block;
+    return config;
+}
+
+// 测试输入能装进内存时不产生临时文件
+void test_es_sort_stream_should_sort_in_memory_when_input_fits(void)
+{
+    FILE *in = make_input(RECORD_COUNT, 7);
+    FILE *out = tmpfile();
+    es_config_t config = make_config(RECORD_COUNT * sizeof(record_t), 0);
+    es_stats_t stats;
+
+    TEST_ASSERT_TRUE(es_sort_stream(in, out, &config, &stats));
+    assert_sorted_output(out, RECORD_COUNT);
+    TEST_ASSERT_EQUAL(RECORD_COUNT, stats.records);
+    TEST_ASSERT_EQUAL(1, stats.runs);
+    TEST_ASSERT_EQUAL(0, stats.merge_passes);
+    TEST_ASSERT_EQUAL(RECORD_COUNT * sizeof(record_t), stats.bytes_read);
+    TEST_ASSERT_EQUAL(RECORD_COUNT * sizeof(record_t), stats.bytes_written);
+    fclose(in);
+    fclose(out);
+}
+
+// 测试多个顺串一趟归并
+void test_es_sort_stream_should_merge_runs_in_one_pass(void)
+{
+    FILE *in = make_input(RECORD_COUNT, 11);
+    FILE *out = tmpfile();
+    // 每个顺串1000条，共20个；每路缓冲512字节，一趟可归并30路
+    es_config_t config = make_config(1000 * sizeof(record_t), 512);
+    es_stats_t stats;
+
+    TEST_ASSERT_TRUE(es_sort_stream(in, out, &config, &stats));
+    assert_sorted_output(out, RECORD_COUNT);
+    TEST_ASSERT_EQUAL(RECORD_COUNT, stats.records);
+    TEST_ASSERT_EQUAL(RECORD_COUNT / 1000, stats.runs);
+    TEST_ASSERT_EQUAL(1, stats.merge_passes);
+    // 输入、顺串写出、顺串读回、最终输出各一遍
+    TEST_ASSERT_EQUAL(2 * RECORD_COUNT * sizeof(record_t), stats.bytes_read);
+    TEST_ASSERT_EQUAL(2 * RECORD_COUNT * sizeof(record_t), stats.bytes_written);
+    fclose(in);
+    fclose(out);
+}
+
+// 测试顺串数超过归并路数时分多趟归并
+void test_es_sort_stream_should_use_multiple_passes(void)
+{
+    FILE *in = make_input(RECORD_COUNT, 23);
+    FILE *out = tmpfile();
+    // 每个顺串64条，共313个，每趟归并3路
+    es_config_t config = make_config(64 * sizeof(record_t), 16 * sizeof(record_t));
+    es_stats_t stats;
+
+    TEST_ASSERT_TRUE(es_sort_stream(in, out, &config, &stats));
+    assert_sorted_output(out, RECORD_COUNT);
+    TEST_ASSERT_EQUAL((RECORD_COUNT + 63) / 64, stats.runs);
+    TEST_ASSERT_TRUE(stats.merge_passes > 2);
+    TEST_ASSERT_EQUAL(stats.bytes_read, stats.bytes_written);
+    TEST_ASSERT_EQUAL((stats.merge_passes + 1) * RECORD_COUNT * sizeof(record_t), stats.bytes_written);
+    fclose(in);
+    fclose(out);
+}
+
+// 测试空输入与输入恰好填满一块内存
+void test_es_sort_stream_should_handle_empty_and_exact_inputs(void)
+{
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    es_config_t config = make_config(100 * sizeof(record_t), 0);
+    es_stats_t stats;
+
+    TEST_ASSERT_TRUE(es_sort_stream(in, out, &config, &stats));
+    TEST_ASSERT_EQUAL(0, stats.records);
+    TEST_ASSERT_EQUAL(0, stats.runs);
+    TEST_ASSERT_EQUAL(0, ftell(out));
+    fclose(in);
+    fclose(out);
+
+    in = make_input(100, 3);
+    out = tmpfile();
+    TEST_ASSERT_TRUE(es_sort_stream(in, out, &config, &stats));
+    assert_sorted_output(out, 100);
+    TEST_ASSERT_EQUAL(1, stats.runs);
+    TEST_ASSERT_EQUAL(0, stats.merge_passes);
+    fclose(in);
+    fclose(out);
+
+    in = make_input(200, 3);
+    out = tmpfile();
+    TEST_ASSERT_TRUE(es_sort_stream(in, out, &config, &stats));
+    assert_sorted_output(out, 200);
+    TEST_ASSERT_EQUAL(2, stats.runs);
+    TEST_ASSERT_EQUAL(1, stats.merge_passes);
+    fclose(in);
+    fclose(out);
+}
+
+// 测试按文件路径排序
+void test_es_sort_file_should_sort_between_paths(void)
+{
+    char in_path[] = "/tmp/test_es_in_XXXXXX";
+    char out_path[] = "/tmp/test_es_out_XXXXXX";
+    int in_fd = mkstemp(in_path);
+    int out_fd = mkstemp(out_path);
+    TEST_ASSERT_TRUE(in_fd >= 0 && out_fd >= 0);
+    close(out_fd);
+
+    FILE *src = make_input(RECORD_COUNT, 31);
+    FILE *in = fdopen(in_fd, "wb");
+    record_t r;
+    while (fread(&r, sizeof(r), 1, src) == 1)
+    {
+        fwrite(&r, sizeof(r), 1, in);
+    }
+    fclose(in);
+    fclose(src);
+
+    es_config_t config = make_config(4096 * sizeof(record_t), 4096);
+    es_stats_t stats;
+    TEST_ASSERT_TRUE(es_sort_file(in_path, out_path, &config, &stats));
+    TEST_ASSERT_EQUAL(RECORD_COUNT, stats.records);
+    TEST_ASSERT_TRUE(stats.runs > 1);
+
+    FILE *out = fopen(out_path, "rb");
+    TEST_ASSERT_NOT_NULL(out);
+    assert_sorted_output(out, RECORD_COUNT);
+    fclose(out);
+    unlink(in_path);
+    unlink(out_path);
+}
+
+// 测试非法参数与不完整的记录
+void test_es_sort_stream_should_reject_invalid_input(void)
+{
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    es_config_t config = make_config(0, 0);
+    es_stats_t stats;
+
+    TEST_ASSERT_FALSE(es_sort_stream(NULL, out, &config, &stats));
+    TEST_ASSERT_FALSE(es_sort_stream(in, NULL, &config, &stats));
+    TEST_ASSERT_FALSE(es_sort_stream(in, out, NULL, &stats));
+    config.cmp = NULL;
+    TEST_ASSERT_FALSE(es_sort_stream(in, out, &config, &stats));
+    config = make_config(2 * sizeof(record_t), 0);
+    TEST_ASSERT_FALSE(es_sort_stream(in, out, &config, &stats));
+
+    // 末尾多出半条记录
+    config = make_config(0, 0);
+    record_t r = {1, 2, 3};
+    fwrite(&r, sizeof(r), 1, in);
+    fwrite(&r, sizeof(r) / 2, 1, in);
+    rewind(in);
+    TEST_ASSERT_FALSE(es_sort_stream(in, out, &config, NULL));
+
+    TEST_ASSERT_FALSE(es_sort_file(NULL, "/tmp/x", &config, &stats));
+    TEST_ASSERT_FALSE(es_sort_file("/nonexistent/es_input", "/tmp/x", &config, &stats));
+    fclose(in);
+    fclose(out);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_es_sort_stream_should_sort_in_memory_when_input_fits);
+    RUN_TEST(test_es_sort_stream_should_merge_runs_in_one_pass);
+    RUN_TEST(test_es_sort_stream_should_use_multiple_passes);
+    RUN_TEST(test_es_sort_stream_should_handle_empty_and_exact_inputs);
+    RUN_TEST(test_es_sort_file_should_sort_between_paths);
+    RUN_TEST(test_es_sort_stream_should_reject_invalid_input);
+
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash/hash.h"
+#include "Unity/src/unity.h"
+
+static int popcount64(uint64_t x)
+{
+    int count = 0;
+    while (x != 0)
+    {
+        x &= x - 1;
+        count++;
+    }
+    return count;
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试结果确定且与对齐无关
+void test_hash_bytes_should_be_deterministic_and_alignment_free(void)
+{
+    uint8_t buffer[300];
+    uint8_t shifted[301];
+    for (size_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    for (size_t len = 0; len <= 256; len++)
+    {
+        memcpy(shifted + 1, buffer, len);
+        uint64_t h = hash_bytes(buffer, len);
+        TEST_ASSERT_EQUAL_UINT64(h, hash_bytes(buffer, len));
+        TEST_ASSERT_EQUAL_UINT64(h, hash_bytes(shifted + 1, len));
+        TEST_ASSERT_EQUAL_UINT64(h, hash_bytes_seeded(buffer, len, 0));
+    }
+}
+
+// 测试所有长度与单字节差异都产生不同的结果
+void test_hash_bytes_should_distinguish_lengths_and_bytes(void)
+{
+    uint8_t buffer[200] = {0};
+    uint64_t seen[201];
+
+    // 全零输入只有长度不同
+    for (size_t len = 0; len <= 200; len++)
+    {
+        seen[len] = hash_bytes(buffer, len);
+        for (size_t j = 0; j < len; j++)
+        {
+            TEST_ASSERT_TRUE(seen[j] != seen[len]);
+        }
+    }
+
+    // 每个位置改变一个字节，各长度分支都要覆盖到全部字节
+    size_t lengths[] = {1, 2, 3, 4, 7, 8, 12, 16, 17, 33, 48, 49, 100, 200};
+    for (size_t k = 0; k < sizeof(lengths) / sizeof(lengths[0]); k++)
+    {
+        size_t len = lengths[k];
+        uint64_t base = hash_bytes(buffer, len);
+        for (size_t pos = 0; pos < len; pos++)
+        {
+            buffer[pos] = 1;
+            TEST_ASSERT_TRUE(hash_bytes(buffer, len) != base);
+            buffer[pos] = 0;
+        }
+    }
+}
+
+// 测试雪崩效应：翻转任一输入位，平均约一半输出位改变
+void test_hash_bytes_should_avalanche(void)
+{
+    uint8_t buffer[64];
+    uint64_t seed = 12345;
+    size_t lengths[] = {3, 8, 16, 24, 64};
+
+    for (size_t k = 0; k < sizeof(lengths) / sizeof(lengths[0]); k++)
+    {
+        size_t len = lengths[k];
+        long total = 0;
+        long samples = 0;
+        for (int round = 0; round < 20; round++)
+        {
+            for (size_t i = 0; i < len; i++)
+            {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                buffer[i] = (uint8_t)(seed >> 56);
+            }
+            uint64_t base = hash_bytes(buffer, len);
+            for (size_t bit = 0; bit < len * 8; bit++)
+            {
+                buffer[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+                total += popcount64(base ^ hash_bytes(buffer, len));
+                samples++;
+                buffer[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+            }
+        }
+        double mean = (double)total / (double)samples;
+        TEST_ASSERT_TRUE(mean > 30.0 && mean < 34.0);
+    }
+}
+
+// 测试种子改变结果
+void test_hash_seeded_should_depend_on_seed(void)
+{
+    const char *text = "hello world";
+    TEST_ASSERT_TRUE(hash_bytes_seeded(text, 11, 1) != hash_bytes_seeded(text, 11, 2));
+    TEST_ASSERT_TRUE(hash_u64_seeded(42, 1) != hash_u64_seeded(42, 2));
+    TEST_ASSERT_TRUE(hash_combine(1, 2) != hash_combine(2, 1));
+    TEST_ASSERT_TRUE(hash_random_seed() != hash_random_seed());
+}
+
+// 测试整数混合函数：小整数不冲突且高位充分混合
+void test_hash_integer_mixers_should_spread_keys(void)
+{
+    size_t n = 1 << 16;
+    uint32_t buckets[256] = {0};
+
+    for (uint64_t i = 0; i < n; i++)
+    {
+        buckets[hash_u64(i) >> 56]++;
+        TEST_ASSERT_TRUE(hash_u64(i) != hash_u64(i + 1));
+        TEST_ASSERT_TRUE(hash_u32((uint32_t)i) != hash_u32((uint32_t)i + 1));
+    }
+    TEST_ASSERT_EQUAL_UINT64(0, hash_u64(0));
+    // 期望每桶256个，允许较大的偶然偏差
+    for (size_t b = 0; b < 256; b++)
+    {
+        TEST_ASSERT_TRUE(buckets[b] > 160 && buckets[b] < 360);
+    }
+}
+
+// 测试批量接口与逐个调用结果一致（覆盖非整倍数的尾部）
+void test_hash_bulk_should_match_scalar(void)
+{
+    uint64_t keys64[37];
+    uint32_t keys32[37];
+    uint64_t out64[37];
+    uint32_t out32[37];
+    char strings[37 * 5];
+
+    for (size_t i = 0; i < 37; i++)
+    {
+        keys64[i] = i * 0x123456789ull;
+        keys32[i] = (uint32_t)(i * 2654435761u);
+        memcpy(strings + i * 5, "k", 1);
+        memcpy(strings + i * 5 + 1, &keys32[i], 4);
+    }
+
+    // 依次限制到CPU支持的每个指令集级别
+    hash_simd_t supported = hash_simd_level();
+    for (int level = HASH_SIMD_NONE; level <= (int)supported; level++)
+    {
+        TEST_ASSERT_EQUAL(level, hash_set_simd_level((hash_simd_t)level));
+        TEST_ASSERT_EQUAL(level, hash_simd_level());
+        for (size_t count = 0; count <= 37; count++)
+        {
+            hash_u64_bulk(keys64, count, out64);
+            hash_u32_bulk(keys32, count, out32);
+            for (size_t i = 0; i < count; i++)
+            {
+                TEST_ASSERT_EQUAL_UINT64(hash_u64(keys64[i]), out64[i]);
+                TEST_ASSERT_EQUAL_UINT32(hash_u32(keys32[i]), out32[i]);
+            }
+        }
+    }
+    // 超过CPU支持的级别时按支持的最高级别
+    TEST_ASSERT_EQUAL(supported, hash_set_simd_level(HASH_SIMD_AVX512));
+
+    hash_bytes_bulk(strings, 5, 37, 9, out64);
+    for (size_t i = 0; i < 37; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT64(hash_bytes_seeded(strings + i * 5, 5, 9), out64[i]);
+    }
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_hash_bytes_should_be_deterministic_and_alignment_free);
+    RUN_TEST(test_hash_bytes_should_distinguish_lengths_and_bytes);
+    RUN_TEST(test_hash_bytes_should_avalanche);
+    RUN_TEST(test_hash_seeded_should_depend_on_seed);
+    RUN_TEST(test_hash_integer_mixers_should_spread_keys);
+    RUN_TEST(test_hash_bulk_should_match_scalar);
+
+    return UNITY_END();
+}
@@ -0,0 +1,360 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_table/hash_table.h"
+#include "Unity/src/unity.h"
+
+// 以指针值作为整数键
+size_t int_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+int int_cmp(void *a, void *b)
+{
+    return (uintptr_t)a == (uintptr_t)b ? 0 : 1;
+}
+
+// 字符串键
+size_t str_hash(void *key)
+{
+    size_t hash = 5381;
+    for (const char *p = (const char *)key; *p != '\0'; p++)
+    {
+        hash = hash * 33 + (unsigned char)*p;
+    }
+    return hash;
+}
+
+int str_cmp(void *a, void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+// 所有键都冲突的哈希函数
+size_t bad_hash(void *key)
+{
+    (void)key;
+    return 42;
+}
+
+static uintptr_t visit_sum;
+
+static void visit(void *key, void *value)
+{
+    (void)key;
+    visit_sum += (uintptr_t)value;
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 检查Robin Hood不变式：每个元素的探测距离与其实际位置一致
+static void assert_invariants(hash_table_t *ht)
+{
+    size_t count = 0;
+    size_t mask = ht->capacity - 1;
+    for (size_t i = 0; i < ht->capacity; i++)
+    {
+        ht_entry_t *e = &ht->entries[i];
+        if (e->dist == 0)
+        {
+            continue;
+        }
+        count++;
+        size_t home = (size_t)(((uint64_t)e->hash * 0x9E3779B97F4A7C15ull) >> ht->shift);
+        TEST_ASSERT_EQUAL(((i - home) & mask) + 1, e->dist);
+        // 下一个元素的探测距离最多比当前大1
+        TEST_ASSERT_TRUE(ht->entries[(i + 1) & mask].dist <= e->dist + 1);
+    }
+    TEST_ASSERT_EQUAL(ht->size, count);
+}
+
+// 测试创建
+void test_ht_create_should_create_empty_table(void)
+{
+    hash_table_t *ht = ht_create(int_hash, int_cmp);
+
+    TEST_ASSERT_NOT_NULL(ht);
+    TEST_ASSERT_EQUAL(0, ht_size(ht));
+    TEST_ASSERT_TRUE(ht_is_empty(ht));
+    TEST_ASSERT_NULL(ht_get(ht, (void *)1));
+    TEST_ASSERT_NULL(ht_create(NULL, int_cmp));
+    TEST_ASSERT_NULL(ht_create(int_hash, NULL));
+
+    ht_destroy(ht);
+}
+
+// 测试插入、查找与替换
+void test_ht_put_get_should_store_and_replace_values(void)
+{
+    hash_table_t *ht = ht_create(str_hash, str_cmp);
+    char key[] = "beta";
+
+    TEST_ASSERT_TRUE(ht_put(ht, "alpha", (void *)1));
+    TEST_ASSERT_TRUE(ht_put(ht, "beta", (void *)2));
+    TEST_ASSERT_EQUAL(2, ht_size(ht));
+    TEST_ASSERT_EQUAL_PTR((void *)1, ht_get(ht, "alpha"));
+    TEST_ASSERT_EQUAL_PTR((void *)2, ht_get(ht, key));
+
+    TEST_ASSERT_TRUE(ht_put(ht, key, (void *)20));
+    TEST_ASSERT_EQUAL(2, ht_size(ht));
+    TEST_ASSERT_EQUAL_PTR((void *)20, ht_get(ht, "beta"));
+
+    // 值为NULL时用ht_find区分
+    void *value = (void *)1;
+    TEST_ASSERT_TRUE(ht_put(ht, "gamma", NULL));
+    TEST_ASSERT_TRUE(ht_find(ht, "gamma", &value));
+    TEST_ASSERT_NULL(value);
+    TEST_ASSERT_FALSE(ht_find(ht, "delta", &value));
+    TEST_ASSERT_TRUE(ht_contains(ht, "gamma"));
+
+    ht_destroy(ht);
+}
+
+// 测试大量插入删除后不变式与内容正确
+void test_ht_many_operations_should_keep_invariants(void)
+{
+    hash_table_t *ht = ht_create(int_hash, int_cmp);
+    size_t n = 20000;
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_TRUE(ht_put(ht, (void *)(i * 7), (void *)i));
+    }
+    TEST_ASSERT_EQUAL(n, ht_size(ht));
+    assert_invariants(ht);
+
+    for (uintptr_t i = 1; i <= n; i += 2)
+    {
+        void *value = NULL;
+        TEST_ASSERT_TRUE(ht_remove(ht, (void *)(i * 7), &value));
+        TEST_ASSERT_EQUAL_PTR((void *)i, value);
+    }
+    TEST_ASSERT_FALSE(ht_remove(ht, (void *)7, NULL));
+    TEST_ASSERT_EQUAL(n / 2, ht_size(ht));
+    assert_invariants(ht);
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_EQUAL(i % 2 == 0, ht_contains(ht, (void *)(i * 7)));
+    }
+
+    ht_destroy(ht);
+}
+
+// 测试全部冲突时仍然正确
+void test_ht_colliding_keys_should_be_handled(void)
+{
+    hash_table_t *ht = ht_create(bad_hash, int_cmp);
+
+    for (uintptr_t i = 1; i <= 200; i++)
+    {
+        ht_put(ht, (void *)i, (void *)(i + 1000));
+    }
+    for (uintptr_t i = 1; i <= 200; i += 3)
+    {
+        TEST_ASSERT_TRUE(ht_remove(ht, (void *)i, NULL));
+    }
+    assert_invariants(ht);
+    for (uintptr_t i = 1; i <= 200; i++)
+    {
+        if (i % 3 == 1)
+        {
+            TEST_ASSERT_FALSE(ht_contains(ht, (void *)i));
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_PTR((void *)(i + 1000), ht_get(ht, (void *)i));
+        }
+    }
+
+    ht_destroy(ht);
+}
+
+// 测试装载因子与预留空间
+void test_ht_reserve_and_load_factor_should_control_capacity(void)
+{
+    hash_table_t *ht = ht_create_with_load(int_hash, int_cmp, 0.5);
+
+    TEST_ASSERT_TRUE(ht_reserve(ht, 1000));
+    size_t capacity = ht_capacity(ht);
+    TEST_ASSERT_TRUE(capacity >= 2000);
+
+    for (uintptr_t i = 0; i < 1000; i++)
+    {
+        ht_put(ht, (void *)i, NULL);
+    }
+    TEST_ASSERT_EQUAL(capacity, ht_capacity(ht));
+    TEST_ASSERT_TRUE(ht_size(ht) <= ht_capacity(ht) / 2);
+
+    // 槽数会溢出时预留失败，表保持原样
+    TEST_ASSERT_FALSE(ht_reserve(ht, SIZE_MAX));
+    TEST_ASSERT_EQUAL(capacity, ht_capacity(ht));
+    TEST_ASSERT_TRUE(ht_contains(ht, (void *)5));
+
+    ht_clear(ht);
+    TEST_ASSERT_EQUAL(0, ht_size(ht));
+    TEST_ASSERT_FALSE(ht_contains(ht, (void *)5));
+    TEST_ASSERT_EQUAL(capacity, ht_capacity(ht));
+
+    ht_destroy(ht);
+}
+
+// 测试遍历
+void test_ht_foreach_should_visit_all_entries(void)
+{
+    hash_table_t *ht = ht_create(int_hash, int_cmp);
+
+    for (uintptr_t i = 1; i <= 100; i++)
+    {
+        ht_put(ht, (void *)i, (void *)i);
+    }
+    visit_sum = 0;
+    ht_foreach(ht, visit);
+    TEST_ASSERT_EQUAL(5050, visit_sum);
+
+    ht_destroy(ht);
+}
+
+// 测试渐进式rehash：迁移期间增删查均正确，迁移最终完成
+void test_ht_incremental_rehash_should_migrate_gradually(void)
+{
+    hash_table_t *ht = ht_create(int_hash, int_cmp);
+    ht_set_rehash_step(ht, 4);
+    size_t n = 5000;
+    bool seen_rehashing = false;
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_TRUE(ht_put(ht, (void *)i, (void *)(i + 1)));
+        seen_rehashing = seen_rehashing || ht_is_rehashing(ht);
+        // 迁移期间替换、查找和删除旧表中的键
+        if (i % 10 == 0)
+        {
+            TEST_ASSERT_TRUE(ht_put(ht, (void *)(i / 2), (void *)(i / 2 + 1)));
+            TEST_ASSERT_EQUAL_PTR((void *)(i / 2 + 1), ht_get(ht, (void *)(i / 2)));
+            TEST_ASSERT_TRUE(ht_remove(ht, (void *)(i / 2), NULL));
+            TEST_ASSERT_TRUE(ht_put(ht, (void *)(i / 2), (void *)(i / 2 + 1)));
+        }
+    }
+    TEST_ASSERT_TRUE(seen_rehashing);
+    TEST_ASSERT_EQUAL(n, ht_size(ht));
+
+    visit_sum = 0;
+    ht_foreach(ht, visit);
+    TEST_ASSERT_EQUAL(n * (n + 1) / 2 + n, visit_sum);
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)(i + 1), ht_get(ht, (void *)i));
+    }
+    for (uintptr_t i = n + 1; i <= 2 * n; i++)
+    {
+        TEST_ASSERT_FALSE(ht_contains(ht, (void *)i));
+    }
+    // 足够多的操作之后迁移完成
+    TEST_ASSERT_FALSE(ht_is_rehashing(ht));
+    assert_invariants(ht);
+
+    // 关闭渐进模式时立即完成迁移
+    while (!ht_is_rehashing(ht))
+    {
+        ht_put(ht, (void *)(++n), NULL);
+    }
+    ht_set_rehash_step(ht, 0);
+    TEST_ASSERT_FALSE(ht_is_rehashing(ht));
+    TEST_ASSERT_EQUAL(n, ht_size(ht));
+    assert_invariants(ht);
+
+    // 迁移期间清空
+    ht_set_rehash_step(ht, 1);
+    while (!ht_is_rehashing(ht))
+    {
+        ht_put(ht, (void *)(++n), NULL);
+    }
+    ht_clear(ht);
+    TEST_ASSERT_FALSE(ht_is_rehashing(ht));
+    TEST_ASSERT_EQUAL(0, ht_size(ht));
+    TEST_ASSERT_FALSE(ht_contains(ht, (void *)1));
+
+    ht_destroy(ht);
+}
+
+// 测试渐进式rehash：即使每次只迁移1个旧槽，每次扩容时上一轮迁移也已完成
+void test_ht_incremental_rehash_should_finish_before_next_growth(void)
+{
+    hash_table_t *ht = ht_create(int_hash, int_cmp);
+    ht_set_rehash_step(ht, 1);
+    size_t growths = 0;
+
+    for (uintptr_t i = 1; i <= 200000; i++)
+    {
+        // 本次插入将触发扩容
+        if (ht->size >= ht->threshold)
+        {
+            TEST_ASSERT_FALSE(ht_is_rehashing(ht));
+            growths++;
+        }
+        TEST_ASSERT_TRUE(ht_put(ht, (void *)i, (void *)i));
+        // 迁移期间夹杂删除与重新插入
+        if (i % 7 == 0)
+        {
+            TEST_ASSERT_TRUE(ht_remove(ht, (void *)(i / 2), NULL));
+            if (ht->size >= ht->threshold)
+            {
+                TEST_ASSERT_FALSE(ht_is_rehashing(ht));
+                growths++;
+            }
+            TEST_ASSERT_TRUE(ht_put(ht, (void *)(i / 2), (void *)(i / 2)));
+        }
+    }
+    TEST_ASSERT_TRUE(growths >= 10);
+    TEST_ASSERT_EQUAL(200000, ht_size(ht));
+    for (uintptr_t i = 1; i <= 200000; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)i, ht_get(ht, (void *)i));
+    }
+    assert_invariants(ht);
+
+    ht_destroy(ht);
+}
+
+// 测试空指针
+void test_ht_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(ht_put(NULL, NULL, NULL));
+    TEST_ASSERT_NULL(ht_get(NULL, NULL));
+    TEST_ASSERT_FALSE(ht_remove(NULL, NULL, NULL));
+    TEST_ASSERT_FALSE(ht_reserve(NULL, 10));
+    TEST_ASSERT_EQUAL(0, ht_size(NULL));
+    TEST_ASSERT_TRUE(ht_is_empty(NULL));
+    ht_foreach(NULL, visit);
+    ht_set_rehash_step(NULL, 1);
+    TEST_ASSERT_FALSE(ht_is_rehashing(NULL));
+    ht_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ht_create_should_create_empty_table);
+    RUN_TEST(test_ht_put_get_should_store_and_replace_values);
+    RUN_TEST(test_ht_many_operations_should_keep_invariants);
+    RUN_TEST(test_ht_colliding_keys_should_be_handled);
+    RUN_TEST(test_ht_reserve_and_load_factor_should_control_capacity);
+    RUN_TEST(test_ht_foreach_should_visit_all_entries);
+    RUN_TEST(test_ht_incremental_rehash_should_migrate_gradually);
+    RUN_TEST(test_ht_incremental_rehash_should_finish_before_next_growth);
+    RUN_TEST(test_ht_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
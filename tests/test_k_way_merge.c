@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "heap/k_way_merge.h"
+#include "Unity/src/unity.h"
+
+#define SHARD_COUNT 100
+#define SHARD_SIZE 50
+
+typedef struct item
+{
+    int key;
+    int shard;
+    int seq;
+} item_t;
+
+static item_t items[SHARD_COUNT * SHARD_SIZE];
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int item_cmp(void *a, void *b)
+{
+    int x = ((item_t *)a)->key;
+    int y = ((item_t *)b)->key;
+    return (x > y) - (x < y);
+}
+
+// 生成shards路有序数据，键取值范围小以制造大量相等元素
+static void make_items(size_t shards)
+{
+    uint32_t seed = 17;
+    for (size_t s = 0; s < shards; s++)
+    {
+        int key = 0;
+        for (size_t i = 0; i < SHARD_SIZE; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            key += (int)((seed >> 16) % 3);
+            item_t *item = &items[s * SHARD_SIZE + i];
+            item->key = key;
+            item->shard = (int)s;
+            item->seq = (int)i;
+        }
+    }
+}
+
+// 检查有序且稳定：相等元素按路序、路内顺序排列
+static void check_order(item_t *prev, item_t *cur)
+{
+    if (prev == NULL)
+    {
+        return;
+    }
+    TEST_ASSERT_TRUE(prev->key <= cur->key);
+    if (prev->key == cur->key)
+    {
+        TEST_ASSERT_TRUE(prev->shard < cur->shard || (prev->shard == cur->shard && prev->seq < cur->seq));
+    }
+}
+
+// 测试合并单链表：按路数覆盖栈上与堆上两种败者树
+void test_km_merge_sl_should_merge_stably(void)
+{
+    static const size_t ways[] = {1, 2, 7, 64, SHARD_COUNT};
+
+    for (size_t w = 0; w < 5; w++)
+    {
+        size_t k = ways[w];
+        sl_list_t *lists[SHARD_COUNT];
+        make_items(k);
+        for (size_t s = 0; s < k; s++)
+        {
+            lists[s] = sl_create();
+            for (size_t i = 0; i < SHARD_SIZE; i++)
+            {
+                sl_add_last(lists[s], sl_node_create(&items[s * SHARD_SIZE + i]));
+            }
+        }
+
+        sl_list_t *dst = sl_create();
+        TEST_ASSERT_TRUE(km_merge_sl(dst, lists, k, item_cmp));
+        TEST_ASSERT_EQUAL(k * SHARD_SIZE, sl_size(dst));
+
+        size_t count = 0;
+        item_t *prev = NULL;
+        for (sl_node_t *node = dst->head; node != NULL; node = node->next)
+        {
+            check_order(prev, (item_t *)node->data);
+            prev = (item_t *)node->data;
+            count++;
+        }
+        TEST_ASSERT_EQUAL(k * SHARD_SIZE, count);
+        TEST_ASSERT_EQUAL_PTR(prev, dst->tail->data);
+        for (size_t s = 0; s < k; s++)
+        {
+            TEST_ASSERT_TRUE(sl_is_empty(lists[s]));
+            sl_destroy(lists[s]);
+        }
+        sl_destroy(dst);
+    }
+}
+
+// 测试合并双向链表：dst为输入之一，含空链表，prev指针正确
+void test_km_merge_dl_should_relink_nodes(void)
+{
+    dl_list_t *lists[8];
+    make_items(8);
+    for (size_t s = 0; s < 8; s++)
+    {
+        lists[s] = dl_create();
+        // 第3路为空
+        for (size_t i = 0; s != 3 && i < SHARD_SIZE; i++)
+        {
+            dl_add_last(lists[s], dl_node_create(&items[s * SHARD_SIZE + i]));
+        }
+    }
+    dl_node_t *first_node = lists[0]->head;
+
+    TEST_ASSERT_TRUE(km_merge_dl(lists[0], lists, 8, item_cmp));
+    TEST_ASSERT_EQUAL(7 * SHARD_SIZE, dl_size(lists[0]));
+
+    size_t count = 0;
+    item_t *prev = NULL;
+    bool found_first = false;
+    for (dl_node_t *node = lists[0]->head; node != NULL; node = node->next)
+    {
+        check_order(prev, (item_t *)node->data);
+        TEST_ASSERT_TRUE(node->prev == NULL ? node == lists[0]->head : node->prev->next == node);
+        found_first |= node == first_node;
+        prev = (item_t *)node->data;
+        count++;
+    }
+    TEST_ASSERT_EQUAL(7 * SHARD_SIZE, count);
+    TEST_ASSERT_TRUE(found_first);
+    TEST_ASSERT_NULL(lists[0]->tail->next);
+    for (size_t s = 1; s < 8; s++)
+    {
+        TEST_ASSERT_TRUE(dl_is_empty(lists[s]));
+        dl_destroy(lists[s]);
+    }
+    dl_destroy(lists[0]);
+}
+
+// 测试合并到非空dst：新节点接在原有节点之后
+void test_km_merge_sl_should_append_to_dst(void)
+{
+    item_t head_item = {-1, -1, 0};
+    sl_list_t *dst = sl_create();
+    sl_list_t *lists[2];
+
+    sl_add_last(dst, sl_node_create(&head_item));
+    make_items(2);
+    for (size_t s = 0; s < 2; s++)
+    {
+        lists[s] = sl_create();
+        for (size_t i = 0; i < SHARD_SIZE; i++)
+        {
+            sl_add_last(lists[s], sl_node_create(&items[s * SHARD_SIZE + i]));
+        }
+    }
+    TEST_ASSERT_TRUE(km_merge_sl(dst, lists, 2, item_cmp));
+    TEST_ASSERT_EQUAL(2 * SHARD_SIZE + 1, sl_size(dst));
+    TEST_ASSERT_EQUAL_PTR(&head_item, dst->head->data);
+
+    sl_destroy(lists[0]);
+    sl_destroy(lists[1]);
+    sl_destroy(dst);
+}
+
+// 测试合并数组
+void test_km_merge_arrays_should_merge_stably(void)
+{
+    static const size_t ways[] = {1, 3, SHARD_COUNT};
+    void *arrays_data[SHARD_COUNT][SHARD_SIZE];
+    void **arrays[SHARD_COUNT];
+    size_t lens[SHARD_COUNT];
+    void **out = (void **)malloc(SHARD_COUNT * SHARD_SIZE * sizeof(void *));
+
+    for (size_t w = 0; w < 3; w++)
+    {
+        size_t k = ways[w];
+        size_t total = 0;
+        make_items(k);
+        for (size_t s = 0; s < k; s++)
+        {
+            // 各路长度不同，部分为空
+            lens[s] = (s * 13) % (SHARD_SIZE + 1);
+            total += lens[s];
+            arrays[s] = arrays_data[s];
+            for (size_t i = 0; i < lens[s]; i++)
+            {
+                arrays_data[s][i] = &items[s * SHARD_SIZE + i];
+            }
+        }
+
+        TEST_ASSERT_EQUAL(total, km_merge_arrays(out, arrays, lens, k, item_cmp));
+        for (size_t i = 1; i < total; i++)
+        {
+            check_order((item_t *)out[i - 1], (item_t *)out[i]);
+        }
+    }
+    free(out);
+}
+
+// 测试参数错误
+void test_km_edge_cases_should_handle_null_inputs(void)
+{
+    sl_list_t *sl = sl_create();
+    sl_list_t *missing[1] = {NULL};
+
+    TEST_ASSERT_FALSE(km_merge_sl(NULL, NULL, 0, item_cmp));
+    TEST_ASSERT_FALSE(km_merge_sl(sl, NULL, 1, item_cmp));
+    TEST_ASSERT_FALSE(km_merge_sl(sl, missing, 1, item_cmp));
+    TEST_ASSERT_FALSE(km_merge_sl(sl, &sl, 1, NULL));
+    TEST_ASSERT_TRUE(km_merge_sl(sl, NULL, 0, item_cmp));
+    TEST_ASSERT_FALSE(km_merge_dl(NULL, NULL, 0, item_cmp));
+    TEST_ASSERT_EQUAL(0, km_merge_arrays(NULL, NULL, NULL, 0, item_cmp));
+    sl_destroy(sl);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_km_merge_sl_should_merge_stably);
+    RUN_TEST(test_km_merge_dl_should_relink_nodes);
+    RUN_TEST(test_km_merge_sl_should_append_to_dst);
+    RUN_TEST(test_km_merge_arrays_should_merge_stably);
+    RUN_TEST(test_km_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "cache/lru_cache.h"
+#include "Unity/src/unity.h"
+
+// 以指针值作为整数键
+size_t int_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+int int_cmp(void *a, void *b)
+{
+    return (uintptr_t)a == (uintptr_t)b ? 0 : 1;
+}
+
+// 字符串键
+size_t str_hash(void *key)
+{
+    size_t hash = 5381;
+    for (const char *p = (const char *)key; *p != '\0'; p++)
+    {
+        hash = hash * 33 + (unsigned char)*p;
+    }
+    return hash;
+}
+
+int str_cmp(void *a, void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+// 记录回调
+static uintptr_t evicted_keys[64];
+static lru_reason_t evicted_reasons[64];
+static size_t evicted_count;
+
+static void record_evict(void *key, void *value, lru_reason_t reason, void *arg)
+{
+    (void)value;
+    (void)arg;
+    evicted_keys[evicted_count] = (uintptr_t)key;
+    evicted_reasons[evicted_count] = reason;
+    evicted_count++;
+}
+
+static void free_evict(void *key, void *value, lru_reason_t reason, void *arg)
+{
+    (void)reason;
+    free(key);
+    free(value);
+    (*(size_t *)arg)++;
+}
+
+static uintptr_t order[16];
+static size_t order_count;
+
+static void collect(void *key, void *value)
+{
+    (void)value;
+    order[order_count++] = (uintptr_t)key;
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+    evicted_count = 0;
+    order_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建
+void test_lru_create_should_create_empty_cache(void)
+{
+    lru_cache_t *cache = lru_create(3, int_hash, int_cmp, NULL, NULL);
+
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_EQUAL(0, lru_size(cache));
+    TEST_ASSERT_EQUAL(0, lru_usage(cache));
+    TEST_ASSERT_EQUAL(3, lru_capacity(cache));
+    TEST_ASSERT_NULL(lru_get(cache, (void *)1));
+    TEST_ASSERT_NULL(lru_create(0, int_hash, int_cmp, NULL, NULL));
+
+    lru_destroy(cache);
+}
+
+// 测试按个数淘汰最久未使用的条目
+void test_lru_should_evict_least_recently_used(void)
+{
+    lru_cache_t *cache = lru_create(3, int_hash, int_cmp, record_evict, NULL);
+
+    lru_put(cache, (void *)1, (void *)10);
+    lru_put(cache, (void *)2, (void *)20);
+    lru_put(cache, (void *)3, (void *)30);
+    // 访问1后，2成为最久未使用
+    TEST_ASSERT_EQUAL_PTR((void *)10, lru_get(cache, (void *)1));
+    lru_put(cache, (void *)4, (void *)40);
+
+    TEST_ASSERT_EQUAL(3, lru_size(cache));
+    TEST_ASSERT_NULL(lru_get(cache, (void *)2));
+    TEST_ASSERT_EQUAL(1, evicted_count);
+    TEST_ASSERT_EQUAL(2, evicted_keys[0]);
+    TEST_ASSERT_EQUAL(LRU_EVICTED, evicted_reasons[0]);
+
+    // peek不改变顺序：3仍是最久未使用
+    TEST_ASSERT_TRUE(lru_peek(cache, (void *)3, NULL));
+    lru_put(cache, (void *)5, (void *)50);
+    TEST_ASSERT_EQUAL(3, evicted_keys[1]);
+
+    lru_foreach(cache, collect);
+    TEST_ASSERT_EQUAL(3, order_count);
+    TEST_ASSERT_EQUAL(5, order[0]);
+    TEST_ASSERT_EQUAL(4, order[1]);
+    TEST_ASSERT_EQUAL(1, order[2]);
+
+    TEST_ASSERT_EQUAL(1, cache->hits);
+    TEST_ASSERT_EQUAL(1, cache->misses);
+    TEST_ASSERT_EQUAL(2, cache->evictions);
+
+    lru_destroy(cache);
+    TEST_ASSERT_EQUAL(5, evicted_count);
+    TEST_ASSERT_EQUAL(LRU_CLEARED, evicted_reasons[4]);
+}
+
+// 测试替换与删除
+void test_lru_replace_and_remove(void)
+{
+    lru_cache_t *cache = lru_create(2, int_hash, int_cmp, record_evict, NULL);
+
+    lru_put(cache, (void *)1, (void *)10);
+    lru_put(cache, (void *)2, (void *)20);
+    lru_put(cache, (void *)1, (void *)11);
+    TEST_ASSERT_EQUAL(1, evicted_count);
+    TEST_ASSERT_EQUAL(LRU_REPLACED, evicted_reasons[0]);
+    TEST_ASSERT_EQUAL(2, lru_size(cache));
+    TEST_ASSERT_EQUAL_PTR((void *)11, lru_get(cache, (void *)1));
+
+    // 替换也会刷新使用顺序，下次淘汰2
+    lru_put(cache, (void *)3, (void *)30);
+    TEST_ASSERT_FALSE(lru_contains(cache, (void *)2));
+
+    void *value = NULL;
+    TEST_ASSERT_TRUE(lru_remove(cache, (void *)1, &value));
+    TEST_ASSERT_EQUAL_PTR((void *)11, value);
+    TEST_ASSERT_FALSE(lru_remove(cache, (void *)1, NULL));
+    TEST_ASSERT_EQUAL(1, lru_size(cache));
+    // remove不调用回调
+    TEST_ASSERT_EQUAL(2, evicted_count);
+
+    lru_destroy(cache);
+}
+
+// 测试按开销（字节数）限制容量
+void test_lru_charge_based_capacity(void)
+{
+    lru_cache_t *cache = lru_create(100, int_hash, int_cmp, record_evict, NULL);
+
+    TEST_ASSERT_TRUE(lru_put_charged(cache, (void *)1, NULL, 40));
+    TEST_ASSERT_TRUE(lru_put_charged(cache, (void *)2, NULL, 40));
+    TEST_ASSERT_EQUAL(80, lru_usage(cache));
+    TEST_ASSERT_FALSE(lru_put_charged(cache, (void *)3, NULL, 101));
+    TEST_ASSERT_EQUAL(2, lru_size(cache));
+
+    // 插入61需要淘汰两个40
+    TEST_ASSERT_TRUE(lru_put_charged(cache, (void *)3, NULL, 61));
+    TEST_ASSERT_EQUAL(1, lru_size(cache));
+    TEST_ASSERT_EQUAL(61, lru_usage(cache));
+    TEST_ASSERT_EQUAL(2, evicted_count);
+
+    // 替换改变开销
+    TEST_ASSERT_TRUE(lru_put_charged(cache, (void *)3, NULL, 10));
+    TEST_ASSERT_EQUAL(10, lru_usage(cache));
+
+    // 缩小容量立即淘汰
+    lru_put_charged(cache, (void *)4, NULL, 50);
+    lru_set_capacity(cache, 50);
+    TEST_ASSERT_EQUAL(1, lru_size(cache));
+    TEST_ASSERT_TRUE(lru_contains(cache, (void *)4));
+
+    lru_destroy(cache);
+}
+
+// 测试回调释放堆上的键值，以及新旧键对象不同的替换
+void test_lru_callback_should_release_owned_memory(void)
+{
+    size_t released = 0;
+    lru_cache_t *cache = lru_create(8, str_hash, str_cmp, free_evict, &released);
+    char key[16];
+
+    for (int i = 0; i < 20; i++)
+    {
+        snprintf(key, sizeof(key), "k%d", i % 12);
+        lru_put(cache, strdup(key), malloc(8));
+    }
+    TEST_ASSERT_EQUAL(8, lru_size(cache));
+    TEST_ASSERT_EQUAL(12, released);
+    TEST_ASSERT_TRUE(lru_contains(cache, "k7"));
+
+    lru_clear(cache);
+    TEST_ASSERT_EQUAL(20, released);
+    TEST_ASSERT_EQUAL(0, lru_size(cache));
+    TEST_ASSERT_EQUAL(0, lru_usage(cache));
+
+    lru_destroy(cache);
+}
+
+// 测试大量操作与淘汰
+void test_lru_many_operations_should_stay_bounded(void)
+{
+    lru_cache_t *cache = lru_create(1000, int_hash, int_cmp, NULL, NULL);
+
+    for (uintptr_t i = 1; i <= 100000; i++)
+    {
+        lru_put(cache, (void *)i, (void *)i);
+        if (i % 3 == 0)
+        {
+            lru_get(cache, (void *)(i - 500));
+        }
+    }
+    TEST_ASSERT_EQUAL(1000, lru_size(cache));
+    TEST_ASSERT_EQUAL(1000, ht_size(cache->index));
+    for (uintptr_t i = 100000 - 499; i <= 100000; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR((void *)i, lru_get(cache, (void *)i));
+    }
+
+    lru_destroy(cache);
+}
+
+// 测试空指针
+void test_lru_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_NULL(lru_create(1, NULL, int_cmp, NULL, NULL));
+    TEST_ASSERT_FALSE(lru_put(NULL, NULL, NULL));
+    TEST_ASSERT_NULL(lru_get(NULL, NULL));
+    TEST_ASSERT_FALSE(lru_peek(NULL, NULL, NULL));
+    TEST_ASSERT_FALSE(lru_remove(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, lru_size(NULL));
+    TEST_ASSERT_EQUAL(0, lru_usage(NULL));
+    lru_set_capacity(NULL, 1);
+    lru_foreach(NULL, collect);
+    lru_clear(NULL);
+    lru_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_lru_create_should_create_empty_cache);
+    RUN_TEST(test_lru_should_evict_least_recently_used);
+    RUN_TEST(test_lru_replace_and_remove);
+    RUN_TEST(test_lru_charge_based_capacity);
+    RUN_TEST(test_lru_callback_should_release_owned_memory);
+    RUN_TEST(test_lru_many_operations_should_stay_bounded);
+    RUN_TEST(test_lru_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "queue/multi_queue.h"
+#include "Unity/src/unity.h"
+
+#define THREAD_COUNT 4
+#define ITEMS_PER_THREAD 20000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建空队列
+void test_mq_create_should_create_empty_queue(void)
+{
+    multi_queue_t *mq = mq_create(8);
+
+    TEST_ASSERT_NOT_NULL(mq);
+    TEST_ASSERT_EQUAL(8, mq_shard_count(mq));
+    TEST_ASSERT_EQUAL(0, mq_size(mq));
+    TEST_ASSERT_TRUE(mq_is_empty(mq));
+    TEST_ASSERT_FALSE(mq_pop(mq, NULL, NULL));
+
+    mq_destroy(mq);
+}
+
+// 测试默认分片数
+void test_mq_create_should_pick_default_shard_count(void)
+{
+    multi_queue_t *mq = mq_create(0);
+
+    TEST_ASSERT_NOT_NULL(mq);
+    TEST_ASSERT_TRUE(mq_shard_count(mq) >= MQ_SHARDS_PER_CPU);
+
+    mq_destroy(mq);
+}
+
+// 测试单分片时严格有序
+void test_mq_single_shard_should_pop_in_strict_order(void)
+{
+    multi_queue_t *mq = mq_create(1);
+    uint64_t keys[] = {50, 10, 40, 20, 30};
+    int values[5];
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_TRUE(mq_push(mq, keys[i], &values[i]));
+    }
+
+    uint64_t expected[] = {10, 20, 30, 40, 50};
+    for (size_t i = 0; i < 5; i++)
+    {
+        uint64_t priority = 0;
+        void *data = NULL;
+        TEST_ASSERT_TRUE(mq_pop(mq, &priority, &data));
+        TEST_ASSERT_EQUAL_UINT64(expected[i], priority);
+    }
+    TEST_ASSERT_FALSE(mq_pop(mq, NULL, NULL));
+
+    mq_destroy(mq);
+}
+
+// 测试多分片时所有元素恰好弹出一次，且顺序大致递增
+void test_mq_multi_shard_should_pop_every_item_once(void)
+{
+    multi_queue_t *mq = mq_create(8);
+    size_t n = 4096;
+    unsigned char *seen = calloc(n, 1);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_TRUE(mq_push(mq, (uint64_t)((i * 2654435761u) % n), NULL));
+    }
+    TEST_ASSERT_EQUAL(n, mq_size(mq));
+
+    uint64_t first_half_sum = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t priority = 0;
+        TEST_ASSERT_TRUE(mq_pop(mq, &priority, NULL));
+        TEST_ASSERT_TRUE(priority < n);
+        TEST_ASSERT_EQUAL(0, seen[priority]);
+        seen[priority] = 1;
+        if (i < n / 2)
+        {
+            first_half_sum += priority;
+        }
+    }
+    TEST_ASSERT_TRUE(mq_is_empty(mq));
+    // 松弛顺序：前一半弹出的元素平均值应明显小于整体平均值
+    TEST_ASSERT_TRUE(first_half_sum / (n / 2) < n / 2);
+
+    free(seen);
+    mq_destroy(mq);
+}
+
+typedef struct
+{
+    multi_queue_t *mq;
+    uint64_t pushed_sum;
+    uint64_t popped_sum;
+    size_t popped;
+} worker_t;
+
+static void *worker_run(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    for (uint64_t i = 1; i <= ITEMS_PER_THREAD; i++)
+    {
+        mq_push(w->mq, i, NULL);
+        w->pushed_sum += i;
+        uint64_t priority = 0;
+        if (mq_pop(w->mq, &priority, NULL))
+        {
+            w->popped_sum += priority;
+            w->popped++;
+        }
+    }
+    return NULL;
+}
+
+// 测试多线程并发插入弹出不丢失元素
+void test_mq_concurrent_push_pop_should_not_lose_items(void)
+{
+    multi_queue_t *mq = mq_create(THREAD_COUNT * 2);
+    pthread_t threads[THREAD_COUNT];
+    worker_t workers[THREAD_COUNT] = {{0}};
+
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        workers[i].mq = mq;
+        pthread_create(&threads[i], NULL, worker_run, &workers[i]);
+    }
+
+    uint64_t pushed = 0;
+    uint64_t popped = 0;
+    size_t popped_count = 0;
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+        pushed += workers[i].pushed_sum;
+        popped += workers[i].popped_sum;
+        popped_count += workers[i].popped;
+    }
+
+    uint64_t priority = 0;
+    while (mq_pop(mq, &priority, NULL))
+    {
+        popped += priority;
+        popped_count++;
+    }
+
+    TEST_ASSERT_EQUAL(THREAD_COUNT * ITEMS_PER_THREAD, popped_count);
+    TEST_ASSERT_EQUAL_UINT64(pushed, popped);
+
+    mq_destroy(mq);
+}
+
+// 测试优先级为UINT64_MAX的元素也能弹出
+void test_mq_should_pop_max_priority(void)
+{
+    multi_queue_t *mq = mq_create(4);
+    int values[3];
+
+    TEST_ASSERT_TRUE(mq_push(mq, UINT64_MAX, &values[0]));
+    TEST_ASSERT_EQUAL(1, mq_size(mq));
+    uint64_t priority = 0;
+    void *data = NULL;
+    TEST_ASSERT_TRUE(mq_pop(mq, &priority, &data));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, priority);
+    TEST_ASSERT_EQUAL_PTR(&values[0], data);
+    TEST_ASSERT_TRUE(mq_is_empty(mq));
+
+    TEST_ASSERT_TRUE(mq_push(mq, UINT64_MAX, &values[1]));
+    TEST_ASSERT_TRUE(mq_push(mq, 7, &values[2]));
+    TEST_ASSERT_TRUE(mq_pop(mq, NULL, NULL));
+    TEST_ASSERT_TRUE(mq_pop(mq, NULL, NULL));
+    TEST_ASSERT_FALSE(mq_pop(mq, NULL, NULL));
+    TEST_ASSERT_TRUE(mq_is_empty(mq));
+
+    mq_destroy(mq);
+}
+
+// 测试空指针
+void test_mq_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(mq_push(NULL, 1, NULL));
+    TEST_ASSERT_FALSE(mq_pop(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, mq_size(NULL));
+    TEST_ASSERT_TRUE(mq_is_empty(NULL));
+    mq_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mq_create_should_create_empty_queue);
+    RUN_TEST(test_mq_create_should_pick_default_shard_count);
+    RUN_TEST(test_mq_single_shard_should_pop_in_strict_order);
+    RUN_TEST(test_mq_multi_shard_should_pop_every_item_once);
+    RUN_TEST(test_mq_concurrent_push_pop_should_not_lose_items);
+    RUN_TEST(test_mq_should_pop_max_priority);
+    RUN_TEST(test_mq_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
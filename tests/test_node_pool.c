@@ -0,0 +1,155 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "pool/node_pool.h"
+#include "Unity/src/unity.h"
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建参数
+void test_np_create_should_round_node_size(void)
+{
+    node_pool_t *pool = np_create(3, 0);
+
+    TEST_ASSERT_NOT_NULL(pool);
+    TEST_ASSERT_EQUAL(sizeof(void *), np_node_size(pool));
+    TEST_ASSERT_EQUAL(NP_DEFAULT_CHUNK_NODES, pool->chunk_nodes);
+    TEST_ASSERT_EQUAL(0, np_in_use(pool));
+    TEST_ASSERT_EQUAL(0, np_bytes(pool));
+    np_destroy(pool);
+
+    pool = np_create(24, 4);
+    TEST_ASSERT_EQUAL(24, np_node_size(pool));
+    np_destroy(pool);
+
+    TEST_ASSERT_NULL(np_create(0, 16));
+}
+
+// 测试分配的节点互不重叠、对齐，并可写满
+void test_np_alloc_should_return_distinct_nodes(void)
+{
+    node_pool_t *pool = np_create(32, 8);
+    uint8_t *nodes[100];
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        nodes[i] = (uint8_t *)np_alloc(pool);
+        TEST_ASSERT_NOT_NULL(nodes[i]);
+        TEST_ASSERT_EQUAL(0, (uintptr_t)nodes[i] % sizeof(void *));
+        memset(nodes[i], (int)i, 32);
+    }
+    TEST_ASSERT_EQUAL(100, np_in_use(pool));
+    // 8个节点一块，需要13块
+    TEST_ASSERT_EQUAL(13, pool->chunk_count);
+    for (size_t i = 0; i < 100; i++)
+    {
+        for (size_t b = 0; b < 32; b++)
+        {
+            TEST_ASSERT_EQUAL((uint8_t)i, nodes[i][b]);
+        }
+    }
+    np_destroy(pool);
+}
+
+// 测试释放的节点被优先复用，不再申请新块
+void test_np_free_should_recycle_nodes(void)
+{
+    node_pool_t *pool = np_create(16, 4);
+    void *nodes[8];
+
+    for (size_t i = 0; i < 8; i++)
+    {
+        nodes[i] = np_alloc(pool);
+    }
+    size_t bytes = np_bytes(pool);
+    for (size_t i = 0; i < 8; i++)
+    {
+        np_free(pool, nodes[i]);
+    }
+    TEST_ASSERT_EQUAL(0, np_in_use(pool));
+
+    for (size_t round = 0; round < 10; round++)
+    {
+        for (size_t i = 0; i < 8; i++)
+        {
+            nodes[i] = np_alloc(pool);
+        }
+        for (size_t i = 0; i < 8; i++)
+        {
+            np_free(pool, nodes[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(bytes, np_bytes(pool));
+
+    np_clear(pool);
+    TEST_ASSERT_EQUAL(0, np_bytes(pool));
+    TEST_ASSERT_NOT_NULL(np_alloc(pool));
+    np_destroy(pool);
+}
+
+// 测试合并：src的节点改由dst释放与复用
+void test_np_merge_should_transfer_ownership(void)
+{
+    node_pool_t *dst = np_create(16, 4);
+    node_pool_t *src = np_create(16, 4);
+    node_pool_t *other = np_create(32, 4);
+    void *a = np_alloc(dst);
+    void *b = np_alloc(src);
+    void *c = np_alloc(src);
+
+    np_free(src, c);
+    TEST_ASSERT_FALSE(np_merge(dst, other));
+    TEST_ASSERT_FALSE(np_merge(dst, dst));
+    TEST_ASSERT_TRUE(np_merge(dst, src));
+    TEST_ASSERT_EQUAL(2, np_in_use(dst));
+    TEST_ASSERT_EQUAL(0, np_in_use(src));
+    TEST_ASSERT_EQUAL(0, np_bytes(src));
+
+    // src释放过的节点成为dst的空闲节点
+    TEST_ASSERT_EQUAL_PTR(c, np_alloc(dst));
+    np_free(dst, b);
+    np_free(dst, a);
+    TEST_ASSERT_EQUAL(1, np_in_use(dst));
+
+    // 合并后的src仍可独立使用
+    TEST_ASSERT_NOT_NULL(np_alloc(src));
+    TEST_ASSERT_EQUAL(1, np_in_use(src));
+
+    np_destroy(other);
+    np_destroy(src);
+    np_destroy(dst);
+}
+
+// 测试空指针
+void test_np_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_NULL(np_alloc(NULL));
+    TEST_ASSERT_EQUAL(0, np_in_use(NULL));
+    TEST_ASSERT_EQUAL(0, np_bytes(NULL));
+    TEST_ASSERT_EQUAL(0, np_node_size(NULL));
+    TEST_ASSERT_FALSE(np_merge(NULL, NULL));
+    np_free(NULL, NULL);
+    np_clear(NULL);
+    np_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_np_create_should_round_node_size);
+    RUN_TEST(test_np_alloc_should_return_distinct_nodes);
+    RUN_TEST(test_np_free_should_recycle_nodes);
+    RUN_TEST(test_np_merge_should_transfer_ownership);
+    RUN_TEST(test_np_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,227 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "tree/order_stat_tree.h"
+#include "Unity/src/unity.h"
+
+#define KEY_RANGE 500
+#define WINDOW 1000
+#define STEP_COUNT 20000
+
+#define K(x) ((void *)(uintptr_t)(x))
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// 检查子树大小、有序性与重量平衡，返回子树大小
+static size_t check_node(ost_node_t *node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    if (node->left != NULL)
+    {
+        TEST_ASSERT_TRUE(key_cmp(node->left->key, node->key) <= 0);
+    }
+    if (node->right != NULL)
+    {
+        TEST_ASSERT_TRUE(key_cmp(node->right->key, node->key) >= 0);
+    }
+    size_t left = check_node(node->left);
+    size_t right = check_node(node->right);
+    TEST_ASSERT_EQUAL(left + right + 1, node->size);
+    if (left + right > 1)
+    {
+        TEST_ASSERT_TRUE(right + 1 <= 3 * (left + 1));
+        TEST_ASSERT_TRUE(left + 1 <= 3 * (right + 1));
+    }
+    return node->size;
+}
+
+// 测试创建
+void test_ost_create_should_start_empty(void)
+{
+    order_stat_tree_t *ost = ost_create(key_cmp);
+
+    TEST_ASSERT_NOT_NULL(ost);
+    TEST_ASSERT_TRUE(ost_is_empty(ost));
+    TEST_ASSERT_NULL(ost_select(ost, 0));
+    TEST_ASSERT_NULL(ost_quantile(ost, 0.5));
+    TEST_ASSERT_EQUAL(0, ost_rank(ost, K(5)));
+    TEST_ASSERT_NULL(ost_create(NULL));
+    ost_destroy(ost);
+}
+
+// 测试重复键的计数、名次与删除
+void test_ost_duplicates_should_be_counted(void)
+{
+    order_stat_tree_t *ost = ost_create(key_cmp);
+    uintptr_t keys[] = {5, 1, 5, 3, 5, 9};
+
+    for (size_t i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_TRUE(ost_insert(ost, K(keys[i])));
+    }
+    TEST_ASSERT_EQUAL(6, ost_size(ost));
+    TEST_ASSERT_EQUAL(3, ost_count(ost, K(5)));
+    TEST_ASSERT_EQUAL(0, ost_count(ost, K(4)));
+    TEST_ASSERT_EQUAL(2, ost_rank(ost, K(5)));
+    TEST_ASSERT_EQUAL(2, ost_rank(ost, K(4)));
+    TEST_ASSERT_EQUAL(6, ost_rank(ost, K(10)));
+
+    // 升序：1 3 5 5 5 9
+    TEST_ASSERT_EQUAL_PTR(K(1), ost_select(ost, 0));
+    TEST_ASSERT_EQUAL_PTR(K(5), ost_select(ost, 4));
+    TEST_ASSERT_EQUAL_PTR(K(9), ost_select(ost, 5));
+    TEST_ASSERT_NULL(ost_select(ost, 6));
+
+    TEST_ASSERT_TRUE(ost_remove(ost, K(5)));
+    TEST_ASSERT_EQUAL(2, ost_count(ost, K(5)));
+    TEST_ASSERT_FALSE(ost_remove(ost, K(4)));
+    TEST_ASSERT_TRUE(ost_contains(ost, K(3)));
+    TEST_ASSERT_FALSE(ost_contains(ost, K(4)));
+    TEST_ASSERT_EQUAL(5, ost_size(ost));
+    check_node(ost->root);
+    ost_destroy(ost);
+}
+
+// 测试分位数（最近名次法）
+void test_ost_quantile_should_use_nearest_rank(void)
+{
+    order_stat_tree_t *ost = ost_create(key_cmp);
+
+    for (uintptr_t key = 100; key >= 1; key--)
+    {
+        ost_insert(ost, K(key));
+    }
+    TEST_ASSERT_EQUAL_PTR(K(1), ost_quantile(ost, 0.0));
+    TEST_ASSERT_EQUAL_PTR(K(50), ost_quantile(ost, 0.5));
+    TEST_ASSERT_EQUAL_PTR(K(99), ost_quantile(ost, 0.99));
+    TEST_ASSERT_EQUAL_PTR(K(100), ost_quantile(ost, 0.995));
+    TEST_ASSERT_EQUAL_PTR(K(100), ost_quantile(ost, 1.0));
+    TEST_ASSERT_EQUAL_PTR(K(1), ost_quantile(ost, -1.0));
+    check_node(ost->root);
+    ost_destroy(ost);
+}
+
+// 测试滑动窗口：每步加入新样本、移除最旧样本，名次与选择始终与排序后的窗口一致
+void test_ost_sliding_window_should_match_sorted_reference(void)
+{
+    order_stat_tree_t *ost = ost_create(key_cmp);
+    uintptr_t *window = (uintptr_t *)malloc(WINDOW * sizeof(uintptr_t));
+    size_t *counts = (size_t *)calloc(KEY_RANGE, sizeof(size_t));
+    uint64_t seed = 99;
+
+    for (size_t step = 0; step < STEP_COUNT; step++)
+    {
+        uintptr_t key = next_rand(&seed) % KEY_RANGE;
+        if (step >= WINDOW)
+        {
+            uintptr_t old = window[step % WINDOW];
+            TEST_ASSERT_TRUE(ost_remove(ost, K(old)));
+            counts[old]--;
+        }
+        window[step % WINDOW] = key;
+        TEST_ASSERT_TRUE(ost_insert(ost, K(key)));
+        counts[key]++;
+
+        if (step % 997 == 0)
+        {
+            check_node(ost->root);
+            // 按计数数组逐个名次核对select与rank
+            size_t index = 0;
+            for (uintptr_t k = 0; k < KEY_RANGE; k++)
+            {
+                TEST_ASSERT_EQUAL(index, ost_rank(ost, K(k)));
+                TEST_ASSERT_EQUAL(counts[k], ost_count(ost, K(k)));
+                for (size_t c = 0; c < counts[k]; c++)
+                {
+                    TEST_ASSERT_EQUAL_PTR(K(k), ost_select(ost, index++));
+                }
+            }
+            TEST_ASSERT_EQUAL(ost_size(ost), index);
+        }
+    }
+    TEST_ASSERT_EQUAL(WINDOW, ost_size(ost));
+
+    ost_clear(ost);
+    TEST_ASSERT_TRUE(ost_is_empty(ost));
+    TEST_ASSERT_EQUAL(0, np_in_use(ost->pool));
+    free(window);
+    free(counts);
+    ost_destroy(ost);
+}
+
+// 测试有序插入后仍保持平衡
+void test_ost_sorted_inserts_should_stay_balanced(void)
+{
+    order_stat_tree_t *ost = ost_create(key_cmp);
+
+    for (uintptr_t key = 0; key < 10000; key++)
+    {
+        ost_insert(ost, K(key));
+    }
+    check_node(ost->root);
+    for (uintptr_t key = 0; key < 10000; key += 2)
+    {
+        TEST_ASSERT_TRUE(ost_remove(ost, K(key)));
+    }
+    check_node(ost->root);
+    TEST_ASSERT_EQUAL(5000, ost_size(ost));
+    TEST_ASSERT_EQUAL_PTR(K(2001), ost_select(ost, 1000));
+    TEST_ASSERT_EQUAL(1000, ost_rank(ost, K(2001)));
+    ost_destroy(ost);
+}
+
+// 测试空指针
+void test_ost_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(ost_insert(NULL, K(1)));
+    TEST_ASSERT_FALSE(ost_remove(NULL, K(1)));
+    TEST_ASSERT_FALSE(ost_contains(NULL, K(1)));
+    TEST_ASSERT_EQUAL(0, ost_count(NULL, K(1)));
+    TEST_ASSERT_NULL(ost_select(NULL, 0));
+    TEST_ASSERT_EQUAL(0, ost_rank(NULL, K(1)));
+    TEST_ASSERT_NULL(ost_quantile(NULL, 0.5));
+    TEST_ASSERT_EQUAL(0, ost_size(NULL));
+    TEST_ASSERT_TRUE(ost_is_empty(NULL));
+    ost_clear(NULL);
+    ost_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ost_create_should_start_empty);
+    RUN_TEST(test_ost_duplicates_should_be_counted);
+    RUN_TEST(test_ost_quantile_should_use_nearest_rank);
+    RUN_TEST(test_ost_sliding_window_should_match_sorted_reference);
+    RUN_TEST(test_ost_sorted_inserts_should_stay_balanced);
+    RUN_TEST(test_ost_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
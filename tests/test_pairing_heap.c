@@ -0,0 +1,244 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "heap/pairing_heap.h"
+#include "Unity/src/unity.h"
+
+#define ITEM_COUNT 5000
+
+typedef struct item
+{
+    int key;
+    ph_node_t *node;
+} item_t;
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int int_cmp(void *a, void *b)
+{
+    intptr_t x = (intptr_t)a;
+    intptr_t y = (intptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static int item_cmp(void *a, void *b)
+{
+    int x = ((item_t *)a)->key;
+    int y = ((item_t *)b)->key;
+    return (x > y) - (x < y);
+}
+
+static uint32_t next_rand(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+// 测试创建
+void test_ph_create_should_start_empty(void)
+{
+    pairing_heap_t *ph = ph_create(int_cmp);
+
+    TEST_ASSERT_NOT_NULL(ph);
+    TEST_ASSERT_TRUE(ph_is_empty(ph));
+    TEST_ASSERT_EQUAL(0, ph_size(ph));
+    TEST_ASSERT_NULL(ph_peek(ph));
+    TEST_ASSERT_NULL(ph_pop(ph));
+    TEST_ASSERT_NULL(ph_create(NULL));
+    ph_destroy(ph);
+}
+
+// 测试随机插入后按顺序弹出
+void test_ph_pop_should_return_sorted_order(void)
+{
+    pairing_heap_t *ph = ph_create(int_cmp);
+    uint32_t seed = 7;
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        TEST_ASSERT_NOT_NULL(ph_push(ph, (void *)(intptr_t)(next_rand(&seed) % 1000)));
+    }
+    TEST_ASSERT_EQUAL(ITEM_COUNT, ph_size(ph));
+
+    intptr_t last = -1;
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR(ph_peek(ph), ph_peek(ph));
+        intptr_t value = (intptr_t)ph_pop(ph);
+        TEST_ASSERT_TRUE(value >= last);
+        last = value;
+    }
+    TEST_ASSERT_TRUE(ph_is_empty(ph));
+    ph_destroy(ph);
+}
+
+// 测试通过句柄提高优先级
+void test_ph_decrease_key_should_reorder(void)
+{
+    pairing_heap_t *ph = ph_create(item_cmp);
+    item_t *items = (item_t *)malloc(ITEM_COUNT * sizeof(item_t));
+    uint32_t seed = 11;
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        items[i].key = (int)(next_rand(&seed) % 100000) + 100000;
+        items[i].node = ph_push(ph, &items[i]);
+    }
+    // 先弹出一部分，使堆内形成多层子树
+    for (int i = 0; i < 10; i++)
+    {
+        item_t *top = (item_t *)ph_pop(ph);
+        top->node = NULL;
+    }
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < ITEM_COUNT; i += 3)
+        {
+            if (items[i].node != NULL)
+            {
+                items[i].key -= (int)(next_rand(&seed) % 50000);
+                TEST_ASSERT_TRUE(ph_decrease_key(ph, items[i].node));
+            }
+        }
+    }
+
+    int last = -1000000;
+    size_t popped = 0;
+    while (!ph_is_empty(ph))
+    {
+        item_t *top = (item_t *)ph_pop(ph);
+        TEST_ASSERT_TRUE(top->key >= last);
+        last = top->key;
+        popped++;
+    }
+    TEST_ASSERT_EQUAL(ITEM_COUNT - 10, popped);
+
+    free(items);
+    ph_destroy(ph);
+}
+
+// 测试删除任意节点
+void test_ph_remove_should_delete_any_node(void)
+{
+    pairing_heap_t *ph = ph_create(item_cmp);
+    item_t items[100];
+
+    for (int i = 0; i < 100; i++)
+    {
+        items[i].key = (i * 37) % 100;
+        items[i].node = ph_push(ph, &items[i]);
+    }
+    ph_pop(ph);
+    items[0].node = NULL;   // key为0的元素已弹出
+    for (int i = 1; i < 100; i += 2)
+    {
+        TEST_ASSERT_EQUAL_PTR(&items[i], ph_remove(ph, items[i].node));
+    }
+    TEST_ASSERT_EQUAL(49, ph_size(ph));
+
+    int last = -1;
+    while (!ph_is_empty(ph))
+    {
+        item_t *top = (item_t *)ph_pop(ph);
+        TEST_ASSERT_TRUE(top->key > last);
+        TEST_ASSERT_EQUAL(0, (int)(top - items) % 2);
+        last = top->key;
+    }
+    ph_destroy(ph);
+}
+
+// 测试合并：src变空，其句柄改属dst
+void test_ph_meld_should_combine_heaps(void)
+{
+    pairing_heap_t *dst = ph_create(item_cmp);
+    pairing_heap_t *src = ph_create(item_cmp);
+    item_t items[200];
+
+    for (int i = 0; i < 200; i++)
+    {
+        items[i].key = 1000 + (i * 71) % 200;
+        items[i].node = ph_push(i % 2 == 0 ? dst : src, &items[i]);
+    }
+    TEST_ASSERT_TRUE(ph_meld(dst, src));
+    TEST_ASSERT_FALSE(ph_meld(dst, dst));
+    TEST_ASSERT_EQUAL(200, ph_size(dst));
+    TEST_ASSERT_TRUE(ph_is_empty(src));
+
+    // 原属src的节点可在dst中调整
+    items[1].key = 0;
+    TEST_ASSERT_TRUE(ph_decrease_key(dst, items[1].node));
+    TEST_ASSERT_EQUAL_PTR(&items[1], ph_pop(dst));
+
+    int last = -1;
+    size_t popped = 0;
+    while (!ph_is_empty(dst))
+    {
+        item_t *top = (item_t *)ph_pop(dst);
+        TEST_ASSERT_TRUE(top->key > last);
+        last = top->key;
+        popped++;
+    }
+    TEST_ASSERT_EQUAL(199, popped);
+
+    // 合并后的src仍可独立使用
+    ph_push(src, &items[0]);
+    TEST_ASSERT_EQUAL_PTR(&items[0], ph_pop(src));
+
+    ph_destroy(src);
+    ph_destroy(dst);
+}
+
+// 测试清空后复用
+void test_ph_clear_should_reset(void)
+{
+    pairing_heap_t *ph = ph_create(int_cmp);
+
+    for (intptr_t i = 0; i < 1000; i++)
+    {
+        ph_push(ph, (void *)i);
+    }
+    ph_clear(ph);
+    TEST_ASSERT_TRUE(ph_is_empty(ph));
+    TEST_ASSERT_NULL(ph_peek(ph));
+    ph_push(ph, (void *)(intptr_t)5);
+    ph_push(ph, (void *)(intptr_t)3);
+    TEST_ASSERT_EQUAL(3, (intptr_t)ph_pop(ph));
+    ph_destroy(ph);
+}
+
+// 测试空指针
+void test_ph_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_NULL(ph_push(NULL, NULL));
+    TEST_ASSERT_NULL(ph_peek(NULL));
+    TEST_ASSERT_NULL(ph_pop(NULL));
+    TEST_ASSERT_FALSE(ph_decrease_key(NULL, NULL));
+    TEST_ASSERT_NULL(ph_remove(NULL, NULL));
+    TEST_ASSERT_FALSE(ph_meld(NULL, NULL));
+    TEST_ASSERT_EQUAL(0, ph_size(NULL));
+    TEST_ASSERT_TRUE(ph_is_empty(NULL));
+    ph_clear(NULL);
+    ph_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ph_create_should_start_empty);
+    RUN_TEST(test_ph_pop_should_return_sorted_order);
+    RUN_TEST(test_ph_decrease_key_should_reorder);
+    RUN_TEST(test_ph_remove_should_delete_any_node);
+    RUN_TEST(test_ph_meld_should_combine_heaps);
+    RUN_TEST(test_ph_clear_should_reset);
+    RUN_TEST(test_ph_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,286 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "hash_table/perfect_hash.h"
+#include "Unity/src/unity.h"
+
+#define KEY_COUNT 10000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static size_t make_key(char *buf, size_t size, size_t i)
+{
+    return (size_t)snprintf(buf, size, "key:%zu", i);
+}
+
+// 构建KEY_COUNT个键的缓冲区，值为键序号
+static void *build_table(size_t *size)
+{
+    mph_builder_t *builder = mph_builder_create();
+    char key[32];
+
+    for (size_t i = 0; i < KEY_COUNT; i++)
+    {
+        uint64_t value = i;
+        TEST_ASSERT_TRUE(mph_builder_add(builder, key, make_key(key, sizeof(key), i), &value, sizeof(value)));
+    }
+    TEST_ASSERT_EQUAL(KEY_COUNT, mph_builder_size(builder));
+
+    void *buf = mph_build(builder, size);
+    mph_builder_destroy(builder);
+    TEST_ASSERT_NOT_NULL(buf);
+    return buf;
+}
+
+// 检查全部键能查到正确的值，序号构成0..n-1的排列，不存在的键查不到
+static void check_table(mph_table_t *table)
+{
+    uint8_t *seen = (uint8_t *)calloc(KEY_COUNT, 1);
+    char key[32];
+
+    TEST_ASSERT_NOT_NULL(table);
+    TEST_ASSERT_EQUAL(KEY_COUNT, mph_size(table));
+    for (size_t i = 0; i < KEY_COUNT; i++)
+    {
+        size_t len = make_key(key, sizeof(key), i);
+        const void *value = NULL;
+        size_t value_len = 0;
+        uint64_t stored;
+
+        TEST_ASSERT_TRUE(mph_find(table, key, len, &value, &value_len));
+        TEST_ASSERT_EQUAL(sizeof(uint64_t), value_len);
+        memcpy(&stored, value, sizeof(stored));
+        TEST_ASSERT_EQUAL(i, stored);
+
+        size_t idx = mph_index(table, key, len);
+        TEST_ASSERT_TRUE(idx < KEY_COUNT);
+        TEST_ASSERT_EQUAL(0, seen[idx]);
+        seen[idx] = 1;
+    }
+    for (size_t i = KEY_COUNT; i < 2 * KEY_COUNT; i++)
+    {
+        TEST_ASSERT_FALSE(mph_contains(table, key, make_key(key, sizeof(key), i)));
+    }
+    TEST_ASSERT_EQUAL(MPH_NOT_FOUND, mph_index(table, "key:", 4));
+    free(seen);
+}
+
+// 测试构建后所有键可查
+void test_mph_build_should_find_all_keys(void)
+{
+    size_t size = 0;
+    void *buf = build_table(&size);
+
+    mph_table_t *table = mph_open(buf, size);
+    check_table(table);
+    // 空间：位数组加秩索引每键只需几位
+    TEST_ASSERT_TRUE(table->bit_words * 64 < KEY_COUNT * 4);
+
+    mph_close(table);
+    free(buf);
+}
+
+static size_t visited;
+static uint64_t value_sum;
+
+static void visit(const void *key, size_t key_len, const void *value, size_t value_len)
+{
+    uint64_t stored;
+    TEST_ASSERT_TRUE(key_len > 4);
+    TEST_ASSERT_EQUAL(0, memcmp(key, "key:", 4));
+    TEST_ASSERT_EQUAL(sizeof(stored), value_len);
+    memcpy(&stored, value, sizeof(stored));
+    value_sum += stored;
+    visited++;
+}
+
+// 测试遍历
+void test_mph_foreach_should_visit_every_entry(void)
+{
+    size_t size = 0;
+    void *buf = build_table(&size);
+    mph_table_t *table = mph_open(buf, size);
+
+    visited = 0;
+    value_sum = 0;
+    mph_foreach(table, visit);
+    TEST_ASSERT_EQUAL(KEY_COUNT, visited);
+    TEST_ASSERT_EQUAL((uint64_t)KEY_COUNT * (KEY_COUNT - 1) / 2, value_sum);
+
+    mph_close(table);
+    free(buf);
+}
+
+// 测试缓冲区不含指针，复制到别处后仍可使用
+void test_mph_buffer_should_be_relocatable(void)
+{
+    size_t size = 0;
+    void *buf = build_table(&size);
+    void *copy = malloc(size);
+
+    memcpy(copy, buf, size);
+    free(buf);
+    mph_table_t *table = mph_open(copy, size);
+    check_table(table);
+
+    mph_close(table);
+    free(copy);
+}
+
+// 测试写入文件后映射查询
+void test_mph_map_file_should_query_without_rebuild(void)
+{
+    char path[] = "/tmp/test_perfect_hash_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    size_t size = 0;
+    void *buf = build_table(&size);
+    TEST_ASSERT_TRUE(mph_write_file(buf, size, path));
+    free(buf);
+
+    mph_table_t *table = mph_map_file(path);
+    TEST_ASSERT_TRUE(table->mapped);
+    check_table(table);
+    mph_close(table);
+
+    TEST_ASSERT_NULL(mph_map_file("/nonexistent/perfect_hash"));
+    unlink(path);
+}
+
+// 测试重复键、空键集与空键
+void test_mph_build_special_key_sets(void)
+{
+    mph_builder_t *builder = mph_builder_create();
+    size_t size = 0;
+
+    // 空键集
+    void *buf = mph_build(builder, &size);
+    TEST_ASSERT_NOT_NULL(buf);
+    mph_table_t *table = mph_open(buf, size);
+    TEST_ASSERT_NOT_NULL(table);
+    TEST_ASSERT_EQUAL(0, mph_size(table));
+    TEST_ASSERT_FALSE(mph_contains(table, "a", 1));
+    mph_close(table);
+    free(buf);
+
+    // 空键与空值
+    TEST_ASSERT_TRUE(mph_builder_add(builder, "", 0, NULL, 0));
+    TEST_ASSERT_TRUE(mph_builder_add(builder, "a", 1, "1", 1));
+    buf = mph_build(builder, &size);
+    table = mph_open(buf, size);
+    const void *value = NULL;
+    size_t value_len = 1;
+    TEST_ASSERT_TRUE(mph_find(table, "", 0, &value, &value_len));
+    TEST_ASSERT_EQUAL(0, value_len);
+    TEST_ASSERT_TRUE(mph_find(table, "a", 1, &value, &value_len));
+    TEST_ASSERT_EQUAL_MEMORY("1", value, 1);
+    mph_close(table);
+    free(buf);
+
+    // 重复键构建失败
+    TEST_ASSERT_TRUE(mph_builder_add(builder, "a", 1, "2", 1));
+    TEST_ASSERT_NULL(mph_build(builder, &size));
+    mph_builder_destroy(builder);
+}
+
+// 测试格式校验
+void test_mph_open_should_reject_corrupt_buffers(void)
+{
+    size_t size = 0;
+    uint8_t *buf = (uint8_t *)build_table(&size);
+
+    TEST_ASSERT_NULL(mph_open(buf, size - 8));
+    TEST_ASSERT_NULL(mph_open(buf, 16));
+    TEST_ASSERT_NULL(mph_open(buf + 1, size - 1));
+
+    uint8_t version = buf[4];
+    buf[4] = 9;
+    TEST_ASSERT_NULL(mph_open(buf, size));
+    buf[4] = version;
+    buf[0] ^= 0xFF;
+    TEST_ASSERT_NULL(mph_open(buf, size));
+    buf[0] ^= 0xFF;
+
+    // 其他字节序的主机生成的缓冲区：字节序标记的字节顺序相反
+    uint8_t marker[4];
+    memcpy(marker, buf + 8, sizeof(marker));
+    for (size_t i = 0; i < sizeof(marker); i++)
+    {
+        buf[8 + i] = marker[sizeof(marker) - 1 - i];
+    }
+    TEST_ASSERT_NULL(mph_open(buf, size));
+    memcpy(buf + 8, marker, sizeof(marker));
+
+    mph_table_t *table = mph_open(buf, size);
+    TEST_ASSERT_NOT_NULL(table);
+    mph_close(table);
+    free(buf);
+}
+
+// 测试键数上限：上限处第一层位数组不超过UINT32_MAX，超过上限的构建被拒绝
+void test_mph_build_should_reject_too_many_keys(void)
+{
+    uint64_t words = (uint64_t)MPH_MAX_KEYS * 2 / 64 + 1;
+    TEST_ASSERT_TRUE(words * 64 <= UINT32_MAX);
+    TEST_ASSERT_TRUE((uint64_t)(MPH_MAX_KEYS + 1) * 2 + 64 > UINT32_MAX);
+
+    // 伪造键数，不实际分配这么多条目
+    mph_builder_t *builder = mph_builder_create();
+    size_t size = 0;
+    builder->count = MPH_MAX_KEYS;
+    TEST_ASSERT_FALSE(mph_builder_add(builder, "a", 1, NULL, 0));
+    builder->count = MPH_MAX_KEYS + 1;
+    TEST_ASSERT_NULL(mph_build(builder, &size));
+    builder->count = 0;
+    mph_builder_destroy(builder);
+}
+
+// 测试空指针
+void test_mph_edge_cases_should_handle_null_inputs(void)
+{
+    size_t size = 0;
+
+    TEST_ASSERT_FALSE(mph_builder_add(NULL, "a", 1, NULL, 0));
+    TEST_ASSERT_EQUAL(0, mph_builder_size(NULL));
+    TEST_ASSERT_NULL(mph_build(NULL, &size));
+    TEST_ASSERT_FALSE(mph_write_file(NULL, 0, "/tmp/x"));
+    TEST_ASSERT_NULL(mph_open(NULL, 0));
+    TEST_ASSERT_NULL(mph_map_file(NULL));
+    TEST_ASSERT_EQUAL(0, mph_size(NULL));
+    TEST_ASSERT_EQUAL(MPH_NOT_FOUND, mph_index(NULL, "a", 1));
+    TEST_ASSERT_FALSE(mph_find(NULL, "a", 1, NULL, NULL));
+    TEST_ASSERT_FALSE(mph_contains(NULL, "a", 1));
+    mph_foreach(NULL, visit);
+    mph_close(NULL);
+    mph_builder_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mph_build_should_find_all_keys);
+    RUN_TEST(test_mph_foreach_should_visit_every_entry);
+    RUN_TEST(test_mph_buffer_should_be_relocatable);
+    RUN_TEST(test_mph_map_file_should_query_without_rebuild);
+    RUN_TEST(test_mph_build_special_key_sets);
+    RUN_TEST(test_mph_open_should_reject_corrupt_buffers);
+    RUN_TEST(test_mph_build_should_reject_too_many_keys);
+    RUN_TEST(test_mph_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "queue/priority_queue.h"
+#include "Unity/src/unity.h"
+
+// 比较函数
+int int_cmp(void *a, void *b)
+{
+    int val_a = *(int *)a;
+    int val_b = *(int *)b;
+    return val_a - val_b;
+}
+
+// 直接以指针值作为键的比较函数
+int key_cmp(void *a, void *b)
+{
+    uintptr_t ka = (uintptr_t)a;
+    uintptr_t kb = (uintptr_t)b;
+    return (ka > kb) - (ka < kb);
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建空队列
+void test_pq_create_should_create_empty_queue(void)
+{
+    priority_queue_t *pq = pq_create(int_cmp);
+
+    TEST_ASSERT_NOT_NULL(pq);
+    TEST_ASSERT_EQUAL(0, pq_size(pq));
+    TEST_ASSERT_TRUE(pq_is_empty(pq));
+    TEST_ASSERT_EQUAL(PQ_DEFAULT_ARITY, pq_arity(pq));
+    TEST_ASSERT_NULL(pq_peek(pq));
+    TEST_ASSERT_NULL(pq_pop(pq));
+
+    pq_destroy(pq);
+}
+
+// 测试非法分叉数
+void test_pq_create_with_arity_should_reject_invalid_arity(void)
+{
+    TEST_ASSERT_NULL(pq_create_with_arity(int_cmp, 0));
+    TEST_ASSERT_NULL(pq_create_with_arity(int_cmp, 1));
+    TEST_ASSERT_NULL(pq_create_with_arity(int_cmp, PQ_MAX_ARITY + 1));
+    TEST_ASSERT_NULL(pq_create_with_arity(NULL, 4));
+}
+
+// 测试子节点组按缓存行对齐
+void test_pq_children_should_share_cache_line(void)
+{
+    priority_queue_t *pq = pq_create_with_arity(int_cmp, 8);
+
+    TEST_ASSERT_EQUAL(0, (uintptr_t)&pq->data[1] % PQ_CACHE_LINE);
+    TEST_ASSERT_TRUE(pq_reserve(pq, 1000));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)&pq->data[1] % PQ_CACHE_LINE);
+
+    pq_destroy(pq);
+}
+
+// 测试按优先级弹出
+void test_pq_pop_should_return_items_in_priority_order(void)
+{
+    int values[] = {5, 3, 8, 1, 9, 2, 7};
+    priority_queue_t *pq = pq_create(int_cmp);
+
+    for (size_t i = 0; i < 7; i++)
+    {
+        TEST_ASSERT_TRUE(pq_push(pq, &values[i]));
+    }
+
+    TEST_ASSERT_EQUAL(7, pq_size(pq));
+    TEST_ASSERT_EQUAL(1, *(int *)pq_peek(pq));
+
+    int expected[] = {1, 2, 3, 5, 7, 8, 9};
+    for (size_t i = 0; i < 7; i++)
+    {
+        TEST_ASSERT_EQUAL(expected[i], *(int *)pq_pop(pq));
+    }
+    TEST_ASSERT_TRUE(pq_is_empty(pq));
+
+    pq_destroy(pq);
+}
+
+// 测试各分叉数下大量随机元素的顺序与扩容
+void test_pq_should_order_many_items_for_each_arity(void)
+{
+    size_t arities[] = {2, 3, 4, 8, 16};
+
+    for (size_t a = 0; a < 5; a++)
+    {
+        priority_queue_t *pq = pq_create_with_arity(key_cmp, arities[a]);
+        uint32_t seed = 12345;
+
+        for (size_t i = 0; i < 5000; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            TEST_ASSERT_TRUE(pq_push(pq, (void *)(uintptr_t)(seed >> 8)));
+        }
+
+        uintptr_t prev = 0;
+        for (size_t i = 0; i < 5000; i++)
+        {
+            uintptr_t key = (uintptr_t)pq_pop(pq);
+            TEST_ASSERT_TRUE(key >= prev);
+            prev = key;
+        }
+        TEST_ASSERT_TRUE(pq_is_empty(pq));
+
+        pq_destroy(pq);
+    }
+}
+
+// 测试清空
+void test_pq_clear_should_remove_all_items(void)
+{
+    int values[] = {4, 2, 6};
+    priority_queue_t *pq = pq_create(int_cmp);
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        pq_push(pq, &values[i]);
+    }
+    pq_clear(pq);
+
+    TEST_ASSERT_EQUAL(0, pq_size(pq));
+    TEST_ASSERT_NULL(pq_peek(pq));
+
+    pq_destroy(pq);
+}
+
+// 测试空指针
+void test_pq_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(pq_push(NULL, NULL));
+    TEST_ASSERT_NULL(pq_pop(NULL));
+    TEST_ASSERT_NULL(pq_peek(NULL));
+    TEST_ASSERT_EQUAL(0, pq_size(NULL));
+    TEST_ASSERT_TRUE(pq_is_empty(NULL));
+    pq_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pq_create_should_create_empty_queue);
+    RUN_TEST(test_pq_create_with_arity_should_reject_invalid_arity);
+    RUN_TEST(test_pq_children_should_share_cache_line);
+    RUN_TEST(test_pq_pop_should_return_items_in_priority_order);
+    RUN_TEST(test_pq_should_order_many_items_for_each_arity);
+    RUN_TEST(test_pq_clear_should_remove_all_items);
+    RUN_TEST(test_pq_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
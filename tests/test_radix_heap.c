@@ -0,0 +1,153 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "heap/radix_heap.h"
+#include "Unity/src/unity.h"
+
+#define EVENT_COUNT 20000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// 测试创建
+void test_rh_create_should_start_empty(void)
+{
+    radix_heap_t *rh = rh_create();
+    uint64_t key = 1;
+
+    TEST_ASSERT_NOT_NULL(rh);
+    TEST_ASSERT_TRUE(rh_is_empty(rh));
+    TEST_ASSERT_EQUAL(0, rh_last_key(rh));
+    TEST_ASSERT_FALSE(rh_pop(rh, &key, NULL));
+    TEST_ASSERT_FALSE(rh_peek(rh, NULL, NULL));
+    rh_destroy(rh);
+}
+
+// 测试随机键按升序弹出，值随键一起返回
+void test_rh_pop_should_return_ascending_keys(void)
+{
+    radix_heap_t *rh = rh_create();
+    uint64_t seed = 88;
+
+    for (size_t i = 0; i < EVENT_COUNT; i++)
+    {
+        uint64_t key = next_rand(&seed) >> (i % 64);
+        TEST_ASSERT_TRUE(rh_push(rh, key, (void *)(uintptr_t)key));
+    }
+    TEST_ASSERT_TRUE(rh_push(rh, UINT64_MAX, NULL));
+    TEST_ASSERT_TRUE(rh_push(rh, 0, NULL));
+    TEST_ASSERT_EQUAL(EVENT_COUNT + 2, rh_size(rh));
+
+    uint64_t last = 0;
+    uint64_t key;
+    void *value;
+    size_t popped = 0;
+    while (rh_pop(rh, &key, &value))
+    {
+        TEST_ASSERT_TRUE(key >= last);
+        TEST_ASSERT_TRUE(key == UINT64_MAX || key == 0 || (uintptr_t)value == key);
+        last = key;
+        popped++;
+    }
+    TEST_ASSERT_EQUAL(EVENT_COUNT + 2, popped);
+    TEST_ASSERT_EQUAL(UINT64_MAX, last);
+    rh_destroy(rh);
+}
+
+// 测试单调约定：小于上次弹出键的插入被拒绝，等于的可以插入
+void test_rh_push_should_enforce_monotone_keys(void)
+{
+    radix_heap_t *rh = rh_create();
+    uint64_t key;
+
+    rh_push(rh, 100, NULL);
+    rh_push(rh, 200, NULL);
+    TEST_ASSERT_TRUE(rh_pop(rh, &key, NULL));
+    TEST_ASSERT_EQUAL(100, key);
+    TEST_ASSERT_EQUAL(100, rh_last_key(rh));
+
+    TEST_ASSERT_FALSE(rh_push(rh, 99, NULL));
+    TEST_ASSERT_TRUE(rh_push(rh, 100, NULL));
+    TEST_ASSERT_TRUE(rh_push(rh, 150, NULL));
+    TEST_ASSERT_EQUAL(3, rh_size(rh));
+
+    // peek推进last
+    TEST_ASSERT_TRUE(rh_peek(rh, &key, NULL));
+    TEST_ASSERT_EQUAL(100, key);
+    rh_pop(rh, &key, NULL);
+    TEST_ASSERT_TRUE(rh_peek(rh, &key, NULL));
+    TEST_ASSERT_EQUAL(150, key);
+    TEST_ASSERT_EQUAL(150, rh_last_key(rh));
+    TEST_ASSERT_FALSE(rh_push(rh, 120, NULL));
+    rh_destroy(rh);
+}
+
+// 测试定时器模型：弹出后插入更晚的事件，始终按时间顺序弹出
+void test_rh_hold_model_should_stay_ordered(void)
+{
+    radix_heap_t *rh = rh_create();
+    uint64_t seed = 5;
+    uint64_t now = 0;
+
+    for (size_t i = 0; i < 1000; i++)
+    {
+        rh_push(rh, next_rand(&seed) % 10000, NULL);
+    }
+    for (size_t i = 0; i < EVENT_COUNT; i++)
+    {
+        uint64_t key;
+        TEST_ASSERT_TRUE(rh_pop(rh, &key, NULL));
+        TEST_ASSERT_TRUE(key >= now);
+        now = key;
+        // 大部分是短延迟，少量长延迟
+        uint64_t delay = (i % 16 == 0) ? next_rand(&seed) % 1000000 : next_rand(&seed) % 100;
+        TEST_ASSERT_TRUE(rh_push(rh, now + delay, NULL));
+    }
+    TEST_ASSERT_EQUAL(1000, rh_size(rh));
+
+    rh_clear(rh);
+    TEST_ASSERT_TRUE(rh_is_empty(rh));
+    TEST_ASSERT_EQUAL(0, rh_last_key(rh));
+    TEST_ASSERT_TRUE(rh_push(rh, 1, NULL));
+    rh_destroy(rh);
+}
+
+// 测试空指针
+void test_rh_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(rh_push(NULL, 1, NULL));
+    TEST_ASSERT_FALSE(rh_peek(NULL, NULL, NULL));
+    TEST_ASSERT_FALSE(rh_pop(NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, rh_size(NULL));
+    TEST_ASSERT_TRUE(rh_is_empty(NULL));
+    TEST_ASSERT_EQUAL(0, rh_last_key(NULL));
+    rh_clear(NULL);
+    rh_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rh_create_should_start_empty);
+    RUN_TEST(test_rh_pop_should_return_ascending_keys);
+    RUN_TEST(test_rh_push_should_enforce_monotone_keys);
+    RUN_TEST(test_rh_hold_model_should_stay_ordered);
+    RUN_TEST(test_rh_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
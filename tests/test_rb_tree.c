@@ -0,0 +1,303 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "tree/rb_tree.h"
+#include "Unity/src/unity.h"
+
+#define KEY_RANGE 4096
+#define OP_COUNT 20000
+
+#define K(x) ((void *)(uintptr_t)(x))
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int key_cmp(void *a, void *b)
+{
+    uintptr_t x = (uintptr_t)a;
+    uintptr_t y = (uintptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t next_rand(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// 检查子树的红黑性质与父指针，返回黑高
+static int check_subtree(rb_node_t *node, rb_node_t *parent, size_t *count)
+{
+    if (node == NULL)
+    {
+        return 1;
+    }
+    TEST_ASSERT_TRUE(node->parent == parent);
+    if (node->color == RB_RED)
+    {
+        TEST_ASSERT_TRUE(node->left == NULL || node->left->color == RB_BLACK);
+        TEST_ASSERT_TRUE(node->right == NULL || node->right->color == RB_BLACK);
+    }
+    if (node->left != NULL)
+    {
+        TEST_ASSERT_TRUE(key_cmp(node->left->key, node->key) < 0);
+    }
+    if (node->right != NULL)
+    {
+        TEST_ASSERT_TRUE(key_cmp(node->right->key, node->key) > 0);
+    }
+    int left = check_subtree(node->left, node, count);
+    int right = check_subtree(node->right, node, count);
+    TEST_ASSERT_EQUAL(left, right);
+    (*count)++;
+    return left + (node->color == RB_BLACK);
+}
+
+static void check_tree(rb_tree_t *rb)
+{
+    size_t count = 0;
+    TEST_ASSERT_TRUE(rb->root == NULL || rb->root->color == RB_BLACK);
+    check_subtree(rb->root, NULL, &count);
+    TEST_ASSERT_EQUAL(rb->size, count);
+}
+
+static bool collect(void *key, void *value, void *arg)
+{
+    (void)value;
+    uintptr_t *out = (uintptr_t *)arg;
+    out[++out[0]] = (uintptr_t)key;
+    return out[0] < 5;
+}
+
+// 测试创建
+void test_rb_create_should_start_empty(void)
+{
+    rb_tree_t *rb = rb_create(key_cmp);
+
+    TEST_ASSERT_NOT_NULL(rb);
+    TEST_ASSERT_TRUE(rb_is_empty(rb));
+    TEST_ASSERT_NULL(rb_first(rb));
+    TEST_ASSERT_NULL(rb_last(rb));
+    TEST_ASSERT_NULL(rb_lower_bound(rb, K(1)));
+    TEST_ASSERT_NULL(rb_create(NULL));
+    rb_destroy(rb);
+}
+
+// 测试插入、查找与替换
+void test_rb_put_should_insert_and_replace(void)
+{
+    rb_tree_t *rb = rb_create(key_cmp);
+    void *value = NULL;
+
+    TEST_ASSERT_TRUE(rb_put(rb, K(5), K(50)));
+    TEST_ASSERT_TRUE(rb_put(rb, K(3), K(30)));
+    TEST_ASSERT_TRUE(rb_put(rb, K(8), K(80)));
+    TEST_ASSERT_EQUAL(3, rb_size(rb));
+    TEST_ASSERT_EQUAL_PTR(K(30), rb_get(rb, K(3)));
+    TEST_ASSERT_TRUE(rb_contains(rb, K(8)));
+    TEST_ASSERT_FALSE(rb_contains(rb, K(4)));
+
+    TEST_ASSERT_TRUE(rb_put(rb, K(3), K(31)));
+    TEST_ASSERT_EQUAL(3, rb_size(rb));
+    TEST_ASSERT_TRUE(rb_find(rb, K(3), &value));
+    TEST_ASSERT_EQUAL_PTR(K(31), value);
+    TEST_ASSERT_FALSE(rb_find(rb, K(4), &value));
+
+    TEST_ASSERT_TRUE(rb_remove(rb, K(5), &value));
+    TEST_ASSERT_EQUAL_PTR(K(50), value);
+    TEST_ASSERT_FALSE(rb_remove(rb, K(5), NULL));
+    TEST_ASSERT_EQUAL(2, rb_size(rb));
+    check_tree(rb);
+    rb_destroy(rb);
+}
+
+// 测试随机插入删除后保持红黑性质，并与参照数组一致
+static void run_random_ops(rb_tree_t *rb, uint64_t seed)
+{
+    uintptr_t *present = (uintptr_t *)calloc(KEY_RANGE, sizeof(uintptr_t));
+    size_t expected = 0;
+
+    for (size_t i = 0; i < OP_COUNT; i++)
+    {
+        uintptr_t key = next_rand(&seed) % KEY_RANGE;
+        if (next_rand(&seed) % 3 != 0)
+        {
+            TEST_ASSERT_TRUE(rb_put(rb, K(key), K(key + 1)));
+            expected += present[key] == 0;
+            present[key] = key + 1;
+        }
+        else
+        {
+            void *value = NULL;
+            bool removed = rb_remove(rb, K(key), &value);
+            TEST_ASSERT_EQUAL(present[key] != 0, removed);
+            if (removed)
+            {
+                TEST_ASSERT_EQUAL_PTR(K(key + 1), value);
+                present[key] = 0;
+                expected--;
+            }
+        }
+        if (i % 1000 == 0)
+        {
+            check_tree(rb);
+        }
+    }
+    check_tree(rb);
+    TEST_ASSERT_EQUAL(expected, rb_size(rb));
+
+    // 中序遍历与参照数组一致
+    rb_node_t *node = rb_first(rb);
+    for (uintptr_t key = 0; key < KEY_RANGE; key++)
+    {
+        if (present[key] != 0)
+        {
+            TEST_ASSERT_NOT_NULL(node);
+            TEST_ASSERT_EQUAL_PTR(K(key), node->key);
+            TEST_ASSERT_EQUAL_PTR(K(present[key]), node->value);
+            node = rb_next(node);
+        }
+    }
+    TEST_ASSERT_NULL(node);
+    free(present);
+}
+
+void test_rb_random_ops_should_keep_invariants(void)
+{
+    rb_tree_t *rb = rb_create(key_cmp);
+    run_random_ops(rb, 17);
+    rb_destroy(rb);
+}
+
+// 测试节点池分配的树，以及清空后复用
+void test_rb_pooled_tree_should_behave_the_same(void)
+{
+    rb_tree_t *rb = rb_create_pooled(key_cmp, 64);
+
+    TEST_ASSERT_NOT_NULL(rb);
+    run_random_ops(rb, 29);
+    rb_clear(rb);
+    TEST_ASSERT_TRUE(rb_is_empty(rb));
+    TEST_ASSERT_EQUAL(0, np_in_use(rb->pool));
+    run_random_ops(rb, 31);
+    rb_destroy(rb);
+}
+
+// 测试上下界与双向迭代
+void test_rb_bounds_should_locate_neighbours(void)
+{
+    rb_tree_t *rb = rb_create(key_cmp);
+
+    for (uintptr_t key = 10; key <= 100; key += 10)
+    {
+        rb_put(rb, K(key), NULL);
+    }
+    TEST_ASSERT_EQUAL_PTR(K(30), rb_lower_bound(rb, K(30))->key);
+    TEST_ASSERT_EQUAL_PTR(K(40), rb_upper_bound(rb, K(30))->key);
+    TEST_ASSERT_EQUAL_PTR(K(40), rb_lower_bound(rb, K(35))->key);
+    TEST_ASSERT_EQUAL_PTR(K(10), rb_lower_bound(rb, K(0))->key);
+    TEST_ASSERT_NULL(rb_lower_bound(rb, K(101)));
+    TEST_ASSERT_NULL(rb_upper_bound(rb, K(100)));
+
+    TEST_ASSERT_EQUAL_PTR(K(10), rb_first(rb)->key);
+    TEST_ASSERT_EQUAL_PTR(K(100), rb_last(rb)->key);
+    rb_node_t *node = rb_last(rb);
+    for (uintptr_t key = 100; key >= 10; key -= 10)
+    {
+        TEST_ASSERT_EQUAL_PTR(K(key), node->key);
+        node = rb_prev(node);
+    }
+    TEST_ASSERT_NULL(node);
+    rb_destroy(rb);
+}
+
+// 测试范围扫描：半开区间，回调返回false时提前结束
+void test_rb_range_should_scan_half_open_interval(void)
+{
+    rb_tree_t *rb = rb_create(key_cmp);
+    uintptr_t out[16] = {0};
+
+    for (uintptr_t key = 0; key < 100; key += 2)
+    {
+        rb_put(rb, K(key), NULL);
+    }
+    TEST_ASSERT_EQUAL(3, rb_range(rb, K(11), K(17), collect, out));
+    TEST_ASSERT_EQUAL(3, out[0]);
+    TEST_ASSERT_EQUAL(12, out[1]);
+    TEST_ASSERT_EQUAL(14, out[2]);
+    TEST_ASSERT_EQUAL(16, out[3]);
+
+    out[0] = 0;
+    TEST_ASSERT_EQUAL(5, rb_range(rb, K(0), K(100), collect, out));
+    TEST_ASSERT_EQUAL(8, out[5]);
+
+    out[0] = 0;
+    TEST_ASSERT_EQUAL(0, rb_range(rb, K(50), K(50), collect, out));
+    TEST_ASSERT_EQUAL(0, rb_range(rb, K(99), K(200), collect, out));
+    rb_destroy(rb);
+}
+
+// 测试边遍历边删除
+void test_rb_erase_should_return_successor(void)
+{
+    rb_tree_t *rb = rb_create(key_cmp);
+
+    for (uintptr_t key = 0; key < 1000; key++)
+    {
+        rb_put(rb, K(key), NULL);
+    }
+    rb_node_t *node = rb_lower_bound(rb, K(100));
+    while (node != NULL && (uintptr_t)node->key < 900)
+    {
+        node = (uintptr_t)node->key % 2 == 0 ? rb_erase(rb, node) : rb_next(node);
+    }
+    check_tree(rb);
+    TEST_ASSERT_EQUAL(600, rb_size(rb));
+    TEST_ASSERT_FALSE(rb_contains(rb, K(500)));
+    TEST_ASSERT_TRUE(rb_contains(rb, K(501)));
+    TEST_ASSERT_NULL(rb_erase(rb, rb_last(rb)));
+    rb_destroy(rb);
+}
+
+// 测试空指针
+void test_rb_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(rb_put(NULL, K(1), NULL));
+    TEST_ASSERT_NULL(rb_get(NULL, K(1)));
+    TEST_ASSERT_FALSE(rb_find(NULL, K(1), NULL));
+    TEST_ASSERT_FALSE(rb_remove(NULL, K(1), NULL));
+    TEST_ASSERT_NULL(rb_first(NULL));
+    TEST_ASSERT_NULL(rb_next(NULL));
+    TEST_ASSERT_NULL(rb_prev(NULL));
+    TEST_ASSERT_NULL(rb_erase(NULL, NULL));
+    TEST_ASSERT_EQUAL(0, rb_range(NULL, K(0), K(1), collect, NULL));
+    TEST_ASSERT_EQUAL(0, rb_size(NULL));
+    TEST_ASSERT_TRUE(rb_is_empty(NULL));
+    rb_foreach(NULL, NULL);
+    rb_clear(NULL);
+    rb_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rb_create_should_start_empty);
+    RUN_TEST(test_rb_put_should_insert_and_replace);
+    RUN_TEST(test_rb_random_ops_should_keep_invariants);
+    RUN_TEST(test_rb_pooled_tree_should_behave_the_same);
+    RUN_TEST(test_rb_bounds_should_locate_neighbours);
+    RUN_TEST(test_rb_range_should_scan_half_open_interval);
+    RUN_TEST(test_rb_erase_should_return_successor);
+    RUN_TEST(test_rb_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
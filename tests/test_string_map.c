@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_table/string_map.h"
+#include "Unity/src/unity.h"
+
+static size_t visit_count;
+static size_t visit_len;
+
+static void visit(const char *key, size_t len, void *value)
+{
+    (void)value;
+    TEST_ASSERT_EQUAL('\0', key[len]);
+    visit_count++;
+    visit_len += len;
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建
+void test_sm_create_should_create_empty_map(void)
+{
+    string_map_t *sm = sm_create();
+
+    TEST_ASSERT_NOT_NULL(sm);
+    TEST_ASSERT_EQUAL(0, sm_size(sm));
+    TEST_ASSERT_TRUE(sm_is_empty(sm));
+    TEST_ASSERT_EQUAL(0, sm_pool_bytes(sm));
+    TEST_ASSERT_FALSE(sm_contains(sm, "a", 1));
+
+    sm_destroy(sm);
+}
+
+// 测试插入、替换，键被复制
+void test_sm_put_get_should_copy_keys(void)
+{
+    string_map_t *sm = sm_create();
+    char buffer[16];
+
+    strcpy(buffer, "apple");
+    TEST_ASSERT_TRUE(sm_put(sm, buffer, 5, (void *)1));
+    // 修改调用方缓冲区不影响表中的键
+    strcpy(buffer, "grape");
+    TEST_ASSERT_EQUAL_PTR((void *)1, sm_get(sm, "apple", 5));
+    TEST_ASSERT_FALSE(sm_contains(sm, "grape", 5));
+
+    TEST_ASSERT_TRUE(sm_put(sm, "apple", 5, (void *)2));
+    TEST_ASSERT_EQUAL(1, sm_size(sm));
+    TEST_ASSERT_EQUAL_PTR((void *)2, sm_get(sm, "apple", 5));
+    TEST_ASSERT_EQUAL(6, sm_pool_bytes(sm));
+
+    sm_destroy(sm);
+}
+
+// 测试按(指针, 长度)查找：前缀、内嵌'\0'与空键
+void test_sm_lookup_by_pointer_and_length(void)
+{
+    string_map_t *sm = sm_create();
+    const char *text = "hello world";
+
+    TEST_ASSERT_TRUE(sm_put(sm, text, 5, (void *)1));
+    TEST_ASSERT_TRUE(sm_put(sm, text + 6, 5, (void *)2));
+    TEST_ASSERT_TRUE(sm_put(sm, "a\0b", 3, (void *)3));
+    TEST_ASSERT_TRUE(sm_put(sm, NULL, 0, (void *)4));
+
+    TEST_ASSERT_EQUAL_PTR((void *)1, sm_get(sm, "hello", 5));
+    TEST_ASSERT_EQUAL_PTR((void *)2, sm_get(sm, "world!", 5));
+    TEST_ASSERT_FALSE(sm_contains(sm, "hell", 4));
+    TEST_ASSERT_FALSE(sm_contains(sm, text, 11));
+    TEST_ASSERT_EQUAL_PTR((void *)3, sm_get(sm, "a\0b", 3));
+    TEST_ASSERT_FALSE(sm_contains(sm, "a", 1));
+    TEST_ASSERT_EQUAL_PTR((void *)4, sm_get(sm, "", 0));
+    TEST_ASSERT_EQUAL(4, sm_size(sm));
+
+    sm_destroy(sm);
+}
+
+// 测试大量插入删除、长键与内存池整理
+void test_sm_many_operations_should_work(void)
+{
+    string_map_t *sm = sm_create();
+    char key[64];
+    size_t n = 20000;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        int len = snprintf(key, sizeof(key), "key-%zu", i);
+        TEST_ASSERT_TRUE(sm_put(sm, key, (size_t)len, (void *)(uintptr_t)(i + 1)));
+    }
+    TEST_ASSERT_EQUAL(n, sm_size(sm));
+
+    for (size_t i = 0; i < n; i += 2)
+    {
+        int len = snprintf(key, sizeof(key), "key-%zu", i);
+        void *value = NULL;
+        TEST_ASSERT_TRUE(sm_remove(sm, key, (size_t)len, &value));
+        TEST_ASSERT_EQUAL_PTR((void *)(uintptr_t)(i + 1), value);
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        int len = snprintf(key, sizeof(key), "key-%zu", i);
+        TEST_ASSERT_EQUAL(i % 2 == 1, sm_contains(sm, key, (size_t)len));
+    }
+
+    // 长键单独占一块
+    char *big = (char *)malloc(SM_CHUNK_SIZE * 2);
+    memset(big, 'x', SM_CHUNK_SIZE * 2);
+    TEST_ASSERT_TRUE(sm_put(sm, big, SM_CHUNK_SIZE * 2, (void *)7));
+    TEST_ASSERT_EQUAL_PTR((void *)7, sm_get(sm, big, SM_CHUNK_SIZE * 2));
+    TEST_ASSERT_TRUE(sm_remove(sm, big, SM_CHUNK_SIZE * 2, NULL));
+    free(big);
+
+    // 反复插入删除同一批键，内存池不会无限增长
+    for (int round = 0; round < 50; round++)
+    {
+        for (size_t i = 0; i < 1000; i++)
+        {
+            int len = snprintf(key, sizeof(key), "churn-%d-%zu", round, i);
+            sm_put(sm, key, (size_t)len, NULL);
+        }
+        for (size_t i = 0; i < 1000; i++)
+        {
+            int len = snprintf(key, sizeof(key), "churn-%d-%zu", round, i);
+            TEST_ASSERT_TRUE(sm_remove(sm, key, (size_t)len, NULL));
+        }
+    }
+    TEST_ASSERT_EQUAL(n / 2, sm_size(sm));
+    TEST_ASSERT_TRUE(sm_pool_bytes(sm) < 4 * SM_CHUNK_SIZE);
+
+    visit_count = 0;
+    visit_len = 0;
+    sm_foreach(sm, visit);
+    TEST_ASSERT_EQUAL(n / 2, visit_count);
+    for (size_t i = 1; i < n; i += 2)
+    {
+        int len = snprintf(key, sizeof(key), "key-%zu", i);
+        TEST_ASSERT_EQUAL_PTR((void *)(uintptr_t)(i + 1), sm_get(sm, key, (size_t)len));
+        visit_len -= (size_t)len;
+    }
+    TEST_ASSERT_EQUAL(0, visit_len);
+
+    sm_clear(sm);
+    TEST_ASSERT_EQUAL(0, sm_size(sm));
+    TEST_ASSERT_EQUAL(0, sm_pool_bytes(sm));
+    TEST_ASSERT_FALSE(sm_contains(sm, "key-1", 5));
+
+    sm_destroy(sm);
+}
+
+// 测试预留空间
+void test_sm_reserve_should_prevent_growth(void)
+{
+    string_map_t *sm = sm_create();
+    char key[32];
+
+    TEST_ASSERT_TRUE(sm_reserve(sm, 1000));
+    size_t capacity = sm_capacity(sm);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        int len = snprintf(key, sizeof(key), "%zu", i);
+        sm_put(sm, key, (size_t)len, NULL);
+    }
+    TEST_ASSERT_EQUAL(capacity, sm_capacity(sm));
+
+    // 槽数会溢出时预留失败，表保持原样
+    TEST_ASSERT_FALSE(sm_reserve(sm, SIZE_MAX));
+    TEST_ASSERT_EQUAL(capacity, sm_capacity(sm));
+    TEST_ASSERT_TRUE(sm_contains(sm, "7", 1));
+
+    sm_destroy(sm);
+}
+
+// 测试空指针
+void test_sm_edge_cases_should_handle_null_inputs(void)
+{
+    string_map_t *sm = sm_create();
+    TEST_ASSERT_FALSE(sm_put(sm, NULL, 3, NULL));
+    TEST_ASSERT_FALSE(sm_find(sm, NULL, 3, NULL));
+    TEST_ASSERT_FALSE(sm_remove(sm, NULL, 3, NULL));
+    sm_destroy(sm);
+
+    TEST_ASSERT_FALSE(sm_put(NULL, "a", 1, NULL));
+    TEST_ASSERT_NULL(sm_get(NULL, "a", 1));
+    TEST_ASSERT_FALSE(sm_remove(NULL, "a", 1, NULL));
+    TEST_ASSERT_FALSE(sm_reserve(NULL, 10));
+    TEST_ASSERT_EQUAL(0, sm_size(NULL));
+    TEST_ASSERT_TRUE(sm_is_empty(NULL));
+    sm_foreach(NULL, visit);
+    sm_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sm_create_should_create_empty_map);
+    RUN_TEST(test_sm_put_get_should_copy_keys);
+    RUN_TEST(test_sm_lookup_by_pointer_and_length);
+    RUN_TEST(test_sm_many_operations_should_work);
+    RUN_TEST(test_sm_reserve_should_prevent_growth);
+    RUN_TEST(test_sm_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
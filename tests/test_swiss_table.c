@@ -0,0 +1,251 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_table/swiss_table.h"
+#include "Unity/src/unity.h"
+
+// 以指针值作为整数键
+size_t int_hash(void *key)
+{
+    return (size_t)(uintptr_t)key;
+}
+
+int int_cmp(void *a, void *b)
+{
+    return (uintptr_t)a == (uintptr_t)b ? 0 : 1;
+}
+
+// 统计比较函数调用次数
+static size_t cmp_calls;
+
+int counting_cmp(void *a, void *b)
+{
+    cmp_calls++;
+    return int_cmp(a, b);
+}
+
+// 所有键都冲突的哈希函数
+size_t bad_hash(void *key)
+{
+    (void)key;
+    return 42;
+}
+
+int str_cmp(void *a, void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+size_t str_hash(void *key)
+{
+    size_t hash = 5381;
+    for (const char *p = (const char *)key; *p != '\0'; p++)
+    {
+        hash = hash * 33 + (unsigned char)*p;
+    }
+    return hash;
+}
+
+static uintptr_t visit_sum;
+
+static void visit(void *key, void *value)
+{
+    (void)key;
+    visit_sum += (uintptr_t)value;
+}
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 测试创建
+void test_st_create_should_create_empty_table(void)
+{
+    swiss_table_t *st = st_create(int_hash, int_cmp);
+
+    TEST_ASSERT_NOT_NULL(st);
+    TEST_ASSERT_EQUAL(0, st_size(st));
+    TEST_ASSERT_TRUE(st_is_empty(st));
+    TEST_ASSERT_EQUAL(0, st_capacity(st) % ST_GROUP_SIZE);
+    TEST_ASSERT_NULL(st_get(st, (void *)1));
+    TEST_ASSERT_NULL(st_create(NULL, int_cmp));
+
+    st_destroy(st);
+}
+
+// 测试插入、查找与替换
+void test_st_put_get_should_store_and_replace_values(void)
+{
+    swiss_table_t *st = st_create(str_hash, str_cmp);
+    char key[] = "beta";
+
+    TEST_ASSERT_TRUE(st_put(st, "alpha", (void *)1));
+    TEST_ASSERT_TRUE(st_put(st, "beta", (void *)2));
+    TEST_ASSERT_EQUAL_PTR((void *)2, st_get(st, key));
+    TEST_ASSERT_TRUE(st_put(st, key, (void *)20));
+    TEST_ASSERT_EQUAL(2, st_size(st));
+    TEST_ASSERT_EQUAL_PTR((void *)20, st_get(st, "beta"));
+
+    void *value = (void *)1;
+    TEST_ASSERT_TRUE(st_put(st, "gamma", NULL));
+    TEST_ASSERT_TRUE(st_find(st, "gamma", &value));
+    TEST_ASSERT_NULL(value);
+    TEST_ASSERT_FALSE(st_contains(st, "delta"));
+
+    st_destroy(st);
+}
+
+// 测试大量插入删除与扩容
+void test_st_many_operations_should_match_expected_contents(void)
+{
+    swiss_table_t *st = st_create(int_hash, int_cmp);
+    size_t n = 50000;
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_TRUE(st_put(st, (void *)i, (void *)(i * 3)));
+    }
+    TEST_ASSERT_EQUAL(n, st_size(st));
+    TEST_ASSERT_TRUE(st_size(st) <= st_capacity(st) / ST_MAX_LOAD_DEN * ST_MAX_LOAD_NUM);
+
+    for (uintptr_t i = 1; i <= n; i += 2)
+    {
+        void *value = NULL;
+        TEST_ASSERT_TRUE(st_remove(st, (void *)i, &value));
+        TEST_ASSERT_EQUAL_PTR((void *)(i * 3), value);
+    }
+    TEST_ASSERT_FALSE(st_remove(st, (void *)1, NULL));
+    TEST_ASSERT_EQUAL(n / 2, st_size(st));
+
+    for (uintptr_t i = 1; i <= n; i++)
+    {
+        TEST_ASSERT_EQUAL(i % 2 == 0, st_contains(st, (void *)i));
+    }
+
+    st_destroy(st);
+}
+
+// 测试反复插入删除不会因已删除标记耗尽空间
+void test_st_churn_should_reuse_deleted_slots(void)
+{
+    swiss_table_t *st = st_create(int_hash, int_cmp);
+
+    for (uintptr_t i = 0; i < 100000; i++)
+    {
+        TEST_ASSERT_TRUE(st_put(st, (void *)i, NULL));
+        if (i >= 50)
+        {
+            TEST_ASSERT_TRUE(st_remove(st, (void *)(i - 50), NULL));
+        }
+    }
+    TEST_ASSERT_EQUAL(50, st_size(st));
+    TEST_ASSERT_TRUE(st_capacity(st) <= 256);
+
+    st_destroy(st);
+}
+
+// 测试全部冲突时仍然正确
+void test_st_colliding_keys_should_be_handled(void)
+{
+    swiss_table_t *st = st_create(bad_hash, int_cmp);
+
+    for (uintptr_t i = 1; i <= 300; i++)
+    {
+        st_put(st, (void *)i, (void *)i);
+    }
+    for (uintptr_t i = 1; i <= 300; i += 3)
+    {
+        TEST_ASSERT_TRUE(st_remove(st, (void *)i, NULL));
+    }
+    for (uintptr_t i = 1; i <= 300; i++)
+    {
+        TEST_ASSERT_EQUAL(i % 3 != 1, st_contains(st, (void *)i));
+    }
+
+    st_destroy(st);
+}
+
+// 测试哈希片段过滤掉大部分比较
+void test_st_lookups_should_rarely_call_cmp_on_mismatch(void)
+{
+    swiss_table_t *st = st_create(int_hash, counting_cmp);
+    size_t n = 10000;
+
+    for (uintptr_t i = 0; i < n; i++)
+    {
+        st_put(st, (void *)i, NULL);
+    }
+    cmp_calls = 0;
+    for (uintptr_t i = n; i < 2 * n; i++)
+    {
+        TEST_ASSERT_FALSE(st_contains(st, (void *)i));
+    }
+    // 每组16个控制字，7位片段误匹配概率约1/128，平均每次未命中约0.125次比较
+    TEST_ASSERT_TRUE(cmp_calls < n / 4);
+
+    st_destroy(st);
+}
+
+// 测试预留、清空与遍历
+void test_st_reserve_clear_and_foreach(void)
+{
+    swiss_table_t *st = st_create(int_hash, int_cmp);
+
+    TEST_ASSERT_TRUE(st_reserve(st, 1000));
+    size_t capacity = st_capacity(st);
+    for (uintptr_t i = 1; i <= 1000; i++)
+    {
+        st_put(st, (void *)i, (void *)i);
+    }
+    TEST_ASSERT_EQUAL(capacity, st_capacity(st));
+
+    // 槽数会溢出时预留失败，表保持原样
+    TEST_ASSERT_FALSE(st_reserve(st, SIZE_MAX));
+    TEST_ASSERT_EQUAL(capacity, st_capacity(st));
+    TEST_ASSERT_EQUAL_PTR((void *)7, st_get(st, (void *)7));
+
+    visit_sum = 0;
+    st_foreach(st, visit);
+    TEST_ASSERT_EQUAL(500500, visit_sum);
+
+    st_clear(st);
+    TEST_ASSERT_EQUAL(0, st_size(st));
+    TEST_ASSERT_FALSE(st_contains(st, (void *)1));
+
+    st_destroy(st);
+}
+
+// 测试空指针
+void test_st_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(st_put(NULL, NULL, NULL));
+    TEST_ASSERT_NULL(st_get(NULL, NULL));
+    TEST_ASSERT_FALSE(st_remove(NULL, NULL, NULL));
+    TEST_ASSERT_FALSE(st_reserve(NULL, 1));
+    TEST_ASSERT_EQUAL(0, st_size(NULL));
+    TEST_ASSERT_TRUE(st_is_empty(NULL));
+    st_foreach(NULL, visit);
+    st_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_st_create_should_create_empty_table);
+    RUN_TEST(test_st_put_get_should_store_and_replace_values);
+    RUN_TEST(test_st_many_operations_should_match_expected_contents);
+    RUN_TEST(test_st_churn_should_reuse_deleted_slots);
+    RUN_TEST(test_st_colliding_keys_should_be_handled);
+    RUN_TEST(test_st_lookups_should_rarely_call_cmp_on_mismatch);
+    RUN_TEST(test_st_reserve_clear_and_foreach);
+    RUN_TEST(test_st_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,241 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "queue/timing_wheel.h"
+#include "Unity/src/unity.h"
+
+static timing_wheel_t *wheel;
+static size_t fired_count;
+static size_t late_count;
+
+// 测试前置和后置处理
+void setUp(void)
+{
+    fired_count = 0;
+    late_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+// 记录触发时刻是否与到期时间一致
+static void on_expire(tw_timer_t *timer, void *arg)
+{
+    (void)arg;
+    fired_count++;
+    if (tw_now(wheel) - 1 != timer->expires)
+    {
+        late_count++;
+    }
+}
+
+// 周期定时器：触发后重新调度自身
+static void on_periodic(tw_timer_t *timer, void *arg)
+{
+    size_t *remaining = (size_t *)arg;
+    fired_count++;
+    if (--(*remaining) > 0)
+    {
+        tw_schedule(wheel, timer, timer->expires + 10);
+    }
+}
+
+// 测试创建
+void test_tw_create_should_create_empty_wheel(void)
+{
+    wheel = tw_create(100);
+
+    TEST_ASSERT_NOT_NULL(wheel);
+    TEST_ASSERT_EQUAL(0, tw_size(wheel));
+    TEST_ASSERT_EQUAL_UINT64(100, tw_now(wheel));
+    TEST_ASSERT_EQUAL(0, tw_advance(wheel, 1000000));
+    TEST_ASSERT_EQUAL_UINT64(1000001, tw_now(wheel));
+
+    tw_destroy(wheel);
+}
+
+// 测试定时器按时触发
+void test_tw_advance_should_fire_timers_at_their_tick(void)
+{
+    wheel = tw_create(0);
+    tw_timer_t timers[3];
+
+    tw_timer_init(&timers[0], on_expire, NULL);
+    tw_timer_init(&timers[1], on_expire, NULL);
+    tw_timer_init(&timers[2], on_expire, NULL);
+    tw_schedule(wheel, &timers[0], 5);
+    tw_schedule(wheel, &timers[1], 300);
+    tw_schedule(wheel, &timers[2], 70000);
+    TEST_ASSERT_EQUAL(3, tw_size(wheel));
+    TEST_ASSERT_TRUE(tw_timer_pending(&timers[1]));
+
+    TEST_ASSERT_EQUAL(0, tw_advance(wheel, 4));
+    TEST_ASSERT_EQUAL(1, tw_advance(wheel, 5));
+    TEST_ASSERT_FALSE(tw_timer_pending(&timers[0]));
+    TEST_ASSERT_EQUAL(0, tw_advance(wheel, 299));
+    TEST_ASSERT_EQUAL(1, tw_advance(wheel, 69999));
+    TEST_ASSERT_EQUAL(1, tw_advance(wheel, 70000));
+    TEST_ASSERT_EQUAL(0, tw_size(wheel));
+    TEST_ASSERT_EQUAL(0, late_count);
+
+    tw_destroy(wheel);
+}
+
+// 测试取消与重新调度
+void test_tw_cancel_and_reschedule_should_update_timers(void)
+{
+    wheel = tw_create(0);
+    tw_timer_t a;
+    tw_timer_t b;
+
+    tw_timer_init(&a, on_expire, NULL);
+    tw_timer_init(&b, on_expire, NULL);
+    tw_schedule(wheel, &a, 1000);
+    tw_schedule(wheel, &b, 2000);
+
+    TEST_ASSERT_TRUE(tw_cancel(wheel, &a));
+    TEST_ASSERT_FALSE(tw_cancel(wheel, &a));
+    TEST_ASSERT_TRUE(tw_schedule(wheel, &b, 50));
+    TEST_ASSERT_EQUAL(1, tw_size(wheel));
+
+    TEST_ASSERT_EQUAL(1, tw_advance(wheel, 50));
+    TEST_ASSERT_EQUAL(0, tw_advance(wheel, 5000));
+    TEST_ASSERT_EQUAL(0, late_count);
+
+    tw_destroy(wheel);
+}
+
+// 测试过期时间早于当前时间的定时器在下一个tick触发
+void test_tw_schedule_in_past_should_fire_on_next_tick(void)
+{
+    wheel = tw_create(1000);
+    tw_timer_t timer;
+
+    tw_timer_init(&timer, NULL, NULL);
+    tw_schedule(wheel, &timer, 10);
+    TEST_ASSERT_EQUAL(1, tw_advance(wheel, 1000));
+
+    tw_destroy(wheel);
+}
+
+// 测试回调中重新调度自身
+void test_tw_callback_should_be_able_to_reschedule(void)
+{
+    wheel = tw_create(0);
+    tw_timer_t timer;
+    size_t remaining = 5;
+
+    tw_timer_init(&timer, on_periodic, &remaining);
+    tw_schedule(wheel, &timer, 10);
+
+    TEST_ASSERT_EQUAL(5, tw_advance(wheel, 1000));
+    TEST_ASSERT_EQUAL(0, remaining);
+    TEST_ASSERT_EQUAL(0, tw_size(wheel));
+
+    tw_destroy(wheel);
+}
+
+// 测试大量随机定时器跨层级联后均准时触发
+void test_tw_random_timers_should_fire_exactly_on_time(void)
+{
+    size_t n = 20000;
+    tw_timer_t *timers = malloc(n * sizeof(tw_timer_t));
+    uint32_t seed = 99;
+    uint64_t start = 123456789;
+
+    wheel = tw_create(start);
+    for (size_t i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint64_t delay = (uint64_t)(seed >> 4) % (1u << (4 + (i % 24)));
+        tw_timer_init(&timers[i], on_expire, NULL);
+        tw_schedule(wheel, &timers[i], start + delay);
+    }
+
+    uint64_t now = start;
+    while (tw_size(wheel) > 0)
+    {
+        seed = seed * 1103515245u + 12345u;
+        now += seed % 5000;
+        tw_advance(wheel, now);
+    }
+
+    TEST_ASSERT_EQUAL(n, fired_count);
+    TEST_ASSERT_EQUAL(0, late_count);
+
+    free(timers);
+    tw_destroy(wheel);
+}
+
+// 测试超出时间轮范围的定时器
+void test_tw_timer_beyond_span_should_still_fire(void)
+{
+    wheel = tw_create(0);
+    tw_timer_t timer;
+    uint64_t expires = ((uint64_t)1 << 33) + 17;
+
+    tw_timer_init(&timer, on_expire, NULL);
+    tw_schedule(wheel, &timer, expires);
+
+    TEST_ASSERT_EQUAL(0, tw_advance(wheel, expires - 1));
+    TEST_ASSERT_EQUAL(1, tw_advance(wheel, expires));
+    TEST_ASSERT_EQUAL(0, late_count);
+
+    tw_destroy(wheel);
+}
+
+// 测试批量收集到期定时器
+void test_tw_collect_expired_should_move_timers_to_list(void)
+{
+    wheel = tw_create(0);
+    tw_timer_t timers[10];
+    dl_list_t expired = {NULL, NULL, 0};
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        tw_timer_init(&timers[i], on_expire, NULL);
+        tw_schedule(wheel, &timers[i], i * 100);
+    }
+
+    TEST_ASSERT_EQUAL(5, tw_collect_expired(wheel, 450, &expired));
+    TEST_ASSERT_EQUAL(5, dl_size(&expired));
+    TEST_ASSERT_EQUAL_PTR(&timers[0], dl_get_first(&expired)->data);
+    TEST_ASSERT_EQUAL_PTR(&timers[4], dl_get_last(&expired)->data);
+    TEST_ASSERT_FALSE(tw_timer_pending(&timers[0]));
+    TEST_ASSERT_EQUAL(5, tw_size(wheel));
+    TEST_ASSERT_EQUAL(0, fired_count);
+
+    tw_destroy(wheel);
+}
+
+// 测试空指针
+void test_tw_edge_cases_should_handle_null_inputs(void)
+{
+    tw_timer_t timer;
+
+    tw_timer_init(&timer, NULL, NULL);
+    TEST_ASSERT_FALSE(tw_schedule(NULL, &timer, 1));
+    TEST_ASSERT_FALSE(tw_cancel(NULL, &timer));
+    TEST_ASSERT_EQUAL(0, tw_advance(NULL, 1));
+    TEST_ASSERT_EQUAL(0, tw_size(NULL));
+    TEST_ASSERT_FALSE(tw_timer_pending(NULL));
+    tw_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_tw_create_should_create_empty_wheel);
+    RUN_TEST(test_tw_advance_should_fire_timers_at_their_tick);
+    RUN_TEST(test_tw_cancel_and_reschedule_should_update_timers);
+    RUN_TEST(test_tw_schedule_in_past_should_fire_on_next_tick);
+    RUN_TEST(test_tw_callback_should_be_able_to_reschedule);
+    RUN_TEST(test_tw_random_timers_should_fire_exactly_on_time);
+    RUN_TEST(test_tw_timer_beyond_span_should_still_fire);
+    RUN_TEST(test_tw_collect_expired_should_move_timers_to_list);
+    RUN_TEST(test_tw_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
@@ -0,0 +1,217 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "heap/top_k.h"
+#include "Unity/src/unity.h"
+
+#define ITEM_COUNT 10000
+
+// 测试前置和后置处理
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int int_cmp(void *a, void *b)
+{
+    intptr_t x = (intptr_t)a;
+    intptr_t y = (intptr_t)b;
+    return (x > y) - (x < y);
+}
+
+static int int_cmp_desc(void *a, void *b)
+{
+    return int_cmp(b, a);
+}
+
+static uint32_t next_rand(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+// 测试创建参数
+void test_tk_create_should_validate_arguments(void)
+{
+    top_k_t *tk = tk_create(10, int_cmp);
+
+    TEST_ASSERT_NOT_NULL(tk);
+    TEST_ASSERT_EQUAL(10, tk_k(tk));
+    TEST_ASSERT_EQUAL(0, tk_size(tk));
+    TEST_ASSERT_NULL(tk_threshold(tk));
+    tk_destroy(tk);
+
+    TEST_ASSERT_NULL(tk_create(0, int_cmp));
+    TEST_ASSERT_NULL(tk_create(10, NULL));
+}
+
+// 测试逐个接收：结果为最小的k个且有序
+void test_tk_offer_should_keep_smallest_k(void)
+{
+    top_k_t *tk = tk_create(100, int_cmp);
+    void *out[100];
+
+    // 逆序输入是最坏情况：每个元素都会替换堆顶
+    for (intptr_t i = ITEM_COUNT; i > 0; i--)
+    {
+        tk_offer(tk, (void *)i);
+    }
+    TEST_ASSERT_EQUAL(100, tk_size(tk));
+    TEST_ASSERT_EQUAL(ITEM_COUNT, tk_seen(tk));
+    TEST_ASSERT_EQUAL(100, (intptr_t)tk_threshold(tk));
+
+    TEST_ASSERT_EQUAL(100, tk_result(tk, out));
+    for (intptr_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL(i + 1, (intptr_t)out[i]);
+    }
+
+    // 顺序输入：堆满后全部被阈值拒绝
+    tk_clear(tk);
+    for (intptr_t i = 1; i <= ITEM_COUNT; i++)
+    {
+        tk_offer(tk, (void *)i);
+    }
+    TEST_ASSERT_EQUAL(ITEM_COUNT - 100, tk_rejected(tk));
+    tk_destroy(tk);
+}
+
+// 测试随机数组批量接收与逐个接收结果一致，且与降序比较函数配合取最大的k个
+void test_tk_offer_array_should_match_single(void)
+{
+    void **items = (void **)malloc(ITEM_COUNT * sizeof(void *));
+    uint32_t seed = 3;
+    for (size_t i = 0; i < ITEM_COUNT; i++)
+    {
+        items[i] = (void *)(intptr_t)(next_rand(&seed) % 100000);
+    }
+
+    top_k_t *bulk = tk_create(50, int_cmp_desc);
+    top_k_t *single = tk_create(50, int_cmp_desc);
+    size_t kept = tk_offer_array(bulk, items, ITEM_COUNT);
+    size_t kept_single = 0;
+    for (size_t i = 0; i < ITEM_COUNT; i++)
+    {
+        kept_single += tk_offer(single, items[i]);
+    }
+    TEST_ASSERT_EQUAL(kept_single, kept);
+    TEST_ASSERT_EQUAL(ITEM_COUNT, tk_seen(bulk));
+    TEST_ASSERT_EQUAL(tk_rejected(single), tk_rejected(bulk));
+
+    void *a[50];
+    void *b[50];
+    TEST_ASSERT_EQUAL(50, tk_result(bulk, a));
+    TEST_ASSERT_EQUAL(50, tk_result(single, b));
+    for (size_t i = 0; i < 50; i++)
+    {
+        TEST_ASSERT_EQUAL_PTR(a[i], b[i]);
+        TEST_ASSERT_TRUE(i == 0 || (intptr_t)a[i - 1] >= (intptr_t)a[i]);
+    }
+
+    // 结果中最小的元素不小于所有未保留的元素
+    size_t larger = 0;
+    for (size_t i = 0; i < ITEM_COUNT; i++)
+    {
+        larger += (intptr_t)items[i] > (intptr_t)a[49];
+    }
+    TEST_ASSERT_TRUE(larger < 50);
+
+    tk_destroy(single);
+    tk_destroy(bulk);
+    free(items);
+}
+
+// 测试从链表接收，链表保持不变；元素少于k时全部保留
+void test_tk_offer_lists(void)
+{
+    sl_list_t *sl = sl_create();
+    dl_list_t *dl = dl_create();
+    for (intptr_t i = 0; i < 20; i++)
+    {
+        sl_add_last(sl, sl_node_create((void *)((i * 7) % 20)));
+        dl_add_last(dl, dl_node_create((void *)((i * 3) % 20)));
+    }
+
+    top_k_t *tk = tk_create(5, int_cmp);
+    tk_offer_sl(tk, sl);
+    tk_offer_dl(tk, dl);
+    TEST_ASSERT_EQUAL(40, tk_seen(tk));
+    TEST_ASSERT_EQUAL(20, sl_size(sl));
+    TEST_ASSERT_EQUAL(20, dl_size(dl));
+
+    void *out[5];
+    TEST_ASSERT_EQUAL(5, tk_result(tk, out));
+    static const intptr_t expected[] = {0, 0, 1, 1, 2};
+    for (size_t i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL(expected[i], (intptr_t)out[i]);
+    }
+    tk_destroy(tk);
+
+    tk = tk_create(100, int_cmp);
+    TEST_ASSERT_EQUAL(20, tk_offer_sl(tk, sl));
+    TEST_ASSERT_NULL(tk_threshold(tk));
+    void *all[100];
+    TEST_ASSERT_EQUAL(20, tk_result(tk, all));
+    for (intptr_t i = 0; i < 20; i++)
+    {
+        TEST_ASSERT_EQUAL(i, (intptr_t)all[i]);
+    }
+    tk_destroy(tk);
+
+    dl_destroy(dl);
+    sl_destroy(sl);
+}
+
+// 测试取结果后仍可继续接收
+void test_tk_result_should_not_consume(void)
+{
+    top_k_t *tk = tk_create(3, int_cmp);
+    void *out[3];
+
+    tk_offer(tk, (void *)(intptr_t)5);
+    tk_offer(tk, (void *)(intptr_t)9);
+    tk_offer(tk, (void *)(intptr_t)7);
+    TEST_ASSERT_EQUAL(3, tk_result(tk, out));
+    TEST_ASSERT_EQUAL(3, tk_size(tk));
+
+    TEST_ASSERT_TRUE(tk_offer(tk, (void *)(intptr_t)1));
+    TEST_ASSERT_FALSE(tk_offer(tk, (void *)(intptr_t)7));
+    tk_result(tk, out);
+    TEST_ASSERT_EQUAL(1, (intptr_t)out[0]);
+    TEST_ASSERT_EQUAL(5, (intptr_t)out[1]);
+    TEST_ASSERT_EQUAL(7, (intptr_t)out[2]);
+    tk_destroy(tk);
+}
+
+// 测试空指针
+void test_tk_edge_cases_should_handle_null_inputs(void)
+{
+    TEST_ASSERT_FALSE(tk_offer(NULL, NULL));
+    TEST_ASSERT_EQUAL(0, tk_offer_array(NULL, NULL, 0));
+    TEST_ASSERT_EQUAL(0, tk_offer_sl(NULL, NULL));
+    TEST_ASSERT_EQUAL(0, tk_offer_dl(NULL, NULL));
+    TEST_ASSERT_NULL(tk_threshold(NULL));
+    TEST_ASSERT_EQUAL(0, tk_result(NULL, NULL));
+    TEST_ASSERT_EQUAL(0, tk_size(NULL));
+    TEST_ASSERT_EQUAL(0, tk_seen(NULL));
+    tk_clear(NULL);
+    tk_destroy(NULL);
+}
+
+// 测试运行器
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_tk_create_should_validate_arguments);
+    RUN_TEST(test_tk_offer_should_keep_smallest_k);
+    RUN_TEST(test_tk_offer_array_should_match_single);
+    RUN_TEST(test_tk_offer_lists);
+    RUN_TEST(test_tk_result_should_not_consume);
+    RUN_TEST(test_tk_edge_cases_should_handle_null_inputs);
+
+    return UNITY_END();
+}
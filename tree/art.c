@@ -0,0 +1,1052 @@
+#include "art.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ART_USE_SSE2 1
+#else
+#define ART_USE_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 子节点指针的最低位标记叶节点（malloc返回的地址至少按8字节对齐）
+#define ART_IS_LEAF(p) (((uintptr_t)(p) & 1) != 0)
+#define ART_LEAF(p) ((art_leaf_t *)((uintptr_t)(p) & ~(uintptr_t)1))
+#define ART_TAG(l) ((void *)((uintptr_t)(l) | 1))
+
+// 删除后收缩的阈值，比增长阈值低一些，避免在边界上反复增长和收缩
+#define ART_SHRINK16 3
+#define ART_SHRINK48 12
+#define ART_SHRINK256 37
+
+#if ART_USE_SSE2
+static unsigned art_ctz(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+static size_t art_min(size_t a, size_t b)
+{
+    return a < b ? a : b;
+}
+
+static art_leaf_t *art_make_leaf(const unsigned char *key, size_t len, void *value)
+{
+    art_leaf_t *leaf = (art_leaf_t *)malloc(sizeof(art_leaf_t) + len);
+    if (leaf == NULL)
+    {
+        return NULL;
+    }
+    leaf->value = value;
+    leaf->len = len;
+    memcpy(leaf->key, key, len);
+    return leaf;
+}
+
+// 空键允许传NULL，统一换成空串，避免对NULL调用memcmp
+static const unsigned char *art_bytes(const void *key)
+{
+    return key != NULL ? (const unsigned char *)key : (const unsigned char *)"";
+}
+
+static bool art_leaf_matches(const art_leaf_t *leaf, const unsigned char *key, size_t len)
+{
+    return leaf->len == len && memcmp(leaf->key, key, len) == 0;
+}
+
+// 叶节点的键是否为key的前缀
+static bool art_leaf_is_prefix(const art_leaf_t *leaf, const unsigned char *key, size_t len)
+{
+    return leaf->len <= len && memcmp(leaf->key, key, leaf->len) == 0;
+}
+
+static art_node_t *art_alloc_node(art_node_type_t type)
+{
+    static const size_t sizes[] = {sizeof(art_node4_t), sizeof(art_node16_t), sizeof(art_node48_t),
+                                   sizeof(art_node256_t)};
+    art_node_t *node = (art_node_t *)calloc(1, sizes[type]);
+    if (node != NULL)
+    {
+        node->type = (uint8_t)type;
+    }
+    return node;
+}
+
+// 复制节点头（不含类型）
+static void art_copy_header(art_node_t *dst, const art_node_t *src)
+{
+    dst->num_children = src->num_children;
+    dst->prefix_len = src->prefix_len;
+    memcpy(dst->prefix, src->prefix, art_min(src->prefix_len, ART_MAX_PREFIX));
+    dst->leaf = src->leaf;
+}
+
+// Node16中等于c的位置，不存在返回-1
+static int art_node16_index(const art_node16_t *n, unsigned char c)
+{
+#if ART_USE_SSE2
+    __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)c), _mm_loadu_si128((const __m128i *)n->keys));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(cmp) & ((1u << n->base.num_children) - 1);
+    return mask != 0 ? (int)art_ctz(mask) : -1;
+#else
+    for (int i = 0; i < n->base.num_children; i++)
+    {
+        if (n->keys[i] == c)
+        {
+            return i;
+        }
+    }
+    return -1;
+#endif
+}
+
+// 查找字节c对应的子节点槽，不存在返回NULL
+static void **art_find_child(art_node_t *node, unsigned char c)
+{
+    switch (node->type)
+    {
+    case ART_NODE4:
+    {
+        art_node4_t *n = (art_node4_t *)node;
+        for (int i = 0; i < node->num_children; i++)
+        {
+            if (n->keys[i] == c)
+            {
+                return &n->children[i];
+            }
+        }
+        return NULL;
+    }
+    case ART_NODE16:
+    {
+        art_node16_t *n = (art_node16_t *)node;
+        int i = art_node16_index(n, c);
+        return i >= 0 ? &n->children[i] : NULL;
+    }
+    case ART_NODE48:
+    {
+        art_node48_t *n = (art_node48_t *)node;
+        return n->index[c] != 0 ? &n->children[n->index[c] - 1] : NULL;
+    }
+    default:
+    {
+        art_node256_t *n = (art_node256_t *)node;
+        return n->children[c] != NULL ? &n->children[c] : NULL;
+    }
+    }
+}
+
+// 子树中最小的叶节点：恰好在节点结束的键排在所有更长的键之前
+static art_leaf_t *art_minimum(const void *p)
+{
+    while (!ART_IS_LEAF(p))
+    {
+        const art_node_t *node = (const art_node_t *)p;
+        if (node->leaf != NULL)
+        {
+            return node->leaf;
+        }
+        switch (node->type)
+        {
+        case ART_NODE4:
+            p = ((const art_node4_t *)node)->children[0];
+            break;
+        case ART_NODE16:
+            p = ((const art_node16_t *)node)->children[0];
+            break;
+        case ART_NODE48:
+        {
+            const art_node48_t *n = (const art_node48_t *)node;
+            int c = 0;
+            while (n->index[c] == 0)
+            {
+                c++;
+            }
+            p = n->children[n->index[c] - 1];
+            break;
+        }
+        default:
+        {
+            const art_node256_t *n = (const art_node256_t *)node;
+            int c = 0;
+            while (n->children[c] == NULL)
+            {
+                c++;
+            }
+            p = n->children[c];
+            break;
+        }
+        }
+    }
+    return ART_LEAF(p);
+}
+
+// 节点前缀与key从depth开始的第一个不同位置，key提前结束也算不同；
+// 超过ART_MAX_PREFIX的部分与子树中任一叶节点的完整键比较
+static size_t art_prefix_mismatch(const art_node_t *node, const unsigned char *key, size_t len, size_t depth)
+{
+    size_t stored = art_min(node->prefix_len, ART_MAX_PREFIX);
+    size_t i;
+    for (i = 0; i < stored; i++)
+    {
+        if (depth + i >= len || node->prefix[i] != key[depth + i])
+        {
+            return i;
+        }
+    }
+    if (node->prefix_len > ART_MAX_PREFIX)
+    {
+        const art_leaf_t *leaf = art_minimum(node);
+        for (; i < node->prefix_len; i++)
+        {
+            if (depth + i >= len || leaf->key[depth + i] != key[depth + i])
+            {
+                return i;
+            }
+        }
+    }
+    return i;
+}
+
+// 把已满的节点内容搬到更大类型的grown中，通过ref替换并释放原节点
+static void art_grow(art_node_t *node, art_node_t *grown, void **ref)
+{
+    art_copy_header(grown, node);
+    switch (node->type)
+    {
+    case ART_NODE4:
+    {
+        art_node4_t *n = (art_node4_t *)node;
+        art_node16_t *g = (art_node16_t *)grown;
+        memcpy(g->keys, n->keys, 4);
+        memcpy(g->children, n->children, 4 * sizeof(void *));
+        break;
+    }
+    case ART_NODE16:
+    {
+        art_node16_t *n = (art_node16_t *)node;
+        art_node48_t *g = (art_node48_t *)grown;
+        for (int i = 0; i < 16; i++)
+        {
+            g->children[i] = n->children[i];
+            g->index[n->keys[i]] = (unsigned char)(i + 1);
+        }
+        break;
+    }
+    default:
+    {
+        art_node48_t *n = (art_node48_t *)node;
+        art_node256_t *g = (art_node256_t *)grown;
+        for (int c = 0; c < 256; c++)
+        {
+            if (n->index[c] != 0)
+            {
+                g->children[c] = n->children[n->index[c] - 1];
+            }
+        }
+        break;
+    }
+    }
+    *ref = grown;
+    free(node);
+}
+
+// 在有序的keys/children数组中插入
+static void art_insert_sorted(unsigned char *keys, void **children, int count, unsigned char c, void *child)
+{
+    int pos = 0;
+    while (pos < count && keys[pos] < c)
+    {
+        pos++;
+    }
+    memmove(keys + pos + 1, keys + pos, (size_t)(count - pos));
+    memmove(children + pos + 1, children + pos, (size_t)(count - pos) * sizeof(void *));
+    keys[pos] = c;
+    children[pos] = child;
+}
+
+// 加入子节点，调用前节点须有空位
+static void art_add_child(art_node_t *node, unsigned char c, void *child)
+{
+    switch (node->type)
+    {
+    case ART_NODE4:
+        art_insert_sorted(((art_node4_t *)node)->keys, ((art_node4_t *)node)->children, node->num_children, c, child);
+        break;
+    case ART_NODE16:
+        art_insert_sorted(((art_node16_t *)node)->keys, ((art_node16_t *)node)->children, node->num_children, c, child);
+        break;
+    case ART_NODE48:
+    {
+        // 删除会在children中留下空洞，取第一个空槽
+        art_node48_t *n = (art_node48_t *)node;
+        int slot = 0;
+        while (n->children[slot] != NULL)
+        {
+            slot++;
+        }
+        n->children[slot] = child;
+        n->index[c] = (unsigned char)(slot + 1);
+        break;
+    }
+    default:
+        ((art_node256_t *)node)->children[c] = child;
+        break;
+    }
+    node->num_children++;
+}
+
+// 节点已满、加入子节点前需要换成的更大类型，不需要增长时返回-1
+static int art_grow_type(const art_node_t *node)
+{
+    static const int capacity[] = {4, 16, 48, 256};
+    if (node->type == ART_NODE256 || node->num_children < capacity[node->type])
+    {
+        return -1;
+    }
+    return node->type + 1;
+}
+
+// 在以*ref为根的子树中插入，depth为已消耗的字节数；内存不足返回false且树不变
+static bool art_insert(art_tree_t *art, void **ref, const unsigned char *key, size_t len, size_t depth, void *value)
+{
+    for (;;)
+    {
+        void *p = *ref;
+        if (p == NULL)
+        {
+            art_leaf_t *leaf = art_make_leaf(key, len, value);
+            if (leaf == NULL)
+            {
+                return false;
+            }
+            *ref = ART_TAG(leaf);
+            art->size++;
+            return true;
+        }
+
+        if (ART_IS_LEAF(p))
+        {
+            art_leaf_t *old = ART_LEAF(p);
+            if (art_leaf_matches(old, key, len))
+            {
+                old->value = value;
+                return true;
+            }
+            // 两个键从depth开始的公共部分成为新Node4的前缀
+            size_t limit = art_min(old->len, len);
+            size_t common = depth;
+            while (common < limit && old->key[common] == key[common])
+            {
+                common++;
+            }
+            art_node4_t *split = (art_node4_t *)art_alloc_node(ART_NODE4);
+            art_leaf_t *leaf = art_make_leaf(key, len, value);
+            if (split == NULL || leaf == NULL)
+            {
+                free(split);
+                free(leaf);
+                return false;
+            }
+            split->base.prefix_len = (uint32_t)(common - depth);
+            memcpy(split->base.prefix, key + depth, art_min(common - depth, ART_MAX_PREFIX));
+            if (old->len == common)
+            {
+                split->base.leaf = old;
+            }
+            else
+            {
+                art_add_child(&split->base, old->key[common], p);
+            }
+            if (len == common)
+            {
+                split->base.leaf = leaf;
+            }
+            else
+            {
+                art_add_child(&split->base, key[common], ART_TAG(leaf));
+            }
+            *ref = split;
+            art->size++;
+            return true;
+        }
+
+        art_node_t *node = (art_node_t *)p;
+        if (node->prefix_len > 0)
+        {
+            size_t diff = art_prefix_mismatch(node, key, len, depth);
+            if (diff < node->prefix_len)
+            {
+                // 前缀在diff处分叉：新Node4保存公共部分，原节点去掉diff+1个字节后挂到其下
+                art_node4_t *split = (art_node4_t *)art_alloc_node(ART_NODE4);
+                art_leaf_t *leaf = art_make_leaf(key, len, value);
+                if (split == NULL || leaf == NULL)
+                {
+                    free(split);
+                    free(leaf);
+                    return false;
+                }
+                split->base.prefix_len = (uint32_t)diff;
+                memcpy(split->base.prefix, node->prefix, art_min(diff, ART_MAX_PREFIX));
+                if (node->prefix_len <= ART_MAX_PREFIX)
+                {
+                    art_add_child(&split->base, node->prefix[diff], node);
+                    node->prefix_len -= (uint32_t)(diff + 1);
+                    memmove(node->prefix, node->prefix + diff + 1, node->prefix_len);
+                }
+                else
+                {
+                    const art_leaf_t *min = art_minimum(node);
+                    art_add_child(&split->base, min->key[depth + diff], node);
+                    node->prefix_len -= (uint32_t)(diff + 1);
+                    memcpy(node->prefix, min->key + depth + diff + 1, art_min(node->prefix_len, ART_MAX_PREFIX));
+                }
+                if (depth + diff == len)
+                {
+                    split->base.leaf = leaf;
+                }
+                else
+                {
+                    art_add_child(&split->base, key[depth + diff], ART_TAG(leaf));
+                }
+                *ref = split;
+                art->size++;
+                return true;
+            }
+            depth += node->prefix_len;
+        }
+
+        if (depth == len)
+        {
+            if (node->leaf != NULL)
+            {
+                node->leaf->value = value;
+                return true;
+            }
+            node->leaf = art_make_leaf(key, len, value);
+            if (node->leaf == NULL)
+            {
+                return false;
+            }
+            art->size++;
+            return true;
+        }
+
+        void **child = art_find_child(node, key[depth]);
+        if (child != NULL)
+        {
+            ref = child;
+            depth++;
+            continue;
+        }
+
+        // 先分配好叶节点和增长后的节点，再修改树
+        art_leaf_t *leaf = art_make_leaf(key, len, value);
+        if (leaf == NULL)
+        {
+            return false;
+        }
+        int grow = art_grow_type(node);
+        if (grow >= 0)
+        {
+            art_node_t *grown = art_alloc_node((art_node_type_t)grow);
+            if (grown == NULL)
+            {
+                free(leaf);
+                return false;
+            }
+            art_grow(node, grown, ref);
+            node = grown;
+        }
+        art_add_child(node, key[depth], ART_TAG(leaf));
+        art->size++;
+        return true;
+    }
+}
+
+// 把只剩一个子节点、且没有自身键的Node4并入该子节点
+static void art_collapse(art_node4_t *n, void **ref)
+{
+    void *child = n->children[0];
+    if (!ART_IS_LEAF(child))
+    {
+        art_node_t *c = (art_node_t *)child;
+        // 新前缀 = 本节点前缀 + 分支字节 + 子节点前缀
+        unsigned char prefix[ART_MAX_PREFIX];
+        size_t stored = art_min(n->base.prefix_len, ART_MAX_PREFIX);
+        memcpy(prefix, n->base.prefix, stored);
+        if (stored < ART_MAX_PREFIX)
+        {
+            prefix[stored++] = n->keys[0];
+        }
+        if (stored < ART_MAX_PREFIX)
+        {
+            size_t extra = art_min(c->prefix_len, ART_MAX_PREFIX - stored);
+            memcpy(prefix + stored, c->prefix, extra);
+            stored += extra;
+        }
+        c->prefix_len += n->base.prefix_len + 1;
+        memcpy(c->prefix, prefix, stored);
+    }
+    *ref = child;
+    free(n);
+}
+
+// 删除子节点或自身键后调整节点：空节点换成自身键的叶节点，过稀的节点收缩成更小的类型
+static void art_shrink(art_node_t *node, void **ref)
+{
+    if (node->num_children == 0)
+    {
+        *ref = node->leaf != NULL ? ART_TAG(node->leaf) : NULL;
+        free(node);
+        return;
+    }
+    switch (node->type)
+    {
+    case ART_NODE4:
+        if (node->num_children == 1 && node->leaf == NULL)
+        {
+            art_collapse((art_node4_t *)node, ref);
+        }
+        break;
+    case ART_NODE16:
+        if (node->num_children <= ART_SHRINK16)
+        {
+            art_node16_t *n = (art_node16_t *)node;
+            art_node4_t *small = (art_node4_t *)art_alloc_node(ART_NODE4);
+            if (small == NULL)
+            {
+                return;
+            }
+            art_copy_header(&small->base, node);
+            memcpy(small->keys, n->keys, node->num_children);
+            memcpy(small->children, n->children, node->num_children * sizeof(void *));
+            *ref = small;
+            free(n);
+        }
+        break;
+    case ART_NODE48:
+        if (node->num_children <= ART_SHRINK48)
+        {
+            art_node48_t *n = (art_node48_t *)node;
+            art_node16_t *small = (art_node16_t *)art_alloc_node(ART_NODE16);
+            if (small == NULL)
+            {
+                return;
+            }
+            art_copy_header(&small->base, node);
+            int count = 0;
+            for (int c = 0; c < 256; c++)
+            {
+                if (n->index[c] != 0)
+                {
+                    small->keys[count] = (unsigned char)c;
+                    small->children[count++] = n->children[n->index[c] - 1];
+                }
+            }
+            *ref = small;
+            free(n);
+        }
+        break;
+    default:
+        if (node->num_children <= ART_SHRINK256)
+        {
+            art_node256_t *n = (art_node256_t *)node;
+            art_node48_t *small = (art_node48_t *)art_alloc_node(ART_NODE48);
+            if (small == NULL)
+            {
+                return;
+            }
+            art_copy_header(&small->base, node);
+            int count = 0;
+            for (int c = 0; c < 256; c++)
+            {
+                if (n->children[c] != NULL)
+                {
+                    small->children[count] = n->children[c];
+                    small->index[c] = (unsigned char)(++count);
+                }
+            }
+            *ref = small;
+            free(n);
+        }
+        break;
+    }
+}
+
+static void art_remove_child(art_node_t *node, unsigned char c, void **slot)
+{
+    switch (node->type)
+    {
+    case ART_NODE4:
+    {
+        art_node4_t *n = (art_node4_t *)node;
+        int pos = (int)(slot - n->children);
+        memmove(n->keys + pos, n->keys + pos + 1, (size_t)(node->num_children - pos - 1));
+        memmove(n->children + pos, n->children + pos + 1, (size_t)(node->num_children - pos - 1) * sizeof(void *));
+        break;
+    }
+    case ART_NODE16:
+    {
+        art_node16_t *n = (art_node16_t *)node;
+        int pos = (int)(slot - n->children);
+        memmove(n->keys + pos, n->keys + pos + 1, (size_t)(node->num_children - pos - 1));
+        memmove(n->children + pos, n->children + pos + 1, (size_t)(node->num_children - pos - 1) * sizeof(void *));
+        break;
+    }
+    case ART_NODE48:
+    {
+        art_node48_t *n = (art_node48_t *)node;
+        n->index[c] = 0;
+        *slot = NULL;
+        break;
+    }
+    default:
+        *slot = NULL;
+        break;
+    }
+    node->num_children--;
+}
+
+// 从以*ref为根的子树中删除key，返回被删除的叶节点，不存在返回NULL
+static art_leaf_t *art_delete(void **ref, const unsigned char *key, size_t len, size_t depth)
+{
+    void *p = *ref;
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    if (ART_IS_LEAF(p))
+    {
+        art_leaf_t *leaf = ART_LEAF(p);
+        if (!art_leaf_matches(leaf, key, len))
+        {
+            return NULL;
+        }
+        *ref = NULL;
+        return leaf;
+    }
+
+    art_node_t *node = (art_node_t *)p;
+    if (node->prefix_len > 0)
+    {
+        if (art_prefix_mismatch(node, key, len, depth) != node->prefix_len)
+        {
+            return NULL;
+        }
+        depth += node->prefix_len;
+    }
+
+    if (depth == len)
+    {
+        art_leaf_t *leaf = node->leaf;
+        if (leaf == NULL)
+        {
+            return NULL;
+        }
+        node->leaf = NULL;
+        art_shrink(node, ref);
+        return leaf;
+    }
+
+    void **child = art_find_child(node, key[depth]);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+    if (ART_IS_LEAF(*child))
+    {
+        art_leaf_t *leaf = ART_LEAF(*child);
+        if (!art_leaf_matches(leaf, key, len))
+        {
+            return NULL;
+        }
+        art_remove_child(node, key[depth], child);
+        art_shrink(node, ref);
+        return leaf;
+    }
+    return art_delete(child, key, len, depth + 1);
+}
+
+static void art_free_node(void *p)
+{
+    if (p == NULL)
+    {
+        return;
+    }
+    if (ART_IS_LEAF(p))
+    {
+        free(ART_LEAF(p));
+        return;
+    }
+    art_node_t *node = (art_node_t *)p;
+    switch (node->type)
+    {
+    case ART_NODE4:
+        for (int i = 0; i < node->num_children; i++)
+        {
+            art_free_node(((art_node4_t *)node)->children[i]);
+        }
+        break;
+    case ART_NODE16:
+        for (int i = 0; i < node->num_children; i++)
+        {
+            art_free_node(((art_node16_t *)node)->children[i]);
+        }
+        break;
+    case ART_NODE48:
+        for (int i = 0; i < 48; i++)
+        {
+            art_free_node(((art_node48_t *)node)->children[i]);
+        }
+        break;
+    default:
+        for (int i = 0; i < 256; i++)
+        {
+            art_free_node(((art_node256_t *)node)->children[i]);
+        }
+        break;
+    }
+    free(node->leaf);
+    free(node);
+}
+
+// 按字典序访问子树中的每个键，func返回false时停止，返回是否继续
+static bool art_walk(const void *p, art_visit_fn func, void *arg, size_t *count)
+{
+    if (ART_IS_LEAF(p))
+    {
+        const art_leaf_t *leaf = ART_LEAF(p);
+        (*count)++;
+        return func(leaf->key, leaf->len, leaf->value, arg);
+    }
+    const art_node_t *node = (const art_node_t *)p;
+    if (node->leaf != NULL)
+    {
+        (*count)++;
+        if (!func(node->leaf->key, node->leaf->len, node->leaf->value, arg))
+        {
+            return false;
+        }
+    }
+    switch (node->type)
+    {
+    case ART_NODE4:
+        for (int i = 0; i < node->num_children; i++)
+        {
+            if (!art_walk(((const art_node4_t *)node)->children[i], func, arg, count))
+            {
+                return false;
+            }
+        }
+        break;
+    case ART_NODE16:
+        for (int i = 0; i < node->num_children; i++)
+        {
+            if (!art_walk(((const art_node16_t *)node)->children[i], func, arg, count))
+            {
+                return false;
+            }
+        }
+        break;
+    case ART_NODE48:
+    {
+        const art_node48_t *n = (const art_node48_t *)node;
+        for (int c = 0; c < 256; c++)
+        {
+            if (n->index[c] != 0 && !art_walk(n->children[n->index[c] - 1], func, arg, count))
+            {
+                return false;
+            }
+        }
+        break;
+    }
+    default:
+    {
+        const art_node256_t *n = (const art_node256_t *)node;
+        for (int c = 0; c < 256; c++)
+        {
+            if (n->children[c] != NULL && !art_walk(n->children[c], func, arg, count))
+            {
+                return false;
+            }
+        }
+        break;
+    }
+    }
+    return true;
+}
+
+// 创建自适应基数树
+art_tree_t *art_create(void)
+{
+    return (art_tree_t *)calloc(1, sizeof(art_tree_t));
+}
+
+// 销毁自适应基数树（不释放值本身）
+void art_destroy(art_tree_t *art)
+{
+    if (art == NULL)
+    {
+        return;
+    }
+    art_free_node(art->root);
+    free(art);
+}
+
+// 清空自适应基数树（不释放值本身）
+void art_clear(art_tree_t *art)
+{
+    if (art == NULL)
+    {
+        return;
+    }
+    art_free_node(art->root);
+    art->root = NULL;
+    art->size = 0;
+}
+
+// 获取键数
+size_t art_size(art_tree_t *art)
+{
+    if (art == NULL)
+    {
+        return 0;
+    }
+    return art->size;
+}
+
+// 判断是否为空
+bool art_is_empty(art_tree_t *art)
+{
+    return art_size(art) == 0;
+}
+
+// 插入或更新键值对，键被复制；内存不足返回false且树不变
+bool art_put(art_tree_t *art, const void *key, size_t len, void *value)
+{
+    if (art == NULL || (key == NULL && len > 0))
+    {
+        return false;
+    }
+    return art_insert(art, &art->root, art_bytes(key), len, 0, value);
+}
+
+// 精确查找键对应的叶节点：路径上只比较节点中保存的前缀字节，最后与叶节点的完整键核对
+static art_leaf_t *art_search(art_tree_t *art, const unsigned char *key, size_t len)
+{
+    const void *p = art->root;
+    size_t depth = 0;
+    while (p != NULL)
+    {
+        if (ART_IS_LEAF(p))
+        {
+            art_leaf_t *leaf = ART_LEAF(p);
+            return art_leaf_matches(leaf, key, len) ? leaf : NULL;
+        }
+        art_node_t *node = (art_node_t *)p;
+        if (node->prefix_len > 0)
+        {
+            if (depth + node->prefix_len > len ||
+                memcmp(node->prefix, key + depth, art_min(node->prefix_len, ART_MAX_PREFIX)) != 0)
+            {
+                return NULL;
+            }
+            depth += node->prefix_len;
+        }
+        if (depth == len)
+        {
+            return node->leaf != NULL && art_leaf_matches(node->leaf, key, len) ? node->leaf : NULL;
+        }
+        void **child = art_find_child(node, key[depth]);
+        p = child != NULL ? *child : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+// 查找键对应的值，不存在返回NULL
+void *art_get(art_tree_t *art, const void *key, size_t len)
+{
+    void *value = NULL;
+    art_find(art, key, len, &value);
+    return value;
+}
+
+// 查找键，存在时通过value返回值（可为NULL）
+bool art_find(art_tree_t *art, const void *key, size_t len, void **value)
+{
+    if (art == NULL || (key == NULL && len > 0))
+    {
+        return false;
+    }
+    art_leaf_t *leaf = art_search(art, art_bytes(key), len);
+    if (leaf == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = leaf->value;
+    }
+    return true;
+}
+
+// 删除键，存在时通过value返回原值（可为NULL）
+bool art_remove(art_tree_t *art, const void *key, size_t len, void **value)
+{
+    if (art == NULL || (key == NULL && len > 0))
+    {
+        return false;
+    }
+    art_leaf_t *leaf = art_delete(&art->root, art_bytes(key), len, 0);
+    if (leaf == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = leaf->value;
+    }
+    free(leaf);
+    art->size--;
+    return true;
+}
+
+// 最长前缀匹配：在已保存的键中找出是key前缀的最长者，适合路由表按路径查找处理函数
+// 这样的键都位于key的查找路径上，路径上的候选逐个与完整键核对，不需要回溯
+bool art_longest_prefix(art_tree_t *art, const void *key, size_t len, size_t *match_len, void **value)
+{
+    if (art == NULL || (key == NULL && len > 0))
+    {
+        return false;
+    }
+    const unsigned char *bytes = art_bytes(key);
+    const art_leaf_t *best = NULL;
+    const void *p = art->root;
+    size_t depth = 0;
+    while (p != NULL)
+    {
+        if (ART_IS_LEAF(p))
+        {
+            if (art_leaf_is_prefix(ART_LEAF(p), bytes, len))
+            {
+                best = ART_LEAF(p);
+            }
+            break;
+        }
+        const art_node_t *node = (const art_node_t *)p;
+        if (node->prefix_len > 0)
+        {
+            if (depth + node->prefix_len > len ||
+                memcmp(node->prefix, bytes + depth, art_min(node->prefix_len, ART_MAX_PREFIX)) != 0)
+            {
+                break;
+            }
+            depth += node->prefix_len;
+        }
+        if (node->leaf != NULL && art_leaf_is_prefix(node->leaf, bytes, len))
+        {
+            best = node->leaf;
+        }
+        if (depth == len)
+        {
+            break;
+        }
+        void **child = art_find_child((art_node_t *)node, bytes[depth]);
+        p = child != NULL ? *child : NULL;
+        depth++;
+    }
+    if (best == NULL)
+    {
+        return false;
+    }
+    if (match_len != NULL)
+    {
+        *match_len = best->len;
+    }
+    if (value != NULL)
+    {
+        *value = best->value;
+    }
+    return true;
+}
+
+// 按字典序访问以prefix开头的所有键（len为0时访问全部），func返回false时停止；返回访问的键数
+size_t art_scan_prefix(art_tree_t *art, const void *prefix, size_t len, art_visit_fn func, void *arg)
+{
+    if (art == NULL || func == NULL || (prefix == NULL && len > 0))
+    {
+        return 0;
+    }
+    const unsigned char *bytes = art_bytes(prefix);
+    const void *p = art->root;
+    size_t depth = 0;
+    size_t count = 0;
+    while (p != NULL)
+    {
+        if (ART_IS_LEAF(p))
+        {
+            const art_leaf_t *leaf = ART_LEAF(p);
+            if (leaf->len >= len && memcmp(leaf->key, bytes, len) == 0)
+            {
+                count++;
+                func(leaf->key, leaf->len, leaf->value, arg);
+            }
+            return count;
+        }
+        const art_node_t *node = (const art_node_t *)p;
+        if (node->prefix_len > 0)
+        {
+            size_t diff = art_prefix_mismatch(node, bytes, len, depth);
+            if (diff < node->prefix_len)
+            {
+                // prefix在节点前缀中途结束时整棵子树都匹配，否则没有匹配
+                if (depth + diff == len)
+                {
+                    art_walk(p, func, arg, &count);
+                }
+                return count;
+            }
+            depth += node->prefix_len;
+        }
+        if (depth == len)
+        {
+            art_walk(p, func, arg, &count);
+            return count;
+        }
+        void **child = art_find_child((art_node_t *)node, bytes[depth]);
+        p = child != NULL ? *child : NULL;
+        depth++;
+    }
+    return count;
+}
+
+static bool art_foreach_visit(const unsigned char *key, size_t len, void *value, void *arg)
+{
+    void (*func)(const unsigned char *, size_t, void *) = *(void (**)(const unsigned char *, size_t, void *))arg;
+    func(key, len, value);
+    return true;
+}
+
+// 按字典序遍历所有键值对
+void art_foreach(art_tree_t *art, void (*func)(const unsigned char *key, size_t len, void *value))
+{
+    if (art == NULL || func == NULL || art->root == NULL)
+    {
+        return;
+    }
+    size_t count = 0;
+    art_walk(art->root, art_foreach_visit, &func, &count);
+}
@@ -0,0 +1,92 @@
+#ifndef __ART_H__
+#define __ART_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 内部节点中保存的压缩路径的最大字节数，更长的部分从子树中任一叶节点的完整键读取
+#define ART_MAX_PREFIX 10
+
+// 自适应基数树（ART）
+// 以任意字节串为键，按字节的字典序排列，比较逐字节进行，不需要每层整键比较。
+// 内部节点按子节点数在Node4/16/48/256之间自动增长和收缩，Node16用SSE2一次比较16个字节；
+// 只有一个子节点的路径被压缩进节点前缀。键可以是另一个键的前缀（如"/a"与"/a/b"），
+// 恰好在某个内部节点结束的键挂在该节点的leaf上。
+// 叶节点复制保存完整的键，值为void *，不复制、不释放值。
+typedef enum art_node_type
+{
+    ART_NODE4,
+    ART_NODE16,
+    ART_NODE48,
+    ART_NODE256
+} art_node_type_t;
+
+typedef struct art_leaf
+{
+    void *value;
+    size_t len;
+    unsigned char key[];
+} art_leaf_t;
+
+// 子节点指针最低位为1时指向叶节点
+typedef struct art_node
+{
+    uint8_t type;
+    uint16_t num_children;
+    uint32_t prefix_len;                    // 压缩路径的完整长度
+    unsigned char prefix[ART_MAX_PREFIX];   // 压缩路径的前ART_MAX_PREFIX个字节
+    art_leaf_t *leaf;                       // 恰好在此节点结束的键
+} art_node_t;
+
+typedef struct art_node4
+{
+    art_node_t base;
+    unsigned char keys[4];      // 有序
+    void *children[4];
+} art_node4_t;
+
+typedef struct art_node16
+{
+    art_node_t base;
+    unsigned char keys[16];     // 有序
+    void *children[16];
+} art_node16_t;
+
+typedef struct art_node48
+{
+    art_node_t base;
+    unsigned char index[256];   // 字节到children的下标+1，0表示没有
+    void *children[48];
+} art_node48_t;
+
+typedef struct art_node256
+{
+    art_node_t base;
+    void *children[256];
+} art_node256_t;
+
+typedef struct art_tree
+{
+    void *root;
+    size_t size;
+} art_tree_t;
+
+typedef bool (*art_visit_fn)(const unsigned char *key, size_t len, void *value, void *arg);
+
+art_tree_t *art_create(void);
+void art_destroy(art_tree_t *art);
+void art_clear(art_tree_t *art);
+size_t art_size(art_tree_t *art);
+bool art_is_empty(art_tree_t *art);
+
+bool art_put(art_tree_t *art, const void *key, size_t len, void *value);
+void *art_get(art_tree_t *art, const void *key, size_t len);
+bool art_find(art_tree_t *art, const void *key, size_t len, void **value);
+bool art_remove(art_tree_t *art, const void *key, size_t len, void **value);
+bool art_longest_prefix(art_tree_t *art, const void *key, size_t len, size_t *match_len, void **value);
+
+size_t art_scan_prefix(art_tree_t *art, const void *prefix, size_t len, art_visit_fn func, void *arg);
+void art_foreach(art_tree_t *art, void (*func)(const unsigned char *key, size_t len, void *value));
+
+#endif // __ART_H__
@@ -0,0 +1,946 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "bplus_tree.h"
+#include <stdlib.h>
+#include <string.h>
+
+// x86上用target属性单独编译各指令集版本，运行时按CPU选择，无需-m编译选项
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BPT_X86_DISPATCH 1
+#endif
+
+#define BPT_ALIGN 64
+#define BPT_PAD UINT64_MAX
+// 最小分叉为BPT_MIN_KEYS+1，32层足以容纳任何可寻址的元素数
+#define BPT_MAX_HEIGHT 32
+
+#define BPT_KEY(p) ((uint64_t)(uintptr_t)(p))
+#define BPT_PTR(k) ((void *)(uintptr_t)(k))
+
+// 节点内统计：less为true时统计小于key的键数，否则统计大于key的键数
+// 固定扫描全部BPT_NODE_KEYS个槽，没有依赖数据的分支；填充槽为UINT64_MAX，
+// 不会计入“小于”，计入“大于”的部分由调用方按count截断
+static size_t bpt_count_scalar(const uint64_t *keys, uint64_t key, bool less)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < BPT_NODE_KEYS; i++)
+    {
+        count += less ? keys[i] < key : keys[i] > key;
+    }
+    return count;
+}
+
+#if defined(BPT_X86_DISPATCH)
+// 无符号比较：翻转符号位后用有符号比较
+__attribute__((target("avx2")))
+static size_t bpt_count_avx2(const uint64_t *keys, uint64_t key, bool less)
+{
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    __m256i target = _mm256_xor_si256(_mm256_set1_epi64x((long long)key), bias);
+    size_t count = 0;
+    for (size_t i = 0; i < BPT_NODE_KEYS; i += 4)
+    {
+        __m256i k = _mm256_xor_si256(_mm256_load_si256((const __m256i *)(keys + i)), bias);
+        __m256i hit = less ? _mm256_cmpgt_epi64(target, k) : _mm256_cmpgt_epi64(k, target);
+        count += (size_t)__builtin_popcount((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(hit)));
+    }
+    return count;
+}
+
+__attribute__((target("sse4.2")))
+static size_t bpt_count_sse42(const uint64_t *keys, uint64_t key, bool less)
+{
+    const __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    __m128i target = _mm_xor_si128(_mm_set1_epi64x((long long)key), bias);
+    size_t count = 0;
+    for (size_t i = 0; i < BPT_NODE_KEYS; i += 2)
+    {
+        __m128i k = _mm_xor_si128(_mm_load_si128((const __m128i *)(keys + i)), bias);
+        __m128i hit = less ? _mm_cmpgt_epi64(target, k) : _mm_cmpgt_epi64(k, target);
+        count += (size_t)__builtin_popcount((unsigned)_mm_movemask_pd(_mm_castsi128_pd(hit)));
+    }
+    return count;
+}
+#endif
+
+// 节点内统计使用的指令集级别，-1表示尚未检测，原子访问
+static int bpt_simd_state = -1;
+
+static bpt_simd_t bpt_simd_detect(void)
+{
+#if defined(BPT_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return BPT_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return BPT_SIMD_SSE42;
+    }
+#endif
+    return BPT_SIMD_NONE;
+}
+
+// 节点内统计当前使用的指令集，首次调用时检测CPU
+bpt_simd_t bpt_simd_level(void)
+{
+    int level = __atomic_load_n(&bpt_simd_state, __ATOMIC_RELAXED);
+    if (level < 0)
+    {
+        level = (int)bpt_simd_detect();
+        __atomic_store_n(&bpt_simd_state, level, __ATOMIC_RELAXED);
+    }
+    return (bpt_simd_t)level;
+}
+
+// 限制节点内统计使用的指令集，不超过CPU支持的级别，返回实际生效的级别
+bpt_simd_t bpt_set_simd_level(bpt_simd_t level)
+{
+    bpt_simd_t supported = bpt_simd_detect();
+    if (level > supported)
+    {
+        level = supported;
+    }
+    __atomic_store_n(&bpt_simd_state, (int)level, __ATOMIC_RELAXED);
+    return level;
+}
+
+static size_t bpt_simd_count(const uint64_t *keys, uint64_t key, bool less)
+{
+#if defined(BPT_X86_DISPATCH)
+    switch (bpt_simd_level())
+    {
+    case BPT_SIMD_AVX2:
+        return bpt_count_avx2(keys, key, less);
+    case BPT_SIMD_SSE42:
+        return bpt_count_sse42(keys, key, less);
+    default:
+        break;
+    }
+#endif
+    return bpt_count_scalar(keys, key, less);
+}
+
+// 节点中小于key的键数，即叶节点中key应在的位置
+static size_t bpt_count_less(const bplus_tree_t *bpt, const bpt_node_t *node, uint64_t key)
+{
+    if (bpt->cmp == NULL)
+    {
+        return bpt_simd_count(node->keys, key, true);
+    }
+    size_t low = 0;
+    size_t high = node->count;
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+        if (bpt->cmp(BPT_PTR(node->keys[mid]), BPT_PTR(key)) < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// 节点中不大于key的键数，即内部节点中key所在的子节点下标
+static size_t bpt_count_not_greater(const bplus_tree_t *bpt, const bpt_node_t *node, uint64_t key)
+{
+    if (bpt->cmp == NULL)
+    {
+        size_t count = BPT_NODE_KEYS - bpt_simd_count(node->keys, key, false);
+        return count < node->count ? count : node->count;
+    }
+    size_t low = 0;
+    size_t high = node->count;
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+        if (bpt->cmp(BPT_PTR(node->keys[mid]), BPT_PTR(key)) <= 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static bool bpt_key_equal(const bplus_tree_t *bpt, uint64_t a, uint64_t b)
+{
+    return bpt->cmp == NULL ? a == b : bpt->cmp(BPT_PTR(a), BPT_PTR(b)) == 0;
+}
+
+static bool bpt_key_less(const bplus_tree_t *bpt, uint64_t a, uint64_t b)
+{
+    return bpt->cmp == NULL ? a < b : bpt->cmp(BPT_PTR(a), BPT_PTR(b)) < 0;
+}
+
+// 把from之后的键槽填充为UINT64_MAX
+static void bpt_pad(bpt_node_t *node, size_t from)
+{
+    for (size_t i = from; i < BPT_NODE_KEYS; i++)
+    {
+        node->keys[i] = BPT_PAD;
+    }
+}
+
+static void *bpt_alloc_node(size_t size, bool leaf)
+{
+    void *memory = NULL;
+    if (posix_memalign(&memory, BPT_ALIGN, size) != 0)
+    {
+        return NULL;
+    }
+    memset(memory, 0, size);
+    bpt_node_t *node = (bpt_node_t *)memory;
+    node->leaf = leaf;
+    bpt_pad(node, 0);
+    return node;
+}
+
+static bpt_leaf_t *bpt_new_leaf(void)
+{
+    return (bpt_leaf_t *)bpt_alloc_node(sizeof(bpt_leaf_t), true);
+}
+
+static bpt_inner_t *bpt_new_inner(void)
+{
+    return (bpt_inner_t *)bpt_alloc_node(sizeof(bpt_inner_t), false);
+}
+
+// 递归释放子树
+static void bpt_free_subtree(bpt_node_t *node, size_t height)
+{
+    if (height > 1)
+    {
+        bpt_inner_t *inner = (bpt_inner_t *)node;
+        for (size_t i = 0; i <= node->count; i++)
+        {
+            bpt_free_subtree(inner->children[i], height - 1);
+        }
+    }
+    free(node);
+}
+
+static bplus_tree_t *bpt_create_with(bpt_cmp_fn cmp)
+{
+    bplus_tree_t *bpt = (bplus_tree_t *)calloc(1, sizeof(bplus_tree_t));
+    if (bpt == NULL)
+    {
+        return NULL;
+    }
+    bpt_leaf_t *leaf = bpt_new_leaf();
+    if (leaf == NULL)
+    {
+        free(bpt);
+        return NULL;
+    }
+    bpt->root = &leaf->base;
+    bpt->first = leaf;
+    bpt->last = leaf;
+    bpt->height = 1;
+    bpt->cmp = cmp;
+    return bpt;
+}
+
+// 创建以uint64_t为键的B+树
+bplus_tree_t *bpt_create_u64(void)
+{
+    return bpt_create_with(NULL);
+}
+
+// 创建以void *为键、用cmp比较的B+树
+bplus_tree_t *bpt_create(bpt_cmp_fn cmp)
+{
+    if (cmp == NULL)
+    {
+        return NULL;
+    }
+    return bpt_create_with(cmp);
+}
+
+// 销毁B+树（不释放键值本身）
+void bpt_destroy(bplus_tree_t *bpt)
+{
+    if (bpt == NULL)
+    {
+        return;
+    }
+    bpt_free_subtree(bpt->root, bpt->height);
+    free(bpt);
+}
+
+// 清空B+树，只保留一个空的根叶节点
+void bpt_clear(bplus_tree_t *bpt)
+{
+    if (bpt == NULL)
+    {
+        return;
+    }
+    if (bpt->height > 1)
+    {
+        bpt_inner_t *inner = (bpt_inner_t *)bpt->root;
+        bpt_node_t *node = &bpt->first->base;
+        // 保留最左的叶节点作为新的根，其余全部释放
+        for (size_t level = bpt->height; level > 1; level--)
+        {
+            bpt_node_t *child = inner->children[0];
+            inner->children[0] = NULL;
+            for (size_t i = 1; i <= inner->base.count; i++)
+            {
+                bpt_free_subtree(inner->children[i], level - 1);
+            }
+            free(inner);
+            inner = (bpt_inner_t *)child;
+        }
+        bpt->root = node;
+    }
+    bpt->first->base.count = 0;
+    bpt_pad(&bpt->first->base, 0);
+    bpt->first->next = NULL;
+    bpt->first->prev = NULL;
+    bpt->last = bpt->first;
+    bpt->size = 0;
+    bpt->height = 1;
+}
+
+// 获取元素个数
+size_t bpt_size(bplus_tree_t *bpt)
+{
+    if (bpt == NULL)
+    {
+        return 0;
+    }
+    return bpt->size;
+}
+
+// 判断是否为空
+bool bpt_is_empty(bplus_tree_t *bpt)
+{
+    if (bpt == NULL)
+    {
+        return true;
+    }
+    return bpt->size == 0;
+}
+
+// 获取层数
+size_t bpt_height(bplus_tree_t *bpt)
+{
+    if (bpt == NULL)
+    {
+        return 0;
+    }
+    return bpt->height;
+}
+
+// 从根走到key所在的叶节点
+static bpt_leaf_t *bpt_find_leaf(const bplus_tree_t *bpt, uint64_t key)
+{
+    bpt_node_t *node = bpt->root;
+    while (!node->leaf)
+    {
+        node = ((bpt_inner_t *)node)->children[bpt_count_not_greater(bpt, node, key)];
+    }
+    return (bpt_leaf_t *)node;
+}
+
+static bool bpt_find_key(bplus_tree_t *bpt, uint64_t key, void **value)
+{
+    bpt_leaf_t *leaf = bpt_find_leaf(bpt, key);
+    size_t pos = bpt_count_less(bpt, &leaf->base, key);
+    if (pos == leaf->base.count || !bpt_key_equal(bpt, leaf->base.keys[pos], key))
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = leaf->values[pos];
+    }
+    return true;
+}
+
+// 插入到叶节点的pos处，节点已满时以right（预先分配）分裂
+static void bpt_leaf_insert(bplus_tree_t *bpt, bpt_leaf_t *leaf, size_t pos, uint64_t key, void *value,
+                            bpt_leaf_t *right)
+{
+    bpt_node_t *node = &leaf->base;
+    bpt_leaf_t *target = leaf;
+    if (right != NULL)
+    {
+        // 在最右叶节点末尾追加（顺序插入）时只把新键放入新节点，使叶节点保持满载
+        size_t keep = (pos == BPT_NODE_KEYS && leaf->next == NULL) ? BPT_NODE_KEYS : BPT_MIN_KEYS;
+        size_t moved = BPT_NODE_KEYS - keep;
+        memcpy(right->base.keys, node->keys + keep, moved * sizeof(uint64_t));
+        memcpy(right->values, leaf->values + keep, moved * sizeof(void *));
+        right->base.count = (uint32_t)moved;
+        node->count = (uint32_t)keep;
+        bpt_pad(node, keep);
+
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (leaf->next != NULL)
+        {
+            leaf->next->prev = right;
+        }
+        else
+        {
+            bpt->last = right;
+        }
+        leaf->next = right;
+
+        if (pos > keep || keep == BPT_NODE_KEYS)
+        {
+            target = right;
+            pos -= keep;
+        }
+    }
+
+    bpt_node_t *dst = &target->base;
+    memmove(dst->keys + pos + 1, dst->keys + pos, (dst->count - pos) * sizeof(uint64_t));
+    memmove(target->values + pos + 1, target->values + pos, (dst->count - pos) * sizeof(void *));
+    dst->keys[pos] = key;
+    target->values[pos] = value;
+    dst->count++;
+}
+
+// 在内部节点的pos处插入分隔键与其右侧的子节点
+// 节点已满时以right（预先分配）分裂，中间键通过split_key上移
+static void bpt_inner_insert(bpt_inner_t *inner, size_t pos, uint64_t key, bpt_node_t *child,
+                             bpt_inner_t *right, uint64_t *split_key)
+{
+    bpt_node_t *node = &inner->base;
+    if (right == NULL)
+    {
+        memmove(node->keys + pos + 1, node->keys + pos, (node->count - pos) * sizeof(uint64_t));
+        memmove(inner->children + pos + 2, inner->children + pos + 1,
+                (node->count - pos) * sizeof(bpt_node_t *));
+        node->keys[pos] = key;
+        inner->children[pos + 1] = child;
+        node->count++;
+        return;
+    }
+
+    // 先在临时数组中插入，再从中间切开
+    uint64_t keys[BPT_NODE_KEYS + 1];
+    bpt_node_t *children[BPT_NODE_KEYS + 2];
+    memcpy(keys, node->keys, pos * sizeof(uint64_t));
+    keys[pos] = key;
+    memcpy(keys + pos + 1, node->keys + pos, (BPT_NODE_KEYS - pos) * sizeof(uint64_t));
+    memcpy(children, inner->children, (pos + 1) * sizeof(bpt_node_t *));
+    children[pos + 1] = child;
+    memcpy(children + pos + 2, inner->children + pos + 1, (BPT_NODE_KEYS - pos) * sizeof(bpt_node_t *));
+
+    size_t left_count = (BPT_NODE_KEYS + 1) / 2;
+    size_t right_count = BPT_NODE_KEYS - left_count;
+    memcpy(node->keys, keys, left_count * sizeof(uint64_t));
+    memcpy(inner->children, children, (left_count + 1) * sizeof(bpt_node_t *));
+    node->count = (uint32_t)left_count;
+    bpt_pad(node, left_count);
+
+    memcpy(right->base.keys, keys + left_count + 1, right_count * sizeof(uint64_t));
+    memcpy(right->children, children + left_count + 1, (right_count + 1) * sizeof(bpt_node_t *));
+    right->base.count = (uint32_t)right_count;
+    *split_key = keys[left_count];
+}
+
+// 插入或替换；需要分裂时先分配好全部新节点，内存不足时树保持原状
+static bool bpt_put_key(bplus_tree_t *bpt, uint64_t key, void *value)
+{
+    bpt_inner_t *path[BPT_MAX_HEIGHT];
+    size_t slots[BPT_MAX_HEIGHT];
+    size_t depth = 0;
+
+    bpt_node_t *node = bpt->root;
+    while (!node->leaf)
+    {
+        size_t index = bpt_count_not_greater(bpt, node, key);
+        path[depth] = (bpt_inner_t *)node;
+        slots[depth] = index;
+        depth++;
+        node = path[depth - 1]->children[index];
+    }
+
+    bpt_leaf_t *leaf = (bpt_leaf_t *)node;
+    size_t pos = bpt_count_less(bpt, node, key);
+    if (pos < node->count && bpt_key_equal(bpt, node->keys[pos], key))
+    {
+        leaf->values[pos] = value;
+        return true;
+    }
+    if (node->count < BPT_NODE_KEYS)
+    {
+        bpt_leaf_insert(bpt, leaf, pos, key, value, NULL);
+        bpt->size++;
+        return true;
+    }
+
+    // 叶节点之上连续满载的内部节点都要分裂，全部满载时还需要新的根
+    size_t full = 0;
+    while (full < depth && path[depth - 1 - full]->base.count == BPT_NODE_KEYS)
+    {
+        full++;
+    }
+    bpt_leaf_t *right_leaf = bpt_new_leaf();
+    bpt_inner_t *spares[BPT_MAX_HEIGHT + 1];
+    size_t needed = full + (full == depth ? 1 : 0);
+    size_t allocated = 0;
+    while (right_leaf != NULL && allocated < needed)
+    {
+        spares[allocated] = bpt_new_inner();
+        if (spares[allocated] == NULL)
+        {
+            break;
+        }
+        allocated++;
+    }
+    if (right_leaf == NULL || allocated < needed)
+    {
+        free(right_leaf);
+        for (size_t i = 0; i < allocated; i++)
+        {
+            free(spares[i]);
+        }
+        return false;
+    }
+
+    bpt_leaf_insert(bpt, leaf, pos, key, value, right_leaf);
+    bpt->size++;
+    bpt_node_t *split = &right_leaf->base;
+    uint64_t split_key = right_leaf->base.keys[0];
+    size_t used = 0;
+    while (split != NULL && depth > 0)
+    {
+        depth--;
+        bpt_inner_t *inner = path[depth];
+        bpt_inner_t *right = inner->base.count == BPT_NODE_KEYS ? spares[used++] : NULL;
+        bpt_inner_insert(inner, slots[depth], split_key, split, right, &split_key);
+        split = right == NULL ? NULL : &right->base;
+    }
+    if (split != NULL)
+    {
+        bpt_inner_t *root = spares[used];
+        root->base.keys[0] = split_key;
+        root->base.count = 1;
+        root->children[0] = bpt->root;
+        root->children[1] = split;
+        bpt->root = &root->base;
+        bpt->height++;
+    }
+    return true;
+}
+
+// 子节点idx从左兄弟借一个元素
+static void bpt_borrow_left(bpt_inner_t *parent, size_t idx)
+{
+    bpt_node_t *child = parent->children[idx];
+    bpt_node_t *left = parent->children[idx - 1];
+    size_t last = left->count - 1;
+
+    memmove(child->keys + 1, child->keys, child->count * sizeof(uint64_t));
+    if (child->leaf)
+    {
+        bpt_leaf_t *cl = (bpt_leaf_t *)child;
+        bpt_leaf_t *ll = (bpt_leaf_t *)left;
+        memmove(cl->values + 1, cl->values, child->count * sizeof(void *));
+        child->keys[0] = left->keys[last];
+        cl->values[0] = ll->values[last];
+        parent->base.keys[idx - 1] = child->keys[0];
+    }
+    else
+    {
+        bpt_inner_t *ci = (bpt_inner_t *)child;
+        bpt_inner_t *li = (bpt_inner_t *)left;
+        memmove(ci->children + 1, ci->children, (child->count + 1) * sizeof(bpt_node_t *));
+        child->keys[0] = parent->base.keys[idx - 1];
+        ci->children[0] = li->children[last + 1];
+        parent->base.keys[idx - 1] = left->keys[last];
+    }
+    child->count++;
+    left->count--;
+    left->keys[left->count] = BPT_PAD;
+}
+
+// 子节点idx从右兄弟借一个元素
+static void bpt_borrow_right(bpt_inner_t *parent, size_t idx)
+{
+    bpt_node_t *child = parent->children[idx];
+    bpt_node_t *right = parent->children[idx + 1];
+
+    if (child->leaf)
+    {
+        bpt_leaf_t *cl = (bpt_leaf_t *)child;
+        bpt_leaf_t *rl = (bpt_leaf_t *)right;
+        child->keys[child->count] = right->keys[0];
+        cl->values[child->count] = rl->values[0];
+        memmove(rl->values, rl->values + 1, (right->count - 1) * sizeof(void *));
+        memmove(right->keys, right->keys + 1, (right->count - 1) * sizeof(uint64_t));
+        parent->base.keys[idx] = right->keys[0];
+    }
+    else
+    {
+        bpt_inner_t *ci = (bpt_inner_t *)child;
+        bpt_inner_t *ri = (bpt_inner_t *)right;
+        child->keys[child->count] = parent->base.keys[idx];
+        ci->children[child->count + 1] = ri->children[0];
+        parent->base.keys[idx] = right->keys[0];
+        memmove(right->keys, right->keys + 1, (right->count - 1) * sizeof(uint64_t));
+        memmove(ri->children, ri->children + 1, right->count * sizeof(bpt_node_t *));
+    }
+    child->count++;
+    right->count--;
+    right->keys[right->count] = BPT_PAD;
+}
+
+// 把子节点i+1并入子节点i，并从父节点删除两者之间的分隔键
+static void bpt_merge(bplus_tree_t *bpt, bpt_inner_t *parent, size_t i)
+{
+    bpt_node_t *left = parent->children[i];
+    bpt_node_t *right = parent->children[i + 1];
+
+    if (left->leaf)
+    {
+        bpt_leaf_t *ll = (bpt_leaf_t *)left;
+        bpt_leaf_t *rl = (bpt_leaf_t *)right;
+        memcpy(left->keys + left->count, right->keys, right->count * sizeof(uint64_t));
+        memcpy(ll->values + left->count, rl->values, right->count * sizeof(void *));
+        left->count += right->count;
+        ll->next = rl->next;
+        if (rl->next != NULL)
+        {
+            rl->next->prev = ll;
+        }
+        else
+        {
+            bpt->last = ll;
+        }
+    }
+    else
+    {
+        bpt_inner_t *li = (bpt_inner_t *)left;
+        bpt_inner_t *ri = (bpt_inner_t *)right;
+        left->keys[left->count] = parent->base.keys[i];
+        memcpy(left->keys + left->count + 1, right->keys, right->count * sizeof(uint64_t));
+        memcpy(li->children + left->count + 1, ri->children, (right->count + 1) * sizeof(bpt_node_t *));
+        left->count += right->count + 1;
+    }
+    free(right);
+
+    bpt_node_t *node = &parent->base;
+    memmove(node->keys + i, node->keys + i + 1, (node->count - i - 1) * sizeof(uint64_t));
+    memmove(parent->children + i + 1, parent->children + i + 2, (node->count - i - 1) * sizeof(bpt_node_t *));
+    node->count--;
+    node->keys[node->count] = BPT_PAD;
+}
+
+// 子节点idx元素不足时，优先向兄弟借，兄弟也不富余时与之合并
+static void bpt_rebalance(bplus_tree_t *bpt, bpt_inner_t *parent, size_t idx)
+{
+    bpt_node_t *left = idx > 0 ? parent->children[idx - 1] : NULL;
+    bpt_node_t *right = idx < parent->base.count ? parent->children[idx + 1] : NULL;
+
+    if (left != NULL && left->count > BPT_MIN_KEYS)
+    {
+        bpt_borrow_left(parent, idx);
+    }
+    else if (right != NULL && right->count > BPT_MIN_KEYS)
+    {
+        bpt_borrow_right(parent, idx);
+    }
+    else if (left != NULL)
+    {
+        bpt_merge(bpt, parent, idx - 1);
+    }
+    else
+    {
+        bpt_merge(bpt, parent, idx);
+    }
+}
+
+static bool bpt_remove_key(bplus_tree_t *bpt, uint64_t key, void **value)
+{
+    bpt_inner_t *path[BPT_MAX_HEIGHT];
+    size_t slots[BPT_MAX_HEIGHT];
+    size_t depth = 0;
+
+    bpt_node_t *node = bpt->root;
+    while (!node->leaf)
+    {
+        size_t index = bpt_count_not_greater(bpt, node, key);
+        path[depth] = (bpt_inner_t *)node;
+        slots[depth] = index;
+        depth++;
+        node = path[depth - 1]->children[index];
+    }
+
+    bpt_leaf_t *leaf = (bpt_leaf_t *)node;
+    size_t pos = bpt_count_less(bpt, node, key);
+    if (pos == node->count || !bpt_key_equal(bpt, node->keys[pos], key))
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = leaf->values[pos];
+    }
+    memmove(node->keys + pos, node->keys + pos + 1, (node->count - pos - 1) * sizeof(uint64_t));
+    memmove(leaf->values + pos, leaf->values + pos + 1, (node->count - pos - 1) * sizeof(void *));
+    node->count--;
+    node->keys[node->count] = BPT_PAD;
+    bpt->size--;
+
+    // 自底向上修复元素不足的节点
+    while (depth > 0 && node->count < BPT_MIN_KEYS)
+    {
+        depth--;
+        bpt_rebalance(bpt, path[depth], slots[depth]);
+        node = &path[depth]->base;
+    }
+    if (!bpt->root->leaf && bpt->root->count == 0)
+    {
+        bpt_inner_t *root = (bpt_inner_t *)bpt->root;
+        bpt->root = root->children[0];
+        bpt->height--;
+        free(root);
+    }
+    return true;
+}
+
+static void bpt_prefetch_leaf(const bpt_leaf_t *leaf)
+{
+    if (leaf == NULL)
+    {
+        return;
+    }
+    for (size_t offset = 0; offset < sizeof(bpt_leaf_t); offset += BPT_ALIGN)
+    {
+        __builtin_prefetch((const char *)leaf + offset);
+    }
+}
+
+static bpt_iter_t bpt_lower_bound_key(bplus_tree_t *bpt, uint64_t key)
+{
+    bpt_iter_t iter;
+    iter.leaf = bpt_find_leaf(bpt, key);
+    iter.index = bpt_count_less(bpt, &iter.leaf->base, key);
+    if (iter.index == iter.leaf->base.count)
+    {
+        iter.leaf = iter.leaf->next;
+        iter.index = 0;
+    }
+    return iter;
+}
+
+// 按升序把键在[low, high)内的元素复制到keys与values，逐个叶节点整段复制
+static size_t bpt_range_keys(bplus_tree_t *bpt, uint64_t low, uint64_t high, void *keys, void **values,
+                             size_t max)
+{
+    bpt_iter_t iter = bpt_lower_bound_key(bpt, low);
+    size_t total = 0;
+
+    while (iter.leaf != NULL && total < max)
+    {
+        bpt_node_t *node = &iter.leaf->base;
+        // 叶节点是指针链，提前取下一个叶节点，与复制当前叶节点重叠
+        bpt_prefetch_leaf(iter.leaf->next);
+        // 整个叶节点都在范围内时不必在节点内查找
+        size_t end = bpt_key_less(bpt, node->keys[node->count - 1], high) ? node->count
+                                                                            : bpt_count_less(bpt, node, high);
+        if (end <= iter.index)
+        {
+            break;
+        }
+        size_t n = end - iter.index;
+        if (n > max - total)
+        {
+            n = max - total;
+        }
+        if (keys != NULL)
+        {
+            if (bpt->cmp == NULL)
+            {
+                memcpy((uint64_t *)keys + total, node->keys + iter.index, n * sizeof(uint64_t));
+            }
+            else
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    ((void **)keys)[total + i] = BPT_PTR(node->keys[iter.index + i]);
+                }
+            }
+        }
+        if (values != NULL)
+        {
+            memcpy(values + total, iter.leaf->values + iter.index, n * sizeof(void *));
+        }
+        total += n;
+        if (end < node->count)
+        {
+            break;
+        }
+        iter.leaf = iter.leaf->next;
+        iter.index = 0;
+    }
+    return total;
+}
+
+// 插入uint64_t键，键已存在时替换值；内存不足或树不是uint64_t键时返回false
+bool bpt_put_u64(bplus_tree_t *bpt, uint64_t key, void *value)
+{
+    if (bpt == NULL || bpt->cmp != NULL)
+    {
+        return false;
+    }
+    return bpt_put_key(bpt, key, value);
+}
+
+// 查找uint64_t键，存在时通过value返回值（value可以为NULL）
+bool bpt_find_u64(bplus_tree_t *bpt, uint64_t key, void **value)
+{
+    if (bpt == NULL || bpt->cmp != NULL)
+    {
+        return false;
+    }
+    return bpt_find_key(bpt, key, value);
+}
+
+// 删除uint64_t键，存在时通过value返回被删除的值（value可以为NULL）
+bool bpt_remove_u64(bplus_tree_t *bpt, uint64_t key, void **value)
+{
+    if (bpt == NULL || bpt->cmp != NULL)
+    {
+        return false;
+    }
+    return bpt_remove_key(bpt, key, value);
+}
+
+// 指向第一个不小于key的元素的迭代器
+bpt_iter_t bpt_lower_bound_u64(bplus_tree_t *bpt, uint64_t key)
+{
+    if (bpt == NULL || bpt->cmp != NULL)
+    {
+        bpt_iter_t end = {NULL, 0};
+        return end;
+    }
+    return bpt_lower_bound_key(bpt, key);
+}
+
+// 按升序复制键在[low, high)内的元素，最多max个，返回复制的个数
+// keys或values为NULL时不复制对应部分；元素多于max时可从最后一个键加1处继续
+size_t bpt_range_u64(bplus_tree_t *bpt, uint64_t low, uint64_t high, uint64_t *keys, void **values,
+                     size_t max)
+{
+    if (bpt == NULL || bpt->cmp != NULL)
+    {
+        return 0;
+    }
+    return bpt_range_keys(bpt, low, high, keys, values, max);
+}
+
+// 插入void *键，键已存在时替换值；内存不足或树不是void *键时返回false
+bool bpt_put(bplus_tree_t *bpt, void *key, void *value)
+{
+    if (bpt == NULL || bpt->cmp == NULL)
+    {
+        return false;
+    }
+    return bpt_put_key(bpt, BPT_KEY(key), value);
+}
+
+// 查找void *键，存在时通过value返回值（value可以为NULL）
+bool bpt_find(bplus_tree_t *bpt, void *key, void **value)
+{
+    if (bpt == NULL || bpt->cmp == NULL)
+    {
+        return false;
+    }
+    return bpt_find_key(bpt, BPT_KEY(key), value);
+}
+
+// 删除void *键，存在时通过value返回被删除的值（value可以为NULL）
+bool bpt_remove(bplus_tree_t *bpt, void *key, void **value)
+{
+    if (bpt == NULL || bpt->cmp == NULL)
+    {
+        return false;
+    }
+    return bpt_remove_key(bpt, BPT_KEY(key), value);
+}
+
+// 指向第一个不小于key的元素的迭代器
+bpt_iter_t bpt_lower_bound(bplus_tree_t *bpt, void *key)
+{
+    if (bpt == NULL || bpt->cmp == NULL)
+    {
+        bpt_iter_t end = {NULL, 0};
+        return end;
+    }
+    return bpt_lower_bound_key(bpt, BPT_KEY(key));
+}
+
+// 按升序复制键在[low, high)内的元素，最多max个，返回复制的个数
+size_t bpt_range(bplus_tree_t *bpt, void *low, void *high, void **keys, void **values, size_t max)
+{
+    if (bpt == NULL || bpt->cmp == NULL)
+    {
+        return 0;
+    }
+    return bpt_range_keys(bpt, BPT_KEY(low), BPT_KEY(high), keys, values, max);
+}
+
+// 指向最小元素的迭代器
+bpt_iter_t bpt_first(bplus_tree_t *bpt)
+{
+    bpt_iter_t iter = {NULL, 0};
+    if (bpt != NULL && bpt->size > 0)
+    {
+        iter.leaf = bpt->first;
+    }
+    return iter;
+}
+
+// 迭代器是否指向元素
+bool bpt_iter_valid(bpt_iter_t iter)
+{
+    return iter.leaf != NULL && iter.index < iter.leaf->base.count;
+}
+
+// 前进到下一个元素，越过最后一个元素后变为无效
+void bpt_iter_next(bpt_iter_t *iter)
+{
+    if (iter == NULL || iter->leaf == NULL)
+    {
+        return;
+    }
+    iter->index++;
+    if (iter->index >= iter->leaf->base.count)
+    {
+        iter->leaf = iter->leaf->next;
+        iter->index = 0;
+    }
+}
+
+// 迭代器所指元素的uint64_t键
+uint64_t bpt_iter_key_u64(bpt_iter_t iter)
+{
+    return bpt_iter_valid(iter) ? iter.leaf->base.keys[iter.index] : 0;
+}
+
+// 迭代器所指元素的void *键
+void *bpt_iter_key(bpt_iter_t iter)
+{
+    return bpt_iter_valid(iter) ? BPT_PTR(iter.leaf->base.keys[iter.index]) : NULL;
+}
+
+// 迭代器所指元素的值
+void *bpt_iter_value(bpt_iter_t iter)
+{
+    return bpt_iter_valid(iter) ? iter.leaf->values[iter.index] : NULL;
+}
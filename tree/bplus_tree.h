@@ -0,0 +1,102 @@
+#ifndef __BPLUS_TREE_H__
+#define __BPLUS_TREE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 每个节点的键数：32个8字节键正好占4条缓存行
+#define BPT_NODE_KEYS 32
+#define BPT_MIN_KEYS (BPT_NODE_KEYS / 2)
+
+// 内存B+树
+// 节点按缓存行对齐，键连续存放在节点开头，查找每层只访问少数几条缓存行，
+// 而二叉树每层都是一次缓存未命中。值只存放在叶节点，叶节点双向链接，
+// 范围扫描顺序读取叶节点中的连续数组。
+// 两种键：bpt_create_u64创建的树以uint64_t为键，节点内用SIMD统计小于目标的键数
+// （x86上运行时按CPU选择AVX2或SSE4.2，不依赖编译选项；都不支持时为无分支的线性扫描）；
+// bpt_create创建的树以void *为键，节点内用cmp二分查找，cmp(a, b) < 0 表示a排在b前。
+// 两种树的接口分别带_u64后缀与不带后缀，混用时返回失败。
+// 插入或删除会使已有的迭代器失效。
+typedef int (*bpt_cmp_fn)(void *a, void *b);
+
+// uint64_t键节点内统计使用的指令集级别
+typedef enum bpt_simd
+{
+    BPT_SIMD_NONE,      // 无分支线性扫描
+    BPT_SIMD_SSE42,
+    BPT_SIMD_AVX2,
+} bpt_simd_t;
+
+typedef struct bpt_node
+{
+    uint64_t keys[BPT_NODE_KEYS];   // 有序键；count之后的槽填充UINT64_MAX
+    uint32_t count;
+    bool leaf;
+} bpt_node_t;
+
+typedef struct bpt_inner
+{
+    bpt_node_t base;
+    bpt_node_t *children[BPT_NODE_KEYS + 1];    // children[i]中的键小于keys[i]，不小于keys[i-1]
+} bpt_inner_t;
+
+typedef struct bpt_leaf
+{
+    bpt_node_t base;
+    void *values[BPT_NODE_KEYS];
+    struct bpt_leaf *prev;
+    struct bpt_leaf *next;
+} bpt_leaf_t;
+
+typedef struct bplus_tree
+{
+    bpt_node_t *root;   // 始终存在，空树时为一个空叶节点
+    bpt_leaf_t *first;
+    bpt_leaf_t *last;
+    size_t size;
+    size_t height;      // 层数，只有根叶节点时为1
+    bpt_cmp_fn cmp;     // NULL表示uint64_t键
+} bplus_tree_t;
+
+// 迭代器：叶节点与其中的下标，leaf为NULL表示已到末尾
+typedef struct bpt_iter
+{
+    bpt_leaf_t *leaf;
+    size_t index;
+} bpt_iter_t;
+
+bplus_tree_t *bpt_create_u64(void);
+bplus_tree_t *bpt_create(bpt_cmp_fn cmp);
+void bpt_destroy(bplus_tree_t *bpt);
+void bpt_clear(bplus_tree_t *bpt);
+size_t bpt_size(bplus_tree_t *bpt);
+bool bpt_is_empty(bplus_tree_t *bpt);
+size_t bpt_height(bplus_tree_t *bpt);
+
+bool bpt_put_u64(bplus_tree_t *bpt, uint64_t key, void *value);
+bool bpt_find_u64(bplus_tree_t *bpt, uint64_t key, void **value);
+bool bpt_remove_u64(bplus_tree_t *bpt, uint64_t key, void **value);
+bpt_iter_t bpt_lower_bound_u64(bplus_tree_t *bpt, uint64_t key);
+size_t bpt_range_u64(bplus_tree_t *bpt, uint64_t low, uint64_t high, uint64_t *keys, void **values,
+                     size_t max);
+
+bool bpt_put(bplus_tree_t *bpt, void *key, void *value);
+bool bpt_find(bplus_tree_t *bpt, void *key, void **value);
+bool bpt_remove(bplus_tree_t *bpt, void *key, void **value);
+bpt_iter_t bpt_lower_bound(bplus_tree_t *bpt, void *key);
+size_t bpt_range(bplus_tree_t *bpt, void *low, void *high, void **keys, void **values, size_t max);
+
+bpt_iter_t bpt_first(bplus_tree_t *bpt);
+bool bpt_iter_valid(bpt_iter_t iter);
+void bpt_iter_next(bpt_iter_t *iter);
+uint64_t bpt_iter_key_u64(bpt_iter_t iter);
+void *bpt_iter_key(bpt_iter_t iter);
+void *bpt_iter_value(bpt_iter_t iter);
+
+// 节点内统计当前使用的指令集（所有树共用）；bpt_set_simd_level限制其上限（用于测试与对比），
+// 不超过CPU支持的级别，返回实际生效的级别
+bpt_simd_t bpt_simd_level(void);
+bpt_simd_t bpt_set_simd_level(bpt_simd_t level);
+
+#endif // __BPLUS_TREE_H__
@@ -0,0 +1,1424 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "disk_btree.h"
+#include "hash/hash.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// 写操作前至少保留的可淘汰帧数：一次插入或删除最多修改路径上每层的节点与兄弟节点，再加几个新页
+#define DBT_RESERVE(height) (3 * (size_t)(height) + 8)
+
+// 删除后键数低于此值时与相邻兄弟合并或重新分配
+#define DBT_LEAF_MIN (DBT_LEAF_KEYS / 4)
+#define DBT_INNER_MIN (DBT_INNER_KEYS / 4)
+
+#define DBT_MAX_HEIGHT 16
+
+// 批量构建时每次写入文件的页数
+#define DBT_BULK_PAGES 64
+
+static bool dbt_pread_all(int fd, void *buf, size_t len, uint64_t offset)
+{
+    uint8_t *p = (uint8_t *)buf;
+    while (len > 0)
+    {
+        ssize_t n = pread(fd, p, len, (off_t)offset);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return true;
+}
+
+static bool dbt_pwrite_all(int fd, const void *buf, size_t len, uint64_t offset)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    while (len > 0)
+    {
+        ssize_t n = pwrite(fd, p, len, (off_t)offset);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return true;
+}
+
+static uint64_t dbt_meta_checksum(const dbt_meta_t *meta)
+{
+    return hash_bytes(meta, offsetof(dbt_meta_t, checksum));
+}
+
+// 元数据页映像：元数据在页首，其余填0
+static void dbt_meta_image(dbt_meta_t *meta, uint8_t *page)
+{
+    meta->checksum = dbt_meta_checksum(meta);
+    memset(page, 0, DBT_PAGE_SIZE);
+    memcpy(page, meta, sizeof(dbt_meta_t));
+}
+
+static uint64_t dbt_wal_checksum(const uint8_t *page, uint64_t page_no)
+{
+    return hash_bytes_seeded(page, DBT_PAGE_SIZE, page_no);
+}
+
+// 第一个不小于key的下标
+static size_t dbt_lower(const uint64_t *keys, size_t count, uint64_t key)
+{
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (keys[mid] < key)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// 第一个大于key的下标，即内部节点中应进入的子节点
+static size_t dbt_upper(const uint64_t *keys, size_t count, uint64_t key)
+{
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (keys[mid] <= key)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static dbt_page_type_t dbt_level_type(uint32_t level)
+{
+    return level == 1 ? DBT_PAGE_LEAF : DBT_PAGE_INNER;
+}
+
+// 校验节点页的类型与键数，防止损坏的文件导致越界访问
+static bool dbt_page_valid(const uint8_t *data, dbt_page_type_t type)
+{
+    const dbt_page_header_t *header = (const dbt_page_header_t *)data;
+    size_t capacity = type == DBT_PAGE_LEAF ? DBT_LEAF_KEYS : DBT_INNER_KEYS;
+    return header->type == type && header->count <= capacity;
+}
+
+static size_t dbt_slot(disk_btree_t *dbt, uint64_t page_no)
+{
+    return (size_t)hash_u64(page_no) & dbt->table_mask;
+}
+
+static dbt_frame_t *dbt_lookup(disk_btree_t *dbt, uint64_t page_no)
+{
+    for (size_t i = dbt_slot(dbt, page_no); dbt->table[i] != 0; i = (i + 1) & dbt->table_mask)
+    {
+        dbt_frame_t *frame = &dbt->frames[dbt->table[i] - 1];
+        if (frame->page_no == page_no)
+        {
+            return frame;
+        }
+    }
+    return NULL;
+}
+
+static void dbt_table_insert(disk_btree_t *dbt, dbt_frame_t *frame)
+{
+    size_t i = dbt_slot(dbt, frame->page_no);
+    while (dbt->table[i] != 0)
+    {
+        i = (i + 1) & dbt->table_mask;
+    }
+    dbt->table[i] = (uint32_t)(frame - dbt->frames) + 1;
+}
+
+// 删除后把同一探测链上的后续项前移，不留墓碑
+static void dbt_table_remove(disk_btree_t *dbt, uint64_t page_no)
+{
+    size_t i = dbt_slot(dbt, page_no);
+    while (dbt->frames[dbt->table[i] - 1].page_no != page_no)
+    {
+        i = (i + 1) & dbt->table_mask;
+    }
+    dbt->table[i] = 0;
+    for (size_t j = (i + 1) & dbt->table_mask; dbt->table[j] != 0; j = (j + 1) & dbt->table_mask)
+    {
+        size_t home = dbt_slot(dbt, dbt->frames[dbt->table[j] - 1].page_no);
+        // home不在(i, j]之间时，j上的项可以移到i
+        bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays)
+        {
+            dbt->table[i] = dbt->table[j];
+            dbt->table[j] = 0;
+            i = j;
+        }
+    }
+}
+
+// 取一个空帧，或用CLOCK淘汰一个未修改、未固定的帧；全部不可淘汰时返回NULL
+static dbt_frame_t *dbt_victim(disk_btree_t *dbt)
+{
+    for (size_t step = 0; step < 2 * dbt->capacity; step++)
+    {
+        dbt_frame_t *frame = &dbt->frames[dbt->hand];
+        dbt->hand = dbt->hand + 1 == dbt->capacity ? 0 : dbt->hand + 1;
+        if (!frame->used)
+        {
+            return frame;
+        }
+        if (frame->pins > 0 || frame->dirty)
+        {
+            continue;
+        }
+        if (frame->ref)
+        {
+            frame->ref = false;
+            continue;
+        }
+        dbt_table_remove(dbt, frame->page_no);
+        frame->used = false;
+        dbt->stats.evictions++;
+        return frame;
+    }
+    return NULL;
+}
+
+// 固定页对应的帧；read为false时不读文件（新分配的页），不在缓存中则内容清零
+static dbt_frame_t *dbt_pin(disk_btree_t *dbt, uint64_t page_no, bool read)
+{
+    dbt_frame_t *frame = dbt_lookup(dbt, page_no);
+    if (frame != NULL)
+    {
+        dbt->stats.hits++;
+        frame->ref = true;
+        frame->pins++;
+        return frame;
+    }
+    if (read && (page_no == 0 || page_no >= dbt->meta.page_count))
+    {
+        return NULL;
+    }
+    frame = dbt_victim(dbt);
+    if (frame == NULL)
+    {
+        return NULL;
+    }
+    if (read)
+    {
+        dbt->stats.misses++;
+        if (!dbt_pread_all(dbt->fd, frame->data, DBT_PAGE_SIZE, page_no * DBT_PAGE_SIZE))
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        memset(frame->data, 0, DBT_PAGE_SIZE);
+    }
+    frame->page_no = page_no;
+    frame->used = true;
+    frame->ref = true;
+    frame->dirty = false;
+    frame->pins = 1;
+    dbt_table_insert(dbt, frame);
+    return frame;
+}
+
+static void dbt_unpin(dbt_frame_t *frame)
+{
+    if (frame != NULL)
+    {
+        frame->pins--;
+    }
+}
+
+static void dbt_mark_dirty(disk_btree_t *dbt, dbt_frame_t *frame)
+{
+    if (!frame->dirty)
+    {
+        frame->dirty = true;
+        dbt->dirty++;
+    }
+}
+
+// 固定并校验一个节点页
+static dbt_frame_t *dbt_pin_node(disk_btree_t *dbt, uint64_t page_no, dbt_page_type_t type)
+{
+    dbt_frame_t *frame = dbt_pin(dbt, page_no, true);
+    if (frame != NULL && !dbt_page_valid(frame->data, type))
+    {
+        dbt_unpin(frame);
+        return NULL;
+    }
+    return frame;
+}
+
+// 只读访问一个节点页：映射时直接返回映射中的地址（frame为NULL），否则固定缓存帧
+static const uint8_t *dbt_read(disk_btree_t *dbt, uint64_t page_no, dbt_page_type_t type, dbt_frame_t **frame)
+{
+    *frame = NULL;
+    if (dbt->map != NULL)
+    {
+        if (page_no == 0 || page_no >= dbt->meta.page_count)
+        {
+            return NULL;
+        }
+        const uint8_t *data = dbt->map + page_no * DBT_PAGE_SIZE;
+        return dbt_page_valid(data, type) ? data : NULL;
+    }
+    *frame = dbt_pin_node(dbt, page_no, type);
+    return *frame != NULL ? (*frame)->data : NULL;
+}
+
+// 分配一页（优先取空闲链表），返回已固定、已标记修改、内容清零的帧
+static dbt_frame_t *dbt_alloc_page(disk_btree_t *dbt, dbt_page_type_t type)
+{
+    dbt_frame_t *frame;
+    if (dbt->meta.free_head != 0)
+    {
+        frame = dbt_pin(dbt, dbt->meta.free_head, true);
+        if (frame == NULL)
+        {
+            return NULL;
+        }
+        dbt->meta.free_head = ((dbt_page_header_t *)frame->data)->next;
+        memset(frame->data, 0, DBT_PAGE_SIZE);
+    }
+    else
+    {
+        frame = dbt_pin(dbt, dbt->meta.page_count, false);
+        if (frame == NULL)
+        {
+            return NULL;
+        }
+        dbt->meta.page_count++;
+    }
+    ((dbt_page_header_t *)frame->data)->type = (uint16_t)type;
+    dbt_mark_dirty(dbt, frame);
+    dbt->meta_dirty = true;
+    return frame;
+}
+
+// 把页放回空闲链表，不需要读出原内容
+static bool dbt_free_page(disk_btree_t *dbt, uint64_t page_no)
+{
+    dbt_frame_t *frame = dbt_pin(dbt, page_no, false);
+    if (frame == NULL)
+    {
+        return false;
+    }
+    memset(frame->data, 0, DBT_PAGE_SIZE);
+    dbt_page_header_t *header = (dbt_page_header_t *)frame->data;
+    header->type = DBT_PAGE_FREE;
+    header->next = dbt->meta.free_head;
+    dbt->meta.free_head = page_no;
+    dbt->meta_dirty = true;
+    dbt_mark_dirty(dbt, frame);
+    dbt_unpin(frame);
+    return true;
+}
+
+// 扫描日志：存在完整的提交记录时返回1（apply为true时重放到数据文件并清空日志），
+// 日志为空或不完整时返回0（apply为true时清空日志），I/O出错返回-1
+static int dbt_recover(int fd, int wal_fd, bool apply)
+{
+    struct stat st;
+    if (fstat(wal_fd, &st) != 0)
+    {
+        return -1;
+    }
+    if (st.st_size == 0)
+    {
+        return 0;
+    }
+
+    uint8_t *page = (uint8_t *)malloc(DBT_PAGE_SIZE);
+    if (page == NULL)
+    {
+        return -1;
+    }
+    uint64_t size = (uint64_t)st.st_size;
+    uint64_t offset = 0;
+    uint64_t records = 0;
+    uint64_t combined = 0;
+    bool committed = false;
+    dbt_wal_record_t record;
+    const uint64_t page_record = sizeof(dbt_wal_record_t) + DBT_PAGE_SIZE;
+
+    // 第一遍校验：遇到校验失败或截断的记录即停止，之后的内容视为未写完
+    while (offset + sizeof(record) <= size && dbt_pread_all(wal_fd, &record, sizeof(record), offset))
+    {
+        if (record.tag == DBT_WAL_COMMIT)
+        {
+            committed = record.page_no == records && record.checksum == combined;
+            break;
+        }
+        if (record.tag != DBT_WAL_PAGE || offset + page_record > size ||
+            !dbt_pread_all(wal_fd, page, DBT_PAGE_SIZE, offset + sizeof(record)) ||
+            dbt_wal_checksum(page, record.page_no) != record.checksum)
+        {
+            break;
+        }
+        combined = hash_combine(combined, record.checksum);
+        records++;
+        offset += page_record;
+    }
+
+    int result = committed ? 1 : 0;
+    if (apply)
+    {
+        offset = 0;
+        for (uint64_t i = 0; committed && i < records && result > 0; i++, offset += page_record)
+        {
+            if (!dbt_pread_all(wal_fd, &record, sizeof(record), offset) ||
+                !dbt_pread_all(wal_fd, page, DBT_PAGE_SIZE, offset + sizeof(record)) ||
+                !dbt_pwrite_all(fd, page, DBT_PAGE_SIZE, record.page_no * DBT_PAGE_SIZE))
+            {
+                result = -1;
+            }
+        }
+        if (result > 0 && fsync(fd) != 0)
+        {
+            result = -1;
+        }
+        if (result >= 0 && ftruncate(wal_fd, 0) != 0)
+        {
+            result = -1;
+        }
+    }
+    free(page);
+    return result;
+}
+
+// 读取并校验元数据页；文件为空时（只可写打开）初始化
+static bool dbt_load_meta(disk_btree_t *dbt)
+{
+    struct stat st;
+    if (fstat(dbt->fd, &st) != 0)
+    {
+        return false;
+    }
+    uint8_t *page = (uint8_t *)malloc(DBT_PAGE_SIZE);
+    if (page == NULL)
+    {
+        return false;
+    }
+
+    bool ok;
+    if ((uint64_t)st.st_size < DBT_PAGE_SIZE)
+    {
+        // 新文件，或创建时元数据页未写完（此时还没有任何提交）
+        memset(&dbt->meta, 0, sizeof(dbt->meta));
+        dbt->meta.magic = DBT_MAGIC;
+        dbt->meta.version = DBT_VERSION;
+        dbt->meta.page_size = DBT_PAGE_SIZE;
+        dbt->meta.page_count = 1;
+        dbt_meta_image(&dbt->meta, page);
+        ok = dbt->wal_fd >= 0 && dbt_pwrite_all(dbt->fd, page, DBT_PAGE_SIZE, 0) && fsync(dbt->fd) == 0;
+    }
+    else
+    {
+        ok = dbt_pread_all(dbt->fd, page, DBT_PAGE_SIZE, 0);
+        if (ok)
+        {
+            memcpy(&dbt->meta, page, sizeof(dbt->meta));
+            const dbt_meta_t *meta = &dbt->meta;
+            ok = meta->magic == DBT_MAGIC && meta->version == DBT_VERSION && meta->page_size == DBT_PAGE_SIZE &&
+                 meta->checksum == dbt_meta_checksum(meta) && meta->page_count >= 1 &&
+                 meta->page_count <= (uint64_t)st.st_size / DBT_PAGE_SIZE && meta->root < meta->page_count &&
+                 meta->height <= DBT_MAX_HEIGHT && (meta->root == 0) == (meta->height == 0);
+        }
+    }
+    free(page);
+    dbt->committed = dbt->meta;
+    return ok;
+}
+
+// 释放全部资源，不提交
+static void dbt_release(disk_btree_t *dbt)
+{
+    if (dbt->map != NULL)
+    {
+        munmap((void *)dbt->map, dbt->map_size);
+    }
+    if (dbt->fd >= 0)
+    {
+        close(dbt->fd);
+    }
+    if (dbt->wal_fd >= 0)
+    {
+        close(dbt->wal_fd);
+    }
+    free(dbt->frames);
+    free(dbt->cache);
+    free(dbt->table);
+    free(dbt);
+}
+
+// 打开或创建磁盘B+树；cache_pages为页缓存页数，0为DBT_DEFAULT_CACHE，不足DBT_MIN_CACHE时取DBT_MIN_CACHE
+// 可写打开时先重放日志中已提交的修改；只读打开时日志中若有未重放的提交则失败，须先可写打开一次
+disk_btree_t *dbt_open(const char *path, unsigned flags, size_t cache_pages)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+    if (flags & DBT_MMAP)
+    {
+        flags |= DBT_READONLY;
+    }
+    bool readonly = (flags & DBT_READONLY) != 0;
+
+    disk_btree_t *dbt = (disk_btree_t *)calloc(1, sizeof(disk_btree_t));
+    size_t len = strlen(path);
+    char *wal_path = (char *)malloc(len + sizeof("-wal"));
+    if (dbt == NULL || wal_path == NULL)
+    {
+        free(dbt);
+        free(wal_path);
+        return NULL;
+    }
+    memcpy(wal_path, path, len);
+    memcpy(wal_path + len, "-wal", sizeof("-wal"));
+    dbt->flags = flags;
+    dbt->wal_fd = -1;
+
+    bool ok;
+    dbt->fd = open(path, readonly ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+    if (readonly)
+    {
+        ok = dbt->fd >= 0;
+        int wal_fd = ok ? open(wal_path, O_RDONLY) : -1;
+        if (wal_fd >= 0)
+        {
+            ok = dbt_recover(dbt->fd, wal_fd, false) == 0;
+            close(wal_fd);
+        }
+    }
+    else
+    {
+        dbt->wal_fd = dbt->fd >= 0 ? open(wal_path, O_RDWR | O_CREAT, 0644) : -1;
+        ok = dbt->wal_fd >= 0 && dbt_recover(dbt->fd, dbt->wal_fd, true) >= 0;
+    }
+    free(wal_path);
+    if (!ok || !dbt_load_meta(dbt))
+    {
+        dbt_release(dbt);
+        return NULL;
+    }
+
+    if (flags & DBT_MMAP)
+    {
+        dbt->map_size = (size_t)dbt->meta.page_count * DBT_PAGE_SIZE;
+        void *map = mmap(NULL, dbt->map_size, PROT_READ, MAP_SHARED, dbt->fd, 0);
+        if (map == MAP_FAILED)
+        {
+            dbt_release(dbt);
+            return NULL;
+        }
+        dbt->map = (const uint8_t *)map;
+        return dbt;
+    }
+
+    dbt->capacity = cache_pages == 0 ? DBT_DEFAULT_CACHE : cache_pages < DBT_MIN_CACHE ? DBT_MIN_CACHE : cache_pages;
+    size_t table_size = 1;
+    while (table_size < 2 * dbt->capacity)
+    {
+        table_size <<= 1;
+    }
+    dbt->table_mask = table_size - 1;
+    dbt->frames = (dbt_frame_t *)calloc(dbt->capacity, sizeof(dbt_frame_t));
+    dbt->table = (uint32_t *)calloc(table_size, sizeof(uint32_t));
+    void *cache = NULL;
+    if (dbt->frames == NULL || dbt->table == NULL ||
+        posix_memalign(&cache, DBT_PAGE_SIZE, dbt->capacity * DBT_PAGE_SIZE) != 0)
+    {
+        dbt_release(dbt);
+        return NULL;
+    }
+    dbt->cache = (uint8_t *)cache;
+    for (size_t i = 0; i < dbt->capacity; i++)
+    {
+        dbt->frames[i].data = dbt->cache + i * DBT_PAGE_SIZE;
+    }
+    return dbt;
+}
+
+// 提交后关闭；返回提交是否成功（只读打开时总是成功）
+bool dbt_close(disk_btree_t *dbt)
+{
+    if (dbt == NULL)
+    {
+        return false;
+    }
+    bool ok = dbt->wal_fd < 0 || dbt_commit(dbt);
+    dbt_release(dbt);
+    return ok;
+}
+
+static int dbt_frame_cmp(const void *a, const void *b)
+{
+    uint64_t x = (*(dbt_frame_t *const *)a)->page_no;
+    uint64_t y = (*(dbt_frame_t *const *)b)->page_no;
+    return (x > y) - (x < y);
+}
+
+// 追加一条页记录
+static bool dbt_wal_append(disk_btree_t *dbt, uint64_t page_no, const uint8_t *page, uint64_t *offset,
+                           uint64_t *combined)
+{
+    dbt_wal_record_t record = {DBT_WAL_PAGE, page_no, dbt_wal_checksum(page, page_no)};
+    if (!dbt_pwrite_all(dbt->wal_fd, &record, sizeof(record), *offset) ||
+        !dbt_pwrite_all(dbt->wal_fd, page, DBT_PAGE_SIZE, *offset + sizeof(record)))
+    {
+        return false;
+    }
+    *offset += sizeof(record) + DBT_PAGE_SIZE;
+    *combined = hash_combine(*combined, record.checksum);
+    return true;
+}
+
+// 按页号排序的修改过的帧，*count返回个数；内存不足时返回NULL
+static dbt_frame_t **dbt_collect_dirty(disk_btree_t *dbt, size_t *count)
+{
+    dbt_frame_t **dirty = (dbt_frame_t **)malloc((dbt->dirty + 1) * sizeof(dbt_frame_t *));
+    if (dirty == NULL)
+    {
+        return NULL;
+    }
+    *count = 0;
+    for (size_t i = 0; i < dbt->capacity; i++)
+    {
+        if (dbt->frames[i].used && dbt->frames[i].dirty)
+        {
+            dirty[(*count)++] = &dbt->frames[i];
+        }
+    }
+    qsort(dirty, *count, sizeof(dbt_frame_t *), dbt_frame_cmp);
+    return dirty;
+}
+
+// 把已提交（日志已落盘）的元数据页与修改过的页写回数据文件并fsync，再清空日志
+// 调用时修改过的帧都已写入日志；失败时保持checkpoint_pending，可以再次调用
+static bool dbt_checkpoint(disk_btree_t *dbt)
+{
+    size_t count = 0;
+    dbt_frame_t **dirty = dbt_collect_dirty(dbt, &count);
+    uint8_t *meta_page = (uint8_t *)malloc(DBT_PAGE_SIZE);
+    bool ok = dirty != NULL && meta_page != NULL;
+    if (ok)
+    {
+        dbt_meta_image(&dbt->committed, meta_page);
+        ok = dbt_pwrite_all(dbt->fd, meta_page, DBT_PAGE_SIZE, 0);
+    }
+    for (size_t i = 0; ok && i < count; i++)
+    {
+        ok = dbt_pwrite_all(dbt->fd, dirty[i]->data, DBT_PAGE_SIZE, dirty[i]->page_no * DBT_PAGE_SIZE);
+    }
+    ok = ok && fsync(dbt->fd) == 0 && ftruncate(dbt->wal_fd, 0) == 0;
+
+    if (ok)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dirty[i]->dirty = false;
+        }
+        dbt->dirty = 0;
+        dbt->checkpoint_pending = false;
+        dbt->stats.pages_written += count + 1;
+    }
+    free(dirty);
+    free(meta_page);
+    return ok;
+}
+
+// 提交：修改过的页与元数据页先写日志并fsync，再按页号顺序写回数据文件并fsync，最后清空日志
+// 日志落盘前失败时清空日志并返回false，修改仍保留在缓存中，可以重试或回滚；
+// 清空日志也失败时树被标记为poisoned，之后的提交与写操作都失败；
+// 日志落盘后即已提交并返回true，写回失败留到之后的写操作前重试
+bool dbt_commit(disk_btree_t *dbt)
+{
+    if (dbt == NULL || dbt->wal_fd < 0 || dbt->poisoned)
+    {
+        return false;
+    }
+    if (dbt->checkpoint_pending)
+    {
+        // 写回完成前不接受新的修改，缓存中只有已提交的页
+        dbt_checkpoint(dbt);
+        return true;
+    }
+    if (dbt->dirty == 0 && !dbt->meta_dirty)
+    {
+        return true;
+    }
+
+    size_t count = 0;
+    dbt_frame_t **dirty = dbt_collect_dirty(dbt, &count);
+    uint8_t *meta_page = (uint8_t *)malloc(DBT_PAGE_SIZE);
+    if (dirty == NULL || meta_page == NULL)
+    {
+        free(dirty);
+        free(meta_page);
+        return false;
+    }
+
+    dbt_meta_t meta = dbt->meta;
+    meta.txn++;
+    dbt_meta_image(&meta, meta_page);
+
+    uint64_t offset = 0;
+    uint64_t combined = 0;
+    bool ok = dbt_wal_append(dbt, 0, meta_page, &offset, &combined);
+    for (size_t i = 0; ok && i < count; i++)
+    {
+        ok = dbt_wal_append(dbt, dirty[i]->page_no, dirty[i]->data, &offset, &combined);
+    }
+    dbt_wal_record_t commit = {DBT_WAL_COMMIT, count + 1, combined};
+    ok = ok && dbt_pwrite_all(dbt->wal_fd, &commit, sizeof(commit), offset) && fsync(dbt->wal_fd) == 0;
+    free(dirty);
+    free(meta_page);
+    if (!ok)
+    {
+        // 日志中可能残留部分记录，甚至是写入了但fsync失败的完整提交，不清空的话下次打开时会被重放
+        if (ftruncate(dbt->wal_fd, 0) != 0 || fsync(dbt->wal_fd) != 0)
+        {
+            dbt->poisoned = true;
+        }
+        return false;
+    }
+
+    // 日志落盘后即已提交，之后写回数据文件中途失败也能在下次打开时重放，不能再回滚
+    dbt->meta = meta;
+    dbt->committed = meta;
+    dbt->meta_dirty = false;
+    dbt->checkpoint_pending = true;
+    dbt->stats.commits++;
+    dbt->stats.wal_bytes += offset + sizeof(commit);
+    dbt_checkpoint(dbt);
+    return true;
+}
+
+// 丢弃上次提交之后的所有修改
+bool dbt_rollback(disk_btree_t *dbt)
+{
+    if (dbt == NULL || dbt->poisoned)
+    {
+        return false;
+    }
+    if (dbt->checkpoint_pending)
+    {
+        // 修改过的帧都是已提交但未写回的页，没有可丢弃的修改
+        return true;
+    }
+    for (size_t i = 0; i < dbt->capacity; i++)
+    {
+        dbt_frame_t *frame = &dbt->frames[i];
+        if (frame->used && frame->dirty)
+        {
+            dbt_table_remove(dbt, frame->page_no);
+            frame->used = false;
+            frame->dirty = false;
+            frame->pins = 0;
+        }
+    }
+    dbt->dirty = 0;
+    dbt->meta = dbt->committed;
+    dbt->meta_dirty = false;
+    return true;
+}
+
+// 获取键数（含未提交的修改）
+size_t dbt_size(disk_btree_t *dbt)
+{
+    if (dbt == NULL)
+    {
+        return 0;
+    }
+    return (size_t)dbt->meta.count;
+}
+
+// 判断是否为空
+bool dbt_is_empty(disk_btree_t *dbt)
+{
+    return dbt_size(dbt) == 0;
+}
+
+// 获取树高
+uint32_t dbt_height(disk_btree_t *dbt)
+{
+    if (dbt == NULL)
+    {
+        return 0;
+    }
+    return dbt->meta.height;
+}
+
+// 查找key所在的叶节点，返回其内容（调用方用dbt_unpin释放frame）
+static const dbt_leaf_page_t *dbt_find_leaf(disk_btree_t *dbt, uint64_t key, dbt_frame_t **frame)
+{
+    uint64_t page_no = dbt->meta.root;
+    for (uint32_t level = dbt->meta.height; level > 1; level--)
+    {
+        const dbt_inner_page_t *inner = (const dbt_inner_page_t *)dbt_read(dbt, page_no, DBT_PAGE_INNER, frame);
+        if (inner == NULL)
+        {
+            return NULL;
+        }
+        page_no = inner->children[dbt_upper(inner->keys, inner->header.count, key)];
+        dbt_unpin(*frame);
+    }
+    return (const dbt_leaf_page_t *)dbt_read(dbt, page_no, DBT_PAGE_LEAF, frame);
+}
+
+// 查找key，存在时通过value返回值（value可以为NULL）
+bool dbt_get(disk_btree_t *dbt, uint64_t key, uint64_t *value)
+{
+    if (dbt == NULL || dbt->meta.root == 0)
+    {
+        return false;
+    }
+    dbt_frame_t *frame;
+    const dbt_leaf_page_t *leaf = dbt_find_leaf(dbt, key, &frame);
+    if (leaf == NULL)
+    {
+        return false;
+    }
+    size_t pos = dbt_lower(leaf->keys, leaf->header.count, key);
+    bool found = pos < leaf->header.count && leaf->keys[pos] == key;
+    if (found && value != NULL)
+    {
+        *value = leaf->values[pos];
+    }
+    dbt_unpin(frame);
+    return found;
+}
+
+// 按升序复制键在[low, high)内的元素，最多max个，返回复制的个数
+// keys或values为NULL时不复制对应部分；元素多于max时可从最后一个键加1处继续
+size_t dbt_range(disk_btree_t *dbt, uint64_t low, uint64_t high, uint64_t *keys, uint64_t *values, size_t max)
+{
+    if (dbt == NULL || dbt->meta.root == 0 || low >= high || max == 0)
+    {
+        return 0;
+    }
+    dbt_frame_t *frame;
+    const dbt_leaf_page_t *leaf = dbt_find_leaf(dbt, low, &frame);
+    size_t pos = leaf != NULL ? dbt_lower(leaf->keys, leaf->header.count, low) : 0;
+    size_t copied = 0;
+    while (leaf != NULL)
+    {
+        size_t count = leaf->header.count;
+        while (pos < count && copied < max && leaf->keys[pos] < high)
+        {
+            if (keys != NULL)
+            {
+                keys[copied] = leaf->keys[pos];
+            }
+            if (values != NULL)
+            {
+                values[copied] = leaf->values[pos];
+            }
+            copied++;
+            pos++;
+        }
+        uint64_t next = leaf->header.next;
+        dbt_unpin(frame);
+        if (pos < count || copied == max || next == 0)
+        {
+            break;
+        }
+        leaf = (const dbt_leaf_page_t *)dbt_read(dbt, next, DBT_PAGE_LEAF, &frame);
+        pos = 0;
+    }
+    return copied;
+}
+
+// 写操作前检查：只读或poisoned时失败；上次提交未写回时先重试写回；可淘汰的帧不足时先提交
+static bool dbt_begin_write(disk_btree_t *dbt)
+{
+    if (dbt->wal_fd < 0 || dbt->poisoned)
+    {
+        return false;
+    }
+    if (dbt->checkpoint_pending && !dbt_checkpoint(dbt))
+    {
+        return false;
+    }
+    if (dbt->capacity - dbt->dirty < DBT_RESERVE(dbt->meta.height))
+    {
+        return dbt_commit(dbt) && !dbt->checkpoint_pending;
+    }
+    return true;
+}
+
+// 在叶节点中插入或更新；满时分裂，返回1并通过split_key/split_page返回右半的首键与页号
+static int dbt_leaf_insert(disk_btree_t *dbt, dbt_frame_t *frame, uint64_t key, uint64_t value, bool *added,
+                           uint64_t *split_key, uint64_t *split_page)
+{
+    dbt_leaf_page_t *leaf = (dbt_leaf_page_t *)frame->data;
+    size_t count = leaf->header.count;
+    size_t pos = dbt_lower(leaf->keys, count, key);
+    dbt_mark_dirty(dbt, frame);
+    if (pos < count && leaf->keys[pos] == key)
+    {
+        leaf->values[pos] = value;
+        return 0;
+    }
+    *added = true;
+    if (count < DBT_LEAF_KEYS)
+    {
+        memmove(leaf->keys + pos + 1, leaf->keys + pos, (count - pos) * sizeof(uint64_t));
+        memmove(leaf->values + pos + 1, leaf->values + pos, (count - pos) * sizeof(uint64_t));
+        leaf->keys[pos] = key;
+        leaf->values[pos] = value;
+        leaf->header.count++;
+        return 0;
+    }
+
+    dbt_frame_t *right_frame = dbt_alloc_page(dbt, DBT_PAGE_LEAF);
+    if (right_frame == NULL)
+    {
+        return -1;
+    }
+    dbt_leaf_page_t *right = (dbt_leaf_page_t *)right_frame->data;
+    uint64_t keys[DBT_LEAF_KEYS + 1];
+    uint64_t values[DBT_LEAF_KEYS + 1];
+    memcpy(keys, leaf->keys, pos * sizeof(uint64_t));
+    memcpy(values, leaf->values, pos * sizeof(uint64_t));
+    keys[pos] = key;
+    values[pos] = value;
+    memcpy(keys + pos + 1, leaf->keys + pos, (count - pos) * sizeof(uint64_t));
+    memcpy(values + pos + 1, leaf->values + pos, (count - pos) * sizeof(uint64_t));
+
+    // 在最右叶节点末尾追加时左侧保持满，顺序插入得到的叶节点都是满的
+    size_t keep = pos == count && leaf->header.next == 0 ? count : (count + 1) / 2;
+    memcpy(leaf->keys, keys, keep * sizeof(uint64_t));
+    memcpy(leaf->values, values, keep * sizeof(uint64_t));
+    memcpy(right->keys, keys + keep, (count + 1 - keep) * sizeof(uint64_t));
+    memcpy(right->values, values + keep, (count + 1 - keep) * sizeof(uint64_t));
+    leaf->header.count = (uint16_t)keep;
+    right->header.count = (uint16_t)(count + 1 - keep);
+    right->header.next = leaf->header.next;
+    leaf->header.next = right_frame->page_no;
+
+    *split_key = right->keys[0];
+    *split_page = right_frame->page_no;
+    dbt_unpin(right_frame);
+    return 1;
+}
+
+// 子节点idx分裂后在内部节点中加入分隔键与新子节点；满时分裂，中间的键上移
+static int dbt_inner_insert(disk_btree_t *dbt, dbt_frame_t *frame, size_t idx, uint64_t sep, uint64_t child,
+                            uint64_t *split_key, uint64_t *split_page)
+{
+    dbt_inner_page_t *inner = (dbt_inner_page_t *)frame->data;
+    size_t count = inner->header.count;
+    dbt_mark_dirty(dbt, frame);
+    if (count < DBT_INNER_KEYS)
+    {
+        memmove(inner->keys + idx + 1, inner->keys + idx, (count - idx) * sizeof(uint64_t));
+        memmove(inner->children + idx + 2, inner->children + idx + 1, (count - idx) * sizeof(uint64_t));
+        inner->keys[idx] = sep;
+        inner->children[idx + 1] = child;
+        inner->header.count++;
+        return 0;
+    }
+
+    dbt_frame_t *right_frame = dbt_alloc_page(dbt, DBT_PAGE_INNER);
+    if (right_frame == NULL)
+    {
+        return -1;
+    }
+    dbt_inner_page_t *right = (dbt_inner_page_t *)right_frame->data;
+    uint64_t keys[DBT_INNER_KEYS + 1];
+    uint64_t children[DBT_INNER_KEYS + 2];
+    memcpy(keys, inner->keys, idx * sizeof(uint64_t));
+    keys[idx] = sep;
+    memcpy(keys + idx + 1, inner->keys + idx, (count - idx) * sizeof(uint64_t));
+    memcpy(children, inner->children, (idx + 1) * sizeof(uint64_t));
+    children[idx + 1] = child;
+    memcpy(children + idx + 2, inner->children + idx + 1, (count - idx) * sizeof(uint64_t));
+
+    size_t total = count + 1;
+    size_t left = total / 2;
+    size_t right_count = total - left - 1;
+    memcpy(inner->keys, keys, left * sizeof(uint64_t));
+    memcpy(inner->children, children, (left + 1) * sizeof(uint64_t));
+    memcpy(right->keys, keys + left + 1, right_count * sizeof(uint64_t));
+    memcpy(right->children, children + left + 1, (right_count + 1) * sizeof(uint64_t));
+    inner->header.count = (uint16_t)left;
+    right->header.count = (uint16_t)right_count;
+
+    *split_key = keys[left];
+    *split_page = right_frame->page_no;
+    dbt_unpin(right_frame);
+    return 1;
+}
+
+// 递归插入：返回-1出错，0完成，1本节点分裂
+static int dbt_insert(disk_btree_t *dbt, uint64_t page_no, uint32_t level, uint64_t key, uint64_t value,
+                      bool *added, uint64_t *split_key, uint64_t *split_page)
+{
+    dbt_frame_t *frame = dbt_pin_node(dbt, page_no, dbt_level_type(level));
+    if (frame == NULL)
+    {
+        return -1;
+    }
+    int result;
+    if (level == 1)
+    {
+        result = dbt_leaf_insert(dbt, frame, key, value, added, split_key, split_page);
+    }
+    else
+    {
+        dbt_inner_page_t *inner = (dbt_inner_page_t *)frame->data;
+        size_t idx = dbt_upper(inner->keys, inner->header.count, key);
+        uint64_t sep;
+        uint64_t child;
+        result = dbt_insert(dbt, inner->children[idx], level - 1, key, value, added, &sep, &child);
+        if (result == 1)
+        {
+            result = dbt_inner_insert(dbt, frame, idx, sep, child, split_key, split_page);
+        }
+    }
+    dbt_unpin(frame);
+    return result;
+}
+
+// 插入或更新键值对；失败时回滚到上次提交并返回false
+bool dbt_put(disk_btree_t *dbt, uint64_t key, uint64_t value)
+{
+    if (dbt == NULL || !dbt_begin_write(dbt))
+    {
+        return false;
+    }
+
+    int result;
+    bool added = false;
+    if (dbt->meta.root == 0)
+    {
+        dbt_frame_t *frame = dbt_alloc_page(dbt, DBT_PAGE_LEAF);
+        result = frame != NULL ? 0 : -1;
+        if (frame != NULL)
+        {
+            dbt_leaf_page_t *leaf = (dbt_leaf_page_t *)frame->data;
+            leaf->keys[0] = key;
+            leaf->values[0] = value;
+            leaf->header.count = 1;
+            dbt->meta.root = frame->page_no;
+            dbt->meta.height = 1;
+            added = true;
+            dbt_unpin(frame);
+        }
+    }
+    else
+    {
+        uint64_t sep;
+        uint64_t right;
+        result = dbt_insert(dbt, dbt->meta.root, dbt->meta.height, key, value, &added, &sep, &right);
+        if (result == 1)
+        {
+            // 根分裂，树长高一层
+            dbt_frame_t *frame = dbt_alloc_page(dbt, DBT_PAGE_INNER);
+            result = frame != NULL ? 0 : -1;
+            if (frame != NULL)
+            {
+                dbt_inner_page_t *root = (dbt_inner_page_t *)frame->data;
+                root->keys[0] = sep;
+                root->children[0] = dbt->meta.root;
+                root->children[1] = right;
+                root->header.count = 1;
+                dbt->meta.root = frame->page_no;
+                dbt->meta.height++;
+                dbt_unpin(frame);
+            }
+        }
+    }
+    if (result < 0)
+    {
+        dbt_rollback(dbt);
+        return false;
+    }
+    if (added)
+    {
+        dbt->meta.count++;
+        dbt->meta_dirty = true;
+    }
+    return true;
+}
+
+// 相邻叶节点：放得下时把右侧并入左侧返回true，否则平分键并更新分隔键
+static bool dbt_rebalance_leaves(dbt_leaf_page_t *left, dbt_leaf_page_t *right, uint64_t *sep)
+{
+    size_t lc = left->header.count;
+    size_t rc = right->header.count;
+    size_t total = lc + rc;
+    if (total <= DBT_LEAF_KEYS)
+    {
+        memcpy(left->keys + lc, right->keys, rc * sizeof(uint64_t));
+        memcpy(left->values + lc, right->values, rc * sizeof(uint64_t));
+        left->header.count = (uint16_t)total;
+        left->header.next = right->header.next;
+        return true;
+    }
+
+    size_t target = total / 2;
+    if (lc < target)
+    {
+        size_t move = target - lc;
+        memcpy(left->keys + lc, right->keys, move * sizeof(uint64_t));
+        memcpy(left->values + lc, right->values, move * sizeof(uint64_t));
+        memmove(right->keys, right->keys + move, (rc - move) * sizeof(uint64_t));
+        memmove(right->values, right->values + move, (rc - move) * sizeof(uint64_t));
+    }
+    else
+    {
+        size_t move = lc - target;
+        memmove(right->keys + move, right->keys, rc * sizeof(uint64_t));
+        memmove(right->values + move, right->values, rc * sizeof(uint64_t));
+        memcpy(right->keys, left->keys + target, move * sizeof(uint64_t));
+        memcpy(right->values, left->values + target, move * sizeof(uint64_t));
+    }
+    left->header.count = (uint16_t)target;
+    right->header.count = (uint16_t)(total - target);
+    *sep = right->keys[0];
+    return false;
+}
+
+// 相邻内部节点：连同分隔键放得下时合并到左侧返回true，否则经分隔键平分
+static bool dbt_rebalance_inner(dbt_inner_page_t *left, dbt_inner_page_t *right, uint64_t *sep)
+{
+    size_t lc = left->header.count;
+    size_t rc = right->header.count;
+    size_t total = lc + rc + 1;
+    if (total <= DBT_INNER_KEYS)
+    {
+        left->keys[lc] = *sep;
+        memcpy(left->keys + lc + 1, right->keys, rc * sizeof(uint64_t));
+        memcpy(left->children + lc + 1, right->children, (rc + 1) * sizeof(uint64_t));
+        left->header.count = (uint16_t)total;
+        return true;
+    }
+
+    uint64_t keys[2 * DBT_INNER_KEYS + 1];
+    uint64_t children[2 * DBT_INNER_KEYS + 2];
+    memcpy(keys, left->keys, lc * sizeof(uint64_t));
+    keys[lc] = *sep;
+    memcpy(keys + lc + 1, right->keys, rc * sizeof(uint64_t));
+    memcpy(children, left->children, (lc + 1) * sizeof(uint64_t));
+    memcpy(children + lc + 1, right->children, (rc + 1) * sizeof(uint64_t));
+
+    size_t target = total / 2;
+    size_t right_count = total - target - 1;
+    memcpy(left->keys, keys, target * sizeof(uint64_t));
+    memcpy(left->children, children, (target + 1) * sizeof(uint64_t));
+    memcpy(right->keys, keys + target + 1, right_count * sizeof(uint64_t));
+    memcpy(right->children, children + target + 1, (right_count + 1) * sizeof(uint64_t));
+    left->header.count = (uint16_t)target;
+    right->header.count = (uint16_t)right_count;
+    *sep = keys[target];
+    return false;
+}
+
+// 合并或重新分配父节点中相邻的子节点i与i + 1，child_level为子节点所在层
+static int dbt_rebalance(disk_btree_t *dbt, dbt_frame_t *parent_frame, uint32_t child_level, size_t i)
+{
+    dbt_inner_page_t *parent = (dbt_inner_page_t *)parent_frame->data;
+    dbt_page_type_t type = dbt_level_type(child_level);
+    dbt_frame_t *left = dbt_pin_node(dbt, parent->children[i], type);
+    dbt_frame_t *right = left != NULL ? dbt_pin_node(dbt, parent->children[i + 1], type) : NULL;
+    if (right == NULL)
+    {
+        dbt_unpin(left);
+        return -1;
+    }
+    dbt_mark_dirty(dbt, parent_frame);
+    dbt_mark_dirty(dbt, left);
+    dbt_mark_dirty(dbt, right);
+
+    bool merged;
+    if (type == DBT_PAGE_LEAF)
+    {
+        merged = dbt_rebalance_leaves((dbt_leaf_page_t *)left->data, (dbt_leaf_page_t *)right->data, &parent->keys[i]);
+    }
+    else
+    {
+        merged = dbt_rebalance_inner((dbt_inner_page_t *)left->data, (dbt_inner_page_t *)right->data, &parent->keys[i]);
+    }
+    uint64_t right_page = right->page_no;
+    dbt_unpin(left);
+    dbt_unpin(right);
+    if (!merged)
+    {
+        return 1;
+    }
+
+    size_t count = parent->header.count;
+    memmove(parent->keys + i, parent->keys + i + 1, (count - i - 1) * sizeof(uint64_t));
+    memmove(parent->children + i + 1, parent->children + i + 2, (count - i - 1) * sizeof(uint64_t));
+    parent->header.count--;
+    return dbt_free_page(dbt, right_page) ? 1 : -1;
+}
+
+// 递归删除：返回-1出错，0不存在，1已删除；remaining返回删除后本节点的键数
+static int dbt_delete(disk_btree_t *dbt, uint64_t page_no, uint32_t level, uint64_t key, uint64_t *value,
+                      size_t *remaining)
+{
+    dbt_frame_t *frame = dbt_pin_node(dbt, page_no, dbt_level_type(level));
+    if (frame == NULL)
+    {
+        return -1;
+    }
+    int result;
+    if (level == 1)
+    {
+        dbt_leaf_page_t *leaf = (dbt_leaf_page_t *)frame->data;
+        size_t count = leaf->header.count;
+        size_t pos = dbt_lower(leaf->keys, count, key);
+        result = pos < count && leaf->keys[pos] == key ? 1 : 0;
+        if (result == 1)
+        {
+            dbt_mark_dirty(dbt, frame);
+            *value = leaf->values[pos];
+            memmove(leaf->keys + pos, leaf->keys + pos + 1, (count - pos - 1) * sizeof(uint64_t));
+            memmove(leaf->values + pos, leaf->values + pos + 1, (count - pos - 1) * sizeof(uint64_t));
+            leaf->header.count--;
+        }
+        *remaining = leaf->header.count;
+    }
+    else
+    {
+        dbt_inner_page_t *inner = (dbt_inner_page_t *)frame->data;
+        size_t count = inner->header.count;
+        size_t idx = dbt_upper(inner->keys, count, key);
+        size_t child_count;
+        result = dbt_delete(dbt, inner->children[idx], level - 1, key, value, &child_count);
+        size_t min = level - 1 == 1 ? DBT_LEAF_MIN : DBT_INNER_MIN;
+        if (result == 1 && child_count < min && count > 0)
+        {
+            result = dbt_rebalance(dbt, frame, level - 1, idx < count ? idx : idx - 1);
+        }
+        *remaining = inner->header.count;
+    }
+    dbt_unpin(frame);
+    return result;
+}
+
+// 删除key，存在时通过value返回被删除的值（value可以为NULL）；出错时回滚到上次提交并返回false
+bool dbt_remove(disk_btree_t *dbt, uint64_t key, uint64_t *value)
+{
+    if (dbt == NULL || dbt->meta.root == 0 || !dbt_begin_write(dbt))
+    {
+        return false;
+    }
+    uint64_t removed = 0;
+    size_t remaining;
+    int result = dbt_delete(dbt, dbt->meta.root, dbt->meta.height, key, &removed, &remaining);
+    if (result == 1 && remaining == 0)
+    {
+        // 根变空：叶根释放后成为空树，内部根由唯一的子节点接替
+        uint64_t old_root = dbt->meta.root;
+        if (dbt->meta.height == 1)
+        {
+            dbt->meta.root = 0;
+            dbt->meta.height = 0;
+        }
+        else
+        {
+            dbt_frame_t *frame = dbt_pin_node(dbt, old_root, DBT_PAGE_INNER);
+            if (frame == NULL)
+            {
+                result = -1;
+            }
+            else
+            {
+                dbt->meta.root = ((dbt_inner_page_t *)frame->data)->children[0];
+                dbt->meta.height--;
+                dbt_unpin(frame);
+            }
+        }
+        if (result == 1 && !dbt_free_page(dbt, old_root))
+        {
+            result = -1;
+        }
+    }
+    if (result < 0)
+    {
+        dbt_rollback(dbt);
+        return false;
+    }
+    if (result == 0)
+    {
+        return false;
+    }
+    dbt->meta.count--;
+    dbt->meta_dirty = true;
+    if (value != NULL)
+    {
+        *value = removed;
+    }
+    return true;
+}
+
+// 批量构建时的顺序页写入器
+typedef struct dbt_bulk_writer
+{
+    int fd;
+    uint8_t *buf;
+    size_t pages;       // 缓冲中的页数
+    uint64_t first;     // 缓冲中第一页的页号
+} dbt_bulk_writer_t;
+
+static bool dbt_bulk_flush(dbt_bulk_writer_t *writer)
+{
+    bool ok = dbt_pwrite_all(writer->fd, writer->buf, writer->pages * DBT_PAGE_SIZE, writer->first * DBT_PAGE_SIZE);
+    writer->first += writer->pages;
+    writer->pages = 0;
+    return ok;
+}
+
+// 取缓冲中下一页（清零），缓冲满时先写出
+static uint8_t *dbt_bulk_page(dbt_bulk_writer_t *writer, bool *ok)
+{
+    if (writer->pages == DBT_BULK_PAGES)
+    {
+        *ok = *ok && dbt_bulk_flush(writer);
+    }
+    uint8_t *page = writer->buf + writer->pages * DBT_PAGE_SIZE;
+    memset(page, 0, DBT_PAGE_SIZE);
+    writer->pages++;
+    return page;
+}
+
+// 从严格递增的键批量构建空树：自底向上逐层生成满节点，页号连续地追加在文件末尾，
+// 不经过页缓存与日志；全部写入并fsync后再提交元数据页，中途失败时树仍为空
+// 每层最后一个节点可能不满
+bool dbt_bulk_load(disk_btree_t *dbt, const uint64_t *keys, const uint64_t *values, size_t n)
+{
+    if (dbt == NULL || dbt->wal_fd < 0 || dbt->meta.root != 0 || (n > 0 && (keys == NULL || values == NULL)))
+    {
+        return false;
+    }
+    for (size_t i = 1; i < n; i++)
+    {
+        if (keys[i - 1] >= keys[i])
+        {
+            return false;
+        }
+    }
+    if (n == 0)
+    {
+        return true;
+    }
+    // 之后直接写文件末尾并覆盖日志，之前的提交须已写回
+    if (!dbt_commit(dbt) || dbt->checkpoint_pending)
+    {
+        return false;
+    }
+
+    // firsts[i]为当前层第i个节点子树中的最小键，当前层的节点页号从level_start起连续
+    size_t nodes = (n + DBT_LEAF_KEYS - 1) / DBT_LEAF_KEYS;
+    uint64_t *firsts = (uint64_t *)malloc(nodes * sizeof(uint64_t));
+    dbt_bulk_writer_t writer = {dbt->fd, (uint8_t *)malloc(DBT_BULK_PAGES * DBT_PAGE_SIZE), 0, dbt->meta.page_count};
+    if (firsts == NULL || writer.buf == NULL)
+    {
+        free(firsts);
+        free(writer.buf);
+        return false;
+    }
+
+    bool ok = true;
+    uint64_t level_start = writer.first;
+    for (size_t i = 0; i < nodes; i++)
+    {
+        dbt_leaf_page_t *leaf = (dbt_leaf_page_t *)dbt_bulk_page(&writer, &ok);
+        size_t begin = i * DBT_LEAF_KEYS;
+        size_t count = n - begin < DBT_LEAF_KEYS ? n - begin : DBT_LEAF_KEYS;
+        leaf->header.type = DBT_PAGE_LEAF;
+        leaf->header.count = (uint16_t)count;
+        leaf->header.next = i + 1 < nodes ? level_start + i + 1 : 0;
+        memcpy(leaf->keys, keys + begin, count * sizeof(uint64_t));
+        memcpy(leaf->values, values + begin, count * sizeof(uint64_t));
+        firsts[i] = keys[begin];
+    }
+
+    uint32_t height = 1;
+    while (nodes > 1)
+    {
+        size_t fanout = DBT_INNER_KEYS + 1;
+        size_t parents = (nodes + fanout - 1) / fanout;
+        uint64_t parent_start = level_start + nodes;
+        for (size_t i = 0; i < parents; i++)
+        {
+            dbt_inner_page_t *inner = (dbt_inner_page_t *)dbt_bulk_page(&writer, &ok);
+            size_t begin = i * fanout;
+            size_t count = nodes - begin < fanout ? nodes - begin : fanout;
+            inner->header.type = DBT_PAGE_INNER;
+            inner->header.count = (uint16_t)(count - 1);
+            for (size_t c = 0; c < count; c++)
+            {
+                inner->children[c] = level_start + begin + c;
+                if (c > 0)
+                {
+                    inner->keys[c - 1] = firsts[begin + c];
+                }
+            }
+            firsts[i] = firsts[begin];
+        }
+        level_start = parent_start;
+        nodes = parents;
+        height++;
+    }
+    ok = ok && dbt_bulk_flush(&writer) && fsync(dbt->fd) == 0;
+    free(firsts);
+    free(writer.buf);
+    if (!ok)
+    {
+        return false;
+    }
+
+    dbt->stats.pages_written += writer.first - dbt->meta.page_count;
+    dbt->meta.root = level_start;
+    dbt->meta.height = height;
+    dbt->meta.count = n;
+    dbt->meta.page_count = writer.first;
+    dbt->meta_dirty = true;
+    if (!dbt_commit(dbt))
+    {
+        dbt_rollback(dbt);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,154 @@
+#ifndef __DISK_BTREE_H__
+#define __DISK_BTREE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DBT_PAGE_SIZE 4096
+#define DBT_LEAF_KEYS 255           // 叶节点最多键数
+#define DBT_INNER_KEYS 254          // 内部节点最多键数（子节点数加1）
+#define DBT_MIN_CACHE 64            // 页缓存最少页数
+#define DBT_DEFAULT_CACHE 1024      // 默认页缓存页数（4MB）
+
+#define DBT_MAGIC 0x3130454552544244ull    // "DBTREE01"
+#define DBT_VERSION 1
+
+// dbt_open的flags
+#define DBT_READONLY 1u
+#define DBT_MMAP 2u                 // 只读映射整个文件，查询不经过页缓存；隐含DBT_READONLY
+
+// 磁盘B+树
+// 键值均为uint64_t，保存在文件中定长4KB的页里，重启后直接打开即可查询，无需重新加载。
+// 读写经过进程内有界的页缓存，用CLOCK算法淘汰未修改的页。
+// 修改先留在缓存中，dbt_commit时以预写日志（路径加"-wal"的文件）保证崩溃安全：
+// 1. 把所有修改过的页（含元数据页）的完整映像与提交记录写入日志并fsync，此后即已提交；
+// 2. 把这些页写回数据文件并fsync；
+// 3. 清空日志。
+// 第2、3步失败时提交仍然有效（下次打开时从日志重放），这些页留在缓存中不被淘汰，
+// 之后的写操作前先重试写回，写回成功前写操作失败，也没有可回滚的修改。
+// 第1步失败时清空日志，使这次提交在重新打开后不生效；清空也失败时下次打开可能重放这次提交，
+// 内存中的状态不再可信，此后的写操作、提交与回滚都失败，只能关闭后重新打开。
+// 打开时若日志中有完整的提交记录，就把其中的页重放到数据文件，否则丢弃日志；
+// 因此数据文件总是处于某次提交之后的状态。
+// 修改过的页在提交前不会被淘汰，缓存中可淘汰的页不足时，写操作之前会自动提交。
+// 操作中途出错（I/O失败等）时回滚到上次提交的状态。
+// dbt_bulk_load从有序输入自底向上构建，页直接顺序写入文件末尾，最后提交元数据页。
+
+// 文件格式：第0页为元数据页，其余为节点页或空闲页
+typedef struct dbt_meta
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t page_size;
+    uint64_t root;          // 根节点页号，0表示空树
+    uint64_t page_count;    // 文件中的页数（含元数据页）
+    uint64_t free_head;     // 空闲页链表头，0表示没有
+    uint64_t count;         // 键数
+    uint32_t height;        // 树高，叶节点为1层，空树为0
+    uint32_t reserved;
+    uint64_t txn;           // 已提交的事务数
+    uint64_t checksum;      // 以上字段的hash_bytes
+} dbt_meta_t;
+
+typedef enum dbt_page_type
+{
+    DBT_PAGE_FREE,
+    DBT_PAGE_LEAF,
+    DBT_PAGE_INNER
+} dbt_page_type_t;
+
+typedef struct dbt_page_header
+{
+    uint16_t type;
+    uint16_t count;         // 键数
+    uint32_t reserved;
+    uint64_t next;          // 叶节点：右侧兄弟页号；空闲页：下一个空闲页号
+} dbt_page_header_t;
+
+typedef struct dbt_leaf_page
+{
+    dbt_page_header_t header;
+    uint64_t keys[DBT_LEAF_KEYS];
+    uint64_t values[DBT_LEAF_KEYS];
+} dbt_leaf_page_t;
+
+// children[i]中的键小于keys[i]，children[i + 1]中的键不小于keys[i]
+typedef struct dbt_inner_page
+{
+    dbt_page_header_t header;
+    uint64_t keys[DBT_INNER_KEYS];
+    uint64_t children[DBT_INNER_KEYS + 1];
+} dbt_inner_page_t;
+
+// 日志记录：页记录后紧跟DBT_PAGE_SIZE字节的页映像，校验和为hash_bytes_seeded(映像, 页大小, 页号)；
+// 提交记录的page_no为之前的页记录数，校验和为各页记录校验和依次hash_combine（初值0）的结果
+#define DBT_WAL_PAGE 0x454741504c415744ull     // "DWALPAGE"
+#define DBT_WAL_COMMIT 0x54494d4d4f434c57ull   // "WLCOMMIT"
+
+typedef struct dbt_wal_record
+{
+    uint64_t tag;
+    uint64_t page_no;
+    uint64_t checksum;
+} dbt_wal_record_t;
+
+// 页缓存中的一帧
+typedef struct dbt_frame
+{
+    uint64_t page_no;
+    uint8_t *data;
+    uint32_t pins;          // 正在使用该页的操作数，大于0时不可淘汰
+    bool used;
+    bool ref;               // CLOCK访问位
+    bool dirty;
+} dbt_frame_t;
+
+// 页缓存与I/O统计
+typedef struct dbt_stats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t commits;
+    uint64_t pages_written;     // 写回数据文件的页数
+    uint64_t wal_bytes;
+} dbt_stats_t;
+
+typedef struct disk_btree
+{
+    int fd;
+    int wal_fd;                 // 只读打开时为-1
+    unsigned flags;
+    dbt_meta_t meta;            // 当前（可能未提交的）元数据
+    dbt_meta_t committed;       // 上次提交的元数据，回滚时恢复
+    bool meta_dirty;
+    bool checkpoint_pending;    // 已提交但写回数据文件失败，修改过的帧都是已提交的页
+    bool poisoned;              // 提交失败后清空日志也失败，日志内容不可信，不再接受修改
+    const uint8_t *map;         // DBT_MMAP时的映射
+    size_t map_size;
+    dbt_frame_t *frames;
+    uint8_t *cache;             // 各帧的页数据，按页对齐
+    size_t capacity;            // 帧数
+    size_t hand;                // CLOCK指针
+    size_t dirty;               // 修改过的帧数
+    uint32_t *table;            // 页号到帧下标+1的开放寻址表，0为空
+    size_t table_mask;
+    dbt_stats_t stats;
+} disk_btree_t;
+
+disk_btree_t *dbt_open(const char *path, unsigned flags, size_t cache_pages);
+bool dbt_close(disk_btree_t *dbt);
+bool dbt_commit(disk_btree_t *dbt);
+bool dbt_rollback(disk_btree_t *dbt);
+size_t dbt_size(disk_btree_t *dbt);
+bool dbt_is_empty(disk_btree_t *dbt);
+uint32_t dbt_height(disk_btree_t *dbt);
+
+bool dbt_put(disk_btree_t *dbt, uint64_t key, uint64_t value);
+bool dbt_get(disk_btree_t *dbt, uint64_t key, uint64_t *value);
+bool dbt_remove(disk_btree_t *dbt, uint64_t key, uint64_t *value);
+size_t dbt_range(disk_btree_t *dbt, uint64_t low, uint64_t high, uint64_t *keys, uint64_t *values, size_t max);
+bool dbt_bulk_load(disk_btree_t *dbt, const uint64_t *keys, const uint64_t *values, size_t n);
+
+#endif // __DISK_BTREE_H__
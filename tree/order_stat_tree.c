@@ -0,0 +1,370 @@
+#include "order_stat_tree.h"
+#include <stdlib.h>
+
+// 重量平衡参数：一侧重量（大小+1）超过另一侧的OST_DELTA倍时旋转，
+// 内侧孙子树的重量不小于外侧的OST_GAMMA倍时做双旋；(3, 2)保证单次插入或删除后一次旋转即可恢复平衡
+#define OST_DELTA 3
+#define OST_GAMMA 2
+
+static size_t ost_node_size(ost_node_t *node)
+{
+    return node == NULL ? 0 : node->size;
+}
+
+static size_t ost_weight(ost_node_t *node)
+{
+    return ost_node_size(node) + 1;
+}
+
+static void ost_update(ost_node_t *node)
+{
+    node->size = ost_node_size(node->left) + ost_node_size(node->right) + 1;
+}
+
+static ost_node_t *ost_rotate_left(ost_node_t *node)
+{
+    ost_node_t *right = node->right;
+    node->right = right->left;
+    right->left = node;
+    ost_update(node);
+    ost_update(right);
+    return right;
+}
+
+static ost_node_t *ost_rotate_right(ost_node_t *node)
+{
+    ost_node_t *left = node->left;
+    node->left = left->right;
+    left->right = node;
+    ost_update(node);
+    ost_update(left);
+    return left;
+}
+
+// 子树变化后更新大小，失衡时做单旋或双旋，返回新的子树根
+static ost_node_t *ost_balance(ost_node_t *node)
+{
+    size_t wl = ost_weight(node->left);
+    size_t wr = ost_weight(node->right);
+    node->size = wl + wr - 1;
+
+    if (wr > OST_DELTA * wl)
+    {
+        ost_node_t *right = node->right;
+        if (ost_weight(right->left) >= OST_GAMMA * ost_weight(right->right))
+        {
+            node->right = ost_rotate_right(right);
+        }
+        return ost_rotate_left(node);
+    }
+    if (wl > OST_DELTA * wr)
+    {
+        ost_node_t *left = node->left;
+        if (ost_weight(left->right) >= OST_GAMMA * ost_weight(left->left))
+        {
+            node->left = ost_rotate_left(left);
+        }
+        return ost_rotate_right(node);
+    }
+    return node;
+}
+
+// 相等的键插入右子树，使重复键保持插入顺序
+static ost_node_t *ost_insert_node(order_stat_tree_t *ost, ost_node_t *node, ost_node_t *leaf)
+{
+    if (node == NULL)
+    {
+        return leaf;
+    }
+    if (ost->cmp(leaf->key, node->key) < 0)
+    {
+        node->left = ost_insert_node(ost, node->left, leaf);
+    }
+    else
+    {
+        node->right = ost_insert_node(ost, node->right, leaf);
+    }
+    return ost_balance(node);
+}
+
+static ost_node_t *ost_remove_min(ost_node_t *node, ost_node_t **min)
+{
+    if (node->left == NULL)
+    {
+        *min = node;
+        return node->right;
+    }
+    node->left = ost_remove_min(node->left, min);
+    return ost_balance(node);
+}
+
+static ost_node_t *ost_remove_max(ost_node_t *node, ost_node_t **max)
+{
+    if (node->right == NULL)
+    {
+        *max = node;
+        return node->left;
+    }
+    node->right = ost_remove_max(node->right, max);
+    return ost_balance(node);
+}
+
+// 合并被删除节点的左右子树：从较大的一侧取出最靠近的节点作为新根
+static ost_node_t *ost_glue(ost_node_t *left, ost_node_t *right)
+{
+    if (left == NULL)
+    {
+        return right;
+    }
+    if (right == NULL)
+    {
+        return left;
+    }
+
+    ost_node_t *root;
+    if (left->size > right->size)
+    {
+        left = ost_remove_max(left, &root);
+    }
+    else
+    {
+        right = ost_remove_min(right, &root);
+    }
+    root->left = left;
+    root->right = right;
+    return ost_balance(root);
+}
+
+// 删除一个与key相等的节点，通过removed返回；不存在时子树不变
+static ost_node_t *ost_remove_node(order_stat_tree_t *ost, ost_node_t *node, void *key, ost_node_t **removed)
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    int c = ost->cmp(key, node->key);
+    if (c == 0)
+    {
+        *removed = node;
+        return ost_glue(node->left, node->right);
+    }
+    if (c < 0)
+    {
+        node->left = ost_remove_node(ost, node->left, key, removed);
+    }
+    else
+    {
+        node->right = ost_remove_node(ost, node->right, key, removed);
+    }
+    return *removed == NULL ? node : ost_balance(node);
+}
+
+// 创建顺序统计树
+order_stat_tree_t *ost_create(int (*cmp)(void *a, void *b))
+{
+    if (cmp == NULL)
+    {
+        return NULL;
+    }
+    order_stat_tree_t *ost = (order_stat_tree_t *)calloc(1, sizeof(order_stat_tree_t));
+    if (ost == NULL)
+    {
+        return NULL;
+    }
+    ost->pool = np_create(sizeof(ost_node_t), 0);
+    if (ost->pool == NULL)
+    {
+        free(ost);
+        return NULL;
+    }
+    ost->cmp = cmp;
+    return ost;
+}
+
+// 销毁顺序统计树（不释放键本身）
+void ost_destroy(order_stat_tree_t *ost)
+{
+    if (ost == NULL)
+    {
+        return;
+    }
+    np_destroy(ost->pool);
+    free(ost);
+}
+
+// 清空顺序统计树（不释放键本身）
+void ost_clear(order_stat_tree_t *ost)
+{
+    if (ost == NULL)
+    {
+        return;
+    }
+    np_clear(ost->pool);
+    ost->root = NULL;
+}
+
+// 获取元素个数
+size_t ost_size(order_stat_tree_t *ost)
+{
+    if (ost == NULL)
+    {
+        return 0;
+    }
+    return ost_node_size(ost->root);
+}
+
+// 判断是否为空
+bool ost_is_empty(order_stat_tree_t *ost)
+{
+    return ost_size(ost) == 0;
+}
+
+// 插入键，允许重复；内存不足返回false
+bool ost_insert(order_stat_tree_t *ost, void *key)
+{
+    if (ost == NULL)
+    {
+        return false;
+    }
+    ost_node_t *leaf = (ost_node_t *)np_alloc(ost->pool);
+    if (leaf == NULL)
+    {
+        return false;
+    }
+    leaf->key = key;
+    leaf->left = NULL;
+    leaf->right = NULL;
+    leaf->size = 1;
+    ost->root = ost_insert_node(ost, ost->root, leaf);
+    return true;
+}
+
+// 删除一个与key相等的键，不存在返回false
+bool ost_remove(order_stat_tree_t *ost, void *key)
+{
+    if (ost == NULL)
+    {
+        return false;
+    }
+    ost_node_t *removed = NULL;
+    ost->root = ost_remove_node(ost, ost->root, key, &removed);
+    if (removed == NULL)
+    {
+        return false;
+    }
+    np_free(ost->pool, removed);
+    return true;
+}
+
+// 判断是否存在与key相等的键
+bool ost_contains(order_stat_tree_t *ost, void *key)
+{
+    if (ost == NULL)
+    {
+        return false;
+    }
+    ost_node_t *node = ost->root;
+    while (node != NULL)
+    {
+        int c = ost->cmp(key, node->key);
+        if (c == 0)
+        {
+            return true;
+        }
+        node = c < 0 ? node->left : node->right;
+    }
+    return false;
+}
+
+// 统计排在key之前的键数；inclusive为true时也计入与key相等的键
+static size_t ost_count_before(order_stat_tree_t *ost, void *key, bool inclusive)
+{
+    size_t rank = 0;
+    ost_node_t *node = ost->root;
+    while (node != NULL)
+    {
+        int c = ost->cmp(node->key, key);
+        if (c < 0 || (inclusive && c == 0))
+        {
+            rank += ost_node_size(node->left) + 1;
+            node = node->right;
+        }
+        else
+        {
+            node = node->left;
+        }
+    }
+    return rank;
+}
+
+// 与key相等的键的个数
+size_t ost_count(order_stat_tree_t *ost, void *key)
+{
+    if (ost == NULL)
+    {
+        return 0;
+    }
+    return ost_count_before(ost, key, true) - ost_count_before(ost, key, false);
+}
+
+// 按升序第index个键（从0开始），越界返回NULL
+void *ost_select(order_stat_tree_t *ost, size_t index)
+{
+    if (ost == NULL || index >= ost_size(ost))
+    {
+        return NULL;
+    }
+    ost_node_t *node = ost->root;
+    for (;;)
+    {
+        size_t left = ost_node_size(node->left);
+        if (index < left)
+        {
+            node = node->left;
+        }
+        else if (index == left)
+        {
+            return node->key;
+        }
+        else
+        {
+            index -= left + 1;
+            node = node->right;
+        }
+    }
+}
+
+// 小于key的键的个数，即key插入后的最小名次；key不必存在
+size_t ost_rank(order_stat_tree_t *ost, void *key)
+{
+    if (ost == NULL)
+    {
+        return 0;
+    }
+    return ost_count_before(ost, key, false);
+}
+
+// q分位数（最近名次法）：升序第ceil(q*n)个键，q取0到1，空树返回NULL
+void *ost_quantile(order_stat_tree_t *ost, double q)
+{
+    size_t n = ost_size(ost);
+    if (n == 0)
+    {
+        return NULL;
+    }
+    if (!(q > 0.0))
+    {
+        return ost_select(ost, 0);
+    }
+    if (q >= 1.0)
+    {
+        return ost_select(ost, n - 1);
+    }
+    double pos = q * (double)n;
+    size_t rank = (size_t)pos;
+    if ((double)rank < pos)
+    {
+        rank++;
+    }
+    return ost_select(ost, rank - 1);
+}
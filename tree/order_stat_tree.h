@@ -0,0 +1,44 @@
+#ifndef __ORDER_STAT_TREE_H__
+#define __ORDER_STAT_TREE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "pool/node_pool.h"
+
+// 顺序统计树（有序多重集合）
+// 按cmp排序保存键，允许重复：cmp(a, b) < 0 表示a排在b前。
+// 每个节点记录子树大小，ost_select按名次取键、ost_rank统计小于某键的个数，
+// 与插入、删除一样都是O(log n)，适合在滑动窗口上增量维护分位数，而不必每次重新排序。
+// 子树大小同时用于平衡：采用重量平衡树（Adams，参数delta=3、gamma=2），
+// 不需要额外的颜色或高度字段。节点从树自带的节点池分配。
+typedef struct ost_node
+{
+    void *key;
+    struct ost_node *left;
+    struct ost_node *right;
+    size_t size;    // 子树中的元素数
+} ost_node_t;
+
+typedef struct order_stat_tree
+{
+    ost_node_t *root;
+    int (*cmp)(void *a, void *b);
+    node_pool_t *pool;
+} order_stat_tree_t;
+
+order_stat_tree_t *ost_create(int (*cmp)(void *a, void *b));
+void ost_destroy(order_stat_tree_t *ost);
+void ost_clear(order_stat_tree_t *ost);
+size_t ost_size(order_stat_tree_t *ost);
+bool ost_is_empty(order_stat_tree_t *ost);
+
+bool ost_insert(order_stat_tree_t *ost, void *key);
+bool ost_remove(order_stat_tree_t *ost, void *key);
+bool ost_contains(order_stat_tree_t *ost, void *key);
+size_t ost_count(order_stat_tree_t *ost, void *key);
+
+void *ost_select(order_stat_tree_t *ost, size_t index);
+size_t ost_rank(order_stat_tree_t *ost, void *key);
+void *ost_quantile(order_stat_tree_t *ost, double q);
+
+#endif // __ORDER_STAT_TREE_H__
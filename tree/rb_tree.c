@@ -0,0 +1,641 @@
+#include "rb_tree.h"
+#include <stdlib.h>
+
+static bool rb_is_black(rb_node_t *node)
+{
+    return node == NULL || node->color == RB_BLACK;
+}
+
+static rb_node_t *rb_node_alloc(rb_tree_t *rb)
+{
+    if (rb->pool != NULL)
+    {
+        return (rb_node_t *)np_alloc(rb->pool);
+    }
+    return (rb_node_t *)malloc(sizeof(rb_node_t));
+}
+
+static void rb_node_free(rb_tree_t *rb, rb_node_t *node)
+{
+    if (rb->pool != NULL)
+    {
+        np_free(rb->pool, node);
+    }
+    else
+    {
+        free(node);
+    }
+}
+
+static rb_node_t *rb_min_node(rb_node_t *node)
+{
+    while (node->left != NULL)
+    {
+        node = node->left;
+    }
+    return node;
+}
+
+static rb_node_t *rb_max_node(rb_node_t *node)
+{
+    while (node->right != NULL)
+    {
+        node = node->right;
+    }
+    return node;
+}
+
+// 用child替换node在父节点中的位置
+static void rb_replace_child(rb_tree_t *rb, rb_node_t *node, rb_node_t *child)
+{
+    rb_node_t *parent = node->parent;
+    if (parent == NULL)
+    {
+        rb->root = child;
+    }
+    else if (parent->left == node)
+    {
+        parent->left = child;
+    }
+    else
+    {
+        parent->right = child;
+    }
+    if (child != NULL)
+    {
+        child->parent = parent;
+    }
+}
+
+static void rb_rotate_left(rb_tree_t *rb, rb_node_t *node)
+{
+    rb_node_t *right = node->right;
+    node->right = right->left;
+    if (right->left != NULL)
+    {
+        right->left->parent = node;
+    }
+    rb_replace_child(rb, node, right);
+    right->left = node;
+    node->parent = right;
+}
+
+static void rb_rotate_right(rb_tree_t *rb, rb_node_t *node)
+{
+    rb_node_t *left = node->left;
+    node->left = left->right;
+    if (left->right != NULL)
+    {
+        left->right->parent = node;
+    }
+    rb_replace_child(rb, node, left);
+    left->right = node;
+    node->parent = left;
+}
+
+// 插入红色节点后修复连续红节点
+static void rb_insert_fixup(rb_tree_t *rb, rb_node_t *node)
+{
+    while (node->parent != NULL && node->parent->color == RB_RED)
+    {
+        rb_node_t *parent = node->parent;
+        rb_node_t *grand = parent->parent;
+        if (parent == grand->left)
+        {
+            rb_node_t *uncle = grand->right;
+            if (!rb_is_black(uncle))
+            {
+                // 叔节点为红：父、叔变黑，祖父变红后继续向上
+                parent->color = RB_BLACK;
+                uncle->color = RB_BLACK;
+                grand->color = RB_RED;
+                node = grand;
+                continue;
+            }
+            if (node == parent->right)
+            {
+                rb_rotate_left(rb, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RB_BLACK;
+            grand->color = RB_RED;
+            rb_rotate_right(rb, grand);
+        }
+        else
+        {
+            rb_node_t *uncle = grand->left;
+            if (!rb_is_black(uncle))
+            {
+                parent->color = RB_BLACK;
+                uncle->color = RB_BLACK;
+                grand->color = RB_RED;
+                node = grand;
+                continue;
+            }
+            if (node == parent->left)
+            {
+                rb_rotate_right(rb, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RB_BLACK;
+            grand->color = RB_RED;
+            rb_rotate_left(rb, grand);
+        }
+    }
+    rb->root->color = RB_BLACK;
+}
+
+// 删除黑色节点后修复黑高，node可能为NULL，因此同时传入其父节点
+static void rb_erase_fixup(rb_tree_t *rb, rb_node_t *node, rb_node_t *parent)
+{
+    while (node != rb->root && rb_is_black(node))
+    {
+        if (node == parent->left)
+        {
+            rb_node_t *sibling = parent->right;
+            if (sibling->color == RB_RED)
+            {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rb_rotate_left(rb, parent);
+                sibling = parent->right;
+            }
+            if (rb_is_black(sibling->left) && rb_is_black(sibling->right))
+            {
+                sibling->color = RB_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (rb_is_black(sibling->right))
+            {
+                sibling->left->color = RB_BLACK;
+                sibling->color = RB_RED;
+                rb_rotate_right(rb, sibling);
+                sibling = parent->right;
+            }
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->right->color = RB_BLACK;
+            rb_rotate_left(rb, parent);
+            node = rb->root;
+        }
+        else
+        {
+            rb_node_t *sibling = parent->left;
+            if (sibling->color == RB_RED)
+            {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rb_rotate_right(rb, parent);
+                sibling = parent->left;
+            }
+            if (rb_is_black(sibling->left) && rb_is_black(sibling->right))
+            {
+                sibling->color = RB_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (rb_is_black(sibling->left))
+            {
+                sibling->right->color = RB_BLACK;
+                sibling->color = RB_RED;
+                rb_rotate_left(rb, sibling);
+                sibling = parent->left;
+            }
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->left->color = RB_BLACK;
+            rb_rotate_right(rb, parent);
+            node = rb->root;
+        }
+    }
+    if (node != NULL)
+    {
+        node->color = RB_BLACK;
+    }
+}
+
+// 从树中摘下节点并重新平衡，不释放节点
+static void rb_unlink(rb_tree_t *rb, rb_node_t *node)
+{
+    rb_node_t *child;
+    rb_node_t *parent;
+    rb_color_t removed = node->color;
+
+    if (node->left == NULL)
+    {
+        child = node->right;
+        parent = node->parent;
+        rb_replace_child(rb, node, child);
+    }
+    else if (node->right == NULL)
+    {
+        child = node->left;
+        parent = node->parent;
+        rb_replace_child(rb, node, child);
+    }
+    else
+    {
+        // 两个子节点：用后继节点顶替node的位置与颜色
+        rb_node_t *successor = rb_min_node(node->right);
+        removed = successor->color;
+        child = successor->right;
+        if (successor->parent == node)
+        {
+            parent = successor;
+        }
+        else
+        {
+            parent = successor->parent;
+            rb_replace_child(rb, successor, child);
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+        rb_replace_child(rb, node, successor);
+        successor->left = node->left;
+        successor->left->parent = successor;
+        successor->color = node->color;
+    }
+
+    if (removed == RB_BLACK)
+    {
+        rb_erase_fixup(rb, child, parent);
+    }
+    rb->size--;
+}
+
+// 创建红黑树，节点逐个malloc
+rb_tree_t *rb_create(rb_cmp_fn cmp)
+{
+    if (cmp == NULL)
+    {
+        return NULL;
+    }
+    rb_tree_t *rb = (rb_tree_t *)calloc(1, sizeof(rb_tree_t));
+    if (rb == NULL)
+    {
+        return NULL;
+    }
+    rb->cmp = cmp;
+    return rb;
+}
+
+// 创建从节点池分配节点的红黑树，chunk_nodes为0时使用NP_DEFAULT_CHUNK_NODES
+rb_tree_t *rb_create_pooled(rb_cmp_fn cmp, size_t chunk_nodes)
+{
+    rb_tree_t *rb = rb_create(cmp);
+    if (rb == NULL)
+    {
+        return NULL;
+    }
+    rb->pool = np_create(sizeof(rb_node_t), chunk_nodes);
+    if (rb->pool == NULL)
+    {
+        free(rb);
+        return NULL;
+    }
+    return rb;
+}
+
+// 销毁红黑树（不释放键值本身）
+void rb_destroy(rb_tree_t *rb)
+{
+    if (rb == NULL)
+    {
+        return;
+    }
+    rb_clear(rb);
+    np_destroy(rb->pool);
+    free(rb);
+}
+
+// 清空红黑树（不释放键值本身）
+void rb_clear(rb_tree_t *rb)
+{
+    if (rb == NULL)
+    {
+        return;
+    }
+    if (rb->pool != NULL)
+    {
+        np_clear(rb->pool);
+    }
+    else
+    {
+        // 借助父指针后序释放，不需要栈
+        rb_node_t *node = rb->root;
+        while (node != NULL)
+        {
+            if (node->left != NULL)
+            {
+                node = node->left;
+            }
+            else if (node->right != NULL)
+            {
+                node = node->right;
+            }
+            else
+            {
+                rb_node_t *parent = node->parent;
+                if (parent != NULL)
+                {
+                    if (parent->left == node)
+                    {
+                        parent->left = NULL;
+                    }
+                    else
+                    {
+                        parent->right = NULL;
+                    }
+                }
+                free(node);
+                node = parent;
+            }
+        }
+    }
+    rb->root = NULL;
+    rb->size = 0;
+}
+
+// 获取元素个数
+size_t rb_size(rb_tree_t *rb)
+{
+    if (rb == NULL)
+    {
+        return 0;
+    }
+    return rb->size;
+}
+
+// 判断是否为空
+bool rb_is_empty(rb_tree_t *rb)
+{
+    if (rb == NULL)
+    {
+        return true;
+    }
+    return rb->size == 0;
+}
+
+// 插入键值对，键已存在时替换值；内存不足返回false
+bool rb_put(rb_tree_t *rb, void *key, void *value)
+{
+    if (rb == NULL)
+    {
+        return false;
+    }
+
+    rb_node_t *parent = NULL;
+    rb_node_t **link = &rb->root;
+    while (*link != NULL)
+    {
+        parent = *link;
+        int c = rb->cmp(key, parent->key);
+        if (c == 0)
+        {
+            parent->value = value;
+            return true;
+        }
+        link = c < 0 ? &parent->left : &parent->right;
+    }
+
+    rb_node_t *node = rb_node_alloc(rb);
+    if (node == NULL)
+    {
+        return false;
+    }
+    node->key = key;
+    node->value = value;
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = parent;
+    node->color = RB_RED;
+    *link = node;
+    rb->size++;
+    rb_insert_fixup(rb, node);
+    return true;
+}
+
+// 查找键所在的节点，不存在返回NULL
+rb_node_t *rb_search(rb_tree_t *rb, void *key)
+{
+    if (rb == NULL)
+    {
+        return NULL;
+    }
+    rb_node_t *node = rb->root;
+    while (node != NULL)
+    {
+        int c = rb->cmp(key, node->key);
+        if (c == 0)
+        {
+            return node;
+        }
+        node = c < 0 ? node->left : node->right;
+    }
+    return NULL;
+}
+
+// 获取键对应的值，不存在返回NULL
+void *rb_get(rb_tree_t *rb, void *key)
+{
+    rb_node_t *node = rb_search(rb, key);
+    return node == NULL ? NULL : node->value;
+}
+
+// 查找键，存在时通过value返回值（value可以为NULL）
+bool rb_find(rb_tree_t *rb, void *key, void **value)
+{
+    rb_node_t *node = rb_search(rb, key);
+    if (node == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = node->value;
+    }
+    return true;
+}
+
+// 判断键是否存在
+bool rb_contains(rb_tree_t *rb, void *key)
+{
+    return rb_search(rb, key) != NULL;
+}
+
+// 删除键，存在时通过value返回被删除的值（value可以为NULL）
+bool rb_remove(rb_tree_t *rb, void *key, void **value)
+{
+    rb_node_t *node = rb_search(rb, key);
+    if (node == NULL)
+    {
+        return false;
+    }
+    if (value != NULL)
+    {
+        *value = node->value;
+    }
+    rb_unlink(rb, node);
+    rb_node_free(rb, node);
+    return true;
+}
+
+// 第一个不小于key的节点，不存在返回NULL
+rb_node_t *rb_lower_bound(rb_tree_t *rb, void *key)
+{
+    if (rb == NULL)
+    {
+        return NULL;
+    }
+    rb_node_t *result = NULL;
+    rb_node_t *node = rb->root;
+    while (node != NULL)
+    {
+        if (rb->cmp(node->key, key) >= 0)
+        {
+            result = node;
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+    return result;
+}
+
+// 第一个大于key的节点，不存在返回NULL
+rb_node_t *rb_upper_bound(rb_tree_t *rb, void *key)
+{
+    if (rb == NULL)
+    {
+        return NULL;
+    }
+    rb_node_t *result = NULL;
+    rb_node_t *node = rb->root;
+    while (node != NULL)
+    {
+        if (rb->cmp(node->key, key) > 0)
+        {
+            result = node;
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+    return result;
+}
+
+// 键最小的节点，空树返回NULL
+rb_node_t *rb_first(rb_tree_t *rb)
+{
+    if (rb == NULL || rb->root == NULL)
+    {
+        return NULL;
+    }
+    return rb_min_node(rb->root);
+}
+
+// 键最大的节点，空树返回NULL
+rb_node_t *rb_last(rb_tree_t *rb)
+{
+    if (rb == NULL || rb->root == NULL)
+    {
+        return NULL;
+    }
+    return rb_max_node(rb->root);
+}
+
+// 中序后继，没有时返回NULL
+rb_node_t *rb_next(rb_node_t *node)
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    if (node->right != NULL)
+    {
+        return rb_min_node(node->right);
+    }
+    while (node->parent != NULL && node == node->parent->right)
+    {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+// 中序前驱，没有时返回NULL
+rb_node_t *rb_prev(rb_node_t *node)
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    if (node->left != NULL)
+    {
+        return rb_max_node(node->left);
+    }
+    while (node->parent != NULL && node == node->parent->left)
+    {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+// 删除节点并返回其后继，便于边遍历边删除；node必须属于rb
+rb_node_t *rb_erase(rb_tree_t *rb, rb_node_t *node)
+{
+    if (rb == NULL || node == NULL)
+    {
+        return NULL;
+    }
+    rb_node_t *next = rb_next(node);
+    rb_unlink(rb, node);
+    rb_node_free(rb, node);
+    return next;
+}
+
+// 按升序访问键在[low, high)内的元素，func返回false时提前结束
+// 返回访问的元素个数
+size_t rb_range(rb_tree_t *rb, void *low, void *high,
+                bool (*func)(void *key, void *value, void *arg), void *arg)
+{
+    if (rb == NULL || func == NULL)
+    {
+        return 0;
+    }
+    size_t count = 0;
+    for (rb_node_t *node = rb_lower_bound(rb, low); node != NULL; node = rb_next(node))
+    {
+        if (rb->cmp(node->key, high) >= 0)
+        {
+            break;
+        }
+        count++;
+        if (!func(node->key, node->value, arg))
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+// 按键的升序遍历
+void rb_foreach(rb_tree_t *rb, void (*func)(void *key, void *value))
+{
+    if (rb == NULL || func == NULL)
+    {
+        return;
+    }
+    for (rb_node_t *node = rb_first(rb); node != NULL; node = rb_next(node))
+    {
+        func(node->key, node->value);
+    }
+}
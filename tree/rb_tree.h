@@ -0,0 +1,66 @@
+#ifndef __RB_TREE_H__
+#define __RB_TREE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "pool/node_pool.h"
+
+// 红黑树有序映射
+// 键值均为void *，cmp(a, b) < 0 表示a排在b前，返回0表示两个键相等。
+// 查找、插入、删除均为最坏O(log n)；节点即迭代器，rb_first/rb_next按键的升序遍历，
+// rb_lower_bound/rb_upper_bound定位范围的起点，rb_range按升序扫描半开区间。
+// 删除只调整指针，不在节点间搬移键值，其他节点在删除后仍然有效。
+// 节点默认逐个malloc，rb_create_pooled创建的树从自带的节点池分配。
+typedef enum rb_color
+{
+    RB_RED,
+    RB_BLACK
+} rb_color_t;
+
+typedef struct rb_node
+{
+    void *key;
+    void *value;
+    struct rb_node *left;
+    struct rb_node *right;
+    struct rb_node *parent;
+    rb_color_t color;
+} rb_node_t;
+
+typedef int (*rb_cmp_fn)(void *a, void *b);
+
+typedef struct rb_tree
+{
+    rb_node_t *root;
+    size_t size;
+    rb_cmp_fn cmp;
+    node_pool_t *pool;  // NULL表示节点逐个malloc
+} rb_tree_t;
+
+rb_tree_t *rb_create(rb_cmp_fn cmp);
+rb_tree_t *rb_create_pooled(rb_cmp_fn cmp, size_t chunk_nodes);
+void rb_destroy(rb_tree_t *rb);
+void rb_clear(rb_tree_t *rb);
+size_t rb_size(rb_tree_t *rb);
+bool rb_is_empty(rb_tree_t *rb);
+
+bool rb_put(rb_tree_t *rb, void *key, void *value);
+void *rb_get(rb_tree_t *rb, void *key);
+bool rb_find(rb_tree_t *rb, void *key, void **value);
+bool rb_contains(rb_tree_t *rb, void *key);
+bool rb_remove(rb_tree_t *rb, void *key, void **value);
+
+rb_node_t *rb_search(rb_tree_t *rb, void *key);
+rb_node_t *rb_lower_bound(rb_tree_t *rb, void *key);
+rb_node_t *rb_upper_bound(rb_tree_t *rb, void *key);
+rb_node_t *rb_first(rb_tree_t *rb);
+rb_node_t *rb_last(rb_tree_t *rb);
+rb_node_t *rb_next(rb_node_t *node);
+rb_node_t *rb_prev(rb_node_t *node);
+rb_node_t *rb_erase(rb_tree_t *rb, rb_node_t *node);
+
+size_t rb_range(rb_tree_t *rb, void *low, void *high,
+                bool (*func)(void *key, void *value, void *arg), void *arg);
+void rb_foreach(rb_tree_t *rb, void (*func)(void *key, void *value));
+
+#endif // __RB_TREE_H__